@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         MSF configuration
+ *
+ */
+
+#ifndef __MSF_CONF_H__
+#define __MSF_CONF_H__
+
+/* The SFID of MSF, c.f. RFC 9033 */
+#ifdef MSF_CONF_SFID
+#define MSF_SFID                                  MSF_CONF_SFID
+#else /* MSF_CONF_SFID */
+#define MSF_SFID                                  0
+#endif /* MSF_CONF_SFID */
+
+/* Handle and length of the slotframe holding the negotiated cells */
+#ifdef MSF_CONF_SLOTFRAME_HANDLE
+#define MSF_SLOTFRAME_HANDLE                      MSF_CONF_SLOTFRAME_HANDLE
+#else /* MSF_CONF_SLOTFRAME_HANDLE */
+#define MSF_SLOTFRAME_HANDLE                      1
+#endif /* MSF_CONF_SLOTFRAME_HANDLE */
+
+#ifdef MSF_CONF_SLOTFRAME_LENGTH
+#define MSF_SLOTFRAME_LENGTH                      MSF_CONF_SLOTFRAME_LENGTH
+#else /* MSF_CONF_SLOTFRAME_LENGTH */
+#define MSF_SLOTFRAME_LENGTH                      101
+#endif /* MSF_CONF_SLOTFRAME_LENGTH */
+
+/* Channel offsets of negotiated cells are picked in 0..MSF_NUM_CHANNEL_OFFSETS-1 */
+#ifdef MSF_CONF_NUM_CHANNEL_OFFSETS
+#define MSF_NUM_CHANNEL_OFFSETS                   MSF_CONF_NUM_CHANNEL_OFFSETS
+#else /* MSF_CONF_NUM_CHANNEL_OFFSETS */
+#define MSF_NUM_CHANNEL_OFFSETS                   16
+#endif /* MSF_CONF_NUM_CHANNEL_OFFSETS */
+
+/* Number of candidate cells in ADD and RELOCATE requests */
+#ifdef MSF_CONF_NUM_CANDIDATES
+#define MSF_NUM_CANDIDATES                        MSF_CONF_NUM_CANDIDATES
+#else /* MSF_CONF_NUM_CANDIDATES */
+#define MSF_NUM_CANDIDATES                        5
+#endif /* MSF_CONF_NUM_CANDIDATES */
+
+/* Max number of TX cells negotiated with the parent */
+#ifdef MSF_CONF_MAX_TX_CELLS
+#define MSF_MAX_TX_CELLS                          MSF_CONF_MAX_TX_CELLS
+#else /* MSF_CONF_MAX_TX_CELLS */
+#define MSF_MAX_TX_CELLS                          8
+#endif /* MSF_CONF_MAX_TX_CELLS */
+
+/* Cell usage is evaluated every MSF_MAX_NUM_CELLS elapsed TX cells. A cell
+ * is added if more than MSF_LIM_NUMCELLSUSED_HIGH percent of them were
+ * used, one is deleted if less than MSF_LIM_NUMCELLSUSED_LOW percent were */
+#ifdef MSF_CONF_MAX_NUM_CELLS
+#define MSF_MAX_NUM_CELLS                         MSF_CONF_MAX_NUM_CELLS
+#else /* MSF_CONF_MAX_NUM_CELLS */
+#define MSF_MAX_NUM_CELLS                         100
+#endif /* MSF_CONF_MAX_NUM_CELLS */
+
+#ifdef MSF_CONF_LIM_NUMCELLSUSED_HIGH
+#define MSF_LIM_NUMCELLSUSED_HIGH                 MSF_CONF_LIM_NUMCELLSUSED_HIGH
+#else /* MSF_CONF_LIM_NUMCELLSUSED_HIGH */
+#define MSF_LIM_NUMCELLSUSED_HIGH                 75
+#endif /* MSF_CONF_LIM_NUMCELLSUSED_HIGH */
+
+#ifdef MSF_CONF_LIM_NUMCELLSUSED_LOW
+#define MSF_LIM_NUMCELLSUSED_LOW                  MSF_CONF_LIM_NUMCELLSUSED_LOW
+#else /* MSF_CONF_LIM_NUMCELLSUSED_LOW */
+#define MSF_LIM_NUMCELLSUSED_LOW                  25
+#endif /* MSF_CONF_LIM_NUMCELLSUSED_LOW */
+
+/* A cell is also added when this many packets wait in the queue to the
+ * parent, to react to bursts faster than the usage estimate. 0 to disable */
+#ifdef MSF_CONF_QUEUE_THRESHOLD
+#define MSF_QUEUE_THRESHOLD                       MSF_CONF_QUEUE_THRESHOLD
+#else /* MSF_CONF_QUEUE_THRESHOLD */
+#define MSF_QUEUE_THRESHOLD                       4
+#endif /* MSF_CONF_QUEUE_THRESHOLD */
+
+/* A TX cell is relocated when its PDR, in percent, falls below
+ * MSF_RELOCATE_PDR_THRESHOLD percent of that of the best cell. Only cells
+ * with at least MSF_MIN_NUM_TX transmissions are considered. Counters are
+ * halved when reaching MSF_MAX_NUM_TX */
+#ifdef MSF_CONF_RELOCATE_PDR_THRESHOLD
+#define MSF_RELOCATE_PDR_THRESHOLD                MSF_CONF_RELOCATE_PDR_THRESHOLD
+#else /* MSF_CONF_RELOCATE_PDR_THRESHOLD */
+#define MSF_RELOCATE_PDR_THRESHOLD                50
+#endif /* MSF_CONF_RELOCATE_PDR_THRESHOLD */
+
+#ifdef MSF_CONF_MIN_NUM_TX
+#define MSF_MIN_NUM_TX                            MSF_CONF_MIN_NUM_TX
+#else /* MSF_CONF_MIN_NUM_TX */
+#define MSF_MIN_NUM_TX                            16
+#endif /* MSF_CONF_MIN_NUM_TX */
+
+#ifdef MSF_CONF_MAX_NUM_TX
+#define MSF_MAX_NUM_TX                            MSF_CONF_MAX_NUM_TX
+#else /* MSF_CONF_MAX_NUM_TX */
+#define MSF_MAX_NUM_TX                            256
+#endif /* MSF_CONF_MAX_NUM_TX */
+
+/* Period of the MSF checks: usage, queue, parent changes */
+#ifdef MSF_CONF_CHECK_INTERVAL
+#define MSF_CHECK_INTERVAL                        MSF_CONF_CHECK_INTERVAL
+#else /* MSF_CONF_CHECK_INTERVAL */
+#define MSF_CHECK_INTERVAL                        CLOCK_SECOND
+#endif /* MSF_CONF_CHECK_INTERVAL */
+
+/* Period of the housekeeping, i.e. of the relocation of bad cells */
+#ifdef MSF_CONF_HOUSEKEEPING_INTERVAL
+#define MSF_HOUSEKEEPING_INTERVAL                 MSF_CONF_HOUSEKEEPING_INTERVAL
+#else /* MSF_CONF_HOUSEKEEPING_INTERVAL */
+#define MSF_HOUSEKEEPING_INTERVAL                 (60 * CLOCK_SECOND)
+#endif /* MSF_CONF_HOUSEKEEPING_INTERVAL */
+
+/* 6P transaction timeout */
+#ifdef MSF_CONF_TIMEOUT
+#define MSF_TIMEOUT                               MSF_CONF_TIMEOUT
+#else /* MSF_CONF_TIMEOUT */
+#define MSF_TIMEOUT                               (15 * CLOCK_SECOND)
+#endif /* MSF_CONF_TIMEOUT */
+
+#endif /* __MSF_CONF_H__ */
@@ -0,0 +1,687 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         MSF: a 6TiSCH Minimal Scheduling Function (c.f. RFC 9033) on
+ *         top of 6P. Negotiates TX cells to the TSCH time source (the RPL
+ *         preferred parent) and adapts their number to the traffic.
+ *
+ */
+
+#include "contiki.h"
+#include "msf.h"
+#include "lib/memb.h"
+#include "lib/random.h"
+#include "net/mac/tsch/tsch-private.h"
+#include "net/mac/tsch/tsch-queue.h"
+#include "net/mac/tsch/sixtop/sixp.h"
+#include <string.h>
+
+#define DEBUG DEBUG_NONE
+#include "net/ip/uip-debug.h"
+
+#if MSF_NUM_CANDIDATES + 1 > SIXP_PKT_MAX_CELLS
+#error "MSF_NUM_CANDIDATES: 6P messages too short, increase SIXP_PKT_CONF_MAX_LEN"
+#endif
+
+/* Usage of a negotiated TX cell, attached to its link */
+struct msf_cell_stats {
+  uint16_t num_tx;
+  uint16_t num_tx_ack;
+};
+MEMB(cell_stats_memb, struct msf_cell_stats, MSF_MAX_TX_CELLS);
+
+/* The parent, i.e. the time source */
+static linkaddr_t parent_addr;
+static uint8_t has_parent;
+/* The former parent, to which a CLEAR is due */
+static linkaddr_t old_parent_addr;
+static uint8_t clear_old_parent;
+
+/* Usage of the TX cells to the parent since the last adaptation.
+ * num_cells_used is incremented from the slot operation, read and reset
+ * it only with TSCH locked */
+static volatile uint16_t num_cells_used;
+static uint16_t num_cells_elapsed;
+static struct tsch_asn_t last_asn;
+
+static struct ctimer check_timer;
+static clock_time_t last_housekeeping;
+
+/* Cell lists of outgoing requests, 6P copies them */
+static uint8_t cells_buf[(MSF_NUM_CANDIDATES + 1) * SIXP_PKT_CELL_LEN];
+
+/*---------------------------------------------------------------------------*/
+/* Returns the slotframe of negotiated cells, (re-)creating it if needed:
+ * TSCH empties the schedule when joining a network */
+static struct tsch_slotframe *
+get_slotframe(void)
+{
+  struct tsch_slotframe *sf = tsch_schedule_get_slotframe_by_handle(MSF_SLOTFRAME_HANDLE);
+  if(sf == NULL) {
+    /* The links the stats were attached to are gone */
+    memb_init(&cell_stats_memb);
+    sf = tsch_schedule_add_slotframe(MSF_SLOTFRAME_HANDLE, MSF_SLOTFRAME_LENGTH);
+  }
+  return sf;
+}
+/*---------------------------------------------------------------------------*/
+/* TX becomes RX and vice versa: the options of the responder */
+static uint8_t
+reverse_options(uint8_t cell_options)
+{
+  uint8_t options = cell_options & SIXP_PKT_CELL_OPTION_SHARED;
+  if(cell_options & SIXP_PKT_CELL_OPTION_TX) {
+    options |= SIXP_PKT_CELL_OPTION_RX;
+  }
+  if(cell_options & SIXP_PKT_CELL_OPTION_RX) {
+    options |= SIXP_PKT_CELL_OPTION_TX;
+  }
+  return options;
+}
+/*---------------------------------------------------------------------------*/
+static int
+count_tx_cells(struct tsch_slotframe *sf, const linkaddr_t *peer)
+{
+  int count = 0;
+  struct tsch_link *l;
+  for(l = list_head(sf->links_list); l != NULL; l = list_item_next(l)) {
+    if((l->link_options & LINK_OPTION_TX) && linkaddr_cmp(&l->addr, peer)) {
+      count++;
+    }
+  }
+  return count;
+}
+/*---------------------------------------------------------------------------*/
+/* Installs a cell if its timeslot is free. The SIXP_PKT_CELL_OPTION_ values
+ * are those of the TSCH link options */
+static struct tsch_link *
+add_cell(struct tsch_slotframe *sf, const linkaddr_t *peer,
+         const struct sixp_pkt_cell *cell, uint8_t options)
+{
+  struct tsch_link *l;
+  struct msf_cell_stats *stats = NULL;
+
+  if(cell->timeslot == 0 || cell->timeslot >= MSF_SLOTFRAME_LENGTH
+     || tsch_schedule_get_link_by_timeslot(sf, cell->timeslot) != NULL) {
+    return NULL;
+  }
+  if(options & LINK_OPTION_TX) {
+    if((stats = memb_alloc(&cell_stats_memb)) != NULL) {
+      memset(stats, 0, sizeof(struct msf_cell_stats));
+    }
+  }
+  l = tsch_schedule_add_link(sf, options, LINK_TYPE_NORMAL, peer,
+                             cell->timeslot, cell->channel_offset);
+  if(l == NULL) {
+    if(stats != NULL) {
+      memb_free(&cell_stats_memb, stats);
+    }
+    return NULL;
+  }
+  l->data = stats;
+  PRINTF("MSF: added cell %u/%u, options %x, with %u\n", cell->timeslot,
+         cell->channel_offset, options, peer->u8[LINKADDR_SIZE - 1]);
+  return l;
+}
+/*---------------------------------------------------------------------------*/
+static struct tsch_link *
+find_cell(struct tsch_slotframe *sf, const linkaddr_t *peer,
+          const struct sixp_pkt_cell *cell, uint8_t options)
+{
+  struct tsch_link *l = tsch_schedule_get_link_by_timeslot(sf, cell->timeslot);
+  if(l != NULL && l->channel_offset == cell->channel_offset
+     && l->link_options == options && linkaddr_cmp(&l->addr, peer)) {
+    return l;
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+remove_cell(struct tsch_slotframe *sf, struct tsch_link *l)
+{
+  struct msf_cell_stats *stats = l->data;
+  PRINTF("MSF: removed cell %u/%u with %u\n", l->timeslot, l->channel_offset,
+         l->addr.u8[LINKADDR_SIZE - 1]);
+  /* Free the stats only once TSCH no longer uses the link */
+  tsch_schedule_remove_link(sf, l);
+  if(stats != NULL) {
+    memb_free(&cell_stats_memb, stats);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+remove_cells(struct tsch_slotframe *sf, const linkaddr_t *peer)
+{
+  struct tsch_link *l = list_head(sf->links_list);
+  while(l != NULL) {
+    struct tsch_link *next = list_item_next(l);
+    if(linkaddr_cmp(&l->addr, peer)) {
+      remove_cell(sf, l);
+    }
+    l = next;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+remove_listed_cells(struct tsch_slotframe *sf, const linkaddr_t *peer,
+                    const uint8_t *cell_list, uint8_t cell_list_len, uint8_t options)
+{
+  struct sixp_pkt_cell cell;
+  struct tsch_link *l;
+  uint8_t i;
+  for(i = 0; i < cell_list_len; i++) {
+    sixp_pkt_get_cell(cell_list, i, &cell);
+    if((l = find_cell(sf, peer, &cell, options)) != NULL) {
+      remove_cell(sf, l);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Picks up to max random cells in free timeslots, all in distinct ones */
+static uint8_t
+select_candidates(struct tsch_slotframe *sf, uint8_t *cell_list, uint8_t max)
+{
+  struct sixp_pkt_cell cell;
+  struct sixp_pkt_cell other;
+  uint8_t count = 0;
+  uint16_t tries;
+  uint8_t i;
+
+  for(tries = 0; tries < MSF_SLOTFRAME_LENGTH && count < max; tries++) {
+    cell.timeslot = 1 + random_rand() % (MSF_SLOTFRAME_LENGTH - 1);
+    cell.channel_offset = random_rand() % MSF_NUM_CHANNEL_OFFSETS;
+    if(tsch_schedule_get_link_by_timeslot(sf, cell.timeslot) != NULL) {
+      continue;
+    }
+    for(i = 0; i < count; i++) {
+      sixp_pkt_get_cell(cell_list, i, &other);
+      if(other.timeslot == cell.timeslot) {
+        break;
+      }
+    }
+    if(i == count) {
+      sixp_pkt_set_cell(cell_list, count++, &cell);
+    }
+  }
+  return count;
+}
+/*---------------------------------------------------------------------------*/
+static int
+request_add(struct tsch_slotframe *sf, const linkaddr_t *peer)
+{
+  struct sixp_pkt request;
+  memset(&request, 0, sizeof(request));
+  request.code = SIXP_PKT_CMD_ADD;
+  request.cell_options = SIXP_PKT_CELL_OPTION_TX;
+  request.num_cells = 1;
+  request.cell_list = cells_buf;
+  request.cell_list_len = select_candidates(sf, cells_buf, MSF_NUM_CANDIDATES);
+  if(request.cell_list_len == 0) {
+    return -1;
+  }
+  return sixp_send_request(peer, MSF_SFID, &request);
+}
+/*---------------------------------------------------------------------------*/
+static int
+request_delete(struct tsch_link *l)
+{
+  struct sixp_pkt request;
+  struct sixp_pkt_cell cell = { l->timeslot, l->channel_offset };
+  memset(&request, 0, sizeof(request));
+  request.code = SIXP_PKT_CMD_DELETE;
+  request.cell_options = SIXP_PKT_CELL_OPTION_TX;
+  request.num_cells = 1;
+  request.cell_list = cells_buf;
+  request.cell_list_len = 1;
+  sixp_pkt_set_cell(cells_buf, 0, &cell);
+  return sixp_send_request(&l->addr, MSF_SFID, &request);
+}
+/*---------------------------------------------------------------------------*/
+static int
+request_relocate(struct tsch_slotframe *sf, struct tsch_link *l)
+{
+  struct sixp_pkt request;
+  struct sixp_pkt_cell cell = { l->timeslot, l->channel_offset };
+  memset(&request, 0, sizeof(request));
+  request.code = SIXP_PKT_CMD_RELOCATE;
+  request.cell_options = SIXP_PKT_CELL_OPTION_TX;
+  request.num_cells = 1;
+  request.cell_list = cells_buf;
+  request.cell_list_len = 1;
+  sixp_pkt_set_cell(cells_buf, 0, &cell);
+  request.candidate_list = cells_buf + SIXP_PKT_CELL_LEN;
+  request.candidate_list_len = select_candidates(sf, request.candidate_list, MSF_NUM_CANDIDATES);
+  if(request.candidate_list_len == 0) {
+    return -1;
+  }
+  return sixp_send_request(&l->addr, MSF_SFID, &request);
+}
+/*---------------------------------------------------------------------------*/
+static int
+request_clear(const linkaddr_t *peer)
+{
+  struct sixp_pkt request;
+  memset(&request, 0, sizeof(request));
+  request.code = SIXP_PKT_CMD_CLEAR;
+  return sixp_send_request(peer, MSF_SFID, &request);
+}
+/*---------------------------------------------------------------------------*/
+static void
+reset_counters(void)
+{
+  /* Without the lock keep both, so that their ratio stays right */
+  if(!tsch_get_lock()) {
+    return;
+  }
+  num_cells_used = 0;
+  num_cells_elapsed = 0;
+  last_asn = tsch_current_asn;
+  tsch_release_lock();
+}
+/*---------------------------------------------------------------------------*/
+/* Relocates the TX cell to the parent with the worst PDR if it is much worse
+ * than that of the best one, c.f. RFC 9033, section 5.3 */
+static void
+housekeeping(struct tsch_slotframe *sf)
+{
+  struct tsch_link *l;
+  struct tsch_link *worst = NULL;
+  uint8_t best_pdr = 0;
+  uint8_t worst_pdr = 100;
+
+  for(l = list_head(sf->links_list); l != NULL; l = list_item_next(l)) {
+    struct msf_cell_stats *stats = l->data;
+    if(stats != NULL && stats->num_tx >= MSF_MIN_NUM_TX
+       && linkaddr_cmp(&l->addr, &parent_addr)) {
+      uint8_t pdr = (uint32_t)stats->num_tx_ack * 100 / stats->num_tx;
+      if(pdr > best_pdr) {
+        best_pdr = pdr;
+      }
+      if(worst == NULL || pdr < worst_pdr) {
+        worst = l;
+        worst_pdr = pdr;
+      }
+    }
+  }
+
+  if(worst != NULL && (uint16_t)worst_pdr * 100 < (uint16_t)best_pdr * MSF_RELOCATE_PDR_THRESHOLD) {
+    PRINTF("MSF: relocating cell %u, pdr %u vs %u\n", worst->timeslot, worst_pdr, best_pdr);
+    request_relocate(sf, worst);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Adapts the number of TX cells to the parent, c.f. RFC 9033, section 5.1 */
+static void
+check(void *ptr)
+{
+  struct tsch_slotframe *sf;
+  struct tsch_link *l;
+  uint32_t slotframes;
+  uint32_t elapsed;
+  int num_tx_cells;
+
+  ctimer_reset(&check_timer);
+
+  if(!tsch_is_associated || (sf = get_slotframe()) == NULL) {
+    return;
+  }
+
+  if(clear_old_parent && !sixp_is_busy(&old_parent_addr)) {
+    /* Best effort: the old parent is possibly out of reach */
+    request_clear(&old_parent_addr);
+    clear_old_parent = 0;
+  }
+
+  if(!has_parent || sixp_is_busy(&parent_addr)) {
+    return;
+  }
+
+  num_tx_cells = count_tx_cells(sf, &parent_addr);
+  slotframes = TSCH_ASN_DIFF(tsch_current_asn, last_asn) / MSF_SLOTFRAME_LENGTH;
+  if(slotframes > 0) {
+    elapsed = num_cells_elapsed + slotframes * num_tx_cells;
+    num_cells_elapsed = elapsed > 0xffff ? 0xffff : elapsed;
+    TSCH_ASN_INC(last_asn, slotframes * MSF_SLOTFRAME_LENGTH);
+  }
+
+  if(num_tx_cells == 0) {
+    /* Always keep one cell to the parent */
+    request_add(sf, &parent_addr);
+    reset_counters();
+  } else if(MSF_QUEUE_THRESHOLD > 0 && num_tx_cells < MSF_MAX_TX_CELLS
+            && tsch_queue_packet_count(&parent_addr) >= MSF_QUEUE_THRESHOLD) {
+    PRINTF("MSF: queue to parent is %u packets long\n",
+           tsch_queue_packet_count(&parent_addr));
+    request_add(sf, &parent_addr);
+    reset_counters();
+  } else if(num_cells_elapsed >= MSF_MAX_NUM_CELLS) {
+    uint32_t used;
+    if(!tsch_get_lock()) {
+      /* Try again at the next housekeeping */
+      return;
+    }
+    used = num_cells_used;
+    tsch_release_lock();
+    PRINTF("MSF: %u cells used out of %u, %u TX cells\n",
+           (unsigned)used, num_cells_elapsed, num_tx_cells);
+    if(used * 100 > (uint32_t)MSF_LIM_NUMCELLSUSED_HIGH * num_cells_elapsed) {
+      if(num_tx_cells < MSF_MAX_TX_CELLS) {
+        request_add(sf, &parent_addr);
+      }
+    } else if(used * 100 < (uint32_t)MSF_LIM_NUMCELLSUSED_LOW * num_cells_elapsed) {
+      if(num_tx_cells > 1) {
+        for(l = list_head(sf->links_list); l != NULL; l = list_item_next(l)) {
+          if((l->link_options & LINK_OPTION_TX) && linkaddr_cmp(&l->addr, &parent_addr)) {
+            request_delete(l);
+            break;
+          }
+        }
+      }
+    }
+    reset_counters();
+  } else if(clock_time() - last_housekeeping >= MSF_HOUSEKEEPING_INTERVAL) {
+    last_housekeeping = clock_time();
+    housekeeping(sf);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Responder: picks the cells of the response. Cells to add are installed
+ * right away, so that no other request gets them, and removed again if the
+ * response does not make it */
+static void
+request_input(const linkaddr_t *peer, const struct sixp_pkt *request,
+              struct sixp_pkt *response)
+{
+  struct tsch_slotframe *sf = get_slotframe();
+  uint8_t options = reverse_options(request->cell_options);
+  struct sixp_pkt_cell cell;
+  uint8_t i;
+
+  if(sf == NULL) {
+    response->code = SIXP_PKT_RC_ERR;
+    return;
+  }
+
+  switch(request->code) {
+    case SIXP_PKT_CMD_RELOCATE:
+    case SIXP_PKT_CMD_DELETE:
+      /* All cells to delete or relocate must be in the schedule */
+      for(i = 0; i < request->cell_list_len; i++) {
+        sixp_pkt_get_cell(request->cell_list, i, &cell);
+        if(find_cell(sf, peer, &cell, options) == NULL) {
+          response->code = SIXP_PKT_RC_ERR_CELLLIST;
+          return;
+        }
+        if(request->code == SIXP_PKT_CMD_DELETE && i < request->num_cells) {
+          sixp_pkt_set_cell(response->cell_list, response->cell_list_len++, &cell);
+        }
+      }
+      if(request->code == SIXP_PKT_CMD_DELETE) {
+        break;
+      }
+      /* RELOCATE: pick new cells among the candidates */
+      for(i = 0; i < request->candidate_list_len
+          && response->cell_list_len < request->num_cells; i++) {
+        sixp_pkt_get_cell(request->candidate_list, i, &cell);
+        if(add_cell(sf, peer, &cell, options) != NULL) {
+          sixp_pkt_set_cell(response->cell_list, response->cell_list_len++, &cell);
+        }
+      }
+      break;
+    case SIXP_PKT_CMD_ADD:
+      for(i = 0; i < request->cell_list_len
+          && response->cell_list_len < request->num_cells; i++) {
+        sixp_pkt_get_cell(request->cell_list, i, &cell);
+        if(add_cell(sf, peer, &cell, options) != NULL) {
+          sixp_pkt_set_cell(response->cell_list, response->cell_list_len++, &cell);
+        }
+      }
+      break;
+    case SIXP_PKT_CMD_CLEAR:
+      /* Done in response_sent */
+      break;
+    default:
+      response->code = SIXP_PKT_RC_ERR;
+      break;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Responder: commits or rolls back the schedule changes */
+static void
+response_sent(const linkaddr_t *peer, const struct sixp_pkt *request,
+              const struct sixp_pkt *response, int status)
+{
+  struct tsch_slotframe *sf = get_slotframe();
+  uint8_t options = reverse_options(request->cell_options);
+
+  if(sf == NULL) {
+    return;
+  }
+
+  if(request->code == SIXP_PKT_CMD_CLEAR) {
+    /* Whether the response made it or not */
+    remove_cells(sf, peer);
+    return;
+  }
+  if(response->code != SIXP_PKT_RC_SUCCESS) {
+    return;
+  }
+
+  switch(request->code) {
+    case SIXP_PKT_CMD_ADD:
+      if(status != MAC_TX_OK) {
+        remove_listed_cells(sf, peer, response->cell_list, response->cell_list_len, options);
+      }
+      break;
+    case SIXP_PKT_CMD_DELETE:
+      if(status == MAC_TX_OK) {
+        remove_listed_cells(sf, peer, response->cell_list, response->cell_list_len, options);
+      }
+      break;
+    case SIXP_PKT_CMD_RELOCATE:
+      if(status == MAC_TX_OK) {
+        /* The i-th new cell replaces the i-th relocated one */
+        remove_listed_cells(sf, peer, request->cell_list, response->cell_list_len, options);
+      } else {
+        remove_listed_cells(sf, peer, response->cell_list, response->cell_list_len, options);
+      }
+      break;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Initiator: applies the schedule changes the responder agreed on */
+static void
+response_input(const linkaddr_t *peer, const struct sixp_pkt *request,
+               const struct sixp_pkt *response)
+{
+  struct tsch_slotframe *sf = get_slotframe();
+  struct sixp_pkt_cell cell;
+  struct sixp_pkt_cell old_cell;
+  struct tsch_link *l;
+  uint8_t i;
+
+  if(sf == NULL) {
+    return;
+  }
+
+  if(request->code == SIXP_PKT_CMD_CLEAR) {
+    remove_cells(sf, peer);
+    return;
+  }
+  if(response->code == SIXP_PKT_RC_ERR_SEQNUM) {
+    /* Schedules are inconsistent, start over, c.f. RFC 9033, section 5.5 */
+    PRINTF("MSF: inconsistent schedule with %u\n", peer->u8[LINKADDR_SIZE - 1]);
+    remove_cells(sf, peer);
+    request_clear(peer);
+    return;
+  }
+  if(response->code != SIXP_PKT_RC_SUCCESS) {
+    return;
+  }
+
+  switch(request->code) {
+    case SIXP_PKT_CMD_ADD:
+      for(i = 0; i < response->cell_list_len && i < request->num_cells; i++) {
+        sixp_pkt_get_cell(response->cell_list, i, &cell);
+        if(sixp_pkt_find_cell(request->cell_list, request->cell_list_len, &cell) != -1) {
+          add_cell(sf, peer, &cell, request->cell_options);
+        }
+      }
+      break;
+    case SIXP_PKT_CMD_DELETE:
+      remove_listed_cells(sf, peer, response->cell_list, response->cell_list_len,
+                          request->cell_options);
+      break;
+    case SIXP_PKT_CMD_RELOCATE:
+      for(i = 0; i < response->cell_list_len && i < request->num_cells; i++) {
+        sixp_pkt_get_cell(response->cell_list, i, &cell);
+        sixp_pkt_get_cell(request->cell_list, i, &old_cell);
+        if(sixp_pkt_find_cell(request->candidate_list, request->candidate_list_len, &cell) != -1) {
+          if((l = find_cell(sf, peer, &old_cell, request->cell_options)) != NULL) {
+            remove_cell(sf, l);
+          }
+          add_cell(sf, peer, &cell, request->cell_options);
+        }
+      }
+      break;
+  }
+  reset_counters();
+}
+/*---------------------------------------------------------------------------*/
+static void
+timeout(const linkaddr_t *peer, const struct sixp_pkt *request)
+{
+  /* Nothing to undo, the next check retries if needed */
+  PRINTF("MSF: request %u to %u timed out\n", request->code, peer->u8[LINKADDR_SIZE - 1]);
+}
+/*---------------------------------------------------------------------------*/
+const struct sixtop_sf msf = {
+  MSF_SFID,
+  MSF_TIMEOUT,
+  NULL,
+  request_input,
+  response_sent,
+  response_input,
+  timeout,
+};
+/*---------------------------------------------------------------------------*/
+/* Number of TX cells currently negotiated with the parent */
+int
+msf_num_tx_cells(void)
+{
+  struct tsch_slotframe *sf = tsch_schedule_get_slotframe_by_handle(MSF_SLOTFRAME_HANDLE);
+  if(sf == NULL || !has_parent) {
+    return 0;
+  }
+  return count_tx_cells(sf, &parent_addr);
+}
+/*---------------------------------------------------------------------------*/
+void
+msf_callback_tx_done(const struct tsch_link *link, int mac_tx_status)
+{
+  struct msf_cell_stats *stats;
+  if(link == NULL || link->slotframe_handle != MSF_SLOTFRAME_HANDLE
+     || (stats = link->data) == NULL) {
+    return;
+  }
+  num_cells_used++;
+  stats->num_tx++;
+  if(mac_tx_status == MAC_TX_OK) {
+    stats->num_tx_ack++;
+  }
+  if(stats->num_tx >= MSF_MAX_NUM_TX) {
+    stats->num_tx /= 2;
+    stats->num_tx_ack /= 2;
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+msf_callback_new_time_source(const struct tsch_neighbor *old, const struct tsch_neighbor *new)
+{
+  struct tsch_slotframe *sf = tsch_schedule_get_slotframe_by_handle(MSF_SLOTFRAME_HANDLE);
+
+  if(old != NULL) {
+    /* Our cells with the old parent are of no use anymore. Tell it from
+     * the next check, this might be called while handling a packet. */
+    if(sf != NULL) {
+      remove_cells(sf, &old->addr);
+    }
+    linkaddr_copy(&old_parent_addr, &old->addr);
+    clear_old_parent = 1;
+  }
+  if(new != NULL) {
+    linkaddr_copy(&parent_addr, &new->addr);
+    has_parent = 1;
+    if(clear_old_parent && linkaddr_cmp(&old_parent_addr, &parent_addr)) {
+      clear_old_parent = 0;
+    }
+  } else {
+    has_parent = 0;
+  }
+  reset_counters();
+}
+/*---------------------------------------------------------------------------*/
+void
+msf_callback_child_removed(const linkaddr_t *addr)
+{
+  struct tsch_slotframe *sf = tsch_schedule_get_slotframe_by_handle(MSF_SLOTFRAME_HANDLE);
+  if(addr == NULL || (has_parent && linkaddr_cmp(addr, &parent_addr))) {
+    return;
+  }
+  if(sf != NULL) {
+    remove_cells(sf, addr);
+  }
+  sixp_reset_nbr(addr);
+}
+/*---------------------------------------------------------------------------*/
+void
+msf_init(void)
+{
+  struct tsch_neighbor *n;
+
+  memb_init(&cell_stats_memb);
+  has_parent = 0;
+  clear_old_parent = 0;
+  if((n = tsch_queue_get_time_source()) != NULL) {
+    linkaddr_copy(&parent_addr, &n->addr);
+    has_parent = 1;
+  }
+  reset_counters();
+  last_housekeeping = clock_time();
+
+  sixtop_add_sf(&msf);
+  ctimer_set(&check_timer, MSF_CHECK_INTERVAL, check, NULL);
+  PRINTF("MSF: initialization done\n");
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         MSF: a 6TiSCH Minimal Scheduling Function (c.f. RFC 9033) on
+ *         top of 6P. Negotiates TX cells to the TSCH time source (the RPL
+ *         preferred parent) and adapts their number to the traffic.
+ *
+ */
+
+#ifndef __MSF_H__
+#define __MSF_H__
+
+#include "net/mac/tsch/tsch.h"
+#include "net/mac/tsch/tsch-conf.h"
+#include "net/mac/tsch/tsch-schedule.h"
+#include "net/mac/tsch/sixtop/sixtop.h"
+#include "msf-conf.h"
+
+/* The 6top scheduling function */
+extern const struct sixtop_sf msf;
+
+/* Call from application to start MSF */
+void msf_init(void);
+/* Number of TX cells currently negotiated with the parent */
+int msf_num_tx_cells(void);
+/* Callbacks required for MSF to operate */
+/* Set with #define TSCH_CALLBACK_NEW_TIME_SOURCE msf_callback_new_time_source */
+void msf_callback_new_time_source(const struct tsch_neighbor *old, const struct tsch_neighbor *new);
+/* Set with #define TSCH_CALLBACK_TX_DONE msf_callback_tx_done */
+void msf_callback_tx_done(const struct tsch_link *link, int mac_tx_status);
+/* Optional, frees the cells of children that left.
+ * Set with #define NETSTACK_CONF_ROUTING_NEIGHBOR_REMOVED_CALLBACK msf_callback_child_removed */
+void msf_callback_child_removed(const linkaddr_t *addr);
+
+#endif /* __MSF_H__ */
@@ -102,4 +102,37 @@
 #define ORCHESTRA_COLLISION_FREE_HASH             0 /* Set to 1 if ORCHESTRA_LINKADDR_HASH returns unique hashes */
 #endif /* ORCHESTRA_CONF_COLLISION_FREE_HASH */
 
+/* Rule unicast_adaptive_rpl_storing: maximum number of receive cells per node
+ * in the unicast slotframe. Cell j of a node is at timeslot
+ * (hash + j * ORCHESTRA_UNICAST_PERIOD / ORCHESTRA_ADAPTIVE_MAX_CELLS) % ORCHESTRA_UNICAST_PERIOD */
+#ifdef ORCHESTRA_CONF_ADAPTIVE_MAX_CELLS
+#define ORCHESTRA_ADAPTIVE_MAX_CELLS              ORCHESTRA_CONF_ADAPTIVE_MAX_CELLS
+#else /* ORCHESTRA_CONF_ADAPTIVE_MAX_CELLS */
+#define ORCHESTRA_ADAPTIVE_MAX_CELLS              4
+#endif /* ORCHESTRA_CONF_ADAPTIVE_MAX_CELLS */
+
+/* Rule unicast_adaptive_rpl_storing: one more receive cell for every this many
+ * nodes in our sub-DODAG (i.e. routing entries) */
+#ifdef ORCHESTRA_CONF_ADAPTIVE_NODES_PER_CELL
+#define ORCHESTRA_ADAPTIVE_NODES_PER_CELL         ORCHESTRA_CONF_ADAPTIVE_NODES_PER_CELL
+#else /* ORCHESTRA_CONF_ADAPTIVE_NODES_PER_CELL */
+#define ORCHESTRA_ADAPTIVE_NODES_PER_CELL         4
+#endif /* ORCHESTRA_CONF_ADAPTIVE_NODES_PER_CELL */
+
+/* Rule unicast_adaptive_rpl_storing: how often the number of receive cells is
+ * re-evaluated. A decrease takes effect one period after being advertised. */
+#ifdef ORCHESTRA_CONF_ADAPTIVE_UPDATE_PERIOD
+#define ORCHESTRA_ADAPTIVE_UPDATE_PERIOD          ORCHESTRA_CONF_ADAPTIVE_UPDATE_PERIOD
+#else /* ORCHESTRA_CONF_ADAPTIVE_UPDATE_PERIOD */
+#define ORCHESTRA_ADAPTIVE_UPDATE_PERIOD          (60 * CLOCK_SECOND)
+#endif /* ORCHESTRA_CONF_ADAPTIVE_UPDATE_PERIOD */
+
+/* Rule unicast_adaptive_rpl_storing: type of the DIO option advertising the
+ * number of receive cells. Not IANA-assigned; RPL nodes ignore unknown options. */
+#ifdef ORCHESTRA_CONF_ADAPTIVE_DIO_OPTION
+#define ORCHESTRA_ADAPTIVE_DIO_OPTION             ORCHESTRA_CONF_ADAPTIVE_DIO_OPTION
+#else /* ORCHESTRA_CONF_ADAPTIVE_DIO_OPTION */
+#define ORCHESTRA_ADAPTIVE_DIO_OPTION             0x7e
+#endif /* ORCHESTRA_CONF_ADAPTIVE_DIO_OPTION */
+
 #endif /* __ORCHESTRA_CONF_H__ */
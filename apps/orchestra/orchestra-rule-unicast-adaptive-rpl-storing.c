@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Orchestra: a receiver-based unicast slotframe for RPL storing mode where
+ *         the number of receive cells of a node grows with the size of its sub-DODAG.
+ *         A node with k cells listens at timeslots
+ *           (hash(MAC) + j * ORCHESTRA_UNICAST_PERIOD / ORCHESTRA_ADAPTIVE_MAX_CELLS)
+ *                   % ORCHESTRA_UNICAST_PERIOD, for j = 0 .. k-1
+ *         with k = 1 + (number of routes) / ORCHESTRA_ADAPTIVE_NODES_PER_CELL.
+ *         k is advertised in a DIO option, so that the parent and children know
+ *         at which timeslots to transmit without any negotiation.
+ *         Nodes transmit to their RPL preferred parent and children at all of their cells,
+ *         choosing the cell of each packet in a round-robin fashion.
+ *
+ */
+
+#include "contiki.h"
+#include "orchestra.h"
+#include "net/ipv6/uip-ds6-route.h"
+#include "net/packetbuf.h"
+#include "net/rpl/rpl-conf.h"
+#include "net/rpl/rpl-private.h"
+#include <string.h>
+
+/*
+ * The body of this rule should be compiled only when "nbr_routes" is available,
+ * otherwise a link error causes build failure. "nbr_routes" is compiled if
+ * UIP_CONF_MAX_ROUTES != 0. See uip-ds6-route.c.
+ */
+#if UIP_CONF_MAX_ROUTES != 0
+
+#define CELL_STRIDE (ORCHESTRA_UNICAST_PERIOD / ORCHESTRA_ADAPTIVE_MAX_CELLS)
+
+/* The number of cells advertised by a neighbor. After a decrease, we keep
+ * transmitting at the cells covered by prev_cells for at least one full
+ * update period, so that packets queued for these cells can drain. */
+struct nbr_cells {
+  uint8_t cells;
+  uint8_t prev_cells;
+  uint8_t keep_prev;
+};
+NBR_TABLE(struct nbr_cells, nbr_cells);
+
+static uint16_t slotframe_handle = 0;
+static uint16_t channel_offset = 0;
+static struct tsch_slotframe *sf_unicast;
+/* The number of cells we advertise, the one we advertised before the last
+ * update, and the number of cells we listen to, which stays larger for two
+ * update periods after a decrease */
+static uint8_t own_cells = 1;
+static uint8_t prev_own_cells = 1;
+static uint8_t rx_cells = 1;
+/* Round-robin index for the cell of the next packet */
+static uint8_t next_cell;
+static struct ctimer update_timer;
+
+/*---------------------------------------------------------------------------*/
+static uint16_t
+get_node_timeslot(const linkaddr_t *addr, uint8_t cell)
+{
+  if(addr != NULL && ORCHESTRA_UNICAST_PERIOD > 0) {
+    return (ORCHESTRA_LINKADDR_HASH(addr) + cell * CELL_STRIDE) % ORCHESTRA_UNICAST_PERIOD;
+  } else {
+    return 0xffff;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+get_nbr_cells(const linkaddr_t *addr, int with_prev)
+{
+  struct nbr_cells *c = nbr_table_get_from_lladdr(nbr_cells, addr);
+  if(c == NULL) {
+    return 1;
+  }
+  return with_prev ? MAX(c->cells, c->prev_cells) : c->cells;
+}
+/*---------------------------------------------------------------------------*/
+static int
+neighbor_has_uc_link(const linkaddr_t *linkaddr)
+{
+  if(linkaddr != NULL && !linkaddr_cmp(linkaddr, &linkaddr_null)) {
+    if(linkaddr_cmp(&orchestra_parent_linkaddr, linkaddr)) {
+      return 1;
+    }
+    if(nbr_table_get_from_lladdr(nbr_routes, (linkaddr_t *)linkaddr) != NULL) {
+      return 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_tx_options(uint8_t *link_options, const linkaddr_t *addr)
+{
+  uint8_t i;
+  uint8_t cells = get_nbr_cells(addr, 1);
+  for(i = 0; i < cells; i++) {
+    link_options[get_node_timeslot(addr, i)] |= LINK_OPTION_TX | LINK_OPTION_SHARED;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+update_links(void)
+{
+  static uint8_t link_options[ORCHESTRA_UNICAST_PERIOD];
+  nbr_table_item_t *item;
+  struct tsch_link *l;
+  uint16_t timeslot;
+  uint8_t i;
+
+  /* Compute the options of every timeslot: RX at our cells, TX|SHARED at
+   * the cells of our parent and of our children */
+  memset(link_options, 0, sizeof(link_options));
+  for(i = 0; i < rx_cells; i++) {
+    link_options[get_node_timeslot(&linkaddr_node_addr, i)] |= LINK_OPTION_RX;
+  }
+  if(!linkaddr_cmp(&orchestra_parent_linkaddr, &linkaddr_null)) {
+    set_tx_options(link_options, &orchestra_parent_linkaddr);
+  }
+  item = nbr_table_head(nbr_routes);
+  while(item != NULL) {
+    set_tx_options(link_options, nbr_table_get_lladdr(nbr_routes, item));
+    item = nbr_table_next(nbr_routes, item);
+  }
+
+  /* Add, update or remove only the links that changed */
+  for(timeslot = 0; timeslot < ORCHESTRA_UNICAST_PERIOD; timeslot++) {
+    l = tsch_schedule_get_link_by_timeslot(sf_unicast, timeslot);
+    if(link_options[timeslot] == 0) {
+      if(l != NULL) {
+        tsch_schedule_remove_link(sf_unicast, l);
+      }
+    } else if(l == NULL || l->link_options != link_options[timeslot]) {
+      tsch_schedule_add_link(sf_unicast, link_options[timeslot], LINK_TYPE_NORMAL,
+                             &tsch_broadcast_address, timeslot, channel_offset);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+update_cells(void *ptr)
+{
+  struct nbr_cells *c;
+  uint8_t cells = 1 + uip_ds6_route_num_routes() / ORCHESTRA_ADAPTIVE_NODES_PER_CELL;
+  cells = MIN(cells, ORCHESTRA_ADAPTIVE_MAX_CELLS);
+
+  /* Keep listening at the cells we stop advertising for two updates, until
+   * our neighbors have drained the packets they queued for them */
+  rx_cells = MAX(cells, MAX(own_cells, prev_own_cells));
+  prev_own_cells = own_cells;
+  for(c = nbr_table_head(nbr_cells); c != NULL; c = nbr_table_next(nbr_cells, c)) {
+    if(c->keep_prev) {
+      c->keep_prev = 0;
+    } else {
+      c->prev_cells = c->cells;
+    }
+  }
+
+  if(cells != own_cells) {
+    own_cells = cells;
+    /* Advertise the new number of cells quickly */
+    if(default_instance != NULL) {
+      rpl_reset_dio_timer(default_instance);
+    }
+  }
+  update_links();
+
+  ctimer_set(&update_timer, ORCHESTRA_ADAPTIVE_UPDATE_PERIOD, update_cells, NULL);
+}
+/*---------------------------------------------------------------------------*/
+static void
+dio_option_input(const linkaddr_t *from, const uint8_t *option, uint8_t len)
+{
+  struct nbr_cells *c;
+  uint8_t cells;
+
+  if(from == NULL || option[0] != ORCHESTRA_ADAPTIVE_DIO_OPTION || len != 3) {
+    return;
+  }
+  cells = MAX(1, MIN(option[2], ORCHESTRA_ADAPTIVE_MAX_CELLS));
+
+  c = nbr_table_get_from_lladdr(nbr_cells, from);
+  if(c == NULL) {
+    if(cells == 1) {
+      /* The default, no need to take a table entry */
+      return;
+    }
+    c = nbr_table_add_lladdr(nbr_cells, from, NBR_TABLE_REASON_RPL_DIO, NULL);
+    if(c == NULL) {
+      return;
+    }
+    c->cells = 1;
+    c->prev_cells = 1;
+    c->keep_prev = 0;
+  }
+  if(c->cells != cells) {
+    if(cells < c->cells) {
+      c->prev_cells = MAX(c->prev_cells, c->cells);
+      c->keep_prev = 1;
+    }
+    c->cells = cells;
+    if(neighbor_has_uc_link(from)) {
+      update_links();
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+dio_options_output(uint8_t *buffer)
+{
+  buffer[0] = ORCHESTRA_ADAPTIVE_DIO_OPTION;
+  buffer[1] = 1;
+  buffer[2] = own_cells;
+  return 3;
+}
+/*---------------------------------------------------------------------------*/
+static void
+child_added(const linkaddr_t *linkaddr)
+{
+  update_links();
+}
+/*---------------------------------------------------------------------------*/
+static void
+child_removed(const linkaddr_t *linkaddr)
+{
+  update_links();
+}
+/*---------------------------------------------------------------------------*/
+static int
+select_packet(uint16_t *slotframe, uint16_t *timeslot)
+{
+  /* Select data packets we have a unicast link to */
+  const linkaddr_t *dest = packetbuf_addr(PACKETBUF_ADDR_RECEIVER);
+  if(packetbuf_attr(PACKETBUF_ATTR_FRAME_TYPE) == FRAME802154_DATAFRAME
+     && neighbor_has_uc_link(dest)) {
+    if(slotframe != NULL) {
+      *slotframe = slotframe_handle;
+    }
+    if(timeslot != NULL) {
+      /* Spread packets over the cells the receiver currently advertises */
+      *timeslot = get_node_timeslot(dest, next_cell++ % get_nbr_cells(dest, 0));
+    }
+    return 1;
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+new_time_source(const struct tsch_neighbor *old, const struct tsch_neighbor *new)
+{
+  if(new != old) {
+    const linkaddr_t *new_addr = new != NULL ? &new->addr : NULL;
+    if(new_addr != NULL) {
+      linkaddr_copy(&orchestra_parent_linkaddr, new_addr);
+    } else {
+      linkaddr_copy(&orchestra_parent_linkaddr, &linkaddr_null);
+    }
+    update_links();
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+init(uint16_t sf_handle)
+{
+  slotframe_handle = sf_handle;
+  channel_offset = sf_handle;
+  nbr_table_register(nbr_cells, NULL);
+  /* Slotframe for unicast transmissions */
+  sf_unicast = tsch_schedule_add_slotframe(slotframe_handle, ORCHESTRA_UNICAST_PERIOD);
+  own_cells = 1;
+  prev_own_cells = 1;
+  rx_cells = 1;
+  update_links();
+  ctimer_set(&update_timer, ORCHESTRA_ADAPTIVE_UPDATE_PERIOD, update_cells, NULL);
+}
+/*---------------------------------------------------------------------------*/
+struct orchestra_rule unicast_adaptive_rpl_storing = {
+  init,
+  new_time_source,
+  select_packet,
+  child_added,
+  child_removed,
+  dio_option_input,
+  dio_options_output,
+};
+
+#endif /* UIP_MAX_ROUTES */
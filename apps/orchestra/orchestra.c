@@ -106,6 +106,33 @@ orchestra_callback_child_removed(const linkaddr_t *addr)
 }
 /*---------------------------------------------------------------------------*/
 void
+orchestra_callback_dio_option_input(const uip_ipaddr_t *from, const uint8_t *option, uint8_t len)
+{
+  /* The DIO is parsed while its frame is still in the packetbuf */
+  const linkaddr_t *sender = packetbuf_addr(PACKETBUF_ADDR_SENDER);
+  int i;
+  for(i = 0; i < NUM_RULES; i++) {
+    if(all_rules[i]->dio_option_input != NULL) {
+      all_rules[i]->dio_option_input(sender, option, len);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+int
+orchestra_callback_dio_options_output(rpl_instance_t *instance, uint8_t *buffer)
+{
+  /* Let every rule append its options to the DIO */
+  int i;
+  int pos = 0;
+  for(i = 0; i < NUM_RULES; i++) {
+    if(all_rules[i]->dio_options_output != NULL) {
+      pos += all_rules[i]->dio_options_output(&buffer[pos]);
+    }
+  }
+  return pos;
+}
+/*---------------------------------------------------------------------------*/
+void
 orchestra_callback_packet_ready(void)
 {
   int i;
@@ -41,6 +41,7 @@
 #include "net/mac/tsch/tsch.h"
 #include "net/mac/tsch/tsch-conf.h"
 #include "net/mac/tsch/tsch-schedule.h"
+#include "net/rpl/rpl.h"
 #include "orchestra-conf.h"
 
 /* The structure of an Orchestra rule */
@@ -50,11 +51,15 @@ struct orchestra_rule {
   int  (* select_packet)(uint16_t *slotframe, uint16_t *timeslot);
   void (* child_added)(const linkaddr_t *addr);
   void (* child_removed)(const linkaddr_t *addr);
+  /* Optional: parse a DIO option from a neighbor, and append options to our DIOs */
+  void (* dio_option_input)(const linkaddr_t *from, const uint8_t *option, uint8_t len);
+  int  (* dio_options_output)(uint8_t *buffer);
 };
 
 struct orchestra_rule eb_per_time_source;
 struct orchestra_rule unicast_per_neighbor_rpl_storing;
 struct orchestra_rule unicast_per_neighbor_rpl_ns;
+struct orchestra_rule unicast_adaptive_rpl_storing;
 struct orchestra_rule default_common;
 
 extern linkaddr_t orchestra_parent_linkaddr;
@@ -71,5 +76,9 @@ void orchestra_callback_new_time_source(const struct tsch_neighbor *old, const s
 void orchestra_callback_child_added(const linkaddr_t *addr);
 /* Set with #define NETSTACK_CONF_ROUTING_NEIGHBOR_REMOVED_CALLBACK orchestra_callback_child_removed */
 void orchestra_callback_child_removed(const linkaddr_t *addr);
+/* Set with #define RPL_CALLBACK_DIO_OPTION_INPUT orchestra_callback_dio_option_input */
+void orchestra_callback_dio_option_input(const uip_ipaddr_t *from, const uint8_t *option, uint8_t len);
+/* Set with #define RPL_CALLBACK_DIO_OPTIONS_OUTPUT orchestra_callback_dio_options_output */
+int orchestra_callback_dio_options_output(rpl_instance_t *instance, uint8_t *buffer);
 
 #endif /* __ORCHESTRA_H__ */
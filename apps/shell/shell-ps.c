@@ -59,8 +59,34 @@ PROCESS_THREAD(shell_ps_process, ev, data)
   for(p = PROCESS_LIST(); p != NULL; p = p->next) {
     char namebuf[30];
     strncpy(namebuf, PROCESS_NAME_STRING(p), sizeof(namebuf));
+#if PROCESS_CONF_NUMEVENTS_HIGH > 0
+    shell_output_str(&ps_command, namebuf,
+                     p->priority == PROCESS_PRIORITY_HIGH ? " (high)" : "");
+#else /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
     shell_output_str(&ps_command, namebuf, "");
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
+#if PROCESS_ACCOUNTING
+    {
+      const struct process_accounting *a = process_accounting_get(p);
+      char buf[80];
+      snprintf(buf, sizeof(buf),
+               " %lu calls, run %lu max %u, queued avg %lu max %u ticks",
+               a->invocations, a->runtime, (unsigned)a->max_runtime,
+               a->events > 0 ? a->queue_delay / a->events : 0,
+               (unsigned)a->max_queue_delay);
+      shell_output_str(&ps_command, "", buf);
+    }
+#endif /* PROCESS_ACCOUNTING */
   }
+#if PROCESS_CONF_STATS
+  {
+    char buf[60];
+    snprintf(buf, sizeof(buf), "max %u normal, %u high, %u overflow, %u dropped",
+             process_maxevents, process_maxevents_high,
+             process_maxoverflow, process_droppedevents);
+    shell_output_str(&ps_command, "Events: ", buf);
+  }
+#endif /* PROCESS_CONF_STATS */
 
   PROCESS_END();
 }
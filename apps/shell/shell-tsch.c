@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         TSCH-related Contiki shell commands
+ */
+
+#include "contiki.h"
+#include "shell-tsch.h"
+#include "net/mac/tsch/tsch-private.h"
+#include "net/mac/tsch/tsch-slot-stats.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if TSCH_WITH_SLOT_STATS
+/*---------------------------------------------------------------------------*/
+PROCESS(shell_tsch_timing_process, "tsch-timing");
+SHELL_COMMAND(tsch_timing_command,
+	      "tsch-timing",
+	      "tsch-timing [reset]: print TSCH slot timing statistics, in usec, and optionally clear them",
+	      &shell_tsch_timing_process);
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(shell_tsch_timing_process, ev, data)
+{
+  const struct tsch_slot_stats *s;
+  char buf[TSCH_SLOT_STATS_NUM_BUCKETS * 6 + 20];
+  char namebuf[16];
+  int phase;
+  int last;
+  int i;
+  int len;
+
+  PROCESS_BEGIN();
+
+  snprintf(buf, sizeof(buf), "timeslot %lu, buckets of %u",
+           (unsigned long)RTIMERTICKS_TO_US_64(tsch_timing[tsch_ts_timeslot_length]),
+           TSCH_SLOT_STATS_BUCKET_US);
+  shell_output_str(&tsch_timing_command, "TSCH slot timing: ", buf);
+
+  for(phase = 0; phase < tsch_phase_count; phase++) {
+    s = tsch_slot_stats_get(phase);
+    if(s->count == 0) {
+      continue;
+    }
+    snprintf(buf, sizeof(buf), ": %lu, avg %lu min %lu max %lu",
+             (unsigned long)s->count,
+             (unsigned long)RTIMERTICKS_TO_US_64(s->sum / s->count),
+             (unsigned long)RTIMERTICKS_TO_US_64(s->min),
+             (unsigned long)RTIMERTICKS_TO_US_64(s->max));
+    strncpy(namebuf, tsch_slot_stats_phase_name(phase), sizeof(namebuf));
+    shell_output_str(&tsch_timing_command, namebuf, buf);
+
+    /* Histogram, up to the last non-empty bucket */
+    last = TSCH_SLOT_STATS_NUM_BUCKETS - 1;
+    while(last > 0 && s->hist[last] == 0) {
+      last--;
+    }
+    len = 0;
+    for(i = 0; i <= last && len < sizeof(buf); i++) {
+      len += snprintf(buf + len, sizeof(buf) - len, " %u", s->hist[i]);
+    }
+    shell_output_str(&tsch_timing_command, " hist:", buf);
+  }
+
+  if(data != NULL && strncmp(data, "reset", 5) == 0) {
+    tsch_slot_stats_reset();
+  }
+
+  PROCESS_END();
+}
+#endif /* TSCH_WITH_SLOT_STATS */
+/*---------------------------------------------------------------------------*/
+void
+shell_tsch_init(void)
+{
+#if TSCH_WITH_SLOT_STATS
+  shell_register_command(&tsch_timing_command);
+#endif /* TSCH_WITH_SLOT_STATS */
+}
+/*---------------------------------------------------------------------------*/
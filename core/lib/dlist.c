@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ * Doubly linked list library implementation.
+ */
+
+/**
+ * \addtogroup dlist
+ * @{
+ */
+
+#include "lib/dlist.h"
+
+#include <stddef.h>
+
+struct dlist_item {
+  struct dlist_item *next;
+  struct dlist_item *prev;
+};
+
+/*---------------------------------------------------------------------------*/
+/**
+ * Initialize a doubly linked list.
+ *
+ * \param list The list to be initialized.
+ */
+void
+dlist_init(dlist_t list)
+{
+  list->head = NULL;
+  list->tail = NULL;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Get a pointer to the first element of a list without removing it.
+ *
+ * \param list The list.
+ * \return A pointer to the first element on the list.
+ */
+void *
+dlist_head(dlist_t list)
+{
+  return list->head;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Get a pointer to the last element of a list without removing it.
+ *
+ * \param list The list.
+ * \return A pointer to the last element on the list.
+ */
+void *
+dlist_tail(dlist_t list)
+{
+  return list->tail;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Add an item at the end of a list.
+ *
+ * \param list The list.
+ * \param item A pointer to the item to be added. The item must not
+ *             already be on the list.
+ */
+void
+dlist_add(dlist_t list, void *item)
+{
+  struct dlist_item *i = item;
+
+  i->next = NULL;
+  i->prev = list->tail;
+  if(list->tail == NULL) {
+    list->head = i;
+  } else {
+    ((struct dlist_item *)list->tail)->next = i;
+  }
+  list->tail = i;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Add an item to the start of a list.
+ *
+ * \param list The list.
+ * \param item A pointer to the item to be added. The item must not
+ *             already be on the list.
+ */
+void
+dlist_push(dlist_t list, void *item)
+{
+  struct dlist_item *i = item;
+
+  i->prev = NULL;
+  i->next = list->head;
+  if(list->head == NULL) {
+    list->tail = i;
+  } else {
+    ((struct dlist_item *)list->head)->prev = i;
+  }
+  list->head = i;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Remove a specific element from a list.
+ *
+ * The item must be on the list. Its next and previous pointers are
+ * cleared.
+ *
+ * \param list The list.
+ * \param item The item that is to be removed from the list.
+ */
+void
+dlist_remove(dlist_t list, void *item)
+{
+  struct dlist_item *i = item;
+
+  if(i == NULL) {
+    return;
+  }
+
+  if(i->prev == NULL) {
+    list->head = i->next;
+  } else {
+    i->prev->next = i->next;
+  }
+  if(i->next == NULL) {
+    list->tail = i->prev;
+  } else {
+    i->next->prev = i->prev;
+  }
+  i->next = NULL;
+  i->prev = NULL;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Remove the first object on a list.
+ *
+ * \param list The list.
+ * \return Pointer to the removed element, or NULL if the list is empty.
+ */
+void *
+dlist_pop(dlist_t list)
+{
+  void *l = list->head;
+
+  dlist_remove(list, l);
+  return l;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Remove the last object on a list.
+ *
+ * \param list The list.
+ * \return Pointer to the removed element, or NULL if the list is empty.
+ */
+void *
+dlist_chop(dlist_t list)
+{
+  void *l = list->tail;
+
+  dlist_remove(list, l);
+  return l;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * Get the length of a list.
+ *
+ * This function counts the number of elements on the list and is the
+ * only dlist function that traverses the list.
+ *
+ * \param list The list.
+ * \return The length of the list.
+ */
+int
+dlist_length(dlist_t list)
+{
+  struct dlist_item *l;
+  int n = 0;
+
+  for(l = list->head; l != NULL; l = l->next) {
+    ++n;
+  }
+
+  return n;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief      Insert an item after a specified item on the list
+ * \param list The list
+ * \param previtem The item after which the new item should be inserted
+ * \param newitem  The new item that is to be inserted
+ *
+ *             If previtem is NULL, the new item is placed at the
+ *             start of the list.
+ */
+void
+dlist_insert(dlist_t list, void *previtem, void *newitem)
+{
+  struct dlist_item *p = previtem;
+  struct dlist_item *i = newitem;
+
+  if(p == NULL) {
+    dlist_push(list, i);
+  } else if(p->next == NULL) {
+    dlist_add(list, i);
+  } else {
+    i->prev = p;
+    i->next = p->next;
+    p->next->prev = i;
+    p->next = i;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief      Get the next item following this item
+ * \param item A list item
+ * \returns    The next item on the list, or NULL
+ */
+void *
+dlist_item_next(void *item)
+{
+  return item == NULL ? NULL : ((struct dlist_item *)item)->next;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief      Get the item preceding this item
+ * \param item A list item
+ * \returns    The previous item on the list, or NULL
+ */
+void *
+dlist_item_prev(void *item)
+{
+  return item == NULL ? NULL : ((struct dlist_item *)item)->prev;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
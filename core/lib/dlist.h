@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ * Doubly linked list manipulation routines.
+ */
+
+/** \addtogroup lib
+    @{ */
+/**
+ * \defgroup dlist Doubly linked list library
+ *
+ * The doubly linked list library is a companion to the \ref list
+ * "linked list library" for lists that are modified often from both
+ * ends or from the middle. A doubly linked list keeps a pointer to
+ * both its head and its tail, and its elements are linked in both
+ * directions. Adding an element to either end of the list, removing
+ * the first or the last element, and removing a specific element
+ * are all constant-time operations.
+ *
+ * An element of a doubly linked list \b must be a structure whose
+ * first element is a pointer to the next element and whose second
+ * element is a pointer to the previous element. Since the first
+ * element is the next pointer, list_item_next() can be used on
+ * doubly linked list elements as well.
+ *
+ * Unlike list_add() and list_push(), the dlist functions do not
+ * check whether an element already is on the list before adding
+ * it. The caller must remove an element before adding it again.
+ *
+ * Lists are declared with the DLIST() macro, or with DLIST_STRUCT()
+ * inside a structure.
+ *
+ * @{
+ */
+
+#ifndef DLIST_H_
+#define DLIST_H_
+
+#include "lib/list.h"
+
+/**
+ * The head and tail pointers of a doubly linked list.
+ */
+struct dlist {
+  void *head;
+  void *tail;
+};
+
+/**
+ * The doubly linked list type.
+ *
+ */
+typedef struct dlist * dlist_t;
+
+/**
+ * Declare a doubly linked list.
+ *
+ * The list variable is declared as static to make it easy to use in
+ * a single C module without unnecessarily exporting the name to
+ * other modules.
+ *
+ * \param name The name of the list.
+ */
+#define DLIST(name) \
+         static struct dlist LIST_CONCAT(name,_dlist); \
+         static dlist_t name = &LIST_CONCAT(name,_dlist)
+
+/**
+ * Declare a doubly linked list inside a structure declaraction.
+ *
+ * As with LIST_STRUCT(), the list is defined as two items: the list
+ * itself, named by the parameter with the suffix "_dlist", and a
+ * pointer to it with the name of the parameter. The list must be
+ * initialized with DLIST_STRUCT_INIT() before it is used.
+ *
+ * \param name The name of the list.
+ */
+#define DLIST_STRUCT(name) \
+         struct dlist LIST_CONCAT(name,_dlist); \
+         dlist_t name
+
+/**
+ * Initialize a doubly linked list that is part of a structure.
+ *
+ * \param struct_ptr A pointer to the struct
+ * \param name The name of the list.
+ */
+#define DLIST_STRUCT_INIT(struct_ptr, name)                             \
+    do {                                                                \
+       (struct_ptr)->name = &((struct_ptr)->LIST_CONCAT(name,_dlist));  \
+       dlist_init((struct_ptr)->name);                                  \
+    } while(0)
+
+void   dlist_init(dlist_t list);
+void * dlist_head(dlist_t list);
+void * dlist_tail(dlist_t list);
+void * dlist_pop (dlist_t list);
+void   dlist_push(dlist_t list, void *item);
+
+void * dlist_chop(dlist_t list);
+
+void   dlist_add(dlist_t list, void *item);
+void   dlist_remove(dlist_t list, void *item);
+
+int    dlist_length(dlist_t list);
+
+void   dlist_insert(dlist_t list, void *previtem, void *newitem);
+
+void * dlist_item_next(void *item);
+void * dlist_item_prev(void *item);
+
+#endif /* DLIST_H_ */
+
+/** @} */
+/** @} */
@@ -53,8 +53,57 @@ memb_init(struct memb *m)
 {
   memset(m->count, 0, m->num);
   memset(m->mem, 0, m->size * m->num);
+#if MEMB_FREELIST
+  m->nfree = 0;
+  m->used = 0;
+#endif /* MEMB_FREELIST */
 }
 /*---------------------------------------------------------------------------*/
+#if MEMB_FREELIST
+void *
+memb_alloc(struct memb *m)
+{
+  unsigned short i;
+
+  if(m->nfree > 0) {
+    /* Reuse the most recently freed block. */
+    i = m->free[--m->nfree];
+  } else if(m->used < m->num) {
+    /* Take the next block that has never been handed out. */
+    i = m->used++;
+  } else {
+    return NULL;
+  }
+
+  m->count[i] = 1;
+  return (void *)((char *)m->mem + (i * m->size));
+}
+/*---------------------------------------------------------------------------*/
+char
+memb_free(struct memb *m, void *ptr)
+{
+  unsigned long offset;
+  unsigned short i;
+
+  if(!memb_inmemb(m, ptr)) {
+    return -1;
+  }
+  offset = (unsigned long)((char *)ptr - (char *)m->mem);
+  if(offset % m->size != 0) {
+    /* The pointer points into the middle of a block. */
+    return -1;
+  }
+  i = offset / m->size;
+
+  if(m->count[i] > 0) {
+    /* Make sure that we don't deallocate free memory. */
+    if(--(m->count[i]) == 0) {
+      m->free[m->nfree++] = i;
+    }
+  }
+  return m->count[i];
+}
+#else /* MEMB_FREELIST */
 void *
 memb_alloc(struct memb *m)
 {
@@ -99,6 +148,7 @@ memb_free(struct memb *m, void *ptr)
   }
   return -1;
 }
+#endif /* MEMB_FREELIST */
 /*---------------------------------------------------------------------------*/
 int
 memb_inmemb(struct memb *m, void *ptr)
@@ -110,6 +160,9 @@ memb_inmemb(struct memb *m, void *ptr)
 int
 memb_numfree(struct memb *m)
 {
+#if MEMB_FREELIST
+  return m->num - m->used + m->nfree;
+#else /* MEMB_FREELIST */
   int i;
   int num_free = 0;
 
@@ -120,5 +173,6 @@ memb_numfree(struct memb *m)
   }
 
   return num_free;
+#endif /* MEMB_FREELIST */
 }
 /** @} */
@@ -65,6 +65,29 @@
 
 #include "sys/cc.h"
 
+/**
+ * \brief Keep a stack of free block indices for O(1) allocation
+ *
+ * By default, memb_alloc() searches the reference count array for an
+ * unused block and memb_free() searches for the block that a pointer
+ * refers to, so both take time proportional to the number of blocks.
+ *
+ * When MEMB_CONF_FREELIST is set to 1, every MEMB() additionally
+ * declares an array of block indices that is used as a stack of
+ * previously freed blocks. Blocks that have never been allocated are
+ * handed out in order from a high-water mark, so a zero-initialized
+ * memb is still valid before memb_init() is called. Allocation,
+ * deallocation and memb_numfree() are then O(1), at the cost of two
+ * extra bytes of RAM per block.
+ *
+ * This affects all memory blocks and not an individual memb.
+ */
+#ifdef MEMB_CONF_FREELIST
+#define MEMB_FREELIST MEMB_CONF_FREELIST
+#else
+#define MEMB_FREELIST 0
+#endif
+
 /**
  * Declare a memory block.
  *
@@ -86,18 +109,37 @@ MEMB(connections, struct connection, 16);
  * \param num The total number of memory chunks in the block.
  *
  */
+#if MEMB_FREELIST
+#define MEMB(name, structure, num) \
+        static char CC_CONCAT(name,_memb_count)[num]; \
+        static structure CC_CONCAT(name,_memb_mem)[num]; \
+        static unsigned short CC_CONCAT(name,_memb_free)[num]; \
+        static struct memb name = {sizeof(structure), num, \
+                                          CC_CONCAT(name,_memb_count), \
+                                          (void *)CC_CONCAT(name,_memb_mem), \
+                                          CC_CONCAT(name,_memb_free), 0, 0}
+#else /* MEMB_FREELIST */
 #define MEMB(name, structure, num) \
         static char CC_CONCAT(name,_memb_count)[num]; \
         static structure CC_CONCAT(name,_memb_mem)[num]; \
         static struct memb name = {sizeof(structure), num, \
                                           CC_CONCAT(name,_memb_count), \
                                           (void *)CC_CONCAT(name,_memb_mem)}
+#endif /* MEMB_FREELIST */
 
 struct memb {
   unsigned short size;
   unsigned short num;
   char *count;
   void *mem;
+#if MEMB_FREELIST
+  /* Indices of freed blocks, used as a stack. */
+  unsigned short *free;
+  /* Number of indices on the free stack. */
+  unsigned short nfree;
+  /* Blocks at or above this index have never been allocated. */
+  unsigned short used;
+#endif /* MEMB_FREELIST */
 };
 
 /**
@@ -47,6 +47,9 @@
 #include "mmem.h"
 #include "list.h"
 #include "contiki-conf.h"
+#if MMEM_INCREMENTAL
+#include "sys/process.h"
+#endif /* MMEM_INCREMENTAL */
 #include <string.h>
 
 #ifdef MMEM_CONF_SIZE
@@ -59,6 +62,22 @@ LIST(mmemlist);
 unsigned int avail_memory;
 static char memory[MMEM_SIZE];
 
+#if MMEM_INCREMENTAL
+/* The blocks on mmemlist are kept in address order. top is the
+   offset of the first byte after the last block, last is the last
+   block. Free memory below top is made up of holes. */
+static unsigned int top;
+static struct mmem *last;
+
+PROCESS(mmem_compact_process, "mmem compaction");
+#endif /* MMEM_INCREMENTAL */
+
+#if MMEM_STATS
+static unsigned long bytes_moved;
+#endif /* MMEM_STATS */
+
+#define OFFSET(m) ((unsigned int)((char *)(m)->ptr - memory))
+
 /*---------------------------------------------------------------------------*/
 /**
  * \brief      Allocate a managed memory block
@@ -82,11 +101,48 @@ static char memory[MMEM_SIZE];
 int
 mmem_alloc(struct mmem *m, unsigned int size)
 {
+#if MMEM_INCREMENTAL
+  struct mmem *n;
+  struct mmem *prev;
+  unsigned int end;
+#endif /* MMEM_INCREMENTAL */
+
   /* Check if we have enough memory left for this allocation. */
   if(avail_memory < size) {
     return 0;
   }
 
+#if MMEM_INCREMENTAL
+  if(MMEM_SIZE - top < size) {
+    /* Not enough room after the last block: take the first hole
+       that is large enough. */
+    prev = NULL;
+    end = 0;
+    for(n = list_head(mmemlist); n != NULL; n = n->next) {
+      if(OFFSET(n) - end >= size) {
+        list_insert(mmemlist, prev, m);
+        m->ptr = &memory[end];
+        m->size = size;
+        avail_memory -= size;
+        return 1;
+      }
+      end = OFFSET(n) + n->size;
+      prev = n;
+    }
+
+    /* No hole is large enough, so compact all of them now. */
+    mmem_compact(MMEM_SIZE);
+  }
+
+  list_insert(mmemlist, last, m);
+  m->ptr = &memory[top];
+  m->size = size;
+  last = m;
+  top += size;
+  avail_memory -= size;
+  return 1;
+#else /* MMEM_INCREMENTAL */
+
   /* We had enough memory so we add this memory block to the end of
      the list of allocated memory blocks. */
   list_add(mmemlist, m);
@@ -104,6 +160,7 @@ mmem_alloc(struct mmem *m, unsigned int size)
   /* Return non-zero to indicate that we were able to allocate
      memory. */
   return 1;
+#endif /* MMEM_INCREMENTAL */
 }
 /*---------------------------------------------------------------------------*/
 /**
@@ -120,6 +177,33 @@ mmem_free(struct mmem *m)
 {
   struct mmem *n;
 
+#if MMEM_INCREMENTAL
+  struct mmem *prev;
+
+  /* Find the block before m and unlink m. The memory of m is left
+     as a hole, unless m is the last block. */
+  prev = NULL;
+  for(n = list_head(mmemlist); n != NULL && n != m; n = n->next) {
+    prev = n;
+  }
+  if(n == NULL) {
+    return;
+  }
+  if(prev == NULL) {
+    list_pop(mmemlist);
+  } else {
+    prev->next = m->next;
+  }
+  m->next = NULL;
+  avail_memory += m->size;
+
+  if(m == last) {
+    last = prev;
+    top = prev == NULL ? 0 : OFFSET(prev) + prev->size;
+  } else {
+    process_poll(&mmem_compact_process);
+  }
+#else /* MMEM_INCREMENTAL */
   if(m->next != NULL) {
     /* Compact the memory after the allocation that is to be removed
        by moving it downwards. */
@@ -131,13 +215,117 @@ mmem_free(struct mmem *m)
     for(n = m->next; n != NULL; n = n->next) {
       n->ptr = (void *)((char *)n->ptr - m->size);
     }
+#if MMEM_STATS
+    bytes_moved += &memory[MMEM_SIZE - avail_memory] - (char *)m->ptr
+      - m->size;
+#endif /* MMEM_STATS */
   }
 
   avail_memory += m->size;
 
   /* Remove the memory block from the list. */
   list_remove(mmemlist, m);
+#endif /* MMEM_INCREMENTAL */
+}
+/*---------------------------------------------------------------------------*/
+#if MMEM_INCREMENTAL
+/**
+ * \brief      Close holes in the managed memory
+ * \param budget The maximum number of bytes to move
+ * \return     Non-zero if holes remain after this call
+ *
+ *             This function moves allocated blocks downwards to close
+ *             the holes left by mmem_free(). It stops before moving a
+ *             block would exceed the budget, but always moves at
+ *             least one block. The mmem compaction process calls this
+ *             function with MMEM_COMPACT_BUDGET until all holes are
+ *             closed.
+ *
+ */
+int
+mmem_compact(unsigned int budget)
+{
+  struct mmem *n;
+  unsigned int end;
+  unsigned int moved;
+
+  end = 0;
+  moved = 0;
+  for(n = list_head(mmemlist); n != NULL; n = n->next) {
+    if(OFFSET(n) != end) {
+      if(moved > 0 && moved + n->size > budget) {
+        break;
+      }
+      memmove(&memory[end], n->ptr, n->size);
+      n->ptr = &memory[end];
+      moved += n->size;
+    }
+    end += n->size;
+  }
+
+#if MMEM_STATS
+  bytes_moved += moved;
+#endif /* MMEM_STATS */
+
+  if(n == NULL) {
+    top = end;
+    return 0;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(mmem_compact_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
+    if(mmem_compact(MMEM_COMPACT_BUDGET)) {
+      process_poll(&mmem_compact_process);
+    }
+  }
+
+  PROCESS_END();
+}
+#endif /* MMEM_INCREMENTAL */
+/*---------------------------------------------------------------------------*/
+#if MMEM_STATS
+/**
+ * \brief      Get fragmentation and compaction statistics
+ * \param stats A pointer to the struct that is filled in
+ *
+ */
+void
+mmem_stats(struct mmem_stats *stats)
+{
+#if MMEM_INCREMENTAL
+  struct mmem *n;
+  unsigned int end;
+
+  stats->holes = 0;
+  stats->largest_free = MMEM_SIZE - top;
+  end = 0;
+  for(n = list_head(mmemlist); n != NULL; n = n->next) {
+    if(OFFSET(n) != end) {
+      stats->holes++;
+      if(OFFSET(n) - end > stats->largest_free) {
+        stats->largest_free = OFFSET(n) - end;
+      }
+    }
+    end = OFFSET(n) + n->size;
+  }
+#else /* MMEM_INCREMENTAL */
+  stats->holes = 0;
+  stats->largest_free = avail_memory;
+#endif /* MMEM_INCREMENTAL */
+
+  stats->free = avail_memory;
+  stats->fragmentation = avail_memory == 0 ? 0 :
+    (unsigned int)((unsigned long)(avail_memory - stats->largest_free) * 100
+                   / avail_memory);
+  stats->bytes_moved = bytes_moved;
 }
+#endif /* MMEM_STATS */
 /*---------------------------------------------------------------------------*/
 /**
  * \brief      Initialize the managed memory module
@@ -157,6 +345,14 @@ mmem_init(void)
   }
   list_init(mmemlist);
   avail_memory = MMEM_SIZE;
+#if MMEM_INCREMENTAL
+  top = 0;
+  last = NULL;
+  process_start(&mmem_compact_process, NULL);
+#endif /* MMEM_INCREMENTAL */
+#if MMEM_STATS
+  bytes_moved = 0;
+#endif /* MMEM_STATS */
   inited = 1;
 }
 /*---------------------------------------------------------------------------*/
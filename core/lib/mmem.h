@@ -44,6 +44,15 @@
  * stays in place. Therefore, a level of indirection is used: access
  * to allocated memory must always be done using a special macro.
  *
+ * By default, mmem_free() compacts the memory immediately, which
+ * costs a memmove() of all memory allocated after the freed block.
+ * With MMEM_CONF_INCREMENTAL, mmem_free() only leaves a hole behind.
+ * mmem_alloc() reuses the first hole that is large enough, and the
+ * holes are closed in small steps by a process that is polled after
+ * a free, so that a burst of frees does not stall the event
+ * loop. Memory then moves between two invocations of any process,
+ * not only during mmem_free().
+ *
  * \note This module has not been heavily tested.
  * @{
  */
@@ -59,6 +68,30 @@
 #ifndef MMEM_H_
 #define MMEM_H_
 
+#include "contiki-conf.h"
+
+/* Leave holes on free and compact them incrementally */
+#ifdef MMEM_CONF_INCREMENTAL
+#define MMEM_INCREMENTAL MMEM_CONF_INCREMENTAL
+#else
+#define MMEM_INCREMENTAL 0
+#endif
+
+/* The maximum number of bytes moved in one incremental compaction
+   step. A single block larger than this is still moved in one step. */
+#ifdef MMEM_CONF_COMPACT_BUDGET
+#define MMEM_COMPACT_BUDGET MMEM_CONF_COMPACT_BUDGET
+#else
+#define MMEM_COMPACT_BUDGET 64
+#endif
+
+/* Keep fragmentation and compaction statistics */
+#ifdef MMEM_CONF_STATS
+#define MMEM_STATS MMEM_CONF_STATS
+#else
+#define MMEM_STATS 0
+#endif
+
 /*---------------------------------------------------------------------------*/
 /**
  * \brief      Get a pointer to the managed memory
@@ -87,6 +120,27 @@ int  mmem_alloc(struct mmem *m, unsigned int size);
 void mmem_free(struct mmem *);
 void mmem_init(void);
 
+#if MMEM_INCREMENTAL
+int  mmem_compact(unsigned int budget);
+#endif /* MMEM_INCREMENTAL */
+
+#if MMEM_STATS
+struct mmem_stats {
+  /* Free bytes in total */
+  unsigned int free;
+  /* Size of the largest contiguous free block */
+  unsigned int largest_free;
+  /* Number of holes between allocated blocks */
+  unsigned int holes;
+  /* Percentage of the free memory outside of the largest free block */
+  unsigned int fragmentation;
+  /* Bytes moved by compaction since mmem_init() */
+  unsigned long bytes_moved;
+};
+
+void mmem_stats(struct mmem_stats *stats);
+#endif /* MMEM_STATS */
+
 #endif /* MMEM_H_ */
 
 /** @} */
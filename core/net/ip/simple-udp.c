@@ -100,6 +100,46 @@ simple_udp_sendto_port(struct simple_udp_connection *c,
   return 0;
 }
 /*---------------------------------------------------------------------------*/
+void *
+simple_udp_reserve(struct simple_udp_connection *c, uint16_t datalen)
+{
+  if(c->udp_conn == NULL) {
+    return NULL;
+  }
+  return uip_udp_packet_reserve(datalen);
+}
+/*---------------------------------------------------------------------------*/
+int
+simple_udp_commit(struct simple_udp_connection *c, uint16_t datalen)
+{
+  return simple_udp_commit_to(c, datalen, &c->remote_addr);
+}
+/*---------------------------------------------------------------------------*/
+int
+simple_udp_commit_to(struct simple_udp_connection *c, uint16_t datalen,
+                     const uip_ipaddr_t *to)
+{
+  if(c->udp_conn != NULL) {
+    uip_udp_packet_commit(c->udp_conn, datalen,
+                          to, UIP_HTONS(c->remote_port));
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+#if UIP_UDP_PACKET_BATCH_NUM
+void *
+simple_udp_batch_reserve(struct simple_udp_connection *c, uint16_t datalen,
+                         const uip_ipaddr_t *to)
+{
+  if(c->udp_conn == NULL) {
+    return NULL;
+  }
+  return uip_udp_packet_batch_reserve(c->udp_conn, datalen,
+                                      to != NULL ? to : &c->remote_addr,
+                                      UIP_HTONS(c->remote_port));
+}
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
+/*---------------------------------------------------------------------------*/
 int
 simple_udp_register(struct simple_udp_connection *c,
                     uint16_t local_port,
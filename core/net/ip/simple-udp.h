@@ -56,6 +56,7 @@
 #define SIMPLE_UDP_H
 
 #include "net/ip/uip.h"
+#include "net/ip/uip-udp-packet.h"
 
 struct simple_udp_connection;
 
@@ -155,6 +156,67 @@ int simple_udp_sendto_port(struct simple_udp_connection *c,
 			   const void *data, uint16_t datalen,
 			   const uip_ipaddr_t *to, uint16_t to_port);
 
+/**
+ * \brief      Get the buffer for the payload of the next UDP packet
+ * \param c    A pointer to a struct simple_udp_connection
+ * \param datalen The number of bytes that will be written
+ * \return     A pointer to the payload buffer, or NULL if datalen
+ *             bytes do not fit
+ *
+ *     The payload is written directly into the uIP packet
+ *     buffer and sent with simple_udp_commit() or
+ *     simple_udp_commit_to(), which avoids the copy that
+ *     simple_udp_send() makes. No other uIP function may be
+ *     called in between, and the buffer must not be reserved
+ *     from within a receive callback.
+ *
+ * \sa uip_udp_packet_reserve()
+ */
+void *simple_udp_reserve(struct simple_udp_connection *c,
+                         uint16_t datalen);
+
+/**
+ * \brief      Send a UDP packet built with simple_udp_reserve()
+ * \param c    A pointer to a struct simple_udp_connection
+ * \param datalen The length of the data
+ *
+ *     Like simple_udp_send(), but sends the payload that was
+ *     written into the buffer returned by simple_udp_reserve().
+ */
+int simple_udp_commit(struct simple_udp_connection *c, uint16_t datalen);
+
+/**
+ * \brief      Send a UDP packet built with simple_udp_reserve() to a specified IP address
+ * \param c    A pointer to a struct simple_udp_connection
+ * \param datalen The length of the data
+ * \param to   The IP address of the receiver
+ *
+ *     Like simple_udp_sendto(), but sends the payload that was
+ *     written into the buffer returned by simple_udp_reserve().
+ */
+int simple_udp_commit_to(struct simple_udp_connection *c, uint16_t datalen,
+                         const uip_ipaddr_t *to);
+
+#if UIP_UDP_PACKET_BATCH_NUM
+/**
+ * \brief      Queue a UDP packet for sending by the tcpip process
+ * \param c    A pointer to a struct simple_udp_connection
+ * \param datalen The number of bytes that will be written
+ * \param to   The IP address of the receiver, or NULL for the
+ *             address given to simple_udp_register()
+ * \return     A pointer to the payload buffer, or NULL if the
+ *             batch is full
+ *
+ *     The payload must be written before the calling process
+ *     yields. All packets queued until then are sent back to
+ *     back by one invocation of the tcpip process.
+ *
+ * \sa uip_udp_packet_batch_reserve()
+ */
+void *simple_udp_batch_reserve(struct simple_udp_connection *c,
+                               uint16_t datalen, const uip_ipaddr_t *to);
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
+
 void simple_udp_init(void);
 
 #endif /* SIMPLE_UDP_H */
@@ -60,26 +60,42 @@ static void
 senddata(struct tcp_socket *s)
 {
   int len = MIN(s->output_data_max_seg, uip_mss());
+#if UIP_TCP_SEND_WINDOW > 1
+  uint16_t offset = uip_outstanding(uip_conn);
+
+  /* The data in flight stays at the start of the output buffer: a new
+     segment follows it, a retransmission starts over at offset 0. */
+  if(s->output_data_len > offset) {
+    len = MIN(s->output_data_len - offset, len);
+    uip_send(&s->output_data_ptr[offset], len);
+    if(offset + len < s->output_data_len) {
+      /* Get called again to send the next segment, if the window
+         has room for it */
+      tcpip_poll_tcp(uip_conn);
+    }
+  }
+#else /* UIP_TCP_SEND_WINDOW > 1 */
 
   if(s->output_senddata_len > 0) {
     len = MIN(s->output_senddata_len, len);
     s->output_data_send_nxt = len;
     uip_send(s->output_data_ptr, len);
   }
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
 }
 /*---------------------------------------------------------------------------*/
 static void
 acked(struct tcp_socket *s)
 {
+#if UIP_TCP_SEND_WINDOW > 1
+  /* Several segments may be in flight; drop the data that the ACK
+     covers from the output buffer */
+  s->output_data_send_nxt = uip_ackedlen();
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
   if(s->output_senddata_len > 0) {
     /* Copy the data in the outputbuf down and update outputbufptr and
        outputbuf_lastsent */
 
-    if(s->output_data_send_nxt > 0) {
-      memcpy(&s->output_data_ptr[0],
-             &s->output_data_ptr[s->output_data_send_nxt],
-             s->output_data_maxlen - s->output_data_send_nxt);
-    }
     if(s->output_data_len < s->output_data_send_nxt) {
       PRINTF("tcp: acked assertion failed s->output_data_len (%d) < s->output_data_send_nxt (%d)\n",
              s->output_data_len,
@@ -90,6 +106,11 @@ acked(struct tcp_socket *s)
       relisten(s);
       return;
     }
+    if(s->output_data_send_nxt > 0) {
+      memmove(&s->output_data_ptr[0],
+              &s->output_data_ptr[s->output_data_send_nxt],
+              s->output_data_len - s->output_data_send_nxt);
+    }
     s->output_data_len -= s->output_data_send_nxt;
     s->output_senddata_len = s->output_data_len;
     s->output_data_send_nxt = 0;
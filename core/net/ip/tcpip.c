@@ -525,6 +525,11 @@ eventhandler(process_event_t ev, process_data_t data)
 #endif /* UIP_UDP */
     }
     break;
+#if UIP_UDP_PACKET_BATCH_NUM
+  case PROCESS_EVENT_POLL:
+    uip_udp_packet_batch_flush();
+    break;
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
 #endif /* UIP_UDP */
 
   case PACKET_INPUT:
@@ -541,11 +546,69 @@ tcpip_input(void)
 }
 /*---------------------------------------------------------------------------*/
 #if NETSTACK_CONF_WITH_IPV6
+#if UIP_FLOW_CACHE_SIZE
+/* The next-hop neighbor of recent destinations. The entries are valid
+   while uip_ds6_generation equals flow_cache_generation. */
+struct flow_cache_entry {
+  uip_ipaddr_t dest;
+  uip_ds6_nbr_t *nbr;
+  uip_ds6_route_t *route;
+};
+
+static struct flow_cache_entry flow_cache[UIP_FLOW_CACHE_SIZE];
+static uint32_t flow_cache_generation;
+/*---------------------------------------------------------------------------*/
+static struct flow_cache_entry *
+flow_cache_entry(const uip_ipaddr_t *dest)
+{
+  if(flow_cache_generation != uip_ds6_generation) {
+    memset(flow_cache, 0, sizeof(flow_cache));
+    flow_cache_generation = uip_ds6_generation;
+  }
+  return &flow_cache[(dest->u8[12] ^ dest->u8[13] ^ dest->u8[14]
+                      ^ dest->u8[15]) % UIP_FLOW_CACHE_SIZE];
+}
+/*---------------------------------------------------------------------------*/
+static uip_ds6_nbr_t *
+flow_cache_lookup(const uip_ipaddr_t *dest)
+{
+  struct flow_cache_entry *e;
+
+  e = flow_cache_entry(dest);
+  if(e->nbr == NULL || !uip_ipaddr_cmp(&e->dest, dest)) {
+    UIP_STAT(++uip_stat.ip.flowcache_miss);
+    return NULL;
+  }
+  UIP_STAT(++uip_stat.ip.flowcache_hit);
+  if(e->route != NULL) {
+    /* Keep the route as recently used as a lookup would */
+    uip_ds6_route_touch(e->route);
+  }
+  return e->nbr;
+}
+/*---------------------------------------------------------------------------*/
+static void
+flow_cache_add(const uip_ipaddr_t *dest, uip_ds6_nbr_t *nbr,
+               uip_ds6_route_t *route)
+{
+  struct flow_cache_entry *e;
+
+  e = flow_cache_entry(dest);
+  uip_ipaddr_copy(&e->dest, dest);
+  e->nbr = nbr;
+  e->route = route;
+}
+#endif /* UIP_FLOW_CACHE_SIZE */
+/*---------------------------------------------------------------------------*/
 void
 tcpip_ipv6_output(void)
 {
   uip_ds6_nbr_t *nbr = NULL;
   uip_ipaddr_t *nexthop = NULL;
+  uip_ds6_route_t *route = NULL;
+#if UIP_FLOW_CACHE_SIZE
+  uint8_t cacheable;
+#endif /* UIP_FLOW_CACHE_SIZE */
 
   if(uip_len == 0) {
     return;
@@ -586,6 +649,17 @@ tcpip_ipv6_output(void)
 
     nbr = NULL;
 
+#if UIP_FLOW_CACHE_SIZE
+    /* A source route decides the next hop by itself */
+    cacheable = nexthop == NULL;
+    if(cacheable) {
+      nbr = flow_cache_lookup(&UIP_IP_BUF->destipaddr);
+      if(nbr != NULL) {
+        goto nbr_found;
+      }
+    }
+#endif /* UIP_FLOW_CACHE_SIZE */
+
     /* We first check if the destination address is on our immediate
        link. If so, we simply use the destination address as our
        nexthop address. */
@@ -621,7 +695,6 @@ tcpip_ipv6_output(void)
 #endif /* ORPL_ENABLED */
 
     if(nexthop == NULL) {
-      uip_ds6_route_t *route;
       /* Check if we have a route to the destination address. */
       route = uip_ds6_route_lookup(&UIP_IP_BUF->destipaddr);
 
@@ -713,10 +786,7 @@ tcpip_ipv6_output(void)
       } else {
 #if UIP_CONF_IPV6_QUEUE_PKT
         /* Copy outgoing pkt in the queuing buffer for later transmit. */
-        if(uip_packetqueue_alloc(&nbr->packethandle, UIP_DS6_NBR_PACKET_LIFETIME) != NULL) {
-          memcpy(uip_packetqueue_buf(&nbr->packethandle), UIP_IP_BUF, uip_len);
-          uip_packetqueue_set_buflen(&nbr->packethandle, uip_len);
-        }
+        uip_packetqueue_enqueue(&nbr->packethandle, UIP_DS6_NBR_PACKET_LIFETIME);
 #endif
         /* RFC4861, 7.2.2:
          * "If the source address of the packet prompting the solicitation is the
@@ -740,16 +810,19 @@ tcpip_ipv6_output(void)
       return;  
 #endif /* UIP_ND6_SEND_NS */
     } else {
+#if UIP_FLOW_CACHE_SIZE
+      if(cacheable) {
+        flow_cache_add(&UIP_IP_BUF->destipaddr, nbr, route);
+      }
+    nbr_found:
+#endif /* UIP_FLOW_CACHE_SIZE */
 #if UIP_ND6_SEND_NS
       if(nbr->state == NBR_INCOMPLETE) {
         PRINTF("tcpip_ipv6_output: nbr cache entry incomplete\n");
 #if UIP_CONF_IPV6_QUEUE_PKT
-        /* Copy outgoing pkt in the queuing buffer for later transmit and set
-           the destination nbr to nbr. */
-        if(uip_packetqueue_alloc(&nbr->packethandle, UIP_DS6_NBR_PACKET_LIFETIME) != NULL) {
-          memcpy(uip_packetqueue_buf(&nbr->packethandle), UIP_IP_BUF, uip_len);
-          uip_packetqueue_set_buflen(&nbr->packethandle, uip_len);
-        }
+        /* Append outgoing pkt to the packets waiting for the address
+           resolution of nbr. */
+        uip_packetqueue_enqueue(&nbr->packethandle, UIP_DS6_NBR_PACKET_LIFETIME);
 #endif /*UIP_CONF_IPV6_QUEUE_PKT*/
         uip_clear_buf();
         return;
@@ -771,12 +844,10 @@ tcpip_ipv6_output(void)
        * Send the queued packets from here, may not be 100% perfect though.
        * This happens in a few cases, for example when instead of receiving a
        * NA after sendiong a NS, you receive a NS with SLLAO: the entry moves
-       * to STALE, and you must both send a NA and the queued packet.
+       * to STALE, and you must both send a NA and the queued packets.
+       * The queue is drained oldest first.
        */
-      if(uip_packetqueue_buflen(&nbr->packethandle) != 0) {
-        uip_len = uip_packetqueue_buflen(&nbr->packethandle);
-        memcpy(UIP_IP_BUF, uip_packetqueue_buf(&nbr->packethandle), uip_len);
-        uip_packetqueue_free(&nbr->packethandle);
+      while(uip_packetqueue_dequeue(&nbr->packethandle) != 0) {
         tcpip_output(uip_ds6_nbr_get_ll(nbr));
       }
 #endif /*UIP_CONF_IPV6_QUEUE_PKT*/
@@ -797,6 +868,16 @@ tcpip_poll_udp(struct uip_udp_conn *conn)
 {
   process_post(&tcpip_process, UDP_POLL, conn);
 }
+/*---------------------------------------------------------------------------*/
+#if UIP_UDP_PACKET_BATCH_NUM
+void
+tcpip_poll_udp_batch(void)
+{
+  /* A poll needs no slot in the event queue and is handled before
+     the next event, usually in the same round of the scheduler */
+  process_poll(&tcpip_process);
+}
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
 #endif /* UIP_UDP */
 /*---------------------------------------------------------------------------*/
 #if UIP_TCP
@@ -856,6 +937,9 @@ PROCESS_THREAD(tcpip_process, ev, data)
 {
   PROCESS_BEGIN();
 
+  /* Keep packet processing ahead of application events */
+  process_set_priority(&tcpip_process, PROCESS_PRIORITY_HIGH);
+
 #if UIP_TCP
   {
     unsigned char i;
@@ -274,6 +274,12 @@ struct uip_udp_conn *udp_broadcast_new(uint16_t port, void *appstate);
  */
 CCIF void tcpip_poll_udp(struct uip_udp_conn *conn);
 
+/**
+ * Make the tcpip process send the datagrams queued with
+ * uip_udp_packet_batch_reserve().
+ */
+void tcpip_poll_udp_batch(void);
+
 /** @} */
  
 /**
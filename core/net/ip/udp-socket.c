@@ -147,6 +147,51 @@ udp_socket_sendto(struct udp_socket *c,
   return -1;
 }
 /*---------------------------------------------------------------------------*/
+void *
+udp_socket_reserve(struct udp_socket *c, uint16_t datalen)
+{
+  if(c == NULL || c->udp_conn == NULL) {
+    return NULL;
+  }
+  return uip_udp_packet_reserve(datalen);
+}
+/*---------------------------------------------------------------------------*/
+int
+udp_socket_commit(struct udp_socket *c, uint16_t datalen)
+{
+  if(c == NULL || c->udp_conn == NULL) {
+    return -1;
+  }
+
+  uip_udp_packet_commit(c->udp_conn, datalen, NULL, 0);
+  return datalen;
+}
+/*---------------------------------------------------------------------------*/
+int
+udp_socket_commit_to(struct udp_socket *c, uint16_t datalen,
+                     const uip_ipaddr_t *to, uint16_t port)
+{
+  if(c == NULL || c->udp_conn == NULL || to == NULL) {
+    return -1;
+  }
+
+  uip_udp_packet_commit(c->udp_conn, datalen, to, UIP_HTONS(port));
+  return datalen;
+}
+/*---------------------------------------------------------------------------*/
+#if UIP_UDP_PACKET_BATCH_NUM
+void *
+udp_socket_batch_reserve(struct udp_socket *c, uint16_t datalen,
+                         const uip_ipaddr_t *to, uint16_t port)
+{
+  if(c == NULL || c->udp_conn == NULL) {
+    return NULL;
+  }
+  return uip_udp_packet_batch_reserve(c->udp_conn, datalen,
+                                      to, UIP_HTONS(port));
+}
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
+/*---------------------------------------------------------------------------*/
 PROCESS_THREAD(udp_socket_process, ev, data)
 {
   struct udp_socket *c;
@@ -33,6 +33,7 @@
 #define UDP_SOCKET_H
 
 #include "net/ip/uip.h"
+#include "net/ip/uip-udp-packet.h"
 
 struct udp_socket;
 
@@ -175,6 +176,65 @@ int udp_socket_sendto(struct udp_socket *c,
                       const void *data, uint16_t datalen,
                       const uip_ipaddr_t *addr, uint16_t port);
 
+/**
+ * \brief      Get the buffer for the payload of the next datagram
+ * \param c    A pointer to the struct udp_socket on which the data will be sent
+ * \param datalen The number of bytes that will be written
+ * \return     A pointer to the payload buffer, or NULL if an error occurred
+ *
+ *             The payload is written directly into the uIP packet
+ *             buffer and sent with udp_socket_commit() or
+ *             udp_socket_commit_to(), which avoids the copy that
+ *             udp_socket_send() makes. No other uIP function may
+ *             be called in between, and the buffer must not be
+ *             reserved from within a receive callback.
+ *
+ */
+void *udp_socket_reserve(struct udp_socket *c, uint16_t datalen);
+
+/**
+ * \brief      Send a datagram built with udp_socket_reserve()
+ * \param c    A pointer to the struct udp_socket on which the data should be sent
+ * \param datalen The length of the data written
+ * \return     The number of bytes sent, or -1 if an error occurred
+ *
+ *             Like udp_socket_send(), the UDP socket must have
+ *             been connected with udp_socket_connect().
+ *
+ */
+int udp_socket_commit(struct udp_socket *c, uint16_t datalen);
+
+/**
+ * \brief      Send a datagram built with udp_socket_reserve() to a specific address and port
+ * \param c    A pointer to the struct udp_socket on which the data should be sent
+ * \param datalen The length of the data written
+ * \param addr The IP address to which the data should be sent
+ * \param port The UDP port number, in host byte order, to which the data should be sent
+ * \return     The number of bytes sent, or -1 if an error occurred
+ *
+ */
+int udp_socket_commit_to(struct udp_socket *c, uint16_t datalen,
+                         const uip_ipaddr_t *addr, uint16_t port);
+
+#if UIP_UDP_PACKET_BATCH_NUM
+/**
+ * \brief      Queue a datagram for sending by the tcpip process
+ * \param c    A pointer to the struct udp_socket on which the data should be sent
+ * \param datalen The number of bytes that will be written
+ * \param addr The IP address to which the data should be sent, or NULL if the socket is connected
+ * \param port The UDP port number, in host byte order, used when addr is not NULL
+ * \return     A pointer to the payload buffer, or NULL if the batch is full
+ *
+ *             The payload must be written before the calling
+ *             process yields. All datagrams queued until then are
+ *             sent back to back by one invocation of the tcpip
+ *             process.
+ *
+ */
+void *udp_socket_batch_reserve(struct udp_socket *c, uint16_t datalen,
+                               const uip_ipaddr_t *addr, uint16_t port);
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
+
 /**
  * \brief      Close a UDP socket
  * \param c    A pointer to the struct udp_socket to be closed
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <string.h>
 
 #include "net/ip/uip.h"
 
@@ -6,8 +7,12 @@
 
 #include "net/ip/uip-packetqueue.h"
 
-#define MAX_NUM_QUEUED_PACKETS 2
-MEMB(packets_memb, struct uip_packetqueue_packet, MAX_NUM_QUEUED_PACKETS);
+MEMB(packets_memb, struct uip_packetqueue_packet, UIP_PACKETQUEUE_NUM);
+
+struct uip_packetqueue_stats uip_packetqueue_stats;
+
+/* The packet that was appended last, while it is queued */
+static struct uip_packetqueue_packet *last;
 
 #define DEBUG 0
 #if DEBUG
@@ -17,15 +22,36 @@ MEMB(packets_memb, struct uip_packetqueue_packet, MAX_NUM_QUEUED_PACKETS);
 #define PRINTF(...)
 #endif
 
+/*---------------------------------------------------------------------------*/
+/* Unlink a packet from its handle and free it */
+static void
+remove_packet(struct uip_packetqueue_packet *p)
+{
+  struct uip_packetqueue_handle *h = p->handle;
+  struct uip_packetqueue_packet **pp;
+
+  for(pp = &h->packet; *pp != NULL; pp = &(*pp)->next) {
+    if(*pp == p) {
+      *pp = p->next;
+      h->count--;
+      break;
+    }
+  }
+  ctimer_stop(&p->lifetimer);
+  if(p == last) {
+    last = NULL;
+  }
+  memb_free(&packets_memb, p);
+}
 /*---------------------------------------------------------------------------*/
 static void
 packet_timedout(void *ptr)
 {
-  struct uip_packetqueue_handle *h = ptr;
+  struct uip_packetqueue_packet *p = ptr;
 
-  PRINTF("uip_packetqueue_free timed out %p\n", h);
-  memb_free(&packets_memb, h->packet);
-  h->packet = NULL;
+  PRINTF("uip_packetqueue_free timed out %p\n", p->handle);
+  uip_packetqueue_stats.timed_out++;
+  remove_packet(p);
 }
 /*---------------------------------------------------------------------------*/
 void
@@ -33,35 +59,94 @@ uip_packetqueue_new(struct uip_packetqueue_handle *handle)
 {
   PRINTF("uip_packetqueue_new %p\n", handle);
   handle->packet = NULL;
+  handle->count = 0;
 }
 /*---------------------------------------------------------------------------*/
 struct uip_packetqueue_packet *
 uip_packetqueue_alloc(struct uip_packetqueue_handle *handle, clock_time_t lifetime)
 {
+  struct uip_packetqueue_packet *p;
+  struct uip_packetqueue_packet **pp;
+
   PRINTF("uip_packetqueue_alloc %p\n", handle);
-  if(handle->packet != NULL) {
+  if(handle->count >= UIP_PACKETQUEUE_PER_HANDLE) {
     PRINTF("alloced\n");
+    uip_packetqueue_stats.full++;
     return NULL;
   }
-  handle->packet = memb_alloc(&packets_memb);
-  if(handle->packet != NULL) {
-    ctimer_set(&handle->packet->lifetimer, lifetime,
-               packet_timedout, handle);
-  } else {
+  p = memb_alloc(&packets_memb);
+  if(p == NULL) {
     PRINTF("uip_packetqueue_alloc failed\n");
+    uip_packetqueue_stats.no_buffer++;
+    return NULL;
   }
-  return handle->packet;
+  p->next = NULL;
+  p->queue_buf_len = 0;
+  p->handle = handle;
+  ctimer_set(&p->lifetimer, lifetime, packet_timedout, p);
+
+  for(pp = &handle->packet; *pp != NULL; pp = &(*pp)->next);
+  *pp = p;
+  handle->count++;
+  last = p;
+  return p;
 }
 /*---------------------------------------------------------------------------*/
 void
 uip_packetqueue_free(struct uip_packetqueue_handle *handle)
 {
   PRINTF("uip_packetqueue_free %p\n", handle);
-  if(handle->packet != NULL) {
-    ctimer_stop(&handle->packet->lifetimer);
-    memb_free(&packets_memb, handle->packet);
-    handle->packet = NULL;
+  while(handle->packet != NULL) {
+    uip_packetqueue_stats.flushed++;
+    remove_packet(handle->packet);
+  }
+}
+/*---------------------------------------------------------------------------*/
+int
+uip_packetqueue_enqueue(struct uip_packetqueue_handle *h, clock_time_t lifetime)
+{
+  struct uip_packetqueue_packet *p;
+
+  p = uip_packetqueue_alloc(h, lifetime);
+  if(p == NULL) {
+    return 0;
   }
+  memcpy(p->queue_buf, &uip_buf[UIP_LLH_LEN], uip_len);
+  p->queue_buf_len = uip_len;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+uip_packetqueue_dequeue(struct uip_packetqueue_handle *h)
+{
+  struct uip_packetqueue_packet *p = h->packet;
+
+  if(p == NULL) {
+    return 0;
+  }
+  uip_len = p->queue_buf_len;
+  memcpy(&uip_buf[UIP_LLH_LEN], p->queue_buf, uip_len);
+  remove_packet(p);
+  return uip_len;
+}
+/*---------------------------------------------------------------------------*/
+struct uip_packetqueue_packet *
+uip_packetqueue_last(void)
+{
+  return last;
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_packetqueue_remove(struct uip_packetqueue_packet *p)
+{
+  PRINTF("uip_packetqueue_remove %p\n", p->handle);
+  remove_packet(p);
+}
+/*---------------------------------------------------------------------------*/
+int
+uip_packetqueue_len(struct uip_packetqueue_handle *h)
+{
+  return h->count;
 }
 /*---------------------------------------------------------------------------*/
 uint8_t *
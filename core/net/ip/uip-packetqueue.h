@@ -3,10 +3,25 @@
 
 #include "sys/ctimer.h"
 
+/* The number of packets that all handles can hold together */
+#ifdef UIP_CONF_PACKETQUEUE_NUM
+#define UIP_PACKETQUEUE_NUM UIP_CONF_PACKETQUEUE_NUM
+#else
+#define UIP_PACKETQUEUE_NUM 2
+#endif
+
+/* The number of packets that one handle, e.g. one neighbor waiting
+   for address resolution, can hold */
+#ifdef UIP_CONF_PACKETQUEUE_PER_HANDLE
+#define UIP_PACKETQUEUE_PER_HANDLE UIP_CONF_PACKETQUEUE_PER_HANDLE
+#else
+#define UIP_PACKETQUEUE_PER_HANDLE 1
+#endif
+
 struct uip_packetqueue_handle;
 
 struct uip_packetqueue_packet {
-  struct uip_ds6_queued_packet *next;
+  struct uip_packetqueue_packet *next;
   uint8_t queue_buf[UIP_BUFSIZE - UIP_LLH_LEN];
   uint16_t queue_buf_len;
   struct ctimer lifetimer;
@@ -14,19 +29,50 @@ struct uip_packetqueue_packet {
 };
 
 struct uip_packetqueue_handle {
+  /* The oldest packet, followed by the newer ones */
   struct uip_packetqueue_packet *packet;
+  uint8_t count;
 };
 
-void uip_packetqueue_new(struct uip_packetqueue_handle *handle);
+struct uip_packetqueue_stats {
+  /* Packets dropped since their handle held UIP_PACKETQUEUE_PER_HANDLE */
+  uint32_t full;
+  /* Packets dropped since all UIP_PACKETQUEUE_NUM buffers were in use */
+  uint32_t no_buffer;
+  /* Packets dropped at the end of their lifetime */
+  uint32_t timed_out;
+  /* Packets dropped by uip_packetqueue_free() */
+  uint32_t flushed;
+};
+
+extern struct uip_packetqueue_stats uip_packetqueue_stats;
 
+void uip_packetqueue_new(struct uip_packetqueue_handle *handle);
 
+/* Append a packet to the queue of a handle; the buffer functions
+   below still refer to the oldest packet */
 struct uip_packetqueue_packet *
 uip_packetqueue_alloc(struct uip_packetqueue_handle *handle, clock_time_t lifetime);
 
-
+/* Drop all packets of a handle */
 void
 uip_packetqueue_free(struct uip_packetqueue_handle *handle);
 
+/* Append a copy of the packet in uip_buf */
+int uip_packetqueue_enqueue(struct uip_packetqueue_handle *h, clock_time_t lifetime);
+
+/* Move the oldest packet into uip_buf; returns its length, or 0 if
+   the queue is empty */
+uint16_t uip_packetqueue_dequeue(struct uip_packetqueue_handle *h);
+
+/* The packet that was appended last, or NULL if it left its queue */
+struct uip_packetqueue_packet *uip_packetqueue_last(void);
+
+/* Drop one packet from the queue of its handle */
+void uip_packetqueue_remove(struct uip_packetqueue_packet *p);
+
+int uip_packetqueue_len(struct uip_packetqueue_handle *h);
+
 uint8_t *uip_packetqueue_buf(struct uip_packetqueue_handle *h);
 uint16_t uip_packetqueue_buflen(struct uip_packetqueue_handle *h);
 void uip_packetqueue_set_buflen(struct uip_packetqueue_handle *h, uint16_t len);
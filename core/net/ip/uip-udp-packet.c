@@ -46,15 +46,33 @@ extern uint16_t uip_slen;
 
 #include <string.h>
 
+#if UIP_UDP_PACKET_BATCH_NUM
+struct batch_entry {
+  struct uip_udp_conn *c;
+  uip_ipaddr_t addr;
+  uint16_t port;
+  uint16_t len;
+};
+
+static struct batch_entry batch[UIP_UDP_PACKET_BATCH_NUM];
+static uint8_t batch_buf[UIP_UDP_PACKET_BATCH_BUFSIZE];
+static uint8_t batch_num;
+static uint16_t batch_used;
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
+
+#define PAYLOAD (&uip_buf[UIP_LLH_LEN + UIP_IPUDPH_LEN])
+
 /*---------------------------------------------------------------------------*/
 void
 uip_udp_packet_send(struct uip_udp_conn *c, const void *data, int len)
 {
 #if UIP_UDP
-  if(data != NULL && len <= (UIP_BUFSIZE - (UIP_LLH_LEN + UIP_IPUDPH_LEN))) {
+  if(data != NULL && len <= UIP_UDP_PACKET_MAXLEN) {
     uip_udp_conn = c;
     uip_slen = len;
-    memmove(&uip_buf[UIP_LLH_LEN + UIP_IPUDPH_LEN], data, len);
+    if(data != PAYLOAD) {
+      memmove(PAYLOAD, data, len);
+    }
     uip_process(UIP_UDP_SEND_CONN);
 
 #if UIP_IPV6_MULTICAST
@@ -100,3 +118,73 @@ uip_udp_packet_sendto(struct uip_udp_conn *c, const void *data, int len,
   }
 }
 /*---------------------------------------------------------------------------*/
+void *
+uip_udp_packet_reserve(int len)
+{
+  if(len < 0 || len > UIP_UDP_PACKET_MAXLEN) {
+    return NULL;
+  }
+  return PAYLOAD;
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_udp_packet_commit(struct uip_udp_conn *c, int len,
+                      const uip_ipaddr_t *toaddr, uint16_t toport)
+{
+  if(toaddr == NULL) {
+    uip_udp_packet_send(c, PAYLOAD, len);
+  } else {
+    uip_udp_packet_sendto(c, PAYLOAD, len, toaddr, toport);
+  }
+}
+/*---------------------------------------------------------------------------*/
+#if UIP_UDP_PACKET_BATCH_NUM
+void *
+uip_udp_packet_batch_reserve(struct uip_udp_conn *c, int len,
+                             const uip_ipaddr_t *toaddr, uint16_t toport)
+{
+  struct batch_entry *e;
+  uint8_t *payload;
+
+  if(c == NULL || len < 0 || len > UIP_UDP_PACKET_MAXLEN
+     || batch_num == UIP_UDP_PACKET_BATCH_NUM
+     || len > UIP_UDP_PACKET_BATCH_BUFSIZE - batch_used) {
+    return NULL;
+  }
+
+  if(batch_num == 0) {
+    tcpip_poll_udp_batch();
+  }
+
+  e = &batch[batch_num++];
+  e->c = c;
+  if(toaddr == NULL) {
+    uip_ipaddr_copy(&e->addr, &c->ripaddr);
+    e->port = c->rport;
+  } else {
+    uip_ipaddr_copy(&e->addr, toaddr);
+    e->port = toport;
+  }
+  e->len = len;
+  payload = &batch_buf[batch_used];
+  batch_used += len;
+  return payload;
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_udp_packet_batch_flush(void)
+{
+  uint8_t i;
+  uint16_t offset;
+
+  offset = 0;
+  for(i = 0; i < batch_num; i++) {
+    uip_udp_packet_sendto(batch[i].c, &batch_buf[offset], batch[i].len,
+                          &batch[i].addr, batch[i].port);
+    offset += batch[i].len;
+  }
+  batch_num = 0;
+  batch_used = 0;
+}
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
+/*---------------------------------------------------------------------------*/
@@ -42,8 +42,79 @@
 
 #include "net/ip/uip.h"
 
+/* Number of datagrams that can be queued with
+   uip_udp_packet_batch_reserve() before the tcpip process sends them.
+   0 disables batching. */
+#ifdef UIP_UDP_PACKET_CONF_BATCH_NUM
+#define UIP_UDP_PACKET_BATCH_NUM UIP_UDP_PACKET_CONF_BATCH_NUM
+#else /* UIP_UDP_PACKET_CONF_BATCH_NUM */
+#define UIP_UDP_PACKET_BATCH_NUM 0
+#endif /* UIP_UDP_PACKET_CONF_BATCH_NUM */
+
+/* Payload bytes shared by all queued datagrams */
+#ifdef UIP_UDP_PACKET_CONF_BATCH_BUFSIZE
+#define UIP_UDP_PACKET_BATCH_BUFSIZE UIP_UDP_PACKET_CONF_BATCH_BUFSIZE
+#else /* UIP_UDP_PACKET_CONF_BATCH_BUFSIZE */
+#define UIP_UDP_PACKET_BATCH_BUFSIZE 256
+#endif /* UIP_UDP_PACKET_CONF_BATCH_BUFSIZE */
+
+/* The largest UDP payload that fits into uip_buf */
+#define UIP_UDP_PACKET_MAXLEN (UIP_BUFSIZE - (UIP_LLH_LEN + UIP_IPUDPH_LEN))
+
 void uip_udp_packet_send(struct uip_udp_conn *c, const void *data, int len);
 void uip_udp_packet_sendto(struct uip_udp_conn *c, const void *data, int len,
 			   const uip_ipaddr_t *toaddr, uint16_t toport);
 
+/**
+ * \brief      Get the payload area of the next outgoing datagram
+ * \param len  The number of payload bytes the caller will write
+ * \return     A pointer into uip_buf, or NULL if len bytes do not fit
+ *
+ *             The caller writes the payload at the returned pointer
+ *             and sends it with uip_udp_packet_commit(), which saves
+ *             the copy that uip_udp_packet_send() makes. The payload
+ *             lives in uip_buf, so no other uIP function may be
+ *             called in between, and this must not be used while an
+ *             incoming packet in uip_buf is still being processed.
+ */
+void *uip_udp_packet_reserve(int len);
+
+/**
+ * \brief      Send a datagram built with uip_udp_packet_reserve()
+ * \param c    The UDP connection to send on
+ * \param len  The number of payload bytes written
+ * \param toaddr The destination, or NULL for the remote address of c
+ * \param toport The destination port in network byte order, used
+ *             only when toaddr is not NULL
+ */
+void uip_udp_packet_commit(struct uip_udp_conn *c, int len,
+                           const uip_ipaddr_t *toaddr, uint16_t toport);
+
+#if UIP_UDP_PACKET_BATCH_NUM
+/**
+ * \brief      Queue a datagram for sending by the tcpip process
+ * \param c    The UDP connection to send on
+ * \param len  The number of payload bytes the caller will write
+ * \param toaddr The destination, or NULL for the remote address of c
+ * \param toport The destination port in network byte order, used
+ *             only when toaddr is not NULL
+ * \return     A pointer to len bytes for the payload, or NULL if
+ *             the batch is full
+ *
+ *             The caller writes the payload at the returned pointer
+ *             before it yields. All datagrams queued until then are
+ *             sent back to back by one invocation of the tcpip
+ *             process, or earlier by uip_udp_packet_batch_flush().
+ *             The connection must stay open until they are sent.
+ */
+void *uip_udp_packet_batch_reserve(struct uip_udp_conn *c, int len,
+                                   const uip_ipaddr_t *toaddr,
+                                   uint16_t toport);
+
+/**
+ * \brief      Send all queued datagrams now
+ */
+void uip_udp_packet_batch_flush(void);
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
+
 #endif /* UIP_UDP_PACKET_H_ */
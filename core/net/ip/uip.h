@@ -588,6 +588,10 @@ struct uip_conn *uip_connect(const uip_ipaddr_t *ripaddr, uint16_t port);
  *
  * Check if a connection has outstanding (i.e., unacknowledged) data.
  *
+ * With UIP_TCP_SEND_WINDOW > 1, this is the number of bytes in
+ * flight, and the application sends new data from this offset of its
+ * oldest unacknowledged byte.
+ *
  * \param conn A pointer to the uip_conn structure for the connection.
  *
  * \hideinitializer
@@ -731,6 +735,19 @@ CCIF void uip_send(const void *data, int len);
  */
 #define uip_acked()   (uip_flags & UIP_ACKDATA)
 
+#if UIP_TCP_SEND_WINDOW > 1
+/**
+ * The number of bytes that the remote host has just acknowledged.
+ *
+ * Only valid when uip_acked() is non-zero. With a send window of
+ * several segments, an acknowledgement may cover only some of the
+ * data in flight; uip_outstanding() is the data that remains.
+ *
+ * \hideinitializer
+ */
+#define uip_ackedlen()  uip_acklen
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
+
 /**
  * Has the connection just been connected?
  *
@@ -1305,6 +1322,10 @@ extern uint8_t uip_ext_len;
 extern uint16_t uip_urglen, uip_surglen;
 #endif /* UIP_URGDATA > 0 */
 
+#if UIP_TCP_SEND_WINDOW > 1
+extern uint16_t uip_acklen;
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
+
 /*
  * Clear uIP buffer
  *
@@ -1352,6 +1373,16 @@ struct uip_conn {
   uint8_t timer;         /**< The retransmission timer. */
   uint8_t nrtx;          /**< The number of retransmissions for the last
                               segment sent. */
+#if UIP_TCP_SEND_WINDOW > 1
+  uint16_t snd_wnd;      /**< The window advertised by the remote host. */
+  uint16_t snd_max;      /**< Length of all data sent since snd_nxt, also
+                              the data sent before a retransmission. */
+  uint16_t rtt_len;      /**< The end of the segment timed for RTT
+                              estimation, relative to snd_nxt, or 0. */
+  uint8_t rtt_timer;     /**< Ticks since the timed segment was sent. */
+  uint8_t cwnd;          /**< The congestion window, in segments. */
+  uint8_t dupacks;       /**< Duplicate ACKs since the last new ACK. */
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
 
   uip_tcp_appstate_t appstate; /** The application state. */
 };
@@ -1453,6 +1484,12 @@ struct uip_stats {
                                checksum errors. */
     uip_stats_t protoerr; /**< Number of packets dropped because they
                                were neither ICMP, UDP nor TCP. */
+#if UIP_FLOW_CACHE_SIZE
+    uip_stats_t flowcache_hit;  /**< Number of next hops found in the
+                                     flow cache. */
+    uip_stats_t flowcache_miss; /**< Number of next hops looked up in
+                                     the route and neighbor tables. */
+#endif /* UIP_FLOW_CACHE_SIZE */
   } ip;                   /**< IP statistics. */
   struct {
     uip_stats_t recv;     /**< Number of received ICMP packets. */
@@ -1893,6 +1930,7 @@ struct uip_udp_hdr {
 #define UIP_EXT_HDR_OPT_PAD1  0
 #define UIP_EXT_HDR_OPT_PADN  1
 #define UIP_EXT_HDR_OPT_RPL   0x63
+#define UIP_EXT_HDR_OPT_MPL   0x6D
 
 /** @} */
 
@@ -2172,6 +2210,30 @@ CCIF extern uip_lladdr_t uip_lladdr;
  */
 uint16_t uip_chksum(uint16_t *data, uint16_t len);
 
+/**
+ * Update an Internet checksum after some of the data it covers has
+ * changed, without summing all of the data again (RFC 1624).
+ *
+ * The changed region must start at an even offset of the checksummed
+ * data. It may change its length, as when one pseudo-header replaces
+ * another, as long as nothing after it moves.
+ *
+ * \param chksum The checksum field, in network byte order.
+ *
+ * \param old The old contents of the changed region.
+ *
+ * \param old_len The length of the old contents.
+ *
+ * \param new The new contents of the changed region.
+ *
+ * \param new_len The length of the new contents.
+ *
+ * \return The new checksum field, in network byte order. A UDP
+ * checksum of 0 must be sent as 0xffff.
+ */
+uint16_t uip_chksum_adjust(uint16_t chksum, const void *old, uint16_t old_len,
+                           const void *new, uint16_t new_len);
+
 /**
  * Calculate the IP header checksum of the packet header in uip_buf.
  *
@@ -316,6 +316,19 @@ void uip_log(char *msg);
 /** Minimum number of default routers */
 #define UIP_CONF_DS6_DEFRT_NBU       2
 #endif
+
+/**
+ * Number of entries of the direct-mapped cache that maps destinations
+ * to next-hop neighbors. tcpip_ipv6_output() looks there before it
+ * consults the route, default router and neighbor tables; any change
+ * to these tables empties the cache. A power of two is best.
+ * (default: 0, no cache)
+ */
+#ifdef UIP_CONF_FLOW_CACHE_SIZE
+#define UIP_FLOW_CACHE_SIZE (UIP_CONF_FLOW_CACHE_SIZE)
+#else /* UIP_CONF_FLOW_CACHE_SIZE */
+#define UIP_FLOW_CACHE_SIZE 0
+#endif /* UIP_CONF_FLOW_CACHE_SIZE */
 /** @} */
 
 /*------------------------------------------------------------------------------*/
@@ -500,6 +513,26 @@ void uip_log(char *msg);
 #define UIP_RECEIVE_WINDOW (UIP_CONF_RECEIVE_WINDOW)
 #endif
 
+/**
+ * The number of segments that a TCP connection may have in flight.
+ *
+ * With the default of 1, the application sends a new segment only
+ * when the previous one has been acknowledged, and regenerates that
+ * segment when it is retransmitted. With more, each call of
+ * uip_send() adds a segment to the ones in flight as long as the
+ * congestion window and the window of the remote host allow. On a
+ * timeout, the application sends again from its oldest
+ * unacknowledged byte, so it must keep all data in flight; tcp-socket
+ * does this in its send buffer. Only uIP for IPv6 implements this.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_TCP_SEND_WINDOW
+#define UIP_TCP_SEND_WINDOW (UIP_CONF_TCP_SEND_WINDOW)
+#else
+#define UIP_TCP_SEND_WINDOW 1
+#endif
+
 /**
  * How long a connection should stay in the TIME_WAIT state.
  *
@@ -619,6 +652,21 @@ void uip_log(char *msg);
 #define UIP_BYTE_ORDER     (UIP_LITTLE_ENDIAN)
 #endif /* UIP_CONF_BYTE_ORDER */
 
+/**
+ * Compute the Internet checksum 32 bits at a time instead of 16.
+ *
+ * The words are summed into a 64-bit accumulator and folded down at
+ * the end, which only pays off on 32 and 64-bit CPUs, such as native
+ * hosts and the ARM Cortex-M. The buffer may be unaligned.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_CHKSUM_WIDE
+#define UIP_CHKSUM_WIDE    (UIP_CONF_CHKSUM_WIDE)
+#else /* UIP_CONF_CHKSUM_WIDE */
+#define UIP_CHKSUM_WIDE    0
+#endif /* UIP_CONF_CHKSUM_WIDE */
+
 /** @} */
 /*------------------------------------------------------------------------------*/
 
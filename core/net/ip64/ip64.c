@@ -358,6 +358,21 @@ ipv6_transport_checksum(const uint8_t *packet, uint16_t len, uint8_t proto)
   return (sum == 0) ? 0xffff : uip_htons(sum);
 }
 /*---------------------------------------------------------------------------*/
+static uint16_t
+translate_transport_checksum(uint16_t chksum,
+                             const void *old_addrs, uint8_t old_addrs_len,
+                             const uint8_t *old_ports,
+                             const void *new_addrs, uint8_t new_addrs_len,
+                             const uint8_t *new_ports)
+{
+  /* The length and protocol in the pseudo-header are the same for
+     IPv4 and IPv6, so only the addresses and the port numbers, which
+     lead both the TCP and the UDP header, change the checksum. */
+  chksum = uip_chksum_adjust(chksum, old_addrs, old_addrs_len,
+                             new_addrs, new_addrs_len);
+  return uip_chksum_adjust(chksum, old_ports, 4, new_ports, 4);
+}
+/*---------------------------------------------------------------------------*/
 int
 ip64_6to4(const uint8_t *ipv6packet, const uint16_t ipv6packet_len,
 	  uint8_t *resultpacket)
@@ -425,13 +440,15 @@ ip64_6to4(const uint8_t *ipv6packet, const uint16_t ipv6packet_len,
     PRINTF("ip64_6to4: TCP header\n");
     v4hdr->proto = IP_PROTO_TCP;
 
-    /* Compute and check the TCP checksum - since we're going to
-       recompute it ourselves, we must ensure that it was correct in
-       the first place. */
+#if DEBUG
+    /* Check the TCP checksum. The update of the checksum below keeps
+       a bad checksum bad, so the receiver will still drop the
+       packet. */
     if(ipv6_transport_checksum(ipv6packet, ipv6len,
                                IP_PROTO_TCP) != 0xffff) {
-      PRINTF("Bad TCP checksum, dropping packet\n");
+      PRINTF("Bad TCP checksum\n");
     }
+#endif /* DEBUG */
 
     break;
 
@@ -447,13 +464,15 @@ ip64_6to4(const uint8_t *ipv6packet, const uint16_t ipv6packet_len,
                       (uint8_t *)udphdr + sizeof(struct udp_hdr),
                       BUFSIZE - IPV4_HDRLEN - sizeof(struct udp_hdr));
     }
-    /* Compute and check the UDP checksum - since we're going to
-       recompute it ourselves, we must ensure that it was correct in
-       the first place. */
+#if DEBUG
+    /* Check the UDP checksum. The update of the checksum below keeps
+       a bad checksum bad, so the receiver will still drop the
+       packet. */
     if(ipv6_transport_checksum(ipv6packet, ipv6len,
                                IP_PROTO_UDP) != 0xffff) {
-      PRINTF("Bad UDP checksum, dropping packet\n");
+      PRINTF("Bad UDP checksum\n");
     }
+#endif /* DEBUG */
     break;
 
   case IP_PROTO_ICMPV6:
@@ -616,17 +635,29 @@ ip64_6to4(const uint8_t *ipv6packet, const uint16_t ipv6packet_len,
 
   /* The checksum is in different places in the different protocol
      headers, so we need to be sure that we update the correct
-     field. */
+     field. Unless DNS64 rewrote the payload, only the pseudo-header
+     and the port numbers differ from the IPv6 packet, so the
+     checksum is updated for those instead of being recomputed. */
   switch(v4hdr->proto) {
   case IP_PROTO_TCP:
-    tcphdr->tcpchksum = 0;
-    tcphdr->tcpchksum = ~(ipv4_transport_checksum(resultpacket, ipv4len,
-						  IP_PROTO_TCP));
+    tcphdr->tcpchksum = translate_transport_checksum(tcphdr->tcpchksum,
+                                                     &v6hdr->srcipaddr, 32,
+                                                     &ipv6packet[IPV6_HDRLEN],
+                                                     &v4hdr->srcipaddr, 8,
+                                                     &resultpacket[IPV4_HDRLEN]);
     break;
   case IP_PROTO_UDP:
-    udphdr->udpchksum = 0;
-    udphdr->udpchksum = ~(ipv4_transport_checksum(resultpacket, ipv4len,
-						  IP_PROTO_UDP));
+    if(udphdr->udpchksum != 0 && udphdr->destport != UIP_HTONS(DNS_PORT)) {
+      udphdr->udpchksum = translate_transport_checksum(udphdr->udpchksum,
+                                                       &v6hdr->srcipaddr, 32,
+                                                       &ipv6packet[IPV6_HDRLEN],
+                                                       &v4hdr->srcipaddr, 8,
+                                                       &resultpacket[IPV4_HDRLEN]);
+    } else {
+      udphdr->udpchksum = 0;
+      udphdr->udpchksum = ~(ipv4_transport_checksum(resultpacket, ipv4len,
+                                                    IP_PROTO_UDP));
+    }
     if(udphdr->udpchksum == 0) {
       udphdr->udpchksum = 0xffff;
     }
@@ -854,16 +885,27 @@ ip64_4to6(const uint8_t *ipv4packet, const uint16_t ipv4packet_len,
      field. */
   switch(v6hdr->nxthdr) {
   case IP_PROTO_TCP:
-    tcphdr->tcpchksum = 0;
-    tcphdr->tcpchksum = ~(ipv6_transport_checksum(resultpacket,
-						  ipv6len,
-						  IP_PROTO_TCP));
+    tcphdr->tcpchksum = translate_transport_checksum(tcphdr->tcpchksum,
+                                                     &v4hdr->srcipaddr, 8,
+                                                     &ipv4packet[IPV4_HDRLEN],
+                                                     &v6hdr->srcipaddr, 32,
+                                                     &resultpacket[IPV6_HDRLEN]);
     break;
   case IP_PROTO_UDP:
-    udphdr->udpchksum = 0;
-    udphdr->udpchksum = ~(ipv6_transport_checksum(resultpacket,
-						  ipv6len,
-						  IP_PROTO_UDP));
+    /* IPv4 UDP packets may come without a checksum, which IPv6 does
+       not allow, and DNS64 may have rewritten the payload. */
+    if(udphdr->udpchksum != 0 && udphdr->srcport != UIP_HTONS(DNS_PORT)) {
+      udphdr->udpchksum = translate_transport_checksum(udphdr->udpchksum,
+                                                       &v4hdr->srcipaddr, 8,
+                                                       &ipv4packet[IPV4_HDRLEN],
+                                                       &v6hdr->srcipaddr, 32,
+                                                       &resultpacket[IPV6_HDRLEN]);
+    } else {
+      udphdr->udpchksum = 0;
+      udphdr->udpchksum = ~(ipv6_transport_checksum(resultpacket,
+                                                    ipv6len,
+                                                    IP_PROTO_UDP));
+    }
     if(udphdr->udpchksum == 0) {
       udphdr->udpchksum = 0xffff;
     }
@@ -0,0 +1,969 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \addtogroup mpl
+ * @{
+ */
+/**
+ * \file
+ *    Implementation of the MPL multicast engine (RFC 7731)
+ */
+
+#include "contiki.h"
+#include "contiki-lib.h"
+#include "contiki-net.h"
+#include "lib/trickle-timer.h"
+#include "net/ipv6/uip-icmp6.h"
+#include "net/ipv6/multicast/uip-mcast6.h"
+#include "net/ipv6/multicast/mpl.h"
+#include <string.h>
+
+#define DEBUG DEBUG_NONE
+#include "net/ip/uip-debug.h"
+
+/*---------------------------------------------------------------------------*/
+/* Data Representation */
+/*---------------------------------------------------------------------------*/
+/*
+ * Seed IDs as they appear in the S field of the MPL Option and of the
+ * MPL Seed Info. A seed ID with S=0 is the IPv6 source address of the
+ * message; we store it as a 128-bit ID, which is the same thing.
+ */
+#define SEED_ID_S0        0
+#define SEED_ID_S16       1
+#define SEED_ID_S64       2
+#define SEED_ID_S128      3
+#define SEED_ID_MAX_LEN  16
+
+static const uint8_t seed_id_len[] = { 0, 2, 8, 16 };
+
+struct seed_id {
+  uint8_t s;
+  uint8_t id[SEED_ID_MAX_LEN];
+};
+
+#define seed_id_cmp(a, b) \
+  ((a)->s == (b)->s && memcmp((a)->id, (b)->id, seed_id_len[(a)->s]) == 0)
+#define PRINT_SEED(sid) PRINTF("S=%u/0x%02x%02x", (sid)->s, \
+  (sid)->id[seed_id_len[(sid)->s] - 2], (sid)->id[seed_id_len[(sid)->s] - 1])
+
+/*
+ * Sequence Numbers and Serial Number Arithmetic
+ *
+ * Comparisons as per RFC1982 "Serial Number Arithmetic", with a
+ * SERIAL_BITS value of 8. Pairs that are 128 apart are neither less
+ * nor greater than one another.
+ */
+#define SEQ_VAL_IS_EQ(i1, i2) ((i1) == (i2))
+#define SEQ_VAL_IS_LT(i1, i2) \
+  ((i1) != (i2) && (uint8_t)((i2) - (i1)) < 0x80)
+#define SEQ_VAL_IS_GT(i1, i2) \
+  ((i1) != (i2) && (uint8_t)((i1) - (i2)) < 0x80)
+
+/* Seed Set: one sliding window per seed */
+struct seed {
+  struct seed_id id;
+  uint8_t min_seqno;            /* Lower bound of the window */
+  uint8_t count;                /* Messages in the buffered message set */
+  uint8_t lifetime;             /* Minutes */
+  uint8_t flags;
+};
+
+#define SEED_U_BIT 0x80         /* Is used */
+#define SEED_L_BIT 0x40         /* Listed in the current control message */
+
+/* Buffered Message Set, shared by all seeds */
+struct mpl_msg {
+  struct trickle_timer tt;
+  struct seed *seed;
+  uint16_t buff_len;
+  uint8_t seq;
+  uint8_t opt;                  /* Offset of the MPL Option in buff */
+  uint8_t e;                    /* Data message timer expirations */
+  uint8_t flags;
+  uint8_t buff[UIP_BUFSIZE - UIP_LLH_LEN];
+};
+
+#define MSG_U_BIT 0x80          /* Is used */
+#define MSG_R_BIT 0x40          /* Missed by a neighbour */
+
+#define MSG_HOP_LIMIT(m) (((struct uip_ip_hdr *)(m)->buff)->ttl)
+
+/* The MPL Option: S, M and V flags, a sequence number and the seed ID */
+#define OPT_FLAGS            2
+#define OPT_SEQ              3
+#define OPT_SEED_ID          4
+#define OPT_GET_S(o)         ((o)[OPT_FLAGS] >> 6)
+#define OPT_M_BIT            0x20
+#define OPT_V_BIT            0x10
+
+/* Our own option fits into 8 bytes of HBH header with either seed ID */
+#define HBHO_TOTAL_LEN       8
+
+/* MPL Seed Info in control messages: min-seqno, bm-len and S */
+#define SEED_INFO_LEN        2
+#define SEED_INFO_GET_BM_LEN(p) ((p)[1] >> 2)
+#define SEED_INFO_GET_S(p)   ((p)[1] & 0x03)
+#define SEED_INFO_MAX_BM_LEN 0x3F
+
+#define BITMAP_IS_SET(b, n)  ((b)[(n) >> 3] & (0x80 >> ((n) & 7)))
+#define BITMAP_SET(b, n)     ((b)[(n) >> 3] |= (0x80 >> ((n) & 7)))
+
+/* ALL_MPL_FORWARDERS of a given scope */
+#define mpl_create_all_forwarders(a, scope) \
+  uip_ip6addr(a, 0xff00 | (scope), 0, 0, 0, 0, 0, 0, 0x00fc)
+#define mpl_is_addr_all_forwarders(a) \
+  (((a)->u8[0]) == 0xff && \
+   ((a)->u8[1]) == UIP_MCAST6_SCOPE_LINK_LOCAL && \
+   ((a)->u16[1]) == 0 && ((a)->u16[2]) == 0 && ((a)->u16[3]) == 0 && \
+   ((a)->u16[4]) == 0 && ((a)->u16[5]) == 0 && ((a)->u16[6]) == 0 && \
+   ((a)->u8[14]) == 0 && ((a)->u8[15]) == 0xfc)
+/*---------------------------------------------------------------------------*/
+/* Internal Data */
+/*---------------------------------------------------------------------------*/
+#if UIP_MCAST6_STATS
+static struct mpl_stats stats;
+
+#define MPL_STATS_ADD(x) stats.x++
+#define MPL_STATS_INIT() do { memset(&stats, 0, sizeof(stats)); } while(0)
+#else /* UIP_MCAST6_STATS */
+#define MPL_STATS_ADD(x)
+#define MPL_STATS_INIT()
+#endif
+
+static struct seed seeds[MPL_SEED_SET_SIZE];
+static struct mpl_msg buffered_msgs[MPL_BUFFER_SIZE];
+static struct trickle_timer control_timer;
+static uint8_t control_expirations;
+static struct ctimer lifetime_timer;
+static uint8_t last_seq;
+
+extern uint16_t uip_slen;
+/*---------------------------------------------------------------------------*/
+/* uIPv6 Pointers */
+/*---------------------------------------------------------------------------*/
+#define UIP_EXT_BUF       ((struct uip_ext_hdr *)&uip_buf[UIP_LLH_LEN + UIP_IPH_LEN])
+#define UIP_EXT_BUF_NEXT  ((uint8_t *)&uip_buf[UIP_LLH_LEN + UIP_IPH_LEN + HBHO_TOTAL_LEN])
+#define UIP_EXT_OPT_FIRST ((uint8_t *)&uip_buf[UIP_LLH_LEN + UIP_IPH_LEN + 2])
+#define UIP_IP_BUF        ((struct uip_ip_hdr *)&uip_buf[UIP_LLH_LEN])
+#define UIP_ICMP_BUF      ((struct uip_icmp_hdr *)&uip_buf[uip_l2_l3_hdr_len])
+#define UIP_ICMP_PAYLOAD  ((unsigned char *)&uip_buf[uip_l2_l3_icmp_hdr_len])
+/*---------------------------------------------------------------------------*/
+/* Local function prototypes */
+/*---------------------------------------------------------------------------*/
+static void icmp_input(void);
+
+UIP_ICMP6_HANDLER(mpl_icmp_handler, ICMP6_MPL,
+                  UIP_ICMP6_HANDLER_CODE_ANY, icmp_input);
+/*---------------------------------------------------------------------------*/
+/* Seed Set */
+/*---------------------------------------------------------------------------*/
+static struct seed *
+seed_lookup(const struct seed_id *id)
+{
+  struct seed *s;
+
+  for(s = seeds; s < &seeds[MPL_SEED_SET_SIZE]; s++) {
+    if((s->flags & SEED_U_BIT) && seed_id_cmp(&s->id, id)) {
+      return s;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Take an unused entry or one that has buffered nothing. Forgetting a
+ * seed whose window still holds messages would let us accept them
+ * again, so a new seed has to wait for such an entry to expire.
+ */
+static struct seed *
+seed_allocate(void)
+{
+  struct seed *s;
+  struct seed *oldest = NULL;
+
+  for(s = seeds; s < &seeds[MPL_SEED_SET_SIZE]; s++) {
+    if(!(s->flags & SEED_U_BIT)) {
+      return s;
+    }
+    if(s->count == 0 && (oldest == NULL || s->lifetime < oldest->lifetime)) {
+      oldest = s;
+    }
+  }
+  return oldest;
+}
+/*---------------------------------------------------------------------------*/
+/* Reads the seed ID of the MPL Option opt of the datagram in uip_buf */
+static uint8_t
+seed_id_from_option(struct seed_id *id, const uint8_t *opt)
+{
+  id->s = OPT_GET_S(opt);
+  if(opt[1] != OPT_SEED_ID - 2 + seed_id_len[id->s]) {
+    return 0;
+  }
+  if(id->s == SEED_ID_S0) {
+    id->s = SEED_ID_S128;
+    memcpy(id->id, &UIP_IP_BUF->srcipaddr, SEED_ID_MAX_LEN);
+  } else {
+    memcpy(id->id, &opt[OPT_SEED_ID], seed_id_len[id->s]);
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Buffered Message Set */
+/*---------------------------------------------------------------------------*/
+static struct mpl_msg *
+msg_lookup(const struct seed *s, uint8_t seq)
+{
+  struct mpl_msg *m;
+
+  for(m = buffered_msgs; m < &buffered_msgs[MPL_BUFFER_SIZE]; m++) {
+    if((m->flags & MSG_U_BIT) && m->seed == s && SEQ_VAL_IS_EQ(m->seq, seq)) {
+      return m;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the message of s with the lowest (low) or highest sequence */
+static struct mpl_msg *
+msg_edge(const struct seed *s, uint8_t low)
+{
+  struct mpl_msg *m;
+  struct mpl_msg *edge = NULL;
+
+  for(m = buffered_msgs; m < &buffered_msgs[MPL_BUFFER_SIZE]; m++) {
+    if((m->flags & MSG_U_BIT) && m->seed == s &&
+       (edge == NULL ||
+        (low ? SEQ_VAL_IS_LT(m->seq, edge->seq) :
+         SEQ_VAL_IS_GT(m->seq, edge->seq)))) {
+      edge = m;
+    }
+  }
+  return edge;
+}
+/*---------------------------------------------------------------------------*/
+static void
+msg_free(struct mpl_msg *m)
+{
+  trickle_timer_stop(&m->tt);
+  m->seed->count--;
+  m->flags = 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+seed_free(struct seed *s)
+{
+  struct mpl_msg *m;
+
+  for(m = buffered_msgs; m < &buffered_msgs[MPL_BUFFER_SIZE]; m++) {
+    if((m->flags & MSG_U_BIT) && m->seed == s) {
+      msg_free(m);
+    }
+  }
+  s->flags = 0;
+}
+/*---------------------------------------------------------------------------*/
+static struct mpl_msg *
+buffer_allocate(void)
+{
+  struct mpl_msg *m;
+
+  for(m = buffered_msgs; m < &buffered_msgs[MPL_BUFFER_SIZE]; m++) {
+    if(!(m->flags & MSG_U_BIT)) {
+      return m;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Frees the oldest message of the seed with the largest window. The
+ * window then starts after it, so that we do not accept it again.
+ */
+static struct mpl_msg *
+buffer_reclaim(void)
+{
+  struct seed *s;
+  struct seed *largest = NULL;
+  struct mpl_msg *m;
+
+  for(s = seeds; s < &seeds[MPL_SEED_SET_SIZE]; s++) {
+    if((s->flags & SEED_U_BIT) &&
+       (largest == NULL || s->count > largest->count)) {
+      largest = s;
+    }
+  }
+  if(largest == NULL || largest->count == 0) {
+    return NULL;
+  }
+
+  m = msg_edge(largest, 1);
+  largest->min_seqno = m->seq + 1;
+  msg_free(m);
+  MPL_STATS_ADD(buffer_reclaim);
+
+  PRINTF("MPL: Reclaimed %u of seed ", m->seq);
+  PRINT_SEED(&largest->id);
+  PRINTF(", window now starts at %u\n", largest->min_seqno);
+  return m;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * seq is newer than all messages of s, but 128 or more past the start
+ * of its window, where sequence numbers no longer compare. Forget the
+ * messages that far behind seq and restart the window at the oldest
+ * message left, or at seq.
+ */
+static void
+window_reset(struct seed *s, uint8_t seq)
+{
+  struct mpl_msg *m;
+
+  for(m = buffered_msgs; m < &buffered_msgs[MPL_BUFFER_SIZE]; m++) {
+    if((m->flags & MSG_U_BIT) && m->seed == s &&
+       (uint8_t)(seq - m->seq) >= 0x80) {
+      msg_free(m);
+    }
+  }
+  m = msg_edge(s, 1);
+  s->min_seqno = m != NULL ? m->seq : seq;
+
+  PRINTF("MPL: %u too far ahead of seed ", seq);
+  PRINT_SEED(&s->id);
+  PRINTF(", window now starts at %u\n", s->min_seqno);
+}
+/*---------------------------------------------------------------------------*/
+/* Trickle Timers */
+/*---------------------------------------------------------------------------*/
+static void
+control_timer_reset(void)
+{
+  if(MPL_CONTROL_MESSAGE_TIMER_EXPIRATIONS > 0) {
+    control_expirations = 0;
+    trickle_timer_reset_event(&control_timer);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+msg_transmit(struct mpl_msg *m)
+{
+  uint8_t *opt;
+
+  /* M: this is the largest sequence number we know from the seed */
+  opt = &m->buff[m->opt];
+  if(msg_edge(m->seed, 0) == m) {
+    opt[OPT_FLAGS] |= OPT_M_BIT;
+  } else {
+    opt[OPT_FLAGS] &= ~OPT_M_BIT;
+  }
+
+  PRINTF("MPL: Sending %u of seed ", m->seq);
+  PRINT_SEED(&m->seed->id);
+  PRINTF("%s\n", (m->flags & MSG_R_BIT) ? " (reactive)" : "");
+
+  uip_len = m->buff_len;
+  memcpy(UIP_IP_BUF, m->buff, uip_len);
+
+  UIP_MCAST6_STATS_ADD(mcast_fwd);
+  if(m->flags & MSG_R_BIT) {
+    MPL_STATS_ADD(data_reactive);
+  } else {
+    MPL_STATS_ADD(data_proactive);
+  }
+  m->flags &= ~MSG_R_BIT;
+
+  tcpip_output(NULL);
+  uip_clear_buf();
+}
+/*---------------------------------------------------------------------------*/
+static void
+data_timer_expired(void *ptr, uint8_t suppress)
+{
+  struct mpl_msg *m = ptr;
+
+  if(suppress == TRICKLE_TIMER_TX_OK && MSG_HOP_LIMIT(m) > 0) {
+    msg_transmit(m);
+  }
+
+  /* The message stays buffered for reactive forwarding */
+  if(++m->e >= MPL_DATA_MESSAGE_TIMER_EXPIRATIONS) {
+    trickle_timer_stop(&m->tt);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* A neighbour misses m: (re)start its timer from Imin */
+static void
+data_timer_reset(struct mpl_msg *m)
+{
+  m->e = 0;
+  m->flags |= MSG_R_BIT;
+  trickle_timer_reset_event(&m->tt);
+}
+/*---------------------------------------------------------------------------*/
+static void
+lifetime_expired(void *ptr)
+{
+  struct seed *s;
+
+  for(s = seeds; s < &seeds[MPL_SEED_SET_SIZE]; s++) {
+    if((s->flags & SEED_U_BIT) && --s->lifetime == 0) {
+      PRINTF("MPL: Seed ");
+      PRINT_SEED(&s->id);
+      PRINTF(" expired\n");
+      seed_free(s);
+    }
+  }
+  ctimer_reset(&lifetime_timer);
+}
+/*---------------------------------------------------------------------------*/
+/* MPL Control Messages */
+/*---------------------------------------------------------------------------*/
+static void
+icmp_output(void)
+{
+  struct seed *s;
+  struct mpl_msg *m;
+  struct mpl_msg *high;
+  uint8_t *buffer;
+  uint8_t *bitmap;
+  uint8_t bm_len;
+  uint16_t payload_len;
+
+  uip_ext_len = 0;
+  buffer = UIP_ICMP_PAYLOAD;
+  payload_len = 0;
+
+  for(s = seeds; s < &seeds[MPL_SEED_SET_SIZE]; s++) {
+    if(!(s->flags & SEED_U_BIT)) {
+      continue;
+    }
+
+    /* The bitmap covers the window from min-seqno to our highest message */
+    bm_len = 0;
+    high = msg_edge(s, 0);
+    if(high != NULL) {
+      bm_len = ((uint8_t)(high->seq - s->min_seqno) >> 3) + 1;
+    }
+    if(bm_len > SEED_INFO_MAX_BM_LEN ||
+       uip_l2_l3_icmp_hdr_len + payload_len + SEED_INFO_LEN +
+       seed_id_len[s->id.s] + bm_len > UIP_BUFSIZE) {
+      break;
+    }
+
+    buffer[0] = s->min_seqno;
+    buffer[1] = (bm_len << 2) | s->id.s;
+    memcpy(&buffer[SEED_INFO_LEN], s->id.id, seed_id_len[s->id.s]);
+    bitmap = &buffer[SEED_INFO_LEN + seed_id_len[s->id.s]];
+    memset(bitmap, 0, bm_len);
+    for(m = buffered_msgs; m < &buffered_msgs[MPL_BUFFER_SIZE]; m++) {
+      if((m->flags & MSG_U_BIT) && m->seed == s) {
+        BITMAP_SET(bitmap, (uint8_t)(m->seq - s->min_seqno));
+      }
+    }
+
+    PRINTF("MPL: Control Out - Seed ");
+    PRINT_SEED(&s->id);
+    PRINTF(" min %u, %u messages\n", s->min_seqno, s->count);
+
+    buffer = bitmap + bm_len;
+    payload_len += SEED_INFO_LEN + seed_id_len[s->id.s] + bm_len;
+  }
+
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->tcflow = 0;
+  UIP_IP_BUF->flow = 0;
+  UIP_IP_BUF->proto = UIP_PROTO_ICMP6;
+  UIP_IP_BUF->ttl = MPL_IP_HOP_LIMIT;
+
+  mpl_create_all_forwarders(&UIP_IP_BUF->destipaddr,
+                            UIP_MCAST6_SCOPE_LINK_LOCAL);
+  uip_ds6_select_src(&UIP_IP_BUF->srcipaddr, &UIP_IP_BUF->destipaddr);
+
+  UIP_IP_BUF->len[0] = (UIP_ICMPH_LEN + payload_len) >> 8;
+  UIP_IP_BUF->len[1] = (UIP_ICMPH_LEN + payload_len) & 0xff;
+
+  UIP_ICMP_BUF->type = ICMP6_MPL;
+  UIP_ICMP_BUF->icode = MPL_ICMP_CODE;
+
+  UIP_ICMP_BUF->icmpchksum = 0;
+  UIP_ICMP_BUF->icmpchksum = ~uip_icmp6chksum();
+
+  uip_len = UIP_IPH_LEN + UIP_ICMPH_LEN + payload_len;
+
+  tcpip_ipv6_output();
+  MPL_STATS_ADD(icmp_out);
+}
+/*---------------------------------------------------------------------------*/
+static void
+control_timer_expired(void *ptr, uint8_t suppress)
+{
+  if(suppress == TRICKLE_TIMER_TX_OK) {
+    icmp_output();
+  }
+
+  if(++control_expirations >= MPL_CONTROL_MESSAGE_TIMER_EXPIRATIONS) {
+    trickle_timer_stop(&control_timer);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Compares the windows of a neighbour with ours. If it has a message
+ * that we miss, we reset the control timer so that it hears from us
+ * soon. If it misses one of ours, we also reset the message's timer.
+ */
+static void
+icmp_input(void)
+{
+  struct seed_id id;
+  struct seed *s;
+  struct mpl_msg *m;
+  uint8_t *info;
+  uint8_t *end;
+  uint8_t *bitmap;
+  uint8_t bm_len;
+  uint8_t min_seqno;
+  uint8_t inconsistent;
+  uint16_t i;
+
+#if UIP_CONF_IPV6_CHECKS
+  if(!uip_is_addr_linklocal(&UIP_IP_BUF->srcipaddr) ||
+     !mpl_is_addr_all_forwarders(&UIP_IP_BUF->destipaddr) ||
+     UIP_ICMP_BUF->icode != MPL_ICMP_CODE ||
+     UIP_IP_BUF->ttl != MPL_IP_HOP_LIMIT) {
+    PRINTF("MPL: Control In, bad header\n");
+    MPL_STATS_ADD(icmp_bad);
+    goto discard;
+  }
+#endif
+
+  MPL_STATS_ADD(icmp_in);
+
+  for(s = seeds; s < &seeds[MPL_SEED_SET_SIZE]; s++) {
+    s->flags &= ~SEED_L_BIT;
+  }
+
+  /* Check the whole message before we act on it */
+  info = UIP_ICMP_PAYLOAD;
+  end = (uint8_t *)UIP_ICMP_PAYLOAD + uip_len - uip_l2_l3_icmp_hdr_len;
+  while(info < end) {
+    if(info + SEED_INFO_LEN > end ||
+       info + SEED_INFO_LEN + seed_id_len[SEED_INFO_GET_S(info)] +
+       SEED_INFO_GET_BM_LEN(info) > end) {
+      PRINTF("MPL: Control In, truncated seed info\n");
+      MPL_STATS_ADD(icmp_bad);
+      goto discard;
+    }
+    info += SEED_INFO_LEN + seed_id_len[SEED_INFO_GET_S(info)] +
+      SEED_INFO_GET_BM_LEN(info);
+  }
+
+  inconsistent = 0;
+  info = UIP_ICMP_PAYLOAD;
+  while(info < end) {
+    min_seqno = info[0];
+    bm_len = SEED_INFO_GET_BM_LEN(info);
+    id.s = SEED_INFO_GET_S(info);
+    if(id.s == SEED_ID_S0) {
+      id.s = SEED_ID_S128;
+      memcpy(id.id, &UIP_IP_BUF->srcipaddr, SEED_ID_MAX_LEN);
+    } else {
+      memcpy(id.id, &info[SEED_INFO_LEN], seed_id_len[id.s]);
+    }
+    bitmap = &info[SEED_INFO_LEN + seed_id_len[SEED_INFO_GET_S(info)]];
+    info = bitmap + bm_len;
+
+    s = seed_lookup(&id);
+    if(s == NULL) {
+      /* They have new if they list any message of an unknown seed */
+      for(i = 0; i < bm_len; i++) {
+        if(bitmap[i]) {
+          PRINTF("MPL: Control In, unknown seed\n");
+          inconsistent = 1;
+          break;
+        }
+      }
+      continue;
+    }
+    s->flags |= SEED_L_BIT;
+
+    /* They have new: a message in our window that we did not buffer */
+    for(i = 0; i < bm_len * 8; i++) {
+      if(BITMAP_IS_SET(bitmap, i) &&
+         !SEQ_VAL_IS_LT((uint8_t)(min_seqno + i), s->min_seqno) &&
+         msg_lookup(s, min_seqno + i) == NULL) {
+        PRINTF("MPL: Control In, they have %u\n", (uint8_t)(min_seqno + i));
+        inconsistent = 1;
+        break;
+      }
+    }
+
+    /* We have new: a message in their window that they did not list */
+    for(m = buffered_msgs; m < &buffered_msgs[MPL_BUFFER_SIZE]; m++) {
+      if((m->flags & MSG_U_BIT) && m->seed == s &&
+         !SEQ_VAL_IS_LT(m->seq, min_seqno)) {
+        i = (uint8_t)(m->seq - min_seqno);
+        if(i >= bm_len * 8 || !BITMAP_IS_SET(bitmap, i)) {
+          PRINTF("MPL: Control In, they miss %u\n", m->seq);
+          data_timer_reset(m);
+          inconsistent = 1;
+        }
+      }
+    }
+  }
+
+  /* We have new: they do not know the seed at all */
+  for(m = buffered_msgs; m < &buffered_msgs[MPL_BUFFER_SIZE]; m++) {
+    if((m->flags & MSG_U_BIT) && !(m->seed->flags & SEED_L_BIT)) {
+      PRINTF("MPL: Control In, they miss seed of %u\n", m->seq);
+      data_timer_reset(m);
+      inconsistent = 1;
+    }
+  }
+
+  if(inconsistent) {
+    control_timer_reset();
+  } else {
+    trickle_timer_consistency(&control_timer);
+  }
+
+discard:
+  uip_clear_buf();
+}
+/*---------------------------------------------------------------------------*/
+/* MPL Data Messages */
+/*---------------------------------------------------------------------------*/
+/* Returns the MPL Option of the datagram in uip_buf, or NULL */
+static uint8_t *
+option_lookup(void)
+{
+  uint8_t *opt;
+  uint8_t *end;
+
+  if(UIP_IP_BUF->proto != UIP_PROTO_HBHO ||
+     uip_len < UIP_IPH_LEN + (UIP_EXT_BUF->len << 3) + 8) {
+    return NULL;
+  }
+
+  opt = UIP_EXT_OPT_FIRST;
+  end = (uint8_t *)UIP_EXT_BUF + (UIP_EXT_BUF->len << 3) + 8;
+  while(opt < end) {
+    if(*opt == UIP_EXT_HDR_OPT_PAD1) {
+      opt++;
+      continue;
+    }
+    if(opt + 2 > end || opt + 2 + opt[1] > end) {
+      return NULL;
+    }
+    if(*opt == UIP_EXT_HDR_OPT_MPL) {
+      return opt[1] >= OPT_SEED_ID - 2 ? opt : NULL;
+    }
+    opt += opt[1] + 2;
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Processes an incoming or outgoing multicast message and determines
+ * whether it should be dropped or accepted
+ *
+ * \param in 1: Incoming packet, 0: Outgoing (we are the seed)
+ *
+ * \return 0: Drop, 1: Accept
+ */
+static uint8_t
+accept(uint8_t in)
+{
+  struct seed_id id;
+  struct seed *s;
+  struct mpl_msg *m;
+  uint8_t *opt;
+  uint8_t seq;
+  uint8_t newest;
+  uint8_t new_seed;
+
+#if UIP_CONF_IPV6_CHECKS
+  if(uip_is_addr_mcast_non_routable(&UIP_IP_BUF->destipaddr)) {
+    PRINTF("MPL: Mcast I/O, bad destination\n");
+    UIP_MCAST6_STATS_ADD(mcast_bad);
+    return UIP_MCAST6_DROP;
+  }
+  /*
+   * Abort transmission if the v6 src is unspecified. This may happen if the
+   * seed tries to TX while it's still performing DAD or waiting for a prefix
+   */
+  if(uip_is_addr_unspecified(&UIP_IP_BUF->srcipaddr)) {
+    PRINTF("MPL: Mcast I/O, bad source\n");
+    UIP_MCAST6_STATS_ADD(mcast_bad);
+    return UIP_MCAST6_DROP;
+  }
+#endif
+
+  opt = option_lookup();
+  if(opt == NULL || (opt[OPT_FLAGS] & OPT_V_BIT) ||
+     !seed_id_from_option(&id, opt)) {
+    PRINTF("MPL: Mcast I/O, bad MPL Option\n");
+    UIP_MCAST6_STATS_ADD(mcast_bad);
+    return UIP_MCAST6_DROP;
+  }
+  seq = opt[OPT_SEQ];
+
+#if UIP_MCAST6_STATS
+  if(in == MPL_DGRAM_IN) {
+    UIP_MCAST6_STATS_ADD(mcast_in_all);
+  }
+#endif
+
+  new_seed = 0;
+  s = seed_lookup(&id);
+  if(s != NULL) {
+    /* The newest message we know: buffer_reclaim() frees the oldest
+       first, so without a buffered message it is the one just before
+       the window */
+    m = msg_edge(s, 0);
+    newest = m != NULL ? m->seq : (uint8_t)(s->min_seqno - 1);
+    if(SEQ_VAL_IS_GT(seq, newest)) {
+      if((uint8_t)(seq - s->min_seqno) >= 0x80) {
+        window_reset(s, seq);
+      }
+    } else if(m == NULL ||
+              (uint8_t)(seq - s->min_seqno) > (uint8_t)(newest - s->min_seqno)) {
+      PRINTF("MPL: %u older than window at %u\n", seq, s->min_seqno);
+      UIP_MCAST6_STATS_ADD(mcast_dropped);
+      return UIP_MCAST6_DROP;
+    }
+    m = msg_lookup(s, seq);
+    if(m != NULL) {
+      PRINTF("MPL: Seen %u before\n", seq);
+      trickle_timer_consistency(&m->tt);
+      UIP_MCAST6_STATS_ADD(mcast_dropped);
+      return UIP_MCAST6_DROP;
+    }
+  } else {
+    s = seed_allocate();
+    if(s == NULL) {
+      PRINTF("MPL: Seed set full\n");
+      UIP_MCAST6_STATS_ADD(mcast_dropped);
+      return UIP_MCAST6_DROP;
+    }
+    seed_free(s);
+    memcpy(&s->id, &id, sizeof(id));
+    s->min_seqno = seq;
+    s->count = 0;
+    s->flags = SEED_U_BIT;
+    new_seed = 1;
+    PRINTF("MPL: New seed ");
+    PRINT_SEED(&s->id);
+    PRINTF("\n");
+  }
+
+  m = buffer_allocate();
+  if(m == NULL) {
+    m = buffer_reclaim();
+  }
+  if(m == NULL || SEQ_VAL_IS_LT(seq, s->min_seqno)) {
+    /* Nothing to reclaim, or the window moved past this message */
+    PRINTF("MPL: No buffer for %u\n", seq);
+    if(new_seed) {
+      s->flags = 0;
+    }
+    UIP_MCAST6_STATS_ADD(mcast_dropped);
+    return UIP_MCAST6_DROP;
+  }
+
+#if UIP_MCAST6_STATS
+  if(in == MPL_DGRAM_IN) {
+    UIP_MCAST6_STATS_ADD(mcast_in_unique);
+  }
+#endif
+
+  memcpy(m->buff, UIP_IP_BUF, uip_len);
+  m->buff_len = uip_len;
+  m->opt = opt - (uint8_t *)UIP_IP_BUF;
+  m->seq = seq;
+  m->seed = s;
+  m->e = 0;
+  m->flags = MSG_U_BIT;
+  s->count++;
+  s->lifetime = MPL_SEED_SET_ENTRY_LIFETIME;
+
+  /* Forwarders decrement the hop limit, the seed sends what it made */
+  if(in == MPL_DGRAM_IN && MSG_HOP_LIMIT(m) > 0) {
+    MSG_HOP_LIMIT(m)--;
+  }
+
+  PRINTF("MPL: Buffered %u of seed ", seq);
+  PRINT_SEED(&s->id);
+  PRINTF(", window [%u, %u] holds %u\n", s->min_seqno,
+         msg_edge(s, 0)->seq, s->count);
+
+  trickle_timer_config(&m->tt, MPL_DATA_MESSAGE_IMIN,
+                       MPL_DATA_MESSAGE_IMAX, MPL_DATA_MESSAGE_K);
+  trickle_timer_set(&m->tt, data_timer_expired, m);
+#if !MPL_PROACTIVE_FORWARDING
+  trickle_timer_stop(&m->tt);
+#endif
+
+  control_timer_reset();
+
+  return UIP_MCAST6_ACCEPT;
+}
+/*---------------------------------------------------------------------------*/
+static void
+out(void)
+{
+  uint8_t *opt;
+
+  if(uip_len + HBHO_TOTAL_LEN > UIP_BUFSIZE) {
+    PRINTF("MPL: Multicast Out can not add HBHO. Packet too long\n");
+    goto drop;
+  }
+
+  /* Slide 'right' by HBHO_TOTAL_LEN bytes */
+  memmove(UIP_EXT_BUF_NEXT, UIP_EXT_BUF, uip_len - UIP_IPH_LEN);
+  memset(UIP_EXT_BUF, 0, HBHO_TOTAL_LEN);
+
+  UIP_EXT_BUF->next = UIP_IP_BUF->proto;
+  UIP_EXT_BUF->len = 0;
+
+  /* We originate the largest sequence number there is, hence M */
+  opt = UIP_EXT_OPT_FIRST;
+  opt[0] = UIP_EXT_HDR_OPT_MPL;
+  opt[OPT_FLAGS] = (MPL_SEED_ID_TYPE << 6) | OPT_M_BIT;
+  opt[OPT_SEQ] = ++last_seq;
+#if MPL_SEED_ID_TYPE == SEED_ID_S16
+  opt[1] = OPT_SEED_ID - 2 + 2;
+  memcpy(&opt[OPT_SEED_ID], &uip_lladdr.addr[UIP_LLADDR_LEN - 2], 2);
+#elif MPL_SEED_ID_TYPE == SEED_ID_S0
+  opt[1] = OPT_SEED_ID - 2;
+  /* PadN */
+  opt[OPT_SEED_ID] = UIP_EXT_HDR_OPT_PADN;
+  opt[OPT_SEED_ID + 1] = 0;
+#else
+#error "MPL_CONF_SEED_ID_TYPE must be 0 or 1"
+#endif
+
+  uip_ext_len += HBHO_TOTAL_LEN;
+  uip_len += HBHO_TOTAL_LEN;
+
+  /* Update the proto and length field in the v6 header */
+  UIP_IP_BUF->proto = UIP_PROTO_HBHO;
+  UIP_IP_BUF->len[0] = ((uip_len - UIP_IPH_LEN) >> 8);
+  UIP_IP_BUF->len[1] = ((uip_len - UIP_IPH_LEN) & 0xff);
+
+  PRINTF("MPL: Multicast Out, seq %u\n", last_seq);
+
+  /*
+   * Buffer the message like one from another seed, so that the data
+   * message timer retransmits it and control messages advertise it.
+   * Send it once right away and set uip_len = 0 to stop the core from
+   * sending it again.
+   */
+  if(accept(MPL_DGRAM_OUT)) {
+    tcpip_output(NULL);
+    UIP_MCAST6_STATS_ADD(mcast_out);
+  }
+
+drop:
+  uip_slen = 0;
+  uip_clear_buf();
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+in(void)
+{
+  /*
+   * We call accept() which will sort out caching and forwarding. Depending
+   * on accept()'s return value, we then need to signal the core
+   * whether to deliver this to higher layers
+   */
+  if(accept(MPL_DGRAM_IN) == UIP_MCAST6_DROP) {
+    return UIP_MCAST6_DROP;
+  }
+
+  if(!uip_ds6_is_my_maddr(&UIP_IP_BUF->destipaddr)) {
+    PRINTF("MPL: Not a group member. No further processing\n");
+    return UIP_MCAST6_DROP;
+  } else {
+    PRINTF("MPL: Ours. Deliver to upper layers\n");
+    UIP_MCAST6_STATS_ADD(mcast_in_ours);
+    return UIP_MCAST6_ACCEPT;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+init(void)
+{
+  uip_ipaddr_t maddr;
+
+  PRINTF("MPL: RFC 7731, %u seeds, %u buffers\n",
+         MPL_SEED_SET_SIZE, MPL_BUFFER_SIZE);
+
+  memset(seeds, 0, sizeof(seeds));
+  memset(buffered_msgs, 0, sizeof(buffered_msgs));
+
+  MPL_STATS_INIT();
+  UIP_MCAST6_STATS_INIT(&stats);
+
+  /* Register the ICMPv6 input handler */
+  uip_icmp6_register_input_handler(&mpl_icmp_handler);
+
+  /* Control messages go to ff02::fc */
+  mpl_create_all_forwarders(&maddr, UIP_MCAST6_SCOPE_LINK_LOCAL);
+  if(uip_ds6_maddr_add(&maddr) == NULL) {
+    PRINTF("MPL: Can not join ALL_MPL_FORWARDERS\n");
+  }
+
+  /* Do not restart at a sequence number our neighbours may remember */
+  last_seq = random_rand();
+
+  /* The control timer runs only after a new message or inconsistency */
+  trickle_timer_config(&control_timer, MPL_CONTROL_MESSAGE_IMIN,
+                       MPL_CONTROL_MESSAGE_IMAX, MPL_CONTROL_MESSAGE_K);
+  trickle_timer_set(&control_timer, control_timer_expired, NULL);
+  trickle_timer_stop(&control_timer);
+
+  ctimer_set(&lifetime_timer, 60 * CLOCK_SECOND, lifetime_expired, NULL);
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief The MPL engine driver
+ */
+const struct uip_mcast6_driver mpl_driver = {
+  "MPL",
+  init,
+  out,
+  in,
+};
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \addtogroup uip6-multicast
+ * @{
+ */
+/**
+ * \defgroup mpl Multicast Protocol for Low-Power and Lossy Networks (MPL)
+ *
+ * IPv6 multicast according to RFC 7731. This is the successor of the
+ * draft implemented by \ref roll-tm.
+ *
+ * Every MPL forwarder keeps a sliding window of sequence numbers per
+ * MPL seed. All windows share one pool of buffered messages. A new
+ * message gets its own Trickle timer, which retransmits it a few times
+ * (proactive forwarding). A second Trickle timer advertises the
+ * contents of the windows in MPL Control Messages, and neighbours that
+ * miss a message answer by retransmitting it (reactive forwarding).
+ *
+ * All MPL forwarders forward every datagram that carries the MPL
+ * option, whatever its routable multicast destination. Seeds use one
+ * sequence space for all destinations, so the seed set does not keep
+ * the MPL domains apart.
+ *
+ * The engine joins ff02::fc, to which control messages go, and takes
+ * one entry of the multicast address list for it. Applications that
+ * want datagrams sent to the realm-local ALL_MPL_FORWARDERS address,
+ * ff03::fc, join it like any other group.
+ * @{
+ */
+/**
+ * \file
+ *    Header file for the implementation of the MPL multicast engine
+ */
+
+#ifndef MPL_H_
+#define MPL_H_
+
+#include "contiki-conf.h"
+#include "net/ipv6/multicast/uip-mcast6-stats.h"
+
+#include <stdint.h>
+/*---------------------------------------------------------------------------*/
+/* Protocol Constants */
+/*---------------------------------------------------------------------------*/
+#define MPL_ICMP_CODE                 0   /**< MPL Control Message code */
+#define MPL_IP_HOP_LIMIT           0xFF   /**< Hop limit for control messages */
+#define MPL_DGRAM_OUT                 0
+#define MPL_DGRAM_IN                  1
+
+/*
+ * Parameters of the two Trickle timers, as in section 5.4 of the RFC.
+ * Imin is in clock ticks and Imax in doublings of Imin; the trickle
+ * timer library needs at least one doubling and a K of at least 1.
+ * After the given number of expirations, a timer stops until the next
+ * inconsistency.
+ *
+ * The RFC suggests an Imin of ten times the expected link latency.
+ * As with ROLL TM, use a longer Imin over a duty-cycled MAC.
+ */
+#ifdef MPL_CONF_DATA_MESSAGE_IMIN
+#define MPL_DATA_MESSAGE_IMIN MPL_CONF_DATA_MESSAGE_IMIN
+#else
+#define MPL_DATA_MESSAGE_IMIN (CLOCK_SECOND / 4)
+#endif
+
+#ifdef MPL_CONF_DATA_MESSAGE_IMAX
+#define MPL_DATA_MESSAGE_IMAX MPL_CONF_DATA_MESSAGE_IMAX
+#else
+#define MPL_DATA_MESSAGE_IMAX 1 /* The RFC's Imax = Imin is not possible */
+#endif
+
+#ifdef MPL_CONF_DATA_MESSAGE_K
+#define MPL_DATA_MESSAGE_K MPL_CONF_DATA_MESSAGE_K
+#else
+#define MPL_DATA_MESSAGE_K 1
+#endif
+
+#ifdef MPL_CONF_DATA_MESSAGE_TIMER_EXPIRATIONS
+#define MPL_DATA_MESSAGE_TIMER_EXPIRATIONS MPL_CONF_DATA_MESSAGE_TIMER_EXPIRATIONS
+#else
+#define MPL_DATA_MESSAGE_TIMER_EXPIRATIONS 3
+#endif
+
+#ifdef MPL_CONF_CONTROL_MESSAGE_IMIN
+#define MPL_CONTROL_MESSAGE_IMIN MPL_CONF_CONTROL_MESSAGE_IMIN
+#else
+#define MPL_CONTROL_MESSAGE_IMIN (CLOCK_SECOND / 2)
+#endif
+
+#ifdef MPL_CONF_CONTROL_MESSAGE_IMAX
+#define MPL_CONTROL_MESSAGE_IMAX MPL_CONF_CONTROL_MESSAGE_IMAX
+#else
+#define MPL_CONTROL_MESSAGE_IMAX 9 /* Imax = 256 secs */
+#endif
+
+#ifdef MPL_CONF_CONTROL_MESSAGE_K
+#define MPL_CONTROL_MESSAGE_K MPL_CONF_CONTROL_MESSAGE_K
+#else
+#define MPL_CONTROL_MESSAGE_K 1
+#endif
+
+#ifdef MPL_CONF_CONTROL_MESSAGE_TIMER_EXPIRATIONS
+#define MPL_CONTROL_MESSAGE_TIMER_EXPIRATIONS MPL_CONF_CONTROL_MESSAGE_TIMER_EXPIRATIONS
+#else
+#define MPL_CONTROL_MESSAGE_TIMER_EXPIRATIONS 10
+#endif
+/*---------------------------------------------------------------------------*/
+/* Configuration */
+/*---------------------------------------------------------------------------*/
+/**
+ * Retransmit new messages on the data message Trickle timer. With 0,
+ * a forwarder only retransmits messages that a neighbour's MPL Control
+ * Message shows to be missing there. Reactive forwarding works either
+ * way unless MPL_CONTROL_MESSAGE_TIMER_EXPIRATIONS is 0.
+ */
+#ifdef MPL_CONF_PROACTIVE_FORWARDING
+#define MPL_PROACTIVE_FORWARDING MPL_CONF_PROACTIVE_FORWARDING
+#else
+#define MPL_PROACTIVE_FORWARDING 1
+#endif
+/*---------------------------------------------------------------------------*/
+/**
+ * Number of seeds we keep a sliding window for. A seed whose window is
+ * empty is forgotten MPL_SEED_SET_ENTRY_LIFETIME minutes after its
+ * last message, or earlier when the set is full
+ */
+#ifdef MPL_CONF_SEED_SET_SIZE
+#define MPL_SEED_SET_SIZE MPL_CONF_SEED_SET_SIZE
+#else
+#define MPL_SEED_SET_SIZE 2
+#endif
+
+#ifdef MPL_CONF_SEED_SET_ENTRY_LIFETIME
+#define MPL_SEED_SET_ENTRY_LIFETIME MPL_CONF_SEED_SET_ENTRY_LIFETIME
+#else
+#define MPL_SEED_SET_ENTRY_LIFETIME 30 /* Minutes */
+#endif
+/*---------------------------------------------------------------------------*/
+/**
+ * Maximum Number of Buffered Messages, shared across all seeds. When
+ * the pool is full, a new message takes the buffer of the oldest
+ * message of the seed with the largest window
+ */
+#ifdef MPL_CONF_BUFFER_SIZE
+#define MPL_BUFFER_SIZE MPL_CONF_BUFFER_SIZE
+#else
+#define MPL_BUFFER_SIZE 6
+#endif
+/*---------------------------------------------------------------------------*/
+/**
+ * Seed ID of the messages we originate: 0 for our IPv6 source address
+ * (elided from the MPL Option), 1 for the last two bytes of our
+ * link-layer address. We accept all four seed ID lengths in input
+ */
+#ifdef MPL_CONF_SEED_ID_TYPE
+#define MPL_SEED_ID_TYPE MPL_CONF_SEED_ID_TYPE
+#else
+#define MPL_SEED_ID_TYPE 0
+#endif
+/*---------------------------------------------------------------------------*/
+#if MPL_DATA_MESSAGE_IMAX < 1 || MPL_CONTROL_MESSAGE_IMAX < 1
+#error "MPL: The trickle timer library needs Imax of at least one doubling"
+#endif
+/*---------------------------------------------------------------------------*/
+/* Stats datatype */
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Multicast stats extension for the MPL engine
+ */
+struct mpl_stats {
+  /** Number of received MPL Control Messages */
+  UIP_MCAST6_STATS_DATATYPE icmp_in;
+
+  /** Number of MPL Control Messages sent */
+  UIP_MCAST6_STATS_DATATYPE icmp_out;
+
+  /** Number of malformed MPL Control Messages seen by us */
+  UIP_MCAST6_STATS_DATATYPE icmp_bad;
+
+  /** Number of retransmissions on a proactive data message timer */
+  UIP_MCAST6_STATS_DATATYPE data_proactive;
+
+  /** Number of retransmissions after a neighbour's control message */
+  UIP_MCAST6_STATS_DATATYPE data_reactive;
+
+  /** Number of buffered messages reclaimed for a new one */
+  UIP_MCAST6_STATS_DATATYPE buffer_reclaim;
+};
+/*---------------------------------------------------------------------------*/
+#endif /* MPL_H_ */
+/*---------------------------------------------------------------------------*/
+/** @} */
+/** @} */
@@ -51,6 +51,7 @@
 #define UIP_MCAST6_ENGINE_SMRF        1 /**< The SMRF engine */
 #define UIP_MCAST6_ENGINE_ROLL_TM     2 /**< The ROLL TM engine */
 #define UIP_MCAST6_ENGINE_ESMRF       3 /**< The ESMRF engine */
+#define UIP_MCAST6_ENGINE_MPL         4 /**< The MPL engine */
 
 #endif /* UIP_MCAST6_ENGINES_H_ */
 /** @} */
@@ -43,6 +43,8 @@
  *   - 'Multicast Forwarding with Trickle' according to the algorithm described
  *     in the internet draft:
  *     http://tools.ietf.org/html/draft-ietf-roll-trickle-mcast
+ *   - 'Multicast Protocol for Low-Power and Lossy Networks' (MPL), the
+ *     successor of that draft, according to RFC 7731
  *
  * @{
  */
@@ -65,6 +67,7 @@
 #include "net/ipv6/multicast/smrf.h"
 #include "net/ipv6/multicast/esmrf.h"
 #include "net/ipv6/multicast/roll-tm.h"
+#include "net/ipv6/multicast/mpl.h"
 
 #include <string.h>
 /*---------------------------------------------------------------------------*/
@@ -165,6 +168,12 @@ struct uip_mcast6_driver {
 #define RPL_WITH_MULTICAST     1
 #define UIP_MCAST6             esmrf_driver
 
+#elif UIP_MCAST6_ENGINE == UIP_MCAST6_ENGINE_MPL
+#define RPL_WITH_MULTICAST     0        /* Not used by MPL */
+#define UIP_CONF_IPV6_MPL      1        /* MPL HBH option support */
+
+#define UIP_MCAST6             mpl_driver
+
 #else
 #error "Multicast Enabled with an Unknown Engine."
 #error "Check the value of UIP_MCAST6_CONF_ENGINE in conf files."
@@ -66,6 +66,7 @@
 #include "net/ip/tcpip.h"
 #include "net/ip/uip.h"
 #include "net/ipv6/uip-ds6.h"
+#include "net/ip/uip-packetqueue.h"
 #include "net/rime/rime.h"
 #include "net/ipv6/sicslowpan.h"
 #include "net/netstack.h"
@@ -291,6 +292,44 @@ struct sicslowpan_frag_buf {
 
 static struct sicslowpan_frag_buf frag_buf[SICSLOWPAN_FRAGMENT_BUFFERS];
 
+#if SICSLOWPAN_FRAG_FORWARDING
+/* The number of datagrams that can be relayed at the same time */
+#ifdef SICSLOWPAN_CONF_FRAG_FWD_ENTRIES
+#define SICSLOWPAN_FRAG_FWD_ENTRIES SICSLOWPAN_CONF_FRAG_FWD_ENTRIES
+#else
+#define SICSLOWPAN_FRAG_FWD_ENTRIES 4
+#endif
+
+/* A switching entry: where the fragments of one datagram go */
+struct sicslowpan_frag_fwd {
+  /** The previous hop and its tag for the datagram */
+  linkaddr_t sender;
+  uint16_t tag;
+  /** The next hop and our tag for the datagram */
+  linkaddr_t next_hop;
+  uint16_t out_tag;
+  /** Total length of the datagram (zero if the entry is free) */
+  uint16_t len;
+  /** Bytes of the datagram relayed so far */
+  uint16_t relayed_len;
+  struct timer lifetime;
+};
+
+static struct sicslowpan_frag_fwd frag_fwd[SICSLOWPAN_FRAG_FWD_ENTRIES];
+
+struct sicslowpan_frag_fwd_stats sicslowpan_frag_fwd_stats;
+
+/* The first fragment that the IP layer is currently routing */
+static struct {
+  struct sicslowpan_frag_fwd *entry;
+  uip_ipaddr_t srcipaddr;
+  uip_ipaddr_t destipaddr;
+  uint16_t first_frag_len;
+  uint16_t len;
+  enum { FWD_PENDING, FWD_RELAYED, FWD_REASSEMBLE } state;
+} fwd_first;
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+
 /*---------------------------------------------------------------------------*/
 static int
 clear_fragments(uint8_t frag_info_index)
@@ -507,6 +546,33 @@ static struct sicslowpan_addr_context *context;
 /** pointer to the byte where to write next inline field. */
 static uint8_t *hc06_ptr;
 
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+/* The longest IPHC header without the UDP checksum: dispatch and
+   context bytes, traffic class and flow label, next header, hop limit,
+   two full addresses and uncompressed ports */
+#define IPHC_TEMPLATE_LEN 46
+
+/* A compressed header and the fields it was compressed from */
+struct sicslowpan_iphc_template {
+  /** Version, traffic class and flow label */
+  uint8_t vtcflow[4];
+  uint8_t proto;
+  uint8_t ttl;
+  /** Source and destination address */
+  uint8_t addrs[2 * sizeof(uip_ipaddr_t)];
+  /** UDP source and destination port */
+  uint16_t ports[2];
+  linkaddr_t link_dest;
+  /** Length of hdr, zero if the template is unused */
+  uint8_t len;
+  uint8_t hdr[IPHC_TEMPLATE_LEN];
+};
+
+static struct sicslowpan_iphc_template iphc_cache[SICSLOWPAN_IPHC_CACHE_SIZE];
+
+struct sicslowpan_iphc_cache_stats sicslowpan_iphc_cache_stats;
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+
 /* Uncompression of linklocal */
 /*   0 -> 16 bytes from packet  */
 /*   1 -> 2 bytes from prefix - bunch of zeroes and 8 from packet */
@@ -634,6 +700,58 @@ uncompress_addr(uip_ipaddr_t *ipaddr, uint8_t const prefix[],
   PRINTF("\n");
 }
 
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+/*--------------------------------------------------------------------*/
+static struct sicslowpan_iphc_template *
+iphc_template_for(void)
+{
+  uint32_t h;
+
+  /* Multiplicative hash of the end of the destination and the ports */
+  h = ((uint32_t)UIP_IP_BUF->destipaddr.u8[14] << 8) |
+    UIP_IP_BUF->destipaddr.u8[15];
+  if(UIP_IP_BUF->proto == UIP_PROTO_UDP) {
+    h ^= ((uint32_t)UIP_UDP_BUF->srcport << 16) ^ UIP_UDP_BUF->destport;
+  }
+  h *= 2654435761UL;
+  return &iphc_cache[(h >> 16) % SICSLOWPAN_IPHC_CACHE_SIZE];
+}
+/*--------------------------------------------------------------------*/
+static void
+iphc_template_key(struct sicslowpan_iphc_template *t,
+                  const linkaddr_t *link_destaddr)
+{
+  memcpy(t->vtcflow, &UIP_IP_BUF->vtc, sizeof(t->vtcflow));
+  t->proto = UIP_IP_BUF->proto;
+  t->ttl = UIP_IP_BUF->ttl;
+  memcpy(t->addrs, &UIP_IP_BUF->srcipaddr, sizeof(t->addrs));
+  if(t->proto == UIP_PROTO_UDP) {
+    t->ports[0] = UIP_UDP_BUF->srcport;
+    t->ports[1] = UIP_UDP_BUF->destport;
+  } else {
+    t->ports[0] = t->ports[1] = 0;
+  }
+  linkaddr_copy(&t->link_dest, link_destaddr);
+}
+/*--------------------------------------------------------------------*/
+static int
+iphc_template_matches(const struct sicslowpan_iphc_template *t,
+                      const linkaddr_t *link_destaddr)
+{
+  /* The end of the destination differs most often, compare it first */
+  return t->len > 0 &&
+    t->proto == UIP_IP_BUF->proto &&
+    t->ttl == UIP_IP_BUF->ttl &&
+    memcmp(&t->addrs[sizeof(uip_ipaddr_t)], &UIP_IP_BUF->destipaddr,
+           sizeof(uip_ipaddr_t)) == 0 &&
+    (t->proto != UIP_PROTO_UDP ||
+     (t->ports[0] == UIP_UDP_BUF->srcport &&
+      t->ports[1] == UIP_UDP_BUF->destport)) &&
+    memcmp(t->addrs, &UIP_IP_BUF->srcipaddr, sizeof(uip_ipaddr_t)) == 0 &&
+    memcmp(t->vtcflow, &UIP_IP_BUF->vtc, sizeof(t->vtcflow)) == 0 &&
+    linkaddr_cmp(&t->link_dest, link_destaddr);
+}
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
 /*--------------------------------------------------------------------*/
 /**
  * \brief Compress IP/UDP header
@@ -673,6 +791,9 @@ static void
 compress_hdr_iphc(linkaddr_t *link_destaddr)
 {
   uint8_t tmp, iphc0, iphc1;
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  struct sicslowpan_iphc_template *template;
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
 #if DEBUG
   { uint16_t ndx;
     PRINTF("before compression (%d): ", UIP_IP_BUF->len[1]);
@@ -684,6 +805,24 @@ compress_hdr_iphc(linkaddr_t *link_destaddr)
   }
 #endif
 
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  template = iphc_template_for();
+  if(iphc_template_matches(template, link_destaddr)) {
+    memcpy(packetbuf_ptr, template->hdr, template->len);
+    hc06_ptr = packetbuf_ptr + template->len;
+    uncomp_hdr_len = UIP_IPH_LEN;
+    if(UIP_IP_BUF->proto == UIP_PROTO_UDP) {
+      memcpy(hc06_ptr, &UIP_UDP_BUF->udpchksum, 2);
+      hc06_ptr += 2;
+      uncomp_hdr_len += UIP_UDPH_LEN;
+    }
+    packetbuf_hdr_len = hc06_ptr - packetbuf_ptr;
+    sicslowpan_iphc_cache_stats.hits++;
+    return;
+  }
+  sicslowpan_iphc_cache_stats.misses++;
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+
   hc06_ptr = packetbuf_ptr + 2;
   /*
    * As we copy some bit-length fields, in the IPHC encoding bytes,
@@ -936,6 +1075,19 @@ compress_hdr_iphc(linkaddr_t *link_destaddr)
   PACKETBUF_IPHC_BUF[1] = iphc1;
 
   packetbuf_hdr_len = hc06_ptr - packetbuf_ptr;
+
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  /* Keep the header up to the UDP checksum for the next packets */
+  tmp = packetbuf_hdr_len;
+  if(UIP_IP_BUF->proto == UIP_PROTO_UDP) {
+    tmp -= 2;
+  }
+  if(tmp <= IPHC_TEMPLATE_LEN) {
+    iphc_template_key(template, link_destaddr);
+    memcpy(template->hdr, packetbuf_ptr, tmp);
+    template->len = tmp;
+  }
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
   return;
 }
 
@@ -1265,6 +1417,299 @@ send_packet(linkaddr_t *dest)
      watchdog know that we are still alive. */
   watchdog_periodic();
 }
+#if SICSLOWPAN_FRAG_FORWARDING
+/*--------------------------------------------------------------------*/
+/** \name Fragment forwarding
+ * @{                                                                 */
+/*--------------------------------------------------------------------*/
+static struct sicslowpan_frag_fwd *
+frag_fwd_alloc(void)
+{
+  struct sicslowpan_frag_fwd *e;
+  struct sicslowpan_frag_fwd *found = NULL;
+
+  for(e = frag_fwd; e < &frag_fwd[SICSLOWPAN_FRAG_FWD_ENTRIES]; e++) {
+    if(e->len > 0 && timer_expired(&e->lifetime)) {
+      e->len = 0;
+      sicslowpan_frag_fwd_stats.expired++;
+    }
+    if(found == NULL && e->len == 0) {
+      found = e;
+    }
+  }
+  return found;
+}
+/*--------------------------------------------------------------------*/
+static struct sicslowpan_frag_fwd *
+frag_fwd_lookup(uint16_t tag, uint16_t len)
+{
+  struct sicslowpan_frag_fwd *e;
+
+  for(e = frag_fwd; e < &frag_fwd[SICSLOWPAN_FRAG_FWD_ENTRIES]; e++) {
+    if(e->len == len && e->tag == tag &&
+       linkaddr_cmp(&e->sender, packetbuf_addr(PACKETBUF_ADDR_SENDER))) {
+      if(timer_expired(&e->lifetime)) {
+        e->len = 0;
+        sicslowpan_frag_fwd_stats.expired++;
+        return NULL;
+      }
+      return e;
+    }
+  }
+  return NULL;
+}
+/*--------------------------------------------------------------------*/
+/*
+ * Whether the IP layer sends a datagram to dest through output(). With
+ * neither an on-link destination, a route nor a default router, it
+ * hands the datagram to the fallback interface, e.g. the SLIP link of
+ * a border router, which must get the whole datagram.
+ */
+static int
+frag_fwd_has_next_hop(uip_ipaddr_t *dest)
+{
+#if ORPL_ENABLED
+  /* Anything not on-link goes to the anycast address */
+  return 1;
+#else /* ORPL_ENABLED */
+  return uip_ds6_is_addr_onlink(dest) ||
+         uip_ds6_route_lookup(dest) != NULL ||
+         uip_ds6_defrt_choose() != NULL;
+#endif /* ORPL_ENABLED */
+}
+/*--------------------------------------------------------------------*/
+/**
+ * \brief Offer the first fragment of a datagram for another node to
+ * the IP layer
+ * \param context The reassembly context that holds the fragment
+ * \param tag The tag of the sender for the datagram
+ * \param len The length of the datagram
+ * \return 1 if the datagram was relayed or dropped, 0 if it must be
+ * reassembled
+ *
+ * The IP layer sees a datagram that ends with the first fragment. If
+ * it routes the datagram, output() sends the fragment with a tag of
+ * our own and sets up a switching entry for the following fragments.
+ */
+static int
+frag_fwd_first(int8_t context, uint16_t tag, uint16_t len)
+{
+  struct sicslowpan_frag_info *info = &frag_info[context];
+  struct uip_ip_hdr *ip = SICSLOWPAN_IP_BUF(info->first_frag);
+  struct sicslowpan_frag_fwd *e;
+  uint16_t payload_len;
+#if UIP_CONF_IPV6_QUEUE_PKT
+  struct uip_packetqueue_packet *queued;
+#endif /* UIP_CONF_IPV6_QUEUE_PKT */
+
+  if(info->first_frag_len >= len ||
+     uip_is_addr_mcast(&ip->destipaddr) ||
+     uip_ds6_is_my_addr(&ip->destipaddr)) {
+    return 0;
+  }
+
+  if(!frag_fwd_has_next_hop(&ip->destipaddr)) {
+    sicslowpan_frag_fwd_stats.no_route++;
+    return 0;
+  }
+
+  e = frag_fwd_alloc();
+  if(e == NULL) {
+    sicslowpan_frag_fwd_stats.no_entry++;
+    return 0;
+  }
+  linkaddr_copy(&e->sender, packetbuf_addr(PACKETBUF_ADDR_SENDER));
+  e->tag = tag;
+
+  memcpy(UIP_IP_BUF, info->first_frag, info->first_frag_len);
+  payload_len = info->first_frag_len - UIP_IPH_LEN;
+  UIP_IP_BUF->len[0] = payload_len >> 8;
+  UIP_IP_BUF->len[1] = payload_len & 0xff;
+  uip_len = info->first_frag_len;
+
+  fwd_first.entry = e;
+  uip_ipaddr_copy(&fwd_first.srcipaddr, &ip->srcipaddr);
+  uip_ipaddr_copy(&fwd_first.destipaddr, &ip->destipaddr);
+  fwd_first.first_frag_len = info->first_frag_len;
+  fwd_first.len = len;
+  fwd_first.state = FWD_PENDING;
+#if UIP_CONF_IPV6_QUEUE_PKT
+  queued = uip_packetqueue_last();
+#endif /* UIP_CONF_IPV6_QUEUE_PKT */
+  tcpip_input();
+  fwd_first.entry = NULL;
+
+#if UIP_CONF_IPV6_QUEUE_PKT
+  if(fwd_first.state == FWD_PENDING &&
+     uip_packetqueue_last() != queued && uip_packetqueue_last() != NULL) {
+    /* The IP layer queued the datagram for address resolution, but it
+       only has the first fragment: drop that copy and queue the
+       reassembled datagram instead */
+    queued = uip_packetqueue_last();
+    if(queued->queue_buf_len == info->first_frag_len &&
+       uip_ipaddr_cmp(&((struct uip_ip_hdr *)queued->queue_buf)->srcipaddr,
+                      &ip->srcipaddr)) {
+      uip_packetqueue_remove(queued);
+      fwd_first.state = FWD_REASSEMBLE;
+    }
+  }
+#endif /* UIP_CONF_IPV6_QUEUE_PKT */
+
+  switch(fwd_first.state) {
+  case FWD_RELAYED:
+    clear_fragments(context);
+    return 1;
+  case FWD_REASSEMBLE:
+    sicslowpan_frag_fwd_stats.reassembled++;
+    return 0;
+  default:
+    /* No route, or the hop limit ran out */
+    sicslowpan_frag_fwd_stats.dropped++;
+    clear_fragments(context);
+    return 1;
+  }
+}
+/*--------------------------------------------------------------------*/
+/**
+ * \brief Check whether uip_buf holds the datagram that
+ * frag_fwd_first() passed to the IP layer
+ *
+ * Until that datagram is sent, packetbuf still holds its first
+ * fragment as we received it. Other datagrams that the IP layer sends
+ * meanwhile, such as an ICMP error or packets that waited for the
+ * same neighbor, do not match.
+ */
+static int
+frag_fwd_match(void)
+{
+  struct sicslowpan_frag_fwd *e = fwd_first.entry;
+
+  return e != NULL && fwd_first.state == FWD_PENDING &&
+         linkaddr_cmp(&e->sender, packetbuf_addr(PACKETBUF_ADDR_SENDER)) &&
+         packetbuf_datalen() >= SICSLOWPAN_FRAG1_HDR_LEN &&
+         ((GET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE) & 0xf800) >> 8) ==
+         SICSLOWPAN_DISPATCH_FRAG1 &&
+         GET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_TAG) == e->tag &&
+         uip_ipaddr_cmp(&UIP_IP_BUF->srcipaddr, &fwd_first.srcipaddr) &&
+         uip_ipaddr_cmp(&UIP_IP_BUF->destipaddr, &fwd_first.destipaddr);
+}
+/*--------------------------------------------------------------------*/
+/**
+ * \brief Send the first fragment of a datagram that we relay
+ * \param dest The next hop
+ * \param max_payload The room for 6lowpan headers and payload
+ * \return 1 if the fragment was sent
+ *
+ * The header in uip_buf is already compressed into packetbuf. The
+ * fragment ends where the next fragment of the sender starts; if our
+ * compressed header is larger than the one we received, the excess
+ * goes into a FRAGN of its own.
+ */
+static uint8_t
+frag_fwd_output(linkaddr_t *dest, int max_payload)
+{
+  struct sicslowpan_frag_fwd *e = fwd_first.entry;
+  struct queuebuf *q;
+  uint16_t frag_end;
+  uint8_t fragments;
+
+  memmove(packetbuf_ptr + SICSLOWPAN_FRAG1_HDR_LEN, packetbuf_ptr, packetbuf_hdr_len);
+  packetbuf_hdr_len += SICSLOWPAN_FRAG1_HDR_LEN;
+  SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE,
+        ((SICSLOWPAN_DISPATCH_FRAG1 << 8) | fwd_first.len));
+  e->out_tag = my_tag++;
+  SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_TAG, e->out_tag);
+
+  frag_end = uip_len;
+  if(frag_end - uncomp_hdr_len > max_payload - packetbuf_hdr_len) {
+    frag_end = (uncomp_hdr_len + max_payload - packetbuf_hdr_len) & 0xfff8;
+  }
+  memcpy(packetbuf_ptr + packetbuf_hdr_len,
+         (uint8_t *)UIP_IP_BUF + uncomp_hdr_len, frag_end - uncomp_hdr_len);
+  packetbuf_set_datalen(frag_end - uncomp_hdr_len + packetbuf_hdr_len);
+
+  last_tx_status = MAC_TX_OK;
+  fragments = 1;
+  if(frag_end < uip_len) {
+    q = queuebuf_new_from_packetbuf();
+    if(q == NULL) {
+      PRINTFO("could not allocate queuebuf for first fragment, dropping packet\n");
+      return 0;
+    }
+    send_packet(dest);
+    queuebuf_to_packetbuf(q);
+    queuebuf_free(q);
+    if((last_tx_status == MAC_TX_COLLISION) ||
+       (last_tx_status == MAC_TX_ERR) ||
+       (last_tx_status == MAC_TX_ERR_FATAL)) {
+      return 0;
+    }
+
+    packetbuf_hdr_len = SICSLOWPAN_FRAGN_HDR_LEN;
+    SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE,
+          ((SICSLOWPAN_DISPATCH_FRAGN << 8) | fwd_first.len));
+    PACKETBUF_FRAG_PTR[PACKETBUF_FRAG_OFFSET] = frag_end >> 3;
+    memcpy(packetbuf_ptr + packetbuf_hdr_len,
+           (uint8_t *)UIP_IP_BUF + frag_end, uip_len - frag_end);
+    packetbuf_set_datalen(uip_len - frag_end + packetbuf_hdr_len);
+    fragments++;
+  }
+  send_packet(dest);
+  if((last_tx_status == MAC_TX_COLLISION) ||
+     (last_tx_status == MAC_TX_ERR) ||
+     (last_tx_status == MAC_TX_ERR_FATAL)) {
+    return 0;
+  }
+
+  PRINTFO("sicslowpan output: relaying datagram len %u, tag %u -> %u\n",
+          fwd_first.len, e->tag, e->out_tag);
+  linkaddr_copy(&e->next_hop, dest);
+  e->len = fwd_first.len;
+  e->relayed_len = uip_len;
+  timer_set(&e->lifetime, SICSLOWPAN_REASS_MAXAGE * CLOCK_SECOND / 16);
+  fwd_first.state = FWD_RELAYED;
+  sicslowpan_frag_fwd_stats.datagrams++;
+  sicslowpan_frag_fwd_stats.fragments += fragments;
+  return 1;
+}
+/*--------------------------------------------------------------------*/
+/**
+ * \brief Relay a subsequent fragment in packetbuf
+ * \param tag The tag of the sender for the datagram
+ * \param len The length of the datagram
+ * \return 0 if the fragment belongs to no switching entry
+ */
+static int
+frag_fwd_relay(uint16_t tag, uint16_t len)
+{
+  struct sicslowpan_frag_fwd *e;
+  linkaddr_t next_hop;
+  uint8_t *frame;
+  uint16_t frame_len;
+
+  e = frag_fwd_lookup(tag, len);
+  if(e == NULL) {
+    return 0;
+  }
+  linkaddr_copy(&next_hop, &e->next_hop);
+  SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_TAG, e->out_tag);
+  e->relayed_len += packetbuf_datalen() - SICSLOWPAN_FRAGN_HDR_LEN;
+  if(e->relayed_len >= e->len) {
+    e->len = 0;
+  }
+
+  /* Send the frame as it is, without the attributes of its reception */
+  frame = packetbuf_dataptr();
+  frame_len = packetbuf_datalen();
+  packetbuf_clear();
+  memmove(packetbuf_dataptr(), frame, frame_len);
+  packetbuf_set_datalen(frame_len);
+  send_packet(&next_hop);
+  sicslowpan_frag_fwd_stats.fragments++;
+  return 1;
+}
+/** @} */
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
 /*--------------------------------------------------------------------*/
 /** \brief Take an IP packet and format it to be sent on an 802.15.4
  *  network using 6lowpan.
@@ -1284,6 +1729,22 @@ output(const uip_lladdr_t *localdest)
   /* The MAC address of the destination of the packet */
   linkaddr_t dest;
 
+#if SICSLOWPAN_FRAG_FORWARDING
+  uint8_t relay = 0;
+
+  if(frag_fwd_match()) {
+    if(uip_len != fwd_first.first_frag_len) {
+      /* The IP layer changed the length of the headers, so the
+         offsets in the following fragments would be wrong */
+      fwd_first.state = FWD_REASSEMBLE;
+      return 0;
+    }
+    UIP_IP_BUF->len[0] = (fwd_first.len - UIP_IPH_LEN) >> 8;
+    UIP_IP_BUF->len[1] = (fwd_first.len - UIP_IPH_LEN) & 0xff;
+    relay = 1;
+  }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+
   /* init */
   uncomp_hdr_len = 0;
   packetbuf_hdr_len = 0;
@@ -1363,6 +1824,11 @@ output(const uip_lladdr_t *localdest)
 #endif /* USE_FRAMER_HDRLEN */
 
   max_payload = MAC_MAX_PAYLOAD - framer_hdrlen;
+#if SICSLOWPAN_FRAG_FORWARDING
+  if(relay) {
+    return frag_fwd_output(&dest, max_payload);
+  }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
   if((int)uip_len - (int)uncomp_hdr_len > max_payload - (int)packetbuf_hdr_len) {
 #if SICSLOWPAN_CONF_FRAG
     /* Number of bytes processed. */
@@ -1589,6 +2055,12 @@ input(void)
              frag_size, frag_tag, frag_offset);
       packetbuf_hdr_len += SICSLOWPAN_FRAGN_HDR_LEN;
 
+#if SICSLOWPAN_FRAG_FORWARDING
+      if(frag_fwd_relay(frag_tag, frag_size)) {
+        return;
+      }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+
       /* If this is the last fragment, we may shave off any extrenous
          bytes at the end. We must be liberal in what we accept. */
       PRINTFI("last_fragment?: packetbuf_payload_len %d frag_size %d\n",
@@ -1691,6 +2163,11 @@ input(void)
     if(first_fragment != 0) {
       frag_info[frag_context].reassembled_len = uncomp_hdr_len + packetbuf_payload_len;
       frag_info[frag_context].first_frag_len = uncomp_hdr_len + packetbuf_payload_len;
+#if SICSLOWPAN_FRAG_FORWARDING
+      if(frag_fwd_first(frag_context, frag_tag, frag_size)) {
+        return;
+      }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
     }
     /* For the last fragment, we are OK if there is extrenous bytes at
        the end of the packet. */
@@ -319,6 +319,66 @@ struct sicslowpan_nh_compressor {
 
 };
 
+/**
+ * With fragment forwarding, a router relays the fragments of a
+ * datagram that is not addressed to it one by one, as they arrive,
+ * instead of reassembling the datagram first. The first fragment goes
+ * through the IP layer, which picks the next hop; a switching entry
+ * then maps the tag of the sender to a new tag towards the next hop
+ * for the following fragments.
+ */
+#ifdef SICSLOWPAN_CONF_FRAG_FORWARDING
+#define SICSLOWPAN_FRAG_FORWARDING SICSLOWPAN_CONF_FRAG_FORWARDING
+#else
+#define SICSLOWPAN_FRAG_FORWARDING 0
+#endif
+
+#if SICSLOWPAN_FRAG_FORWARDING
+struct sicslowpan_frag_fwd_stats {
+  /** Datagrams relayed fragment by fragment */
+  uint32_t datagrams;
+  /** Fragments relayed, including the first ones */
+  uint32_t fragments;
+  /** Datagrams reassembled since no switching entry was free */
+  uint32_t no_entry;
+  /** Datagrams reassembled since the IP layer changed their header
+      length or queued them for address resolution */
+  uint32_t reassembled;
+  /** Datagrams reassembled since they had no next hop in the mesh */
+  uint32_t no_route;
+  /** Datagrams that the IP layer did not forward */
+  uint32_t dropped;
+  /** Switching entries that timed out before the last fragment */
+  uint32_t expired;
+};
+
+extern struct sicslowpan_frag_fwd_stats sicslowpan_frag_fwd_stats;
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+
+/**
+ * The IPHC header of a packet only depends on its addresses, next
+ * header, ports, traffic class, flow label and hop limit, and on the
+ * link-layer destination. A cache of compressed headers for recent
+ * flows lets the following packets of a flow copy the header and only
+ * fill in the UDP checksum.
+ */
+#ifdef SICSLOWPAN_CONF_IPHC_CACHE_SIZE
+#define SICSLOWPAN_IPHC_CACHE_SIZE SICSLOWPAN_CONF_IPHC_CACHE_SIZE
+#else
+#define SICSLOWPAN_IPHC_CACHE_SIZE 0
+#endif
+
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+struct sicslowpan_iphc_cache_stats {
+  /** Headers copied from the cache */
+  uint32_t hits;
+  /** Headers compressed field by field */
+  uint32_t misses;
+};
+
+extern struct sicslowpan_iphc_cache_stats sicslowpan_iphc_cache_stats;
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+
 int sicslowpan_get_last_rssi(void);
 
 extern const struct network_driver sicslowpan_driver;
@@ -84,8 +84,20 @@ uip_ds6_nbr_add(const uip_ipaddr_t *ipaddr, const uip_lladdr_t *lladdr,
                 uint8_t isrouter, uint8_t state, nbr_table_reason_t reason,
                 void *data)
 {
-  uip_ds6_nbr_t *nbr = nbr_table_add_lladdr(ds6_neighbors, (linkaddr_t*)lladdr
-                                            , reason, data);
+  uip_ds6_nbr_t *nbr;
+
+#if UIP_CONF_IPV6_QUEUE_PKT
+  /* An entry with the same lladdr, e.g. the one entry without lladdr
+     that address resolution uses, is reinitialized below: free the
+     packets it queued first */
+  nbr = nbr_table_get_from_lladdr(ds6_neighbors, lladdr != NULL ?
+                                  (linkaddr_t *)lladdr : &linkaddr_null);
+  if(nbr != NULL) {
+    uip_packetqueue_free(&nbr->packethandle);
+  }
+#endif /* UIP_CONF_IPV6_QUEUE_PKT */
+  nbr = nbr_table_add_lladdr(ds6_neighbors, (linkaddr_t*)lladdr
+                             , reason, data);
   if(nbr) {
     uip_ipaddr_copy(&nbr->ipaddr, ipaddr);
 #if UIP_ND6_SEND_RA || !UIP_CONF_ROUTER
@@ -111,6 +123,7 @@ uip_ds6_nbr_add(const uip_ipaddr_t *ipaddr, const uip_lladdr_t *lladdr,
     PRINTLLADDR(lladdr);
     PRINTF(" state %u\n", state);
     NEIGHBOR_STATE_CHANGED(nbr);
+    UIP_DS6_TABLES_CHANGED();
     return nbr;
   } else {
     PRINTF("uip_ds6_nbr_add drop ip addr ");
@@ -131,6 +144,7 @@ uip_ds6_nbr_rm(uip_ds6_nbr_t *nbr)
     uip_packetqueue_free(&nbr->packethandle);
 #endif /* UIP_CONF_IPV6_QUEUE_PKT */
     NEIGHBOR_STATE_CHANGED(nbr);
+    UIP_DS6_TABLES_CHANGED();
     return nbr_table_remove(ds6_neighbors, nbr);
   }
   return 0;
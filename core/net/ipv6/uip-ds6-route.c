@@ -69,12 +69,31 @@ MEMB(neighborroutememb, struct uip_ds6_route_neighbor_route, UIP_DS6_ROUTE_NB);
 /* Each route is repressented by a uip_ds6_route_t structure and
    memory for each route is allocated from the routememb memory
    block. These routes are maintained on the routelist. */
+#if UIP_DS6_ROUTE_WITH_DLIST
+DLIST(routelist);
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
 LIST(routelist);
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
 MEMB(routememb, uip_ds6_route_t, UIP_DS6_ROUTE_NB);
 
 static int num_routes = 0;
 static void rm_routelist_callback(nbr_table_item_t *ptr);
 
+#if UIP_DS6_ROUTE_WITH_LPM
+#if UIP_DS6_ROUTE_LPM_SIZE <= UIP_DS6_ROUTE_NB
+#error "UIP_DS6_ROUTE_LPM_SIZE must be larger than UIP_CONF_MAX_ROUTES"
+#endif
+/* Prefix index over the routes, using linear probing. Each slot holds
+   the index of the route in routememb plus one, so that zero marks an
+   empty slot. */
+static uint16_t lpm_slots[UIP_DS6_ROUTE_LPM_SIZE];
+/* The prefix lengths in use, longest first, and the number of routes
+   with each of them */
+static uint8_t lpm_lengths[UIP_DS6_ROUTE_LPM_LENGTHS];
+static uint16_t lpm_length_routes[UIP_DS6_ROUTE_LPM_LENGTHS];
+static uint8_t lpm_num_lengths;
+#endif /* UIP_DS6_ROUTE_WITH_LPM */
+
 #endif /* (UIP_CONF_MAX_ROUTES != 0) */
 
 /* Default routes are held on the defaultrouterlist and their
@@ -119,6 +138,144 @@ assert_nbr_routes_list_sane(void)
 }
 #endif /* DEBUG != DEBUG_NONE */
 /*---------------------------------------------------------------------------*/
+#if UIP_DS6_ROUTE_WITH_LPM
+static uip_ds6_route_t *
+lpm_route(uint16_t slot)
+{
+  return &((uip_ds6_route_t *)routememb.mem)[lpm_slots[slot] - 1];
+}
+/*---------------------------------------------------------------------------*/
+/* Hash the prefix of the given length. Like uip_ipaddr_prefixcmp(),
+   only the whole bytes of the prefix count. */
+static uint16_t
+lpm_hash(const uip_ipaddr_t *addr, uint8_t length)
+{
+  uint32_t h;
+  int i;
+
+  /* FNV-1a */
+  h = (2166136261UL ^ length) * 16777619UL;
+  for(i = 0; i < (length >> 3); i++) {
+    h = (h ^ addr->u8[i]) * 16777619UL;
+  }
+  return h % UIP_DS6_ROUTE_LPM_SIZE;
+}
+/*---------------------------------------------------------------------------*/
+/* Count a route with the given prefix length. Returns zero if there
+   is no room for another length. */
+static int
+lpm_length_add(uint8_t length)
+{
+  int i;
+  int j;
+
+  for(i = 0; i < lpm_num_lengths && lpm_lengths[i] > length; i++);
+  if(i < lpm_num_lengths && lpm_lengths[i] == length) {
+    lpm_length_routes[i]++;
+    return 1;
+  }
+  if(lpm_num_lengths == UIP_DS6_ROUTE_LPM_LENGTHS) {
+    return 0;
+  }
+  for(j = lpm_num_lengths; j > i; j--) {
+    lpm_lengths[j] = lpm_lengths[j - 1];
+    lpm_length_routes[j] = lpm_length_routes[j - 1];
+  }
+  lpm_lengths[i] = length;
+  lpm_length_routes[i] = 1;
+  lpm_num_lengths++;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+lpm_length_remove(uint8_t length)
+{
+  int i;
+
+  for(i = 0; i < lpm_num_lengths && lpm_lengths[i] != length; i++);
+  if(i == lpm_num_lengths || --lpm_length_routes[i] > 0) {
+    return;
+  }
+  lpm_num_lengths--;
+  for(; i < lpm_num_lengths; i++) {
+    lpm_lengths[i] = lpm_lengths[i + 1];
+    lpm_length_routes[i] = lpm_length_routes[i + 1];
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+lpm_insert(uip_ds6_route_t *r)
+{
+  uint16_t slot;
+
+  slot = lpm_hash(&r->ipaddr, r->length);
+  while(lpm_slots[slot] != 0) {
+    slot = (slot + 1) % UIP_DS6_ROUTE_LPM_SIZE;
+  }
+  lpm_slots[slot] = r - (uip_ds6_route_t *)routememb.mem + 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+lpm_remove(uip_ds6_route_t *r)
+{
+  uint16_t slot;
+  uint16_t next;
+  uint16_t home;
+  uint16_t index;
+
+  index = r - (uip_ds6_route_t *)routememb.mem + 1;
+  slot = lpm_hash(&r->ipaddr, r->length);
+  while(lpm_slots[slot] != index) {
+    if(lpm_slots[slot] == 0) {
+      return;
+    }
+    slot = (slot + 1) % UIP_DS6_ROUTE_LPM_SIZE;
+  }
+
+  /* Shift later entries of the same probe sequence back, so that
+     lookups never stop early at the freed slot */
+  next = slot;
+  while(1) {
+    lpm_slots[slot] = 0;
+    do {
+      next = (next + 1) % UIP_DS6_ROUTE_LPM_SIZE;
+      if(lpm_slots[next] == 0) {
+        return;
+      }
+      home = lpm_hash(&lpm_route(next)->ipaddr, lpm_route(next)->length);
+      /* Keep the entry if its home slot lies cyclically in (slot, next] */
+    } while(slot <= next
+            ? (slot < home && home <= next)
+            : (slot < home || home <= next));
+    lpm_slots[slot] = lpm_slots[next];
+    slot = next;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uip_ds6_route_t *
+lpm_lookup(const uip_ipaddr_t *addr)
+{
+  uip_ds6_route_t *r;
+  uint16_t slot;
+  uint8_t length;
+  int i;
+
+  for(i = 0; i < lpm_num_lengths; i++) {
+    length = lpm_lengths[i];
+    slot = lpm_hash(addr, length);
+    while(lpm_slots[slot] != 0) {
+      r = lpm_route(slot);
+      if(r->length == length &&
+         uip_ipaddr_prefixcmp(addr, &r->ipaddr, length)) {
+        return r;
+      }
+      slot = (slot + 1) % UIP_DS6_ROUTE_LPM_SIZE;
+    }
+  }
+  return NULL;
+}
+#endif /* UIP_DS6_ROUTE_WITH_LPM */
+/*---------------------------------------------------------------------------*/
 #if UIP_DS6_NOTIFICATIONS
 static void
 call_route_callback(int event, uip_ipaddr_t *route,
@@ -161,9 +318,17 @@ uip_ds6_route_init(void)
 {
 #if (UIP_CONF_MAX_ROUTES != 0)
   memb_init(&routememb);
+#if UIP_DS6_ROUTE_WITH_DLIST
+  dlist_init(routelist);
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
   list_init(routelist);
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
   nbr_table_register(nbr_routes,
                      (nbr_table_callback *)rm_routelist_callback);
+#if UIP_DS6_ROUTE_WITH_LPM
+  memset(lpm_slots, 0, sizeof(lpm_slots));
+  lpm_num_lengths = 0;
+#endif /* UIP_DS6_ROUTE_WITH_LPM */
 #endif /* (UIP_CONF_MAX_ROUTES != 0) */
 
   memb_init(&defaultroutermemb);
@@ -205,7 +370,11 @@ uip_ds6_route_t *
 uip_ds6_route_head(void)
 {
 #if (UIP_CONF_MAX_ROUTES != 0)
+#if UIP_DS6_ROUTE_WITH_DLIST
+  return dlist_head(routelist);
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
   return list_head(routelist);
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
 #else /* (UIP_CONF_MAX_ROUTES != 0) */
   return NULL;
 #endif /* (UIP_CONF_MAX_ROUTES != 0) */
@@ -254,15 +423,20 @@ uip_ds6_route_t *
 uip_ds6_route_lookup(uip_ipaddr_t *addr)
 {
 #if (UIP_CONF_MAX_ROUTES != 0)
-  uip_ds6_route_t *r;
   uip_ds6_route_t *found_route;
+#if !UIP_DS6_ROUTE_WITH_LPM
+  uip_ds6_route_t *r;
   uint8_t longestmatch;
+#endif /* !UIP_DS6_ROUTE_WITH_LPM */
 
   PRINTF("uip-ds6-route: Looking up route for ");
   PRINT6ADDR(addr);
   PRINTF("\n");
 
 
+#if UIP_DS6_ROUTE_WITH_LPM
+  found_route = lpm_lookup(addr);
+#else /* UIP_DS6_ROUTE_WITH_LPM */
   found_route = NULL;
   longestmatch = 0;
   for(r = uip_ds6_route_head();
@@ -278,6 +452,7 @@ uip_ds6_route_lookup(uip_ipaddr_t *addr)
       }
     }
   }
+#endif /* UIP_DS6_ROUTE_WITH_LPM */
 
   if(found_route != NULL) {
     PRINTF("uip-ds6-route: Found route: ");
@@ -289,14 +464,8 @@ uip_ds6_route_lookup(uip_ipaddr_t *addr)
     PRINTF("uip-ds6-route: No route found\n");
   }
 
-  if(found_route != NULL && found_route != list_head(routelist)) {
-    /* If we found a route, we put it at the start of the routeslist
-       list. The list is ordered by how recently we looked them up:
-       the least recently used route will be at the end of the
-       list - for fast lookups (assuming multiple packets to the same node). */
-
-    list_remove(routelist, found_route);
-    list_push(routelist, found_route);
+  if(found_route != NULL) {
+    uip_ds6_route_touch(found_route);
   }
 
   return found_route;
@@ -305,6 +474,27 @@ uip_ds6_route_lookup(uip_ipaddr_t *addr)
 #endif /* (UIP_CONF_MAX_ROUTES != 0) */
 }
 /*---------------------------------------------------------------------------*/
+void
+uip_ds6_route_touch(uip_ds6_route_t *route)
+{
+#if (UIP_CONF_MAX_ROUTES != 0)
+  if(route != uip_ds6_route_head()) {
+    /* We put the route at the start of the routeslist list. The list
+       is ordered by how recently we looked them up: the least
+       recently used route will be at the end of the list - for fast
+       lookups (assuming multiple packets to the same node). */
+
+#if UIP_DS6_ROUTE_WITH_DLIST
+    dlist_remove(routelist, route);
+    dlist_push(routelist, route);
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
+    list_remove(routelist, route);
+    list_push(routelist, route);
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
+  }
+#endif /* (UIP_CONF_MAX_ROUTES != 0) */
+}
+/*---------------------------------------------------------------------------*/
 uip_ds6_route_t *
 uip_ds6_route_add(uip_ipaddr_t *ipaddr, uint8_t length,
 		  uip_ipaddr_t *nexthop)
@@ -345,6 +535,14 @@ uip_ds6_route_add(uip_ipaddr_t *ipaddr, uint8_t length,
   }
   {
     struct uip_ds6_route_neighbor_routes *routes;
+
+#if UIP_DS6_ROUTE_WITH_LPM
+    if(!lpm_length_add(length)) {
+      PRINTF("uip_ds6_route_add: too many prefix lengths\n");
+      return NULL;
+    }
+#endif /* UIP_DS6_ROUTE_WITH_LPM */
+
     /* If there is no routing entry, create one. We first need to
        check if we have room for this route. If not, we remove the
        least recently used one we have. */
@@ -355,9 +553,16 @@ uip_ds6_route_add(uip_ipaddr_t *ipaddr, uint8_t length,
 #if UIP_DS6_ROUTE_REMOVE_LEAST_RECENTLY_USED
       /* Removing the oldest route entry from the route table. The
          least recently used route is the first route on the list. */
+#if UIP_DS6_ROUTE_WITH_DLIST
+      oldest = dlist_tail(routelist);
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
       oldest = list_tail(routelist);
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
 #endif
       if(oldest == NULL) {
+#if UIP_DS6_ROUTE_WITH_LPM
+        lpm_length_remove(length);
+#endif /* UIP_DS6_ROUTE_WITH_LPM */
         return NULL;
       }
       PRINTF("uip_ds6_route_add: dropping route to ");
@@ -391,9 +596,16 @@ uip_ds6_route_add(uip_ipaddr_t *ipaddr, uint8_t length,
         /* This should not happen, as we explicitly deallocated one
            route table entry above. */
         PRINTF("uip_ds6_route_add: could not allocate neighbor table entry\n");
+#if UIP_DS6_ROUTE_WITH_LPM
+        lpm_length_remove(length);
+#endif /* UIP_DS6_ROUTE_WITH_LPM */
         return NULL;
       }
+#if UIP_DS6_ROUTE_WITH_DLIST
+      DLIST_STRUCT_INIT(routes, route_list);
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
       LIST_STRUCT_INIT(routes, route_list);
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
 #ifdef NETSTACK_CONF_ROUTING_NEIGHBOR_ADDED_CALLBACK
       NETSTACK_CONF_ROUTING_NEIGHBOR_ADDED_CALLBACK((const linkaddr_t *)nexthop_lladdr);
 #endif
@@ -406,25 +618,45 @@ uip_ds6_route_add(uip_ipaddr_t *ipaddr, uint8_t length,
       /* This should not happen, as we explicitly deallocated one
          route table entry above. */
       PRINTF("uip_ds6_route_add: could not allocate route\n");
+#if UIP_DS6_ROUTE_WITH_LPM
+      lpm_length_remove(length);
+#endif /* UIP_DS6_ROUTE_WITH_LPM */
       return NULL;
     }
 
     /* add new routes first - assuming that there is a reason to add this
        and that there is a packet coming soon. */
+#if UIP_DS6_ROUTE_WITH_DLIST
+    dlist_push(routelist, r);
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
     list_push(routelist, r);
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
 
     nbrr = memb_alloc(&neighborroutememb);
     if(nbrr == NULL) {
       /* This should not happen, as we explicitly deallocated one
          route table entry above. */
       PRINTF("uip_ds6_route_add: could not allocate neighbor route list entry\n");
+#if UIP_DS6_ROUTE_WITH_DLIST
+      dlist_remove(routelist, r);
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
+      list_remove(routelist, r);
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
       memb_free(&routememb, r);
+#if UIP_DS6_ROUTE_WITH_LPM
+      lpm_length_remove(length);
+#endif /* UIP_DS6_ROUTE_WITH_LPM */
       return NULL;
     }
 
     nbrr->route = r;
     /* Add the route to this neighbor */
+#if UIP_DS6_ROUTE_WITH_DLIST
+    dlist_add(routes->route_list, nbrr);
+    r->neighbor_route = nbrr;
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
     list_add(routes->route_list, nbrr);
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
     r->neighbor_routes = routes;
     num_routes++;
 
@@ -436,10 +668,14 @@ uip_ds6_route_add(uip_ipaddr_t *ipaddr, uint8_t length,
 
   uip_ipaddr_copy(&(r->ipaddr), ipaddr);
   r->length = length;
+#if UIP_DS6_ROUTE_WITH_LPM
+  lpm_insert(r);
+#endif /* UIP_DS6_ROUTE_WITH_LPM */
 
 #ifdef UIP_DS6_ROUTE_STATE_TYPE
   memset(&r->state, 0, sizeof(UIP_DS6_ROUTE_STATE_TYPE));
 #endif
+  UIP_DS6_TABLES_CHANGED();
 
   PRINTF("uip_ds6_route_add: adding route: ");
   PRINT6ADDR(ipaddr);
@@ -477,6 +713,19 @@ uip_ds6_route_rm(uip_ds6_route_t *route)
     PRINT6ADDR(&route->ipaddr);
     PRINTF("\n");
 
+#if UIP_DS6_ROUTE_WITH_LPM
+    lpm_remove(route);
+    lpm_length_remove(route->length);
+#endif /* UIP_DS6_ROUTE_WITH_LPM */
+
+#if UIP_DS6_ROUTE_WITH_DLIST
+    /* Remove the route from the route list and its neighbor_route
+       from the route list of the neighbor. */
+    dlist_remove(routelist, route);
+    neighbor_route = route->neighbor_route;
+    dlist_remove(route->neighbor_routes->route_list, neighbor_route);
+    if(dlist_head(route->neighbor_routes->route_list) == NULL) {
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
     /* Remove the route from the route list */
     list_remove(routelist, route);
 
@@ -492,6 +741,7 @@ uip_ds6_route_rm(uip_ds6_route_t *route)
     }
     list_remove(route->neighbor_routes->route_list, neighbor_route);
     if(list_head(route->neighbor_routes->route_list) == NULL) {
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
       /* If this was the only route using this neighbor, remove the
          neighbor from the table - this implicitly unlocks nexthop */
 #if (DEBUG) & DEBUG_ANNOTATE
@@ -511,6 +761,7 @@ uip_ds6_route_rm(uip_ds6_route_t *route)
     memb_free(&neighborroutememb, neighbor_route);
 
     num_routes--;
+    UIP_DS6_TABLES_CHANGED();
 
     PRINTF("uip_ds6_route_rm num %d\n", num_routes);
 
@@ -538,11 +789,17 @@ rm_routelist(struct uip_ds6_route_neighbor_routes *routes)
   PRINTF("uip_ds6_route_rm_routelist\n");
   if(routes != NULL && routes->route_list != NULL) {
     struct uip_ds6_route_neighbor_route *r;
+#if UIP_DS6_ROUTE_WITH_DLIST
+    while((r = dlist_head(routes->route_list)) != NULL) {
+      uip_ds6_route_rm(r->route);
+    }
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
     r = list_head(routes->route_list);
     while(r != NULL) {
       uip_ds6_route_rm(r->route);
       r = list_head(routes->route_list);
     }
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
     nbr_table_remove(nbr_routes, routes);
   }
 #if DEBUG != DEBUG_NONE
@@ -603,6 +860,7 @@ uip_ds6_defrt_add(uip_ipaddr_t *ipaddr, unsigned long interval)
     }
 
     list_push(defaultrouterlist, d);
+    UIP_DS6_TABLES_CHANGED();
   }
 
   uip_ipaddr_copy(&d->ipaddr, ipaddr);
@@ -643,6 +901,7 @@ uip_ds6_defrt_rm(uip_ds6_defrt_t *defrt)
       PRINTF("Removing default route\n");
       list_remove(defaultrouterlist, defrt);
       memb_free(&defaultroutermemb, defrt);
+      UIP_DS6_TABLES_CHANGED();
       ANNOTATE("#L %u 0\n", defrt->ipaddr.u8[sizeof(uip_ipaddr_t) - 1]);
 #if UIP_DS6_NOTIFICATIONS
       call_route_callback(UIP_DS6_NOTIFICATION_DEFRT_RM,
@@ -44,6 +44,47 @@
 #include "net/nbr-table.h"
 #include "sys/stimer.h"
 #include "lib/list.h"
+#include "lib/dlist.h"
+
+/* Index the routing table by prefix for longest-prefix-match lookups:
+   one hash table holds all routes keyed by their prefix and length,
+   and a lookup probes it once per distinct prefix length in use,
+   longest first, instead of walking the whole table. Costs two bytes
+   per hash slot. */
+#ifdef UIP_DS6_ROUTE_CONF_WITH_LPM
+#define UIP_DS6_ROUTE_WITH_LPM UIP_DS6_ROUTE_CONF_WITH_LPM
+#else
+#define UIP_DS6_ROUTE_WITH_LPM 0
+#endif
+
+/* Number of slots of the prefix index. Must be larger than the number
+   of routes. */
+#ifdef UIP_DS6_ROUTE_CONF_LPM_SIZE
+#define UIP_DS6_ROUTE_LPM_SIZE UIP_DS6_ROUTE_CONF_LPM_SIZE
+#else
+#define UIP_DS6_ROUTE_LPM_SIZE (2 * UIP_DS6_ROUTE_NB)
+#endif
+
+/* Number of distinct prefix lengths the index can hold. Routes with
+   yet another prefix length are refused. */
+#ifdef UIP_DS6_ROUTE_CONF_LPM_LENGTHS
+#define UIP_DS6_ROUTE_LPM_LENGTHS UIP_DS6_ROUTE_CONF_LPM_LENGTHS
+#else
+#define UIP_DS6_ROUTE_LPM_LENGTHS 8
+#endif
+
+/* Keep the routing table and the per-neighbor route lists on doubly
+   linked lists. This makes moving a route to the front of the table
+   on lookup, dropping the least recently used route and removing a
+   route constant-time operations, at the cost of one extra pointer
+   per route and per neighbor route entry. */
+#ifdef UIP_DS6_ROUTE_CONF_WITH_DLIST
+#define UIP_DS6_ROUTE_WITH_DLIST UIP_DS6_ROUTE_CONF_WITH_DLIST
+#else
+/* The prefix index finds a route at once, so moving it to the front of
+   the table must not walk the list either */
+#define UIP_DS6_ROUTE_WITH_DLIST UIP_DS6_ROUTE_WITH_LPM
+#endif
 
 NBR_TABLE_DECLARE(nbr_routes);
 
@@ -141,12 +182,21 @@ typedef struct rpl_route_entry {
 /** \brief The neighbor routes hold a list of routing table entries
     that are attached to a specific neihbor. */
 struct uip_ds6_route_neighbor_routes {
+#if UIP_DS6_ROUTE_WITH_DLIST
+  DLIST_STRUCT(route_list);
+#else /* UIP_DS6_ROUTE_WITH_DLIST */
   LIST_STRUCT(route_list);
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
 };
 
 /** \brief An entry in the routing table */
 typedef struct uip_ds6_route {
   struct uip_ds6_route *next;
+#if UIP_DS6_ROUTE_WITH_DLIST
+  struct uip_ds6_route *prev;
+  /* The entry for this route on the route list of its neighbor. */
+  struct uip_ds6_route_neighbor_route *neighbor_route;
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
   /* Each route entry belongs to a specific neighbor. That neighbor
      holds a list of all routing entries that go through it. The
      routes field point to the uip_ds6_route_neighbor_routes that
@@ -164,6 +214,9 @@ typedef struct uip_ds6_route {
     uip_ds6_route->neighbor_routes->route_list list. */
 struct uip_ds6_route_neighbor_route {
   struct uip_ds6_route_neighbor_route *next;
+#if UIP_DS6_ROUTE_WITH_DLIST
+  struct uip_ds6_route_neighbor_route *prev;
+#endif /* UIP_DS6_ROUTE_WITH_DLIST */
   struct uip_ds6_route *route;
 };
 
@@ -191,6 +244,7 @@ void uip_ds6_defrt_periodic(void);
 /** \name Routing Table basic routines */
 /** @{ */
 uip_ds6_route_t *uip_ds6_route_lookup(uip_ipaddr_t *destipaddr);
+void uip_ds6_route_touch(uip_ds6_route_t *route);
 uip_ds6_route_t *uip_ds6_route_add(uip_ipaddr_t *ipaddr, uint8_t length,
                                    uip_ipaddr_t *next_hop);
 void uip_ds6_route_rm(uip_ds6_route_t *route);
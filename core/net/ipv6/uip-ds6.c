@@ -71,6 +71,9 @@ static uint8_t rscount;                                         /**< number of r
 /** @{ */
 uip_ds6_netif_t uip_ds6_if;                                     /**< The single interface */
 uip_ds6_prefix_t uip_ds6_prefix_list[UIP_DS6_PREFIX_NB];        /**< Prefix list */
+#if UIP_FLOW_CACHE_SIZE
+uint32_t uip_ds6_generation;                                    /**< Table changes */
+#endif /* UIP_FLOW_CACHE_SIZE */
 
 /* Used by Cooja to enable extraction of addresses from memory.*/
 uint8_t uip_ds6_addr_size;
@@ -243,6 +246,7 @@ uip_ds6_prefix_add(uip_ipaddr_t *ipaddr, uint8_t ipaddrlen,
     locprefix->isused = 1;
     uip_ipaddr_copy(&locprefix->ipaddr, ipaddr);
     locprefix->length = ipaddrlen;
+    UIP_DS6_TABLES_CHANGED();
     locprefix->advertise = advertise;
     locprefix->l_a_reserved = flags;
     locprefix->vlifetime = vtime;
@@ -271,6 +275,7 @@ uip_ds6_prefix_add(uip_ipaddr_t *ipaddr, uint8_t ipaddrlen,
     locprefix->isused = 1;
     uip_ipaddr_copy(&locprefix->ipaddr, ipaddr);
     locprefix->length = ipaddrlen;
+    UIP_DS6_TABLES_CHANGED();
     if(interval != 0) {
       stimer_set(&(locprefix->vlifetime), interval);
       locprefix->isinfinite = 0;
@@ -292,6 +297,7 @@ uip_ds6_prefix_rm(uip_ds6_prefix_t *prefix)
 {
   if(prefix != NULL) {
     prefix->isused = 0;
+    UIP_DS6_TABLES_CHANGED();
   }
   return;
 }
@@ -175,6 +175,15 @@
 #define NOSPACE 2
 /*--------------------------------------------------*/
 
+#if UIP_FLOW_CACHE_SIZE
+/** Counts the changes to the prefix, neighbor, route and default
+    router tables, which invalidate the flow cache of tcpip.c */
+extern uint32_t uip_ds6_generation;
+#define UIP_DS6_TABLES_CHANGED() (uip_ds6_generation++)
+#else /* UIP_FLOW_CACHE_SIZE */
+#define UIP_DS6_TABLES_CHANGED()
+#endif /* UIP_FLOW_CACHE_SIZE */
+
 #if UIP_CONF_IPV6_QUEUE_PKT
 #include "net/ip/uip-packetqueue.h"
 #endif                          /*UIP_CONF_QUEUE_PKT */
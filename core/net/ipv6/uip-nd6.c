@@ -589,17 +589,10 @@ na_input(void)
     }
   }
 #if UIP_CONF_IPV6_QUEUE_PKT
-  /* The nbr is now reachable, check if we had buffered a pkt for it */
-  /*if(nbr->queue_buf_len != 0) {
-    uip_len = nbr->queue_buf_len;
-    memcpy(UIP_IP_BUF, nbr->queue_buf, uip_len);
-    nbr->queue_buf_len = 0;
-    return;
-    }*/
-  if(uip_packetqueue_buflen(&nbr->packethandle) != 0) {
-    uip_len = uip_packetqueue_buflen(&nbr->packethandle);
-    memcpy(UIP_IP_BUF, uip_packetqueue_buf(&nbr->packethandle), uip_len);
-    uip_packetqueue_free(&nbr->packethandle);
+  /* The nbr is now reachable, check if we had buffered pkts for it.
+     The oldest one is sent on return; tcpip_ipv6_output() then finds
+     the nbr reachable and drains the others in order. */
+  if(uip_packetqueue_dequeue(&nbr->packethandle) != 0) {
     return;
   }
 
@@ -1077,17 +1070,9 @@ ra_input(void)
 
 #if UIP_CONF_IPV6_QUEUE_PKT
   /* If the nbr just became reachable (e.g. it was in NBR_INCOMPLETE state
-   * and we got a SLLAO), check if we had buffered a pkt for it */
-  /*  if((nbr != NULL) && (nbr->queue_buf_len != 0)) {
-    uip_len = nbr->queue_buf_len;
-    memcpy(UIP_IP_BUF, nbr->queue_buf, uip_len);
-    nbr->queue_buf_len = 0;
-    return;
-    }*/
-  if(nbr != NULL && uip_packetqueue_buflen(&nbr->packethandle) != 0) {
-    uip_len = uip_packetqueue_buflen(&nbr->packethandle);
-    memcpy(UIP_IP_BUF, uip_packetqueue_buf(&nbr->packethandle), uip_len);
-    uip_packetqueue_free(&nbr->packethandle);
+   * and we got a SLLAO), check if we had buffered pkts for it; the
+   * others follow the oldest one out of tcpip_ipv6_output() */
+  if(nbr != NULL && uip_packetqueue_dequeue(&nbr->packethandle) != 0) {
     return;
   }
 
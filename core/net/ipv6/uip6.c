@@ -207,6 +207,11 @@ uint16_t uip_urglen, uip_surglen;
 
 /* The uip_len is either 8 or 16 bits, depending on the maximum packet size.*/
 uint16_t uip_len, uip_slen;
+
+#if UIP_TCP_SEND_WINDOW > 1
+/* The number of bytes that the incoming segment acknowledged */
+uint16_t uip_acklen;
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
 /** @} */
 
 /*---------------------------------------------------------------------------*/
@@ -332,6 +337,62 @@ uip_add32(uint8_t *op32, uint16_t op16)
 
 #if ! UIP_ARCH_CHKSUM
 /*---------------------------------------------------------------------------*/
+#if UIP_CHKSUM_WIDE
+static uint16_t
+chksum(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+  uint64_t acc;
+  uint32_t w[4];
+  uint16_t t;
+
+  /* The one's complement sum does not depend on the byte order, so the
+     words are summed as the CPU loads them and the result is swapped
+     into host order at the end (RFC 1071, section 2). memcpy() keeps
+     unaligned loads safe and compiles into plain loads where the CPU
+     allows them. */
+  acc = 0;
+  while(len >= sizeof(w)) {
+    memcpy(w, data, sizeof(w));
+    acc += (uint64_t)w[0] + w[1] + w[2] + w[3];
+    data += sizeof(w);
+    len -= sizeof(w);
+  }
+  while(len >= sizeof(w[0])) {
+    memcpy(w, data, sizeof(w[0]));
+    acc += w[0];
+    data += sizeof(w[0]);
+    len -= sizeof(w[0]);
+  }
+  if(len >= sizeof(t)) {
+    memcpy(&t, data, sizeof(t));
+    acc += t;
+    data += sizeof(t);
+    len -= sizeof(t);
+  }
+  if(len > 0) {
+    /* Pad the last byte with a zero byte, as if it was a whole word */
+    t = 0;
+    *(uint8_t *)&t = *data;
+    acc += t;
+  }
+
+  /* Fold the accumulator down to 16 bits */
+  acc = (acc >> 32) + (acc & 0xffffffff);
+  acc = (acc >> 32) + (acc & 0xffffffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+
+  t = uip_ntohs((uint16_t)acc);
+  sum += t;
+  if(sum < t) {
+    sum++;      /* carry */
+  }
+
+  /* Return sum in host byte order. */
+  return sum;
+}
+#else /* UIP_CHKSUM_WIDE */
 static uint16_t
 chksum(uint16_t sum, const uint8_t *data, uint16_t len)
 {
@@ -362,6 +423,7 @@ chksum(uint16_t sum, const uint8_t *data, uint16_t len)
   /* Return sum in host byte order. */
   return sum;
 }
+#endif /* UIP_CHKSUM_WIDE */
 /*---------------------------------------------------------------------------*/
 uint16_t
 uip_chksum(uint16_t *data, uint16_t len)
@@ -438,6 +500,24 @@ uip_udpchksum(void)
 #endif /* UIP_UDP && UIP_UDP_CHECKSUMS */
 #endif /* UIP_ARCH_CHKSUM */
 /*---------------------------------------------------------------------------*/
+uint16_t
+uip_chksum_adjust(uint16_t chksum, const void *old, uint16_t old_len,
+                  const void *new, uint16_t new_len)
+{
+  uint32_t sum;
+
+  /* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m'). The one's complement sum
+     does not depend on the byte order, so all of it is done in network
+     byte order. */
+  sum = (uint16_t)~chksum;
+  sum += (uint16_t)~uip_chksum((uint16_t *)old, old_len);
+  sum += uip_chksum((uint16_t *)new, new_len);
+  sum = (sum >> 16) + (sum & 0xffff);
+  sum = (sum >> 16) + (sum & 0xffff);
+
+  return (uint16_t)~sum;
+}
+/*---------------------------------------------------------------------------*/
 void
 uip_init(void)
 {
@@ -535,6 +615,13 @@ uip_connect(const uip_ipaddr_t *ripaddr, uint16_t rport)
   conn->rto = UIP_RTO;
   conn->sa = 0;
   conn->sv = 16;   /* Initial value of the RTT variance. */
+#if UIP_TCP_SEND_WINDOW > 1
+  conn->snd_wnd = 0;
+  conn->snd_max = 0;
+  conn->rtt_len = 0;
+  conn->cwnd = 1;
+  conn->dupacks = 0;
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
   conn->lport = uip_htons(lastport);
   conn->rport = rport;
   uip_ipaddr_copy(&conn->ripaddr, ripaddr);
@@ -864,7 +951,64 @@ uip_add_rcv_nxt(uint16_t n)
   uip_conn->rcv_nxt[2] = uip_acc32[2];
   uip_conn->rcv_nxt[3] = uip_acc32[3];
 }
-#endif
+/*---------------------------------------------------------------------------*/
+/* RTT estimation from a measurement of m ticks, taken directly from
+   VJs original code in his paper */
+static void
+update_rto(struct uip_conn *conn, signed char m)
+{
+  m = m - (conn->sa >> 3);
+  conn->sa += m;
+  if(m < 0) {
+    m = -m;
+  }
+  m = m - (conn->sv >> 2);
+  conn->sv += m;
+  conn->rto = (conn->sa >> 3) + conn->sv;
+}
+#if UIP_TCP_SEND_WINDOW > 1
+/* The number of duplicate ACKs after which we retransmit. A receiver
+   sends one for every segment after a lost one, and only a few
+   segments are in flight. */
+#define TCP_DUPACK_THRESHOLD 2
+/*---------------------------------------------------------------------------*/
+/* The number of bytes that the incoming segment acknowledges, or 0 if
+   it acknowledges nothing that we have sent */
+static uint16_t
+acked_len(struct uip_conn *conn)
+{
+  uint32_t acked;
+
+  acked = (((uint32_t)UIP_TCP_BUF->ackno[0] << 24) |
+           ((uint32_t)UIP_TCP_BUF->ackno[1] << 16) |
+           ((uint32_t)UIP_TCP_BUF->ackno[2] << 8) |
+           UIP_TCP_BUF->ackno[3]) -
+          (((uint32_t)conn->snd_nxt[0] << 24) |
+           ((uint32_t)conn->snd_nxt[1] << 16) |
+           ((uint32_t)conn->snd_nxt[2] << 8) |
+           conn->snd_nxt[3]);
+  if(acked > MAX(conn->len, conn->snd_max)) {
+    return 0;
+  }
+  return acked;
+}
+/*---------------------------------------------------------------------------*/
+/* The number of bytes that the connection may add to the ones in
+   flight. One segment of the current MSS is always allowed, as
+   without a send window. */
+static uint16_t
+send_room(struct uip_conn *conn)
+{
+  uint32_t limit;
+
+  limit = MIN((uint32_t)conn->cwnd * conn->mss, conn->snd_wnd);
+  if(limit < conn->mss) {
+    limit = conn->mss;
+  }
+  return limit > conn->len ? limit - conn->len : 0;
+}
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
+#endif /* UIP_TCP */
 /*---------------------------------------------------------------------------*/
 
 /**
@@ -912,6 +1056,13 @@ ext_hdr_options_process(void)
 #endif /* UIP_CONF_IPV6_RPL */
       uip_ext_opt_offset += (UIP_EXT_HDR_OPT_BUF->len) + 2;
       return 0;
+#if UIP_CONF_IPV6_MPL
+    case UIP_EXT_HDR_OPT_MPL:
+      /* The MPL multicast engine parses this option itself */
+      PRINTF("Processing MPL option\n");
+      uip_ext_opt_offset += (UIP_EXT_HDR_OPT_BUF->len) + 2;
+      break;
+#endif /* UIP_CONF_IPV6_MPL */
     default:
       /*
        * check the two highest order bits of the option
@@ -949,6 +1100,24 @@ ext_hdr_options_process(void)
   return 0;
 }
 
+#if UIP_TCP && UIP_TCP_SEND_WINDOW > 1
+/*---------------------------------------------------------------------------*/
+/* Go back to the oldest unacknowledged byte: the application puts the
+ * data from there into the buffer again, of which one segment is sent */
+static void
+tcp_window_rexmit(struct uip_conn *conn)
+{
+  conn->len = 0;
+  conn->rtt_len = 0;
+  uip_slen = 0;
+  uip_flags = UIP_REXMIT;
+  UIP_APPCALL();
+  if(uip_slen > conn->mss) {
+    uip_slen = conn->mss;
+  }
+  conn->len = uip_slen;
+}
+#endif /* UIP_TCP && UIP_TCP_SEND_WINDOW > 1 */
 
 /*---------------------------------------------------------------------------*/
 void
@@ -959,6 +1128,10 @@ uip_process(uint8_t flag)
   uint16_t tmp16;
   uint8_t opt;
   register struct uip_conn *uip_connr = uip_conn;
+#if UIP_TCP_SEND_WINDOW > 1
+  /* The sequence number of the segment to send, relative to snd_nxt */
+  uint16_t snd_offset = 0;
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
 #endif /* UIP_TCP */
 #if UIP_UDP
   if(flag == UIP_UDP_SEND_CONN) {
@@ -972,7 +1145,11 @@ uip_process(uint8_t flag)
   if(flag == UIP_POLL_REQUEST) {
 #if UIP_TCP
     if((uip_connr->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED &&
+#if UIP_TCP_SEND_WINDOW > 1
+       send_room(uip_connr) > 0) {
+#else /* UIP_TCP_SEND_WINDOW > 1 */
        !uip_outstanding(uip_connr)) {
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
       uip_flags = UIP_POLL;
       UIP_APPCALL();
       goto appsend;
@@ -1020,6 +1197,11 @@ uip_process(uint8_t flag)
        * in which case we retransmit.
        */
       if(uip_outstanding(uip_connr)) {
+#if UIP_TCP_SEND_WINDOW > 1
+        if(uip_connr->rtt_len > 0 && uip_connr->rtt_timer < 127) {
+          ++(uip_connr->rtt_timer);
+        }
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
         if(uip_connr->timer-- == 0) {
           if(uip_connr->nrtx == UIP_MAXRTX ||
              ((uip_connr->tcpstateflags == UIP_SYN_SENT ||
@@ -1074,8 +1256,19 @@ uip_process(uint8_t flag)
              * the code for sending out the packet (the apprexmit
              * label).
              */
+#if UIP_TCP_SEND_WINDOW > 1
+            /*
+             * With a send window, we go back to the oldest
+             * unacknowledged byte and start over with a single
+             * segment in flight. Karn's algorithm rules out timing
+             * the segments sent again.
+             */
+            uip_connr->cwnd = 1;
+            tcp_window_rexmit(uip_connr);
+#else /* UIP_TCP_SEND_WINDOW > 1 */
             uip_flags = UIP_REXMIT;
             UIP_APPCALL();
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
             goto apprexmit;
 
           case UIP_FIN_WAIT_1:
@@ -1774,6 +1967,13 @@ uip_process(uint8_t flag)
   uip_connr->sa = 0;
   uip_connr->sv = 4;
   uip_connr->nrtx = 0;
+#if UIP_TCP_SEND_WINDOW > 1
+  uip_connr->snd_wnd = 0;
+  uip_connr->snd_max = 0;
+  uip_connr->rtt_len = 0;
+  uip_connr->cwnd = 1;
+  uip_connr->dupacks = 0;
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
   uip_connr->lport = UIP_TCP_BUF->destport;
   uip_connr->rport = UIP_TCP_BUF->srcport;
   uip_ipaddr_copy(&uip_connr->ripaddr, &UIP_IP_BUF->srcipaddr);
@@ -1903,6 +2103,48 @@ uip_process(uint8_t flag)
      data. If so, we update the sequence number, reset the length of
      the outstanding data, calculate RTT estimations, and reset the
      retransmission timer. */
+#if UIP_TCP_SEND_WINDOW > 1
+  /* With a send window, the segment may acknowledge some of the data
+     in flight, or data sent before a retransmission. Only the timed
+     segment yields an RTT measurement, and each acknowledgement opens
+     the congestion window by one segment. */
+  if((UIP_TCP_BUF->flags & TCP_ACK) &&
+     (uip_outstanding(uip_connr) || uip_connr->snd_max > 0)) {
+    uip_acklen = acked_len(uip_connr);
+    if(uip_acklen > 0) {
+      uip_add32(uip_connr->snd_nxt, uip_acklen);
+      uip_connr->snd_nxt[0] = uip_acc32[0];
+      uip_connr->snd_nxt[1] = uip_acc32[1];
+      uip_connr->snd_nxt[2] = uip_acc32[2];
+      uip_connr->snd_nxt[3] = uip_acc32[3];
+
+      uip_connr->len -= MIN(uip_connr->len, uip_acklen);
+      uip_connr->snd_max -= MIN(uip_connr->snd_max, uip_acklen);
+      if(uip_connr->rtt_len > uip_acklen) {
+        uip_connr->rtt_len -= uip_acklen;
+      } else if(uip_connr->rtt_len > 0) {
+        if(uip_connr->nrtx == 0) {
+          update_rto(uip_connr, uip_connr->rtt_timer);
+        }
+        uip_connr->rtt_len = 0;
+      }
+      if(uip_connr->cwnd < UIP_TCP_SEND_WINDOW) {
+        ++(uip_connr->cwnd);
+      }
+      uip_connr->dupacks = 0;
+      uip_flags = UIP_ACKDATA;
+      uip_connr->timer = uip_connr->rto;
+    } else if(uip_len == 0 && uip_outstanding(uip_connr) &&
+              memcmp(UIP_TCP_BUF->ackno, uip_connr->snd_nxt, 4) == 0 &&
+              uip_connr->dupacks < 255) {
+      ++(uip_connr->dupacks);
+    }
+  }
+  if(UIP_TCP_BUF->flags & TCP_ACK) {
+    uip_connr->snd_wnd = ((uint16_t)UIP_TCP_BUF->wnd[0] << 8) +
+      UIP_TCP_BUF->wnd[1];
+  }
+#else /* UIP_TCP_SEND_WINDOW > 1 */
   if((UIP_TCP_BUF->flags & TCP_ACK) && uip_outstanding(uip_connr)) {
     uip_add32(uip_connr->snd_nxt, uip_connr->len);
 
@@ -1918,18 +2160,7 @@ uip_process(uint8_t flag)
 
       /* Do RTT estimation, unless we have done retransmissions. */
       if(uip_connr->nrtx == 0) {
-        signed char m;
-        m = uip_connr->rto - uip_connr->timer;
-        /* This is taken directly from VJs original code in his paper */
-        m = m - (uip_connr->sa >> 3);
-        uip_connr->sa += m;
-        if(m < 0) {
-          m = -m;
-        }
-        m = m - (uip_connr->sv >> 2);
-        uip_connr->sv += m;
-        uip_connr->rto = (uip_connr->sa >> 3) + uip_connr->sv;
-
+        update_rto(uip_connr, uip_connr->rto - uip_connr->timer);
       }
       /* Set the acknowledged flag. */
       uip_flags = UIP_ACKDATA;
@@ -1941,6 +2172,7 @@ uip_process(uint8_t flag)
     }
 
   }
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
 
   /* Do different things depending on in what state the connection is. */
   switch(uip_connr->tcpstateflags & UIP_TS_MASK) {
@@ -2112,6 +2344,22 @@ uip_process(uint8_t flag)
     }
     uip_connr->mss = tmp16;
 
+#if UIP_TCP_SEND_WINDOW > 1
+    /* On enough duplicate ACKs, a segment has been lost and the ones
+         after it have been discarded or will be. We go back to the
+         lost one without waiting for the timeout, and halve the
+         congestion window. The timeout takes the same path with a
+         congestion window of one segment. */
+    if(uip_connr->dupacks == TCP_DUPACK_THRESHOLD) {
+      ++(uip_connr->dupacks);
+      uip_connr->cwnd = MAX(uip_connr->cwnd / 2, 1);
+      uip_connr->timer = uip_connr->rto;
+      UIP_STAT(++uip_stat.tcp.rexmit);
+      tcp_window_rexmit(uip_connr);
+      goto apprexmit;
+    }
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
+
     /* If this packet constitutes an ACK for outstanding data (flagged
          by the UIP_ACKDATA flag, we should call the application since it
          might want to send more data. If the incoming packet had data
@@ -2152,6 +2400,33 @@ uip_process(uint8_t flag)
 
       /* If uip_slen > 0, the application has data to be sent. */
       if(uip_slen > 0) {
+#if UIP_TCP_SEND_WINDOW > 1
+        /* The application has put the data that follows the ones in
+             flight into the buffer. We send as much of it as the MSS
+             and the windows allow, and time it for RTT estimation
+             unless it is a retransmission or another segment is
+             timed. */
+        if(uip_slen > uip_connr->mss) {
+          uip_slen = uip_connr->mss;
+        }
+        if(uip_slen > send_room(uip_connr)) {
+          uip_slen = send_room(uip_connr);
+        }
+        if(uip_slen > 0) {
+          if(uip_connr->len == 0) {
+            uip_connr->timer = uip_connr->rto;
+          }
+          if(uip_connr->rtt_len == 0 &&
+             uip_connr->len >= uip_connr->snd_max) {
+            uip_connr->rtt_len = uip_connr->len + uip_slen;
+            uip_connr->rtt_timer = 0;
+          }
+          uip_connr->len += uip_slen;
+          if(uip_connr->snd_max < uip_connr->len) {
+            uip_connr->snd_max = uip_connr->len;
+          }
+        }
+#else /* UIP_TCP_SEND_WINDOW > 1 */
 
         /* If the connection has acknowledged data, the contents of
              the ->len variable should be discarded. */
@@ -2181,11 +2456,30 @@ uip_process(uint8_t flag)
                retransmit) out more than it previously sent out. */
           uip_slen = uip_connr->len;
         }
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
+      }
+#if UIP_TCP_SEND_WINDOW > 1
+      /* Retransmitted data may still be in flight */
+      if((uip_flags & UIP_ACKDATA) || uip_connr->len == 0) {
+        uip_connr->nrtx = 0;
       }
+#else /* UIP_TCP_SEND_WINDOW > 1 */
       uip_connr->nrtx = 0;
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
       apprexmit:
       uip_appdata = uip_sappdata;
 
+#if UIP_TCP_SEND_WINDOW > 1
+      /* The segment goes after the ones in flight, and a pure ACK
+         carries the sequence number of the next segment. */
+      if(uip_slen > 0) {
+        uip_len = uip_slen + UIP_TCPIP_HLEN;
+        snd_offset = uip_connr->len - uip_slen;
+        UIP_TCP_BUF->flags = TCP_ACK | TCP_PSH;
+        goto tcp_send_noopts;
+      }
+      snd_offset = uip_connr->len;
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
       /* If the application has data to be sent, or if the incoming
            packet had new data in it, we must send out a packet. */
       if(uip_slen > 0 && uip_connr->len > 0) {
@@ -2299,6 +2593,15 @@ uip_process(uint8_t flag)
   UIP_TCP_BUF->seqno[1] = uip_connr->snd_nxt[1];
   UIP_TCP_BUF->seqno[2] = uip_connr->snd_nxt[2];
   UIP_TCP_BUF->seqno[3] = uip_connr->snd_nxt[3];
+#if UIP_TCP_SEND_WINDOW > 1
+  if(snd_offset > 0) {
+    uip_add32(uip_connr->snd_nxt, snd_offset);
+    UIP_TCP_BUF->seqno[0] = uip_acc32[0];
+    UIP_TCP_BUF->seqno[1] = uip_acc32[1];
+    UIP_TCP_BUF->seqno[2] = uip_acc32[2];
+    UIP_TCP_BUF->seqno[3] = uip_acc32[3];
+  }
+#endif /* UIP_TCP_SEND_WINDOW > 1 */
 
   UIP_TCP_BUF->srcport  = uip_connr->lport;
   UIP_TCP_BUF->destport = uip_connr->rport;
@@ -60,9 +60,13 @@ enum ieee802154e_header_ie_id {
 enum ieee802154e_payload_ie_id {
   PAYLOAD_IE_ESDU = 0,
   PAYLOAD_IE_MLME,
+  PAYLOAD_IE_IETF = 0x5,
   PAYLOAD_IE_LIST_TERMINATION = 0xf,
 };
 
+/* c.f. RFC 8480: Sub-ID of the 6top IE within the IETF IE */
+#define IETF_IE_SIXTOP_SUBID 0xc9
+
 /* c.f. IEEE 802.15.4e Table 4d */
 enum ieee802154e_mlme_short_subie_id {
   MLME_SHORT_IE_TSCH_SYNCHRONIZATION = 0x1a,
@@ -192,6 +196,26 @@ frame80215e_create_ie_payload_list_termination(uint8_t *buf, int len,
   }
 }
 
+/* Payload IE. IETF IE holding a 6top IE (6P message). Used by 6top */
+int
+frame80215e_create_ie_sixtop(uint8_t *buf, int len,
+    struct ieee802154_ies *ies)
+{
+  int ie_len;
+  if(ies == NULL || ies->ie_sixtop_content == NULL) {
+    return -1;
+  }
+  ie_len = 1 + ies->ie_sixtop_content_len;
+  if(len >= 2 + ie_len && ie_len <= 0x7ff) {
+    buf[2] = IETF_IE_SIXTOP_SUBID;
+    memmove(buf + 3, ies->ie_sixtop_content, ies->ie_sixtop_content_len);
+    create_payload_ie_descriptor(buf, PAYLOAD_IE_IETF, ie_len);
+    return 2 + ie_len;
+  } else {
+    return -1;
+  }
+}
+
 /* Payload IE. MLME. Used to nest sub-IEs */
 int
 frame80215e_create_ie_mlme(uint8_t *buf, int len,
@@ -529,6 +553,15 @@ frame802154e_parse_information_elements(const uint8_t *buf, uint8_t buf_size,
             len = 0; /* Reset len as we want to read subIEs and not jump over them */
             PRINTF("frame802154e: entering MLME ie with len %u\n", nested_mlme_len);
             break;
+          case PAYLOAD_IE_IETF:
+            /* We support only the 6top IE, c.f. RFC 8480 */
+            if(len == 0 || len > buf_size || buf[0] != IETF_IE_SIXTOP_SUBID) {
+              PRINTF("frame802154e: non-supported ietf ie\n");
+              return -1;
+            }
+            ies->ie_sixtop_content = buf + 1;
+            ies->ie_sixtop_content_len = len - 1;
+            break;
           case PAYLOAD_IE_LIST_TERMINATION:
             PRINTF("frame802154e: payload ie list termination %u\n", len);
             return (len == 0) ? buf + len - start : -1;
@@ -80,6 +80,9 @@ struct ieee802154_ies {
   /* We include and parse only the sequence len and list and omit unused fields */
   uint16_t ie_hopping_sequence_len;
   uint8_t ie_hopping_sequence_list[TSCH_HOPPING_SEQUENCE_MAX_LEN];
+  /* Payload IETF IE: content of the 6top IE, i.e. a 6P message */
+  const uint8_t *ie_sixtop_content;
+  uint16_t ie_sixtop_content_len;
 };
 
 /** Insert various Information Elements **/
@@ -97,6 +100,10 @@ int frame80215e_create_ie_header_list_termination_2(uint8_t *buf, int len,
 /* Payload IE. List termination */
 int frame80215e_create_ie_payload_list_termination(uint8_t *buf, int len,
     struct ieee802154_ies *ies);
+/* Payload IE. IETF IE holding a 6top IE (6P message). Used by 6top.
+ * The content may already be in buf, at the place of the IE content */
+int frame80215e_create_ie_sixtop(uint8_t *buf, int len,
+    struct ieee802154_ies *ies);
 /* Payload IE. MLME. Used to nest sub-IEs */
 int frame80215e_create_ie_mlme(uint8_t *buf, int len,
     struct ieee802154_ies *ies);
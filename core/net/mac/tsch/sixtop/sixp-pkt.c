@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         6top Protocol (6P) messages, c.f. RFC 8480: creation and parsing
+ *
+ */
+
+#include "contiki.h"
+#include "net/mac/tsch/sixtop/sixp-pkt.h"
+#include <string.h>
+
+#define WRITE16(buf, val) \
+  do { ((uint8_t *)(buf))[0] = (val) & 0xff; \
+       ((uint8_t *)(buf))[1] = ((val) >> 8) & 0xff; } while(0)
+
+#define READ16(buf) \
+  (((const uint8_t *)(buf))[0] | ((const uint8_t *)(buf))[1] << 8)
+
+/*---------------------------------------------------------------------------*/
+/* Parses a 6P message. The cell lists of pkt point into buf.
+ * Returns 0 if success, -1 if the message is malformed, and -2 if it has
+ * an unsupported version */
+int
+sixp_pkt_parse(uint8_t *buf, uint16_t len, struct sixp_pkt *pkt)
+{
+  uint8_t *body;
+  uint16_t body_len;
+
+  if(buf == NULL || pkt == NULL || len < SIXP_PKT_HDR_LEN) {
+    return -1;
+  }
+  memset(pkt, 0, sizeof(struct sixp_pkt));
+
+  /* Version: b0-b3, type: b4-b5, reserved: b6-b7 */
+  pkt->type = (buf[0] >> 4) & 0x03;
+  pkt->code = buf[1];
+  pkt->sfid = buf[2];
+  pkt->seqnum = buf[3];
+  if((buf[0] & 0x0f) != SIXP_PKT_VERSION) {
+    return -2;
+  }
+
+  body = buf + SIXP_PKT_HDR_LEN;
+  body_len = len - SIXP_PKT_HDR_LEN;
+
+  if(pkt->type == SIXP_PKT_TYPE_REQUEST) {
+    if(body_len < 2) {
+      return -1;
+    }
+    pkt->metadata = READ16(body);
+    switch(pkt->code) {
+      case SIXP_PKT_CMD_ADD:
+      case SIXP_PKT_CMD_DELETE:
+      case SIXP_PKT_CMD_RELOCATE:
+        if(body_len < 4 || (body_len - 4) % SIXP_PKT_CELL_LEN != 0) {
+          return -1;
+        }
+        pkt->cell_options = body[2];
+        pkt->num_cells = body[3];
+        pkt->cell_list = body + 4;
+        pkt->cell_list_len = (body_len - 4) / SIXP_PKT_CELL_LEN;
+        if(pkt->code == SIXP_PKT_CMD_RELOCATE) {
+          /* The relocation cell list holds exactly num_cells cells,
+           * the candidate cell list follows */
+          if(pkt->cell_list_len < pkt->num_cells) {
+            return -1;
+          }
+          pkt->candidate_list = pkt->cell_list + pkt->num_cells * SIXP_PKT_CELL_LEN;
+          pkt->candidate_list_len = pkt->cell_list_len - pkt->num_cells;
+          pkt->cell_list_len = pkt->num_cells;
+        }
+        break;
+      default:
+        /* CLEAR has only metadata. We do not look into the body of
+         * the other commands, which we do not support. */
+        break;
+    }
+  } else if(pkt->type == SIXP_PKT_TYPE_RESPONSE
+            || pkt->type == SIXP_PKT_TYPE_CONFIRMATION) {
+    /* The body of responses to ADD, DELETE and RELOCATE is a cell list,
+     * and that of CLEAR is empty */
+    if(body_len % SIXP_PKT_CELL_LEN != 0) {
+      return -1;
+    }
+    pkt->cell_list = body_len > 0 ? body : NULL;
+    pkt->cell_list_len = body_len / SIXP_PKT_CELL_LEN;
+  } else {
+    return -1;
+  }
+
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Writes a 6P message to buf. The cell lists of pkt may already be in
+ * place in buf. Returns the length of the message, -1 if it does not fit */
+int
+sixp_pkt_create(const struct sixp_pkt *pkt, uint8_t *buf, uint16_t len)
+{
+  uint16_t curr_len = SIXP_PKT_HDR_LEN;
+  uint16_t cells_len;
+  uint16_t candidates_len = 0;
+
+  if(pkt == NULL || buf == NULL || len < SIXP_PKT_HDR_LEN) {
+    return -1;
+  }
+
+  cells_len = pkt->cell_list_len * SIXP_PKT_CELL_LEN;
+  if(pkt->type == SIXP_PKT_TYPE_REQUEST) {
+    switch(pkt->code) {
+      case SIXP_PKT_CMD_RELOCATE:
+        candidates_len = pkt->candidate_list_len * SIXP_PKT_CELL_LEN;
+        if(pkt->cell_list_len != pkt->num_cells) {
+          return -1;
+        }
+        /* Fall through */
+      case SIXP_PKT_CMD_ADD:
+      case SIXP_PKT_CMD_DELETE:
+        if(len < curr_len + 4 + cells_len + candidates_len) {
+          return -1;
+        }
+        /* Move the cell lists first, they may be where the fields go */
+        if(candidates_len > 0) {
+          memmove(buf + curr_len + 4 + cells_len, pkt->candidate_list, candidates_len);
+        }
+        if(cells_len > 0) {
+          memmove(buf + curr_len + 4, pkt->cell_list, cells_len);
+        }
+        WRITE16(buf + curr_len, pkt->metadata);
+        buf[curr_len + 2] = pkt->cell_options;
+        buf[curr_len + 3] = pkt->num_cells;
+        curr_len += 4 + cells_len + candidates_len;
+        break;
+      case SIXP_PKT_CMD_CLEAR:
+        if(len < curr_len + 2) {
+          return -1;
+        }
+        WRITE16(buf + curr_len, pkt->metadata);
+        curr_len += 2;
+        break;
+      default:
+        /* Not supported */
+        return -1;
+    }
+  } else {
+    if(len < curr_len + cells_len) {
+      return -1;
+    }
+    if(cells_len > 0) {
+      memmove(buf + curr_len, pkt->cell_list, cells_len);
+    }
+    curr_len += cells_len;
+  }
+
+  buf[0] = SIXP_PKT_VERSION | ((pkt->type & 0x03) << 4);
+  buf[1] = pkt->code;
+  buf[2] = pkt->sfid;
+  buf[3] = pkt->seqnum;
+
+  return curr_len;
+}
+/*---------------------------------------------------------------------------*/
+/* Reads the i-th cell of a cell list */
+void
+sixp_pkt_get_cell(const uint8_t *cell_list, uint8_t i, struct sixp_pkt_cell *cell)
+{
+  cell->timeslot = READ16(cell_list + i * SIXP_PKT_CELL_LEN);
+  cell->channel_offset = READ16(cell_list + i * SIXP_PKT_CELL_LEN + 2);
+}
+/*---------------------------------------------------------------------------*/
+/* Writes the i-th cell of a cell list */
+void
+sixp_pkt_set_cell(uint8_t *cell_list, uint8_t i, const struct sixp_pkt_cell *cell)
+{
+  WRITE16(cell_list + i * SIXP_PKT_CELL_LEN, cell->timeslot);
+  WRITE16(cell_list + i * SIXP_PKT_CELL_LEN + 2, cell->channel_offset);
+}
+/*---------------------------------------------------------------------------*/
+/* Looks for a cell in a cell list. Returns its index, -1 if not found */
+int
+sixp_pkt_find_cell(const uint8_t *cell_list, uint8_t cell_list_len,
+                   const struct sixp_pkt_cell *cell)
+{
+  struct sixp_pkt_cell c;
+  uint8_t i;
+  for(i = 0; i < cell_list_len; i++) {
+    sixp_pkt_get_cell(cell_list, i, &c);
+    if(c.timeslot == cell->timeslot && c.channel_offset == cell->channel_offset) {
+      return i;
+    }
+  }
+  return -1;
+}
+/*---------------------------------------------------------------------------*/
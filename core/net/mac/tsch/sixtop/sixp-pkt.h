@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         6top Protocol (6P) messages, c.f. RFC 8480: creation and parsing
+ *
+ */
+
+#ifndef __SIXP_PKT_H__
+#define __SIXP_PKT_H__
+
+/********** Includes **********/
+
+#include "contiki.h"
+
+/******** Configuration *******/
+
+/* Max length of a 6P message, i.e. of the content of a 6top IE. Bounds the
+ * number of cells in a message: (SIXP_PKT_MAX_LEN - 8) / 4 */
+#ifdef SIXP_PKT_CONF_MAX_LEN
+#define SIXP_PKT_MAX_LEN SIXP_PKT_CONF_MAX_LEN
+#else
+#define SIXP_PKT_MAX_LEN 64
+#endif
+
+/********** Constants *********/
+
+#define SIXP_PKT_VERSION          0
+
+/* Header length (version and type, code, SFID, SeqNum) */
+#define SIXP_PKT_HDR_LEN          4
+/* Length of a cell in a cell list: slotOffset and channelOffset */
+#define SIXP_PKT_CELL_LEN         4
+/* Max number of cells in a message */
+#define SIXP_PKT_MAX_CELLS        ((SIXP_PKT_MAX_LEN - SIXP_PKT_HDR_LEN - 4) / SIXP_PKT_CELL_LEN)
+
+/* Message types */
+#define SIXP_PKT_TYPE_REQUEST       0
+#define SIXP_PKT_TYPE_RESPONSE      1
+#define SIXP_PKT_TYPE_CONFIRMATION  2
+
+/* Commands, the code of requests */
+#define SIXP_PKT_CMD_ADD          1
+#define SIXP_PKT_CMD_DELETE       2
+#define SIXP_PKT_CMD_RELOCATE     3
+#define SIXP_PKT_CMD_COUNT        4
+#define SIXP_PKT_CMD_LIST         5
+#define SIXP_PKT_CMD_SIGNAL       6
+#define SIXP_PKT_CMD_CLEAR        7
+
+/* Return codes, the code of responses */
+#define SIXP_PKT_RC_SUCCESS       0
+#define SIXP_PKT_RC_EOL           1
+#define SIXP_PKT_RC_ERR           2
+#define SIXP_PKT_RC_RESET         3
+#define SIXP_PKT_RC_ERR_VERSION   4
+#define SIXP_PKT_RC_ERR_SFID      5
+#define SIXP_PKT_RC_ERR_SEQNUM    6
+#define SIXP_PKT_RC_ERR_CELLLIST  7
+#define SIXP_PKT_RC_ERR_BUSY      8
+#define SIXP_PKT_RC_ERR_LOCKED    9
+
+/* Cell options, from the point of view of the sender of the request.
+ * Same values as the TSCH link options. */
+#define SIXP_PKT_CELL_OPTION_TX     1
+#define SIXP_PKT_CELL_OPTION_RX     2
+#define SIXP_PKT_CELL_OPTION_SHARED 4
+
+/************ Types ***********/
+
+struct sixp_pkt_cell {
+  uint16_t timeslot;
+  uint16_t channel_offset;
+};
+
+/* A 6P message. Cell lists are kept in their wire format; use
+ * sixp_pkt_get_cell() and sixp_pkt_set_cell() to access them.
+ * Which fields are present depends on the type and code:
+ * - ADD, DELETE requests: metadata, cell_options, num_cells, cell_list
+ * - RELOCATE requests: metadata, cell_options, num_cells, cell_list (the
+ *   relocation cell list, of num_cells cells) and candidate_list
+ * - CLEAR requests: metadata
+ * - responses: cell_list */
+struct sixp_pkt {
+  uint8_t type;
+  /* Command of a request, return code of a response */
+  uint8_t code;
+  uint8_t sfid;
+  uint8_t seqnum;
+  uint16_t metadata;
+  uint8_t cell_options;
+  uint8_t num_cells;
+  uint8_t *cell_list;
+  uint8_t cell_list_len;
+  uint8_t *candidate_list;
+  uint8_t candidate_list_len;
+};
+
+/********** Functions *********/
+
+/* Parses a 6P message. The cell lists of pkt point into buf.
+ * Returns 0 if success, -1 if the message is malformed, and -2 if it has
+ * an unsupported version */
+int sixp_pkt_parse(uint8_t *buf, uint16_t len, struct sixp_pkt *pkt);
+/* Writes a 6P message to buf. The cell lists of pkt may already be in
+ * place in buf. Returns the length of the message, -1 if it does not fit */
+int sixp_pkt_create(const struct sixp_pkt *pkt, uint8_t *buf, uint16_t len);
+/* Reads the i-th cell of a cell list */
+void sixp_pkt_get_cell(const uint8_t *cell_list, uint8_t i, struct sixp_pkt_cell *cell);
+/* Writes the i-th cell of a cell list */
+void sixp_pkt_set_cell(uint8_t *cell_list, uint8_t i, const struct sixp_pkt_cell *cell);
+/* Looks for a cell in a cell list. Returns its index, -1 if not found */
+int sixp_pkt_find_cell(const uint8_t *cell_list, uint8_t cell_list_len,
+                       const struct sixp_pkt_cell *cell);
+
+#endif /* __SIXP_PKT_H__ */
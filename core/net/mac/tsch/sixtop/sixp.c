@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         6top Protocol (6P), c.f. RFC 8480: 2-step transactions and
+ *         sequence numbers
+ *
+ */
+
+#include "contiki.h"
+#include "lib/list.h"
+#include "lib/memb.h"
+#include "net/nbr-table.h"
+#include "net/mac/mac.h"
+#include "net/mac/tsch/tsch.h"
+#include "net/mac/tsch/tsch-log.h"
+#include "net/mac/tsch/sixtop/sixtop.h"
+#include "net/mac/tsch/sixtop/sixp.h"
+#include <string.h>
+
+#if TSCH_LOG_LEVEL >= 1
+#define DEBUG DEBUG_PRINT
+#else /* TSCH_LOG_LEVEL */
+#define DEBUG DEBUG_NONE
+#endif /* TSCH_LOG_LEVEL */
+#include "net/net-debug.h"
+
+/* Transaction states */
+#define SIXP_TRANS_STATE_REQUEST_SENDING  0
+#define SIXP_TRANS_STATE_REQUEST_SENT     1
+#define SIXP_TRANS_STATE_RESPONSE_SENDING 2
+
+/* A 2-step transaction, from the point of view of either peer */
+struct sixp_trans {
+  struct sixp_trans *next;
+  linkaddr_t peer;
+  const struct sixtop_sf *sf;
+  uint8_t is_initiator;
+  uint8_t state;
+  /* Identifies the transaction in MAC callbacks, which may come after the
+   * transaction is over */
+  uint8_t id;
+  /* Initiator: the response timeout. Responder: a guard in case the MAC
+   * never reports on the response */
+  struct ctimer timer;
+  uint8_t request[SIXP_PKT_MAX_LEN];
+  uint8_t request_len;
+  uint8_t response[SIXP_PKT_MAX_LEN];
+  uint8_t response_len;
+};
+
+/* Per-neighbor 6P state */
+struct sixp_nbr {
+  uint8_t seqnum;
+};
+
+MEMB(trans_memb, struct sixp_trans, SIXP_MAX_TRANSACTIONS);
+LIST(trans_list);
+NBR_TABLE(struct sixp_nbr, sixp_nbrs);
+static uint8_t trans_next_id;
+
+/*---------------------------------------------------------------------------*/
+static struct sixp_trans *
+find_trans_by_peer(const linkaddr_t *peer)
+{
+  struct sixp_trans *t;
+  for(t = list_head(trans_list); t != NULL; t = list_item_next(t)) {
+    if(linkaddr_cmp(&t->peer, peer)) {
+      return t;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static struct sixp_trans *
+find_trans_by_id(uint8_t id)
+{
+  struct sixp_trans *t;
+  for(t = list_head(trans_list); t != NULL; t = list_item_next(t)) {
+    if(t->id == id) {
+      return t;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static struct sixp_trans *
+alloc_trans(const linkaddr_t *peer, const struct sixtop_sf *sf, uint8_t is_initiator)
+{
+  struct sixp_trans *t = memb_alloc(&trans_memb);
+  if(t != NULL) {
+    linkaddr_copy(&t->peer, peer);
+    t->sf = sf;
+    t->is_initiator = is_initiator;
+    t->state = is_initiator ? SIXP_TRANS_STATE_REQUEST_SENDING
+                            : SIXP_TRANS_STATE_RESPONSE_SENDING;
+    t->id = trans_next_id++;
+    t->request_len = 0;
+    t->response_len = 0;
+    list_add(trans_list, t);
+  }
+  return t;
+}
+/*---------------------------------------------------------------------------*/
+static void
+free_trans(struct sixp_trans *t)
+{
+  ctimer_stop(&t->timer);
+  list_remove(trans_list, t);
+  memb_free(&trans_memb, t);
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+get_seqnum(const linkaddr_t *peer)
+{
+  struct sixp_nbr *nbr = nbr_table_get_from_lladdr(sixp_nbrs, peer);
+  return nbr != NULL ? nbr->seqnum : 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Sets the sequence number of peer. Use next_seqnum to advance it: it wraps
+ * to 1, 0 being reserved for a neighbor whose schedule was cleared */
+static void
+set_seqnum(const linkaddr_t *peer, uint8_t seqnum)
+{
+  struct sixp_nbr *nbr = nbr_table_get_from_lladdr(sixp_nbrs, peer);
+  if(nbr == NULL && seqnum != 0) {
+    nbr = nbr_table_add_lladdr(sixp_nbrs, peer, NBR_TABLE_REASON_SIXTOP, NULL);
+  }
+  if(nbr != NULL) {
+    nbr->seqnum = seqnum;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+next_seqnum(uint8_t seqnum)
+{
+  return seqnum == 0xff ? 1 : seqnum + 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Sends a response outside of any transaction, for requests we reject
+ * before handing them to a scheduling function */
+static void
+send_error(const linkaddr_t *peer, const struct sixp_pkt *request, uint8_t rc)
+{
+  uint8_t buf[SIXP_PKT_HDR_LEN];
+  struct sixp_pkt response;
+  int len;
+
+  memset(&response, 0, sizeof(response));
+  response.type = SIXP_PKT_TYPE_RESPONSE;
+  response.code = rc;
+  response.sfid = request->sfid;
+  response.seqnum = request->seqnum;
+  if((len = sixp_pkt_create(&response, buf, sizeof(buf))) > 0) {
+    PRINTF("6P: rejecting request %u from %u, rc %u\n",
+           request->code, TSCH_LOG_ID_FROM_LINKADDR(peer), rc);
+    sixtop_output(peer, buf, len, NULL, NULL);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* The initiator gives up on a transaction */
+static void
+abort_initiator(struct sixp_trans *t)
+{
+  uint8_t request_buf[SIXP_PKT_MAX_LEN];
+  struct sixp_pkt request;
+  linkaddr_t peer;
+  const struct sixtop_sf *sf = t->sf;
+
+  PRINTF("6P: transaction with %u failed\n", TSCH_LOG_ID_FROM_LINKADDR(&t->peer));
+
+  /* Free the transaction before calling the SF, which may start another */
+  linkaddr_copy(&peer, &t->peer);
+  memcpy(request_buf, t->request, t->request_len);
+  sixp_pkt_parse(request_buf, t->request_len, &request);
+  free_trans(t);
+
+  if(sf->timeout != NULL) {
+    sf->timeout(&peer, &request);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* The responder is done with a transaction. status is a MAC_TX_ status */
+static void
+end_responder(struct sixp_trans *t, int status)
+{
+  struct sixp_pkt request;
+  struct sixp_pkt response;
+
+  sixp_pkt_parse(t->request, t->request_len, &request);
+  sixp_pkt_parse(t->response, t->response_len, &response);
+
+  /* The seqnum of CLEAR was reset when responding. Others advance once the
+   * initiator has received a successful response. */
+  if(status == MAC_TX_OK && request.code != SIXP_PKT_CMD_CLEAR
+     && response.code == SIXP_PKT_RC_SUCCESS) {
+    set_seqnum(&t->peer, next_seqnum(request.seqnum));
+  }
+
+  if(t->sf->response_sent != NULL) {
+    t->sf->response_sent(&t->peer, &request, &response, status);
+  }
+  free_trans(t);
+}
+/*---------------------------------------------------------------------------*/
+static void
+handle_timeout(void *ptr)
+{
+  struct sixp_trans *t = ptr;
+  if(t->is_initiator) {
+    abort_initiator(t);
+  } else {
+    end_responder(t, MAC_TX_ERR);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+packet_sent(void *ptr, int status, int transmissions)
+{
+  struct sixp_trans *t = find_trans_by_id((uint8_t)(uintptr_t)ptr);
+  if(t == NULL) {
+    /* The transaction is over already, e.g. the response was received
+     * before we were notified of the request */
+    return;
+  }
+  if(t->is_initiator) {
+    if(status == MAC_TX_OK) {
+      t->state = SIXP_TRANS_STATE_REQUEST_SENT;
+    } else {
+      abort_initiator(t);
+    }
+  } else {
+    end_responder(t, status);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+handle_request(const struct sixp_pkt *pkt, const uint8_t *buf, uint16_t len,
+               const linkaddr_t *src)
+{
+  const struct sixtop_sf *sf;
+  struct sixp_trans *t;
+  struct sixp_pkt request;
+  struct sixp_pkt response;
+  int ret;
+
+  if((sf = sixtop_find_sf(pkt->sfid)) == NULL) {
+    send_error(src, pkt, SIXP_PKT_RC_ERR_SFID);
+    return;
+  }
+  if(find_trans_by_peer(src) != NULL) {
+    send_error(src, pkt, SIXP_PKT_RC_ERR_BUSY);
+    return;
+  }
+  if(pkt->code != SIXP_PKT_CMD_CLEAR && pkt->seqnum != get_seqnum(src)) {
+    send_error(src, pkt, SIXP_PKT_RC_ERR_SEQNUM);
+    return;
+  }
+  if(pkt->code != SIXP_PKT_CMD_ADD && pkt->code != SIXP_PKT_CMD_DELETE
+     && pkt->code != SIXP_PKT_CMD_RELOCATE && pkt->code != SIXP_PKT_CMD_CLEAR) {
+    /* COUNT, LIST and SIGNAL are not supported */
+    send_error(src, pkt, SIXP_PKT_RC_ERR);
+    return;
+  }
+  if(len > sizeof(t->request)) {
+    /* More cells than a transaction can hold */
+    send_error(src, pkt, SIXP_PKT_RC_ERR);
+    return;
+  }
+  if((t = alloc_trans(src, sf, 0)) == NULL) {
+    send_error(src, pkt, SIXP_PKT_RC_ERR_BUSY);
+    return;
+  }
+
+  /* buf is in packetbuf, which sending the response overwrites */
+  memcpy(t->request, buf, len);
+  t->request_len = len;
+  sixp_pkt_parse(t->request, t->request_len, &request);
+
+  /* The SF writes the cells of the response in place */
+  memset(&response, 0, sizeof(response));
+  response.type = SIXP_PKT_TYPE_RESPONSE;
+  response.code = SIXP_PKT_RC_SUCCESS;
+  response.sfid = request.sfid;
+  response.seqnum = request.seqnum;
+  response.cell_list = t->response + SIXP_PKT_HDR_LEN;
+  if(sf->request_input != NULL) {
+    sf->request_input(src, &request, &response);
+  } else {
+    response.code = SIXP_PKT_RC_ERR;
+  }
+
+  if((ret = sixp_pkt_create(&response, t->response, sizeof(t->response))) < 0) {
+    free_trans(t);
+    return;
+  }
+  t->response_len = ret;
+
+  if(request.code == SIXP_PKT_CMD_CLEAR) {
+    set_seqnum(src, 0);
+  }
+
+  PRINTF("6P: request %u from %u, seqnum %u, rc %u\n",
+         request.code, TSCH_LOG_ID_FROM_LINKADDR(src), request.seqnum, response.code);
+
+  ctimer_set(&t->timer, sf->timeout_interval, handle_timeout, t);
+  if(sixtop_output(src, t->response, t->response_len, packet_sent,
+                   (void *)(uintptr_t)t->id) < 0) {
+    end_responder(t, MAC_TX_ERR);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+handle_response(const uint8_t *buf, uint16_t len, const linkaddr_t *src)
+{
+  uint8_t request_buf[SIXP_PKT_MAX_LEN];
+  uint8_t response_buf[SIXP_PKT_MAX_LEN];
+  struct sixp_pkt request;
+  struct sixp_pkt response;
+  const struct sixtop_sf *sf;
+  struct sixp_trans *t;
+
+  t = find_trans_by_peer(src);
+  if(t == NULL || !t->is_initiator || len > sizeof(response_buf)) {
+    PRINTF("6P:! unexpected response from %u\n", TSCH_LOG_ID_FROM_LINKADDR(src));
+    return;
+  }
+
+  /* Copy out both messages, so that the transaction can be freed and the
+   * SF can start another one from its callback */
+  memcpy(request_buf, t->request, t->request_len);
+  sixp_pkt_parse(request_buf, t->request_len, &request);
+  memcpy(response_buf, buf, len);
+  sixp_pkt_parse(response_buf, len, &response);
+
+  if(response.sfid != request.sfid || response.seqnum != request.seqnum) {
+    PRINTF("6P:! response from %u does not match request\n",
+           TSCH_LOG_ID_FROM_LINKADDR(src));
+    return;
+  }
+
+  sf = t->sf;
+  free_trans(t);
+
+  if(request.code == SIXP_PKT_CMD_CLEAR) {
+    set_seqnum(src, 0);
+  } else if(response.code == SIXP_PKT_RC_SUCCESS) {
+    set_seqnum(src, next_seqnum(request.seqnum));
+  }
+
+  PRINTF("6P: response from %u to request %u, seqnum %u, rc %u\n",
+         TSCH_LOG_ID_FROM_LINKADDR(src), request.code, request.seqnum, response.code);
+
+  if(sf->response_input != NULL) {
+    sf->response_input(src, &request, &response);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Starts a transaction with a request to peer. The SFID, type and
+ * sequence number of the request are set by 6P.
+ * Returns 0 if success, -1 otherwise */
+int
+sixp_send_request(const linkaddr_t *peer, uint8_t sfid,
+                  struct sixp_pkt *request)
+{
+  const struct sixtop_sf *sf;
+  struct sixp_trans *t;
+  int ret;
+
+  if(peer == NULL || request == NULL
+     || (sf = sixtop_find_sf(sfid)) == NULL
+     || find_trans_by_peer(peer) != NULL
+     || (t = alloc_trans(peer, sf, 1)) == NULL) {
+    return -1;
+  }
+
+  request->type = SIXP_PKT_TYPE_REQUEST;
+  request->sfid = sfid;
+  request->seqnum = get_seqnum(peer);
+  if((ret = sixp_pkt_create(request, t->request, sizeof(t->request))) < 0) {
+    free_trans(t);
+    return -1;
+  }
+  t->request_len = ret;
+
+  PRINTF("6P: request %u to %u, seqnum %u\n",
+         request->code, TSCH_LOG_ID_FROM_LINKADDR(peer), request->seqnum);
+
+  ctimer_set(&t->timer, sf->timeout_interval, handle_timeout, t);
+  if(sixtop_output(peer, t->request, t->request_len, packet_sent,
+                   (void *)(uintptr_t)t->id) < 0) {
+    free_trans(t);
+    return -1;
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Is there an ongoing transaction with peer? */
+int
+sixp_is_busy(const linkaddr_t *peer)
+{
+  return find_trans_by_peer(peer) != NULL;
+}
+/*---------------------------------------------------------------------------*/
+/* Resets the sequence number of peer, e.g. when the schedule with it
+ * was cleared */
+void
+sixp_reset_nbr(const linkaddr_t *peer)
+{
+  set_seqnum(peer, 0);
+}
+/*---------------------------------------------------------------------------*/
+/* Handles an incoming 6P message from src */
+void
+sixp_input(uint8_t *buf, uint16_t len, const linkaddr_t *src)
+{
+  struct sixp_pkt pkt;
+  int ret = sixp_pkt_parse(buf, len, &pkt);
+
+  if(ret == -2) {
+    if(pkt.type == SIXP_PKT_TYPE_REQUEST) {
+      send_error(src, &pkt, SIXP_PKT_RC_ERR_VERSION);
+    }
+    return;
+  } else if(ret < 0) {
+    PRINTF("6P:! malformed message from %u\n", TSCH_LOG_ID_FROM_LINKADDR(src));
+    return;
+  }
+
+  switch(pkt.type) {
+    case SIXP_PKT_TYPE_REQUEST:
+      handle_request(&pkt, buf, len, src);
+      break;
+    case SIXP_PKT_TYPE_RESPONSE:
+      handle_response(buf, len, src);
+      break;
+    default:
+      /* 3-step transactions are not supported */
+      break;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Initializes 6P */
+void
+sixp_init(void)
+{
+  memb_init(&trans_memb);
+  list_init(trans_list);
+  nbr_table_register(sixp_nbrs, NULL);
+}
+/*---------------------------------------------------------------------------*/
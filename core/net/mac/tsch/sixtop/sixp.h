@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         6top Protocol (6P), c.f. RFC 8480: 2-step transactions and
+ *         sequence numbers
+ *
+ */
+
+#ifndef __SIXP_H__
+#define __SIXP_H__
+
+/********** Includes **********/
+
+#include "contiki.h"
+#include "net/linkaddr.h"
+#include "net/mac/tsch/sixtop/sixp-pkt.h"
+
+/******** Configuration *******/
+
+/* Max number of concurrent transactions, at most one per neighbor */
+#ifdef SIXP_CONF_MAX_TRANSACTIONS
+#define SIXP_MAX_TRANSACTIONS SIXP_CONF_MAX_TRANSACTIONS
+#else
+#define SIXP_MAX_TRANSACTIONS 2
+#endif
+
+/********** Functions *********/
+
+/* Starts a transaction with a request to peer. The SFID, type and
+ * sequence number of the request are set by 6P.
+ * Returns 0 if success, -1 otherwise */
+int sixp_send_request(const linkaddr_t *peer, uint8_t sfid,
+                      struct sixp_pkt *request);
+/* Is there an ongoing transaction with peer? */
+int sixp_is_busy(const linkaddr_t *peer);
+/* Resets the sequence number of peer, e.g. when the schedule with it
+ * was cleared */
+void sixp_reset_nbr(const linkaddr_t *peer);
+/* Handles an incoming 6P message from src */
+void sixp_input(uint8_t *buf, uint16_t len, const linkaddr_t *src);
+/* Initializes 6P */
+void sixp_init(void);
+
+#endif /* __SIXP_H__ */
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         6top sublayer, c.f. RFC 8480. Carries 6P messages in 6top IEs
+ *         and dispatches them to scheduling functions (SF).
+ *
+ */
+
+#include "contiki.h"
+#include "net/packetbuf.h"
+#include "net/netstack.h"
+#include "net/mac/frame802154e-ie.h"
+#include "net/mac/tsch/tsch.h"
+#include "net/mac/tsch/tsch-log.h"
+#include "net/mac/tsch/sixtop/sixtop.h"
+#include "net/mac/tsch/sixtop/sixp.h"
+#include <string.h>
+
+#if TSCH_LOG_LEVEL >= 1
+#define DEBUG DEBUG_PRINT
+#else /* TSCH_LOG_LEVEL */
+#define DEBUG DEBUG_NONE
+#endif /* TSCH_LOG_LEVEL */
+#include "net/net-debug.h"
+
+/* The registered scheduling functions */
+static const struct sixtop_sf *sf_list[SIXTOP_MAX_SCHEDULING_FUNCTIONS];
+
+/*---------------------------------------------------------------------------*/
+/* Registers a scheduling function. Returns 0 if success, -1 otherwise */
+int
+sixtop_add_sf(const struct sixtop_sf *sf)
+{
+  int i;
+  if(sf == NULL || sixtop_find_sf(sf->sfid) != NULL) {
+    return -1;
+  }
+  for(i = 0; i < SIXTOP_MAX_SCHEDULING_FUNCTIONS; i++) {
+    if(sf_list[i] == NULL) {
+      sf_list[i] = sf;
+      if(sf->init != NULL) {
+        sf->init();
+      }
+      PRINTF("6top: added sf %u\n", sf->sfid);
+      return 0;
+    }
+  }
+  PRINTF("6top:! no room for sf %u\n", sf->sfid);
+  return -1;
+}
+/*---------------------------------------------------------------------------*/
+/* Looks up a scheduling function by SFID */
+const struct sixtop_sf *
+sixtop_find_sf(uint8_t sfid)
+{
+  int i;
+  for(i = 0; i < SIXTOP_MAX_SCHEDULING_FUNCTIONS; i++) {
+    if(sf_list[i] != NULL && sf_list[i]->sfid == sfid) {
+      return sf_list[i];
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/* Sends a 6P message to dest, in a 6top IE. The frame has an empty header IE
+ * list, terminated by a Header Termination 1 IE, and the 6top IE as the
+ * only payload IE. */
+int
+sixtop_output(const linkaddr_t *dest, const uint8_t *msg, uint16_t len,
+              mac_callback_t sent, void *ptr)
+{
+  struct ieee802154_ies ies;
+  int ret;
+
+  if(dest == NULL || msg == NULL) {
+    return -1;
+  }
+
+  packetbuf_clear();
+
+  /* Payload IE: the 6top IE */
+  memset(&ies, 0, sizeof(ies));
+  ies.ie_sixtop_content = msg;
+  ies.ie_sixtop_content_len = len;
+  if((ret = frame80215e_create_ie_sixtop(packetbuf_dataptr(), PACKETBUF_SIZE, &ies)) == -1) {
+    return -1;
+  }
+  packetbuf_set_datalen(ret);
+
+  /* Header IE list termination, before the payload IEs */
+  if(!packetbuf_hdralloc(2)
+     || frame80215e_create_ie_header_list_termination_1(packetbuf_hdrptr(), 2, &ies) == -1) {
+    return -1;
+  }
+
+  packetbuf_set_attr(PACKETBUF_ATTR_IE_LIST_PRESENT, 1);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, dest);
+
+  NETSTACK_MAC.send(sent, ptr);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Called by TSCH for every incoming data frame. Returns 1 if the frame
+ * was a 6P message, which 6top consumed, 0 otherwise */
+int
+sixtop_input(void)
+{
+  struct ieee802154_ies ies;
+  linkaddr_t src;
+
+  if(!packetbuf_attr(PACKETBUF_ATTR_IE_LIST_PRESENT)) {
+    return 0;
+  }
+
+  memset(&ies, 0, sizeof(ies));
+  if(frame802154e_parse_information_elements(packetbuf_dataptr(),
+                                             packetbuf_datalen(), &ies) == -1
+     || ies.ie_sixtop_content == NULL) {
+    return 0;
+  }
+
+  /* 6P may send a response, overwriting packetbuf. The message itself is
+   * copied by 6P before doing so. */
+  linkaddr_copy(&src, packetbuf_addr(PACKETBUF_ADDR_SENDER));
+  sixp_input((uint8_t *)ies.ie_sixtop_content, ies.ie_sixtop_content_len, &src);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Initializes 6top and 6P */
+void
+sixtop_init(void)
+{
+  memset(sf_list, 0, sizeof(sf_list));
+  sixp_init();
+}
+/*---------------------------------------------------------------------------*/
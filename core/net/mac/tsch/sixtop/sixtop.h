@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         6top sublayer, c.f. RFC 8480. Carries 6P messages in 6top IEs
+ *         and dispatches them to scheduling functions (SF).
+ *
+ */
+
+#ifndef __SIXTOP_H__
+#define __SIXTOP_H__
+
+/********** Includes **********/
+
+#include "contiki.h"
+#include "net/linkaddr.h"
+#include "net/mac/mac.h"
+#include "net/mac/tsch/sixtop/sixp-pkt.h"
+
+/******** Configuration *******/
+
+/* Max number of scheduling functions registered at a time */
+#ifdef SIXTOP_CONF_MAX_SCHEDULING_FUNCTIONS
+#define SIXTOP_MAX_SCHEDULING_FUNCTIONS SIXTOP_CONF_MAX_SCHEDULING_FUNCTIONS
+#else
+#define SIXTOP_MAX_SCHEDULING_FUNCTIONS 1
+#endif
+
+/************ Types ***********/
+
+/* A scheduling function. All callbacks are optional.
+ * 6P takes care of transactions and sequence numbers; the SF decides which
+ * cells to add, delete or relocate, and installs them in the schedule. */
+struct sixtop_sf {
+  uint8_t sfid;
+  /* Time after which an initiator gives up on a transaction */
+  clock_time_t timeout_interval;
+  /* Called at registration */
+  void (*init)(void);
+  /* Responder: a request was received. Fills in the return code and the
+   * cell list of the response, which has room for SIXP_PKT_MAX_CELLS cells */
+  void (*request_input)(const linkaddr_t *peer, const struct sixp_pkt *request,
+                        struct sixp_pkt *response);
+  /* Responder: the response was sent, status is a MAC_TX_ status. The
+   * cells of the response are to be installed only if status is MAC_TX_OK */
+  void (*response_sent)(const linkaddr_t *peer, const struct sixp_pkt *request,
+                        const struct sixp_pkt *response, int status);
+  /* Initiator: a response was received */
+  void (*response_input)(const linkaddr_t *peer, const struct sixp_pkt *request,
+                         const struct sixp_pkt *response);
+  /* Initiator: the request could not be sent or no response was received */
+  void (*timeout)(const linkaddr_t *peer, const struct sixp_pkt *request);
+};
+
+/********** Functions *********/
+
+/* Registers a scheduling function. Returns 0 if success, -1 otherwise */
+int sixtop_add_sf(const struct sixtop_sf *sf);
+/* Looks up a scheduling function by SFID */
+const struct sixtop_sf *sixtop_find_sf(uint8_t sfid);
+/* Sends a 6P message to dest, in a 6top IE */
+int sixtop_output(const linkaddr_t *dest, const uint8_t *msg, uint16_t len,
+                  mac_callback_t sent, void *ptr);
+/* Called by TSCH for every incoming data frame. Returns 1 if the frame
+ * was a 6P message, which 6top consumed, 0 otherwise */
+int sixtop_input(void);
+/* Initializes 6top and 6P */
+void sixtop_init(void);
+
+#endif /* __SIXTOP_H__ */
@@ -198,4 +198,20 @@
 #define TSCH_CHANNEL_SCAN_DURATION CLOCK_SECOND
 #endif
 
+/* Enable the 6top sublayer and 6P, c.f. sixtop/. The negotiation itself is
+ * up to a scheduling function, e.g. apps/msf */
+#ifdef TSCH_CONF_WITH_SIXTOP
+#define TSCH_WITH_SIXTOP TSCH_CONF_WITH_SIXTOP
+#else
+#define TSCH_WITH_SIXTOP 0
+#endif
+
+/* Record how long each phase of the slot operation takes, c.f.
+ * tsch-slot-stats.h */
+#ifdef TSCH_CONF_WITH_SLOT_STATS
+#define TSCH_WITH_SLOT_STATS TSCH_CONF_WITH_SLOT_STATS
+#else
+#define TSCH_WITH_SLOT_STATS 0
+#endif
+
 #endif /* __TSCH_CONF_H__ */
@@ -44,6 +44,7 @@
 
 #include "contiki.h"
 #include "lib/list.h"
+#include "lib/dlist.h"
 #include "lib/memb.h"
 #include "lib/random.h"
 #include "net/queuebuf.h"
@@ -68,15 +69,69 @@
 #error TSCH_QUEUE_NUM_PER_NEIGHBOR must be power of two
 #endif
 
+#if TSCH_QUEUE_WITH_NBR_HASH
+#if (TSCH_QUEUE_NBR_HASH_SIZE & (TSCH_QUEUE_NBR_HASH_SIZE - 1)) != 0
+#error TSCH_QUEUE_NBR_HASH_SIZE must be power of two
+#endif
+#endif /* TSCH_QUEUE_WITH_NBR_HASH */
+
 /* We have as many packets are there are queuebuf in the system */
 MEMB(packet_memb, struct tsch_packet, QUEUEBUF_NUM);
 MEMB(neighbor_memb, struct tsch_neighbor, TSCH_QUEUE_MAX_NEIGHBOR_QUEUES);
+#if TSCH_QUEUE_WITH_DLIST
+DLIST(neighbor_list);
+#define neighbor_list_init() dlist_init(neighbor_list)
+#define neighbor_list_head() dlist_head(neighbor_list)
+#define neighbor_list_add(n) dlist_add(neighbor_list, (n))
+#define neighbor_list_remove(n) dlist_remove(neighbor_list, (n))
+#else /* TSCH_QUEUE_WITH_DLIST */
 LIST(neighbor_list);
+#define neighbor_list_init() list_init(neighbor_list)
+#define neighbor_list_head() list_head(neighbor_list)
+#define neighbor_list_add(n) list_add(neighbor_list, (n))
+#define neighbor_list_remove(n) list_remove(neighbor_list, (n))
+#endif /* TSCH_QUEUE_WITH_DLIST */
+
+#if TSCH_QUEUE_WITH_NBR_HASH
+/* Hash buckets of neighbors, chained through hash_next */
+static struct tsch_neighbor *nbr_hash[TSCH_QUEUE_NBR_HASH_SIZE];
+#endif /* TSCH_QUEUE_WITH_NBR_HASH */
 
 /* Broadcast and EB virtual neighbors */
 struct tsch_neighbor *n_broadcast;
 struct tsch_neighbor *n_eb;
 
+#if TSCH_QUEUE_WITH_NBR_HASH
+/*---------------------------------------------------------------------------*/
+static struct tsch_neighbor **
+nbr_hash_bucket(const linkaddr_t *addr)
+{
+  uint32_t h;
+  int i;
+
+  /* FNV-1a */
+  h = 2166136261UL;
+  for(i = 0; i < LINKADDR_SIZE; i++) {
+    h = (h ^ addr->u8[i]) * 16777619UL;
+  }
+  return &nbr_hash[h & (TSCH_QUEUE_NBR_HASH_SIZE - 1)];
+}
+/*---------------------------------------------------------------------------*/
+/* Remove a neighbor from its hash bucket */
+static void
+nbr_hash_remove(struct tsch_neighbor *n)
+{
+  struct tsch_neighbor **prev = nbr_hash_bucket(&n->addr);
+  while(*prev != NULL) {
+    if(*prev == n) {
+      *prev = n->hash_next;
+      return;
+    }
+    prev = &(*prev)->hash_next;
+  }
+}
+#endif /* TSCH_QUEUE_WITH_NBR_HASH */
+
 /*---------------------------------------------------------------------------*/
 /* Add a TSCH neighbor */
 struct tsch_neighbor *
@@ -98,7 +153,14 @@ tsch_queue_add_nbr(const linkaddr_t *addr)
           || linkaddr_cmp(addr, &tsch_broadcast_address);
         tsch_queue_backoff_reset(n);
         /* Add neighbor to the list */
-        list_add(neighbor_list, n);
+        neighbor_list_add(n);
+#if TSCH_QUEUE_WITH_NBR_HASH
+        {
+          struct tsch_neighbor **bucket = nbr_hash_bucket(addr);
+          n->hash_next = *bucket;
+          *bucket = n;
+        }
+#endif /* TSCH_QUEUE_WITH_NBR_HASH */
       }
       tsch_release_lock();
     }
@@ -111,13 +173,23 @@ struct tsch_neighbor *
 tsch_queue_get_nbr(const linkaddr_t *addr)
 {
   if(!tsch_is_locked()) {
-    struct tsch_neighbor *n = list_head(neighbor_list);
+#if TSCH_QUEUE_WITH_NBR_HASH
+    struct tsch_neighbor *n = *nbr_hash_bucket(addr);
+    while(n != NULL) {
+      if(linkaddr_cmp(&n->addr, addr)) {
+        return n;
+      }
+      n = n->hash_next;
+    }
+#else /* TSCH_QUEUE_WITH_NBR_HASH */
+    struct tsch_neighbor *n = neighbor_list_head();
     while(n != NULL) {
       if(linkaddr_cmp(&n->addr, addr)) {
         return n;
       }
       n = list_item_next(n);
     }
+#endif /* TSCH_QUEUE_WITH_NBR_HASH */
   }
   return NULL;
 }
@@ -127,7 +199,7 @@ struct tsch_neighbor *
 tsch_queue_get_time_source(void)
 {
   if(!tsch_is_locked()) {
-    struct tsch_neighbor *curr_nbr = list_head(neighbor_list);
+    struct tsch_neighbor *curr_nbr = neighbor_list_head();
     while(curr_nbr != NULL) {
       if(curr_nbr->is_time_source) {
         return curr_nbr;
@@ -187,12 +259,31 @@ tsch_queue_update_time_source(const linkaddr_t *new_addr)
   return 0;
 }
 /*---------------------------------------------------------------------------*/
+/* Remove first packet from a neighbor queue, whether it was sent or not */
+static struct tsch_packet *
+remove_head_packet(struct tsch_neighbor *n)
+{
+  if(!tsch_is_locked()) {
+    if(n != NULL) {
+      /* Get and remove packet from ringbuf (remove committed through an atomic operation */
+      int16_t get_index = ringbufindex_get(&n->tx_ringbuf);
+      if(get_index != -1) {
+        PRINTF("TSCH-queue: packet is removed, get_index=%u\n", get_index);
+        return n->tx_array[get_index];
+      } else {
+        return NULL;
+      }
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
 /* Flush a neighbor queue */
 static void
 tsch_queue_flush_nbr_queue(struct tsch_neighbor *n)
 {
   while(!tsch_queue_is_empty(n)) {
-    struct tsch_packet *p = tsch_queue_remove_packet_from_queue(n);
+    struct tsch_packet *p = remove_head_packet(n);
     if(p != NULL) {
       /* Set return status for packet_sent callback */
       p->ret = MAC_TX_ERR;
@@ -214,7 +305,10 @@ tsch_queue_remove_nbr(struct tsch_neighbor *n)
     if(tsch_get_lock()) {
 
       /* Remove neighbor from list */
-      list_remove(neighbor_list, n);
+      neighbor_list_remove(n);
+#if TSCH_QUEUE_WITH_NBR_HASH
+      nbr_hash_remove(n);
+#endif /* TSCH_QUEUE_WITH_NBR_HASH */
 
       tsch_release_lock();
 
@@ -251,6 +345,7 @@ tsch_queue_add_packet(const linkaddr_t *addr, mac_callback_t sent, void *ptr)
             p->ptr = ptr;
             p->ret = MAC_TX_DEFERRED;
             p->transmissions = 0;
+            p->enqueue_asn = tsch_current_asn.ls4b;
             /* Add to ringbuf (actual add committed through atomic operation) */
             n->tx_array[put_index] = p;
             ringbufindex_put(&n->tx_ringbuf);
@@ -286,19 +381,21 @@ tsch_queue_packet_count(const linkaddr_t *addr)
 struct tsch_packet *
 tsch_queue_remove_packet_from_queue(struct tsch_neighbor *n)
 {
-  if(!tsch_is_locked()) {
-    if(n != NULL) {
-      /* Get and remove packet from ringbuf (remove committed through an atomic operation */
-      int16_t get_index = ringbufindex_get(&n->tx_ringbuf);
-      if(get_index != -1) {
-        PRINTF("TSCH-queue: packet is removed, get_index=%u\n", get_index);
-        return n->tx_array[get_index];
-      } else {
-        return NULL;
-      }
+  struct tsch_packet *p = remove_head_packet(n);
+#if TSCH_QUEUE_WITH_STATS
+  if(p != NULL) {
+    uint32_t delay = tsch_current_asn.ls4b - p->enqueue_asn;
+    if(n->stats.count == 0xffff) {
+      /* Halve the history rather than overflow, keeps the average */
+      n->stats.count /= 2;
+      n->stats.delay_sum /= 2;
     }
+    n->stats.count++;
+    n->stats.delay_sum += delay;
+    n->stats.delay_max = MAX(n->stats.delay_max, MIN(delay, 0xffff));
   }
-  return NULL;
+#endif /* TSCH_QUEUE_WITH_STATS */
+  return p;
 }
 /*---------------------------------------------------------------------------*/
 /* Free a packet */
@@ -317,7 +414,7 @@ tsch_queue_reset(void)
 {
   /* Deallocate unneeded neighbors */
   if(!tsch_is_locked()) {
-    struct tsch_neighbor *n = list_head(neighbor_list);
+    struct tsch_neighbor *n = neighbor_list_head();
     while(n != NULL) {
       struct tsch_neighbor *next_n = list_item_next(n);
       /* Flush queue */
@@ -335,7 +432,7 @@ tsch_queue_free_unused_neighbors(void)
 {
   /* Deallocate unneeded neighbors */
   if(!tsch_is_locked()) {
-    struct tsch_neighbor *n = list_head(neighbor_list);
+    struct tsch_neighbor *n = neighbor_list_head();
     while(n != NULL) {
       struct tsch_neighbor *next_n = list_item_next(n);
       /* Queue is empty, no tx link to this neighbor: deallocate.
@@ -400,25 +497,64 @@ struct tsch_packet *
 tsch_queue_get_unicast_packet_for_any(struct tsch_neighbor **n, struct tsch_link *link)
 {
   if(!tsch_is_locked()) {
-    struct tsch_neighbor *curr_nbr = list_head(neighbor_list);
+    struct tsch_neighbor *curr_nbr = neighbor_list_head();
     struct tsch_packet *p = NULL;
+#if TSCH_QUEUE_OLDEST_FIRST
+    struct tsch_neighbor *oldest_nbr = NULL;
+    struct tsch_packet *oldest_p = NULL;
+#endif /* TSCH_QUEUE_OLDEST_FIRST */
     while(curr_nbr != NULL) {
       if(!curr_nbr->is_broadcast && curr_nbr->tx_links_count == 0) {
         /* Only look up for non-broadcast neighbors we do not have a tx link to */
         p = tsch_queue_get_packet_for_nbr(curr_nbr, link);
+#if TSCH_QUEUE_OLDEST_FIRST
+        if(p != NULL && (oldest_p == NULL
+                         || (int32_t)(p->enqueue_asn - oldest_p->enqueue_asn) < 0)) {
+          oldest_nbr = curr_nbr;
+          oldest_p = p;
+        }
+#else /* TSCH_QUEUE_OLDEST_FIRST */
         if(p != NULL) {
           if(n != NULL) {
             *n = curr_nbr;
           }
           return p;
         }
+#endif /* TSCH_QUEUE_OLDEST_FIRST */
       }
       curr_nbr = list_item_next(curr_nbr);
     }
+#if TSCH_QUEUE_OLDEST_FIRST
+    if(oldest_p != NULL && n != NULL) {
+      *n = oldest_nbr;
+    }
+    return oldest_p;
+#endif /* TSCH_QUEUE_OLDEST_FIRST */
   }
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
+#if TSCH_QUEUE_WITH_STATS
+/* Average queueing delay towards a neighbor, in timeslots */
+int32_t
+tsch_queue_get_avg_delay(const struct tsch_neighbor *n)
+{
+  if(n == NULL || n->stats.count == 0) {
+    return -1;
+  }
+  return n->stats.delay_sum / n->stats.count;
+}
+/*---------------------------------------------------------------------------*/
+/* Clear the queueing delay statistics of a neighbor */
+void
+tsch_queue_reset_stats(struct tsch_neighbor *n)
+{
+  if(n != NULL) {
+    memset(&n->stats, 0, sizeof(n->stats));
+  }
+}
+#endif /* TSCH_QUEUE_WITH_STATS */
+/*---------------------------------------------------------------------------*/
 /* May the neighbor transmit over a shared link? */
 int
 tsch_queue_backoff_expired(const struct tsch_neighbor *n)
@@ -455,7 +591,7 @@ tsch_queue_update_all_backoff_windows(const linkaddr_t *dest_addr)
 {
   if(!tsch_is_locked()) {
     int is_broadcast = linkaddr_cmp(dest_addr, &tsch_broadcast_address);
-    struct tsch_neighbor *n = list_head(neighbor_list);
+    struct tsch_neighbor *n = neighbor_list_head();
     while(n != NULL) {
       if(n->backoff_window != 0 /* Is the queue in backoff state? */
          && ((n->tx_links_count == 0 && is_broadcast)
@@ -471,7 +607,10 @@ tsch_queue_update_all_backoff_windows(const linkaddr_t *dest_addr)
 void
 tsch_queue_init(void)
 {
-  list_init(neighbor_list);
+  neighbor_list_init();
+#if TSCH_QUEUE_WITH_NBR_HASH
+  memset(nbr_hash, 0, sizeof(nbr_hash));
+#endif /* TSCH_QUEUE_WITH_NBR_HASH */
   memb_init(&neighbor_memb);
   memb_init(&packet_memb);
   /* Add virtual EB and the broadcast neighbors */
@@ -77,6 +77,46 @@
 #define TSCH_QUEUE_MAX_NEIGHBOR_QUEUES ((NBR_TABLE_CONF_MAX_NEIGHBORS) + 2)
 #endif
 
+/* Keep the neighbor queues on a doubly linked list, so that adding and
+ * removing a neighbor does not traverse the list */
+#ifdef TSCH_QUEUE_CONF_WITH_DLIST
+#define TSCH_QUEUE_WITH_DLIST TSCH_QUEUE_CONF_WITH_DLIST
+#else
+#define TSCH_QUEUE_WITH_DLIST 0
+#endif
+
+/* Index the neighbor queues by MAC address with a hash table, so that
+ * tsch_queue_get_nbr() does not walk all neighbors. Worth enabling when
+ * TSCH_QUEUE_MAX_NEIGHBOR_QUEUES is large. */
+#ifdef TSCH_QUEUE_CONF_WITH_NBR_HASH
+#define TSCH_QUEUE_WITH_NBR_HASH TSCH_QUEUE_CONF_WITH_NBR_HASH
+#else
+#define TSCH_QUEUE_WITH_NBR_HASH 0
+#endif
+
+/* Number of buckets of the neighbor hash table. Must be power of two. */
+#ifdef TSCH_QUEUE_CONF_NBR_HASH_SIZE
+#define TSCH_QUEUE_NBR_HASH_SIZE TSCH_QUEUE_CONF_NBR_HASH_SIZE
+#else
+#define TSCH_QUEUE_NBR_HASH_SIZE 16
+#endif
+
+/* On shared links without a destination, send the oldest packet of all
+ * neighbors instead of the head packet of the first neighbor that has
+ * one, so that no neighbor is starved by those before it in the list */
+#ifdef TSCH_QUEUE_CONF_OLDEST_FIRST
+#define TSCH_QUEUE_OLDEST_FIRST TSCH_QUEUE_CONF_OLDEST_FIRST
+#else
+#define TSCH_QUEUE_OLDEST_FIRST 0
+#endif
+
+/* Keep queueing delay statistics for each neighbor */
+#ifdef TSCH_QUEUE_CONF_WITH_STATS
+#define TSCH_QUEUE_WITH_STATS TSCH_QUEUE_CONF_WITH_STATS
+#else
+#define TSCH_QUEUE_WITH_STATS 0
+#endif
+
 /* TSCH CSMA-CA parameters, see IEEE 802.15.4e-2012 */
 /* Min backoff exponent */
 #ifdef TSCH_CONF_MAC_MIN_BE
@@ -121,12 +161,28 @@ struct tsch_packet {
   uint8_t ret; /* status -- MAC return code */
   uint8_t header_len; /* length of header and header IEs (needed for link-layer security) */
   uint8_t tsch_sync_ie_offset; /* Offset within the frame used for quick update of EB ASN and join priority */
+  uint32_t enqueue_asn; /* ASN (4 least significant bytes) at which the packet was queued */
+};
+
+/* Queueing delay of the packets that left a neighbor queue, after being
+ * sent or dropped. Delays are in timeslots. */
+struct tsch_queue_stats {
+  uint32_t delay_sum; /* sum of the delays */
+  uint16_t count; /* number of packets */
+  uint16_t delay_max; /* largest delay, saturated at 0xffff */
 };
 
 /* TSCH neighbor information */
 struct tsch_neighbor {
   /* Neighbors are stored as a list: "next" must be the first field */
   struct tsch_neighbor *next;
+#if TSCH_QUEUE_WITH_DLIST
+  /* ... and "prev" the second one when the list is doubly linked */
+  struct tsch_neighbor *prev;
+#endif /* TSCH_QUEUE_WITH_DLIST */
+#if TSCH_QUEUE_WITH_NBR_HASH
+  struct tsch_neighbor *hash_next; /* next neighbor in the same hash bucket */
+#endif /* TSCH_QUEUE_WITH_NBR_HASH */
   linkaddr_t addr; /* MAC address of the neighbor */
   uint8_t is_broadcast; /* is this neighbor a virtual neighbor used for broadcast (of data packets or EBs) */
   uint8_t is_time_source; /* is this neighbor a time source? */
@@ -140,6 +196,9 @@ struct tsch_neighbor {
   struct tsch_packet *tx_array[TSCH_QUEUE_NUM_PER_NEIGHBOR];
   /* Circular buffer of pointers to packet. */
   struct ringbufindex tx_ringbuf;
+#if TSCH_QUEUE_WITH_STATS
+  struct tsch_queue_stats stats;
+#endif /* TSCH_QUEUE_WITH_STATS */
 };
 
 /***** External Variables *****/
@@ -178,8 +237,16 @@ struct tsch_packet *tsch_queue_get_packet_for_nbr(const struct tsch_neighbor *n,
 /* Returns the head packet from a neighbor queue (from neighbor address) */
 struct tsch_packet *tsch_queue_get_packet_for_dest_addr(const linkaddr_t *addr, struct tsch_link *link);
 /* Returns the head packet of any neighbor queue with zero backoff counter.
+ * With TSCH_QUEUE_OLDEST_FIRST, the oldest of them.
  * Writes pointer to the neighbor in *n */
 struct tsch_packet *tsch_queue_get_unicast_packet_for_any(struct tsch_neighbor **n, struct tsch_link *link);
+#if TSCH_QUEUE_WITH_STATS
+/* Average queueing delay towards a neighbor, in timeslots, or -1 if no
+ * packet has left its queue yet */
+int32_t tsch_queue_get_avg_delay(const struct tsch_neighbor *n);
+/* Clear the queueing delay statistics of a neighbor */
+void tsch_queue_reset_stats(struct tsch_neighbor *n);
+#endif /* TSCH_QUEUE_WITH_STATS */
 /* May the neighbor transmit over a share link? */
 int tsch_queue_backoff_expired(const struct tsch_neighbor *n);
 /* Reset neighbor backoff */
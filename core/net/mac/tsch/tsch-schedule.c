@@ -68,6 +68,88 @@ MEMB(link_memb, struct tsch_link, TSCH_SCHEDULE_MAX_LINKS);
 MEMB(slotframe_memb, struct tsch_slotframe, TSCH_SCHEDULE_MAX_SLOTFRAMES);
 /* List of slotframes (each slotframe holds its own list of links) */
 LIST(slotframe_list);
+/* All links, sorted by slotframe (in the order of slotframe_list) and
+ * then by timeslot. Lets us find the next link of a slotframe with a
+ * binary search, in the short time between two slots. */
+static struct tsch_link *link_index[TSCH_SCHEDULE_MAX_LINKS];
+static uint16_t link_index_len;
+
+/*---------------------------------------------------------------------------*/
+/* Returns the position in link_index of the first link of the slotframe
+ * with a timeslot >= the given one (the end of the slotframe if none) */
+static uint16_t
+index_lower_bound(struct tsch_slotframe *sf, uint16_t timeslot)
+{
+  uint16_t low = sf->index_start;
+  uint16_t high = sf->index_start + sf->links_count;
+  while(low < high) {
+    uint16_t mid = low + (high - low) / 2;
+    if(link_index[mid]->timeslot < timeslot) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the position in link_index of the first link of the slotframe
+ * with a timeslot > the given one (the end of the slotframe if none) */
+static uint16_t
+index_upper_bound(struct tsch_slotframe *sf, uint16_t timeslot)
+{
+  uint16_t low = sf->index_start;
+  uint16_t high = sf->index_start + sf->links_count;
+  while(low < high) {
+    uint16_t mid = low + (high - low) / 2;
+    if(link_index[mid]->timeslot <= timeslot) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+/*---------------------------------------------------------------------------*/
+/* Inserts a link into link_index, after the links of the same timeslot.
+ * Call with the lock taken. */
+static void
+index_add(struct tsch_slotframe *sf, struct tsch_link *l)
+{
+  struct tsch_slotframe *next;
+  uint16_t pos = index_upper_bound(sf, l->timeslot);
+  memmove(&link_index[pos + 1], &link_index[pos],
+          (link_index_len - pos) * sizeof(link_index[0]));
+  link_index[pos] = l;
+  link_index_len++;
+  sf->links_count++;
+  for(next = list_item_next(sf); next != NULL; next = list_item_next(next)) {
+    next->index_start++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Removes a link from link_index. Call with the lock taken. */
+static void
+index_remove(struct tsch_slotframe *sf, struct tsch_link *l)
+{
+  struct tsch_slotframe *next;
+  uint16_t end = sf->index_start + sf->links_count;
+  uint16_t pos = index_lower_bound(sf, l->timeslot);
+  while(pos < end && link_index[pos] != l) {
+    pos++;
+  }
+  if(pos == end) {
+    return;
+  }
+  link_index_len--;
+  memmove(&link_index[pos], &link_index[pos + 1],
+          (link_index_len - pos) * sizeof(link_index[0]));
+  sf->links_count--;
+  for(next = list_item_next(sf); next != NULL; next = list_item_next(next)) {
+    next->index_start--;
+  }
+}
+/*---------------------------------------------------------------------------*/
 
 /* Adds and returns a slotframe (NULL if failure) */
 struct tsch_slotframe *
@@ -89,6 +171,9 @@ tsch_schedule_add_slotframe(uint16_t handle, uint16_t size)
       sf->handle = handle;
       TSCH_ASN_DIVISOR_INIT(sf->size, size);
       LIST_STRUCT_INIT(sf, links_list);
+      /* The new slotframe is the last one, its links go at the end of the index */
+      sf->index_start = link_index_len;
+      sf->links_count = 0;
       /* Add the slotframe to the global list */
       list_add(slotframe_list, sf);
     }
@@ -136,6 +221,13 @@ tsch_schedule_remove_slotframe(struct tsch_slotframe *slotframe)
   return 0;
 }
 /*---------------------------------------------------------------------------*/
+/* Returns next slotframe (the first one if sf is NULL) */
+struct tsch_slotframe *
+tsch_schedule_slotframes_next(struct tsch_slotframe *sf)
+{
+  return sf == NULL ? list_head(slotframe_list) : list_item_next(sf);
+}
+/*---------------------------------------------------------------------------*/
 /* Looks for a slotframe from a handle */
 struct tsch_slotframe *
 tsch_schedule_get_slotframe_by_handle(uint16_t handle)
@@ -209,6 +301,7 @@ tsch_schedule_add_link(struct tsch_slotframe *slotframe,
           address = &linkaddr_null;
         }
         linkaddr_copy(&l->addr, address);
+        index_add(slotframe, l);
 
         PRINTF("TSCH-schedule: add_link %u %u %u %u %u %u\n",
                slotframe->handle, link_options, link_type, timeslot, channel_offset, TSCH_LOG_ID_FROM_LINKADDR(address));
@@ -256,6 +349,7 @@ tsch_schedule_remove_link(struct tsch_slotframe *slotframe, struct tsch_link *l)
              TSCH_LOG_ID_FROM_LINKADDR(&l->addr));
 
       list_remove(slotframe->links_list, l);
+      index_remove(slotframe, l);
       memb_free(&link_memb, l);
 
       /* Release the lock before we update the neighbor (will take the lock) */
@@ -294,15 +388,12 @@ tsch_schedule_get_link_by_timeslot(struct tsch_slotframe *slotframe, uint16_t ti
 {
   if(!tsch_is_locked()) {
     if(slotframe != NULL) {
-      struct tsch_link *l = list_head(slotframe->links_list);
-      /* Loop over all items. Assume there is max one link per timeslot */
-      while(l != NULL) {
-        if(l->timeslot == timeslot) {
-          return l;
-        }
-        l = list_item_next(l);
+      uint16_t pos = index_lower_bound(slotframe, timeslot);
+      /* Assume there is max one link per timeslot */
+      if(pos < slotframe->index_start + slotframe->links_count
+         && link_index[pos]->timeslot == timeslot) {
+        return link_index[pos];
       }
-      return l;
     }
   }
   return NULL;
@@ -325,7 +416,16 @@ tsch_schedule_get_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset
     while(sf != NULL) {
       /* Get timeslot from ASN, given the slotframe length */
       uint16_t timeslot = TSCH_ASN_MOD(*asn, sf->size);
-      struct tsch_link *l = list_head(sf->links_list);
+      uint16_t end = sf->index_start + sf->links_count;
+      /* The first link after the current timeslot, or else the first
+       * link of the slotframe. Only links of its timeslot can be the
+       * earliest ones of this slotframe. */
+      uint16_t pos = index_upper_bound(sf, timeslot);
+      struct tsch_link *l;
+      if(pos == end) {
+        pos = sf->index_start;
+      }
+      l = pos < end ? link_index[pos] : NULL;
       while(l != NULL) {
         uint16_t time_to_timeslot =
           l->timeslot > timeslot ?
@@ -369,7 +469,9 @@ tsch_schedule_get_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset
           }
         }
 
-        l = list_item_next(l);
+        pos++;
+        l = pos < end && link_index[pos]->timeslot == l->timeslot ?
+          link_index[pos] : NULL;
       }
       sf = list_item_next(sf);
     }
@@ -391,6 +493,7 @@ tsch_schedule_init(void)
     memb_init(&link_memb);
     memb_init(&slotframe_memb);
     list_init(slotframe_list);
+    link_index_len = 0;
     tsch_release_lock();
     return 1;
   } else {
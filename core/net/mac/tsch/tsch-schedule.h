@@ -122,6 +122,10 @@ struct tsch_slotframe {
   struct tsch_asn_divisor_t size;
   /* List of links belonging to this slotframe */
   LIST_STRUCT(links_list);
+  /* The links of this slotframe, sorted by timeslot, are at
+   * index_start .. index_start + links_count - 1 of the schedule index */
+  uint16_t index_start;
+  uint16_t links_count;
 };
 
 /********** Functions *********/
@@ -142,7 +146,7 @@ int tsch_schedule_remove_slotframe(struct tsch_slotframe *slotframe);
 /* Removes all slotframes, resulting in an empty schedule */
 int tsch_schedule_remove_all_slotframes(void);
 
-/* Returns next slotframe */
+/* Returns next slotframe (the first one if sf is NULL) */
 struct tsch_slotframe *tsch_schedule_slotframes_next(struct tsch_slotframe *sf);
 /* Adds a link to a slotframe, return a pointer to it (NULL if failure) */
 struct tsch_link *tsch_schedule_add_link(struct tsch_slotframe *slotframe,
@@ -54,6 +54,7 @@
 #include "net/mac/tsch/tsch-packet.h"
 #include "net/mac/tsch/tsch-security.h"
 #include "net/mac/tsch/tsch-adaptive-timesync.h"
+#include "net/mac/tsch/tsch-slot-stats.h"
 #if CONTIKI_TARGET_COOJA || CONTIKI_TARGET_COOJA_IP64
 #include "lib/simEnvChange.h"
 #include "sys/cooja_mt.h"
@@ -87,6 +88,16 @@
 #define TSCH_DEBUG_SLOT_END()
 #endif
 
+/* Slot timing statistics: record the time elapsed since start */
+#if TSCH_WITH_SLOT_STATS
+#define SLOT_STATS_START(start) ((start) = RTIMER_NOW())
+#define SLOT_STATS_RECORD(phase, start) \
+  tsch_slot_stats_record((phase), (rtimer_clock_t)(RTIMER_NOW() - (start)))
+#else /* TSCH_WITH_SLOT_STATS */
+#define SLOT_STATS_START(start)
+#define SLOT_STATS_RECORD(phase, start)
+#endif /* TSCH_WITH_SLOT_STATS */
+
 /* Check if TSCH_MAX_INCOMING_PACKETS is power of two */
 #if (TSCH_MAX_INCOMING_PACKETS & (TSCH_MAX_INCOMING_PACKETS - 1)) != 0
 #error TSCH_MAX_INCOMING_PACKETS must be power of two
@@ -158,6 +169,13 @@ struct tsch_neighbor *last_timesource_neighbor = NULL;
 /* Used from tsch_slot_operation and sub-protothreads */
 static rtimer_clock_t volatile current_slot_start;
 
+#if TSCH_WITH_SLOT_STATS
+/* Start of the slot phase being measured, and of the security
+ * processing, which can happen within a phase */
+static rtimer_clock_t phase_start;
+static rtimer_clock_t security_start;
+#endif /* TSCH_WITH_SLOT_STATS */
+
 /* Are we currently inside a slot? */
 static volatile int tsch_in_slot_operation = 0;
 
@@ -308,6 +326,7 @@ tsch_schedule_slot_operation(struct rtimer *tm, rtimer_clock_t ref_time, rtimer_
   int missed = check_timer_miss(ref_time, offset - RTIMER_GUARD, now);
 
   if(missed) {
+    SLOT_STATS_RECORD(tsch_phase_deadline_miss, ref_time + offset - RTIMER_GUARD);
     TSCH_LOG_ADD(tsch_log_message,
                 snprintf(log->message, sizeof(log->message),
                     "!dl-miss %s %d %d",
@@ -547,8 +566,10 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
         /* If we are going to encrypt, we need to generate the output in a separate buffer and keep
          * the original untouched. This is to allow for future retransmissions. */
         int with_encryption = packetbuf_attr(PACKETBUF_ATTR_SECURITY_LEVEL) & 0x4;
+        SLOT_STATS_START(security_start);
         packet_len += tsch_security_secure_frame(packet, with_encryption ? encrypted_packet : packet, current_packet->header_len,
             packet_len - current_packet->header_len, &tsch_current_asn);
+        SLOT_STATS_RECORD(tsch_phase_security, security_start);
         if(with_encryption) {
           packet = encrypted_packet;
         }
@@ -560,15 +581,19 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
       if(packet_ready && NETSTACK_RADIO.prepare(packet, packet_len) == 0) { /* 0 means success */
         static rtimer_clock_t tx_duration;
 
+        SLOT_STATS_RECORD(tsch_phase_tx_prepare, current_slot_start);
+
 #if CCA_ENABLED
         cca_status = 1;
         /* delay before CCA */
         TSCH_SCHEDULE_AND_YIELD(pt, t, current_slot_start, TS_CCA_OFFSET, "cca");
         TSCH_DEBUG_TX_EVENT();
         tsch_radio_on(TSCH_RADIO_CMD_ON_WITHIN_TIMESLOT);
+        SLOT_STATS_START(phase_start);
         /* CCA */
         BUSYWAIT_UNTIL_ABS(!(cca_status |= NETSTACK_RADIO.channel_clear()),
                            current_slot_start, TS_CCA_OFFSET + TS_CCA);
+        SLOT_STATS_RECORD(tsch_phase_cca, phase_start);
         TSCH_DEBUG_TX_EVENT();
         /* there is not enough time to turn radio off */
         /*  NETSTACK_RADIO.off(); */
@@ -581,7 +606,9 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
           TSCH_SCHEDULE_AND_YIELD(pt, t, current_slot_start, tsch_timing[tsch_ts_tx_offset] - RADIO_DELAY_BEFORE_TX, "TxBeforeTx");
           TSCH_DEBUG_TX_EVENT();
           /* send packet already in radio tx buffer */
+          SLOT_STATS_START(phase_start);
           mac_tx_status = NETSTACK_RADIO.transmit(packet_len);
+          SLOT_STATS_RECORD(tsch_phase_tx, phase_start);
           /* Save tx timestamp */
           tx_start_time = current_slot_start + tsch_timing[tsch_ts_tx_offset];
           /* calculate TX duration based on sent packet len */
@@ -610,6 +637,7 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
                   tsch_timing[tsch_ts_tx_offset] + tx_duration + tsch_timing[tsch_ts_rx_ack_delay] - RADIO_DELAY_BEFORE_RX, "TxBeforeAck");
               TSCH_DEBUG_TX_EVENT();
               tsch_radio_on(TSCH_RADIO_CMD_ON_WITHIN_TIMESLOT);
+              SLOT_STATS_START(phase_start);
               /* Wait for ACK to come */
               BUSYWAIT_UNTIL_ABS(NETSTACK_RADIO.receiving_packet(),
                   tx_start_time, tx_duration + tsch_timing[tsch_ts_rx_ack_delay] + tsch_timing[tsch_ts_ack_wait] + RADIO_DELAY_BEFORE_DETECT);
@@ -622,6 +650,7 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
                                  ack_start_time, tsch_timing[tsch_ts_max_ack]);
               TSCH_DEBUG_TX_EVENT();
               tsch_radio_off(TSCH_RADIO_CMD_OFF_WITHIN_TIMESLOT);
+              SLOT_STATS_RECORD(tsch_phase_ack_wait, phase_start);
 
 #if TSCH_HW_FRAME_FILTERING
               /* Leaving promiscuous mode */
@@ -645,8 +674,12 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
 
 #if LLSEC802154_ENABLED
                 if(ack_len != 0) {
-                  if(!tsch_security_parse_frame(packetbuf_hdrptr(), ack_hdrlen, ack_len - ack_hdrlen - tsch_security_mic_len(),
-                      &current_neighbor->addr, &tsch_current_asn)) {
+                  int ack_secured;
+                  SLOT_STATS_START(security_start);
+                  ack_secured = tsch_security_parse_frame(packetbuf_hdrptr(), ack_hdrlen, ack_len - ack_hdrlen - tsch_security_mic_len(),
+                      &current_neighbor->addr, &tsch_current_asn);
+                  SLOT_STATS_RECORD(tsch_phase_security, security_start);
+                  if(!ack_secured) {
                     TSCH_LOG_ADD(tsch_log_message,
                         snprintf(log->message, sizeof(log->message),
                         "!failed to authenticate ACK"));
@@ -706,6 +739,10 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
     /* Post TX: Update neighbor state */
     in_queue = update_neighbor_state(current_neighbor, current_packet, current_link, mac_tx_status);
 
+#ifdef TSCH_CALLBACK_TX_DONE
+    TSCH_CALLBACK_TX_DONE(current_link, mac_tx_status);
+#endif
+
     /* The packet was dequeued, add it to dequeued_ringbuf for later processing */
     if(in_queue == 0) {
       dequeued_array[dequeued_index] = current_packet;
@@ -784,6 +821,7 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
 
     /* Start radio for at least guard time */
     tsch_radio_on(TSCH_RADIO_CMD_ON_WITHIN_TIMESLOT);
+    SLOT_STATS_START(phase_start);
     packet_seen = NETSTACK_RADIO.receiving_packet() || NETSTACK_RADIO.pending_packet();
     if(!packet_seen) {
       /* Check if receiving within guard time */
@@ -793,6 +831,7 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
     if(!packet_seen) {
       /* no packets on air */
       tsch_radio_off(TSCH_RADIO_CMD_OFF_FORCE);
+      SLOT_STATS_RECORD(tsch_phase_rx, phase_start);
     } else {
       TSCH_DEBUG_RX_EVENT();
       /* Save packet timestamp */
@@ -803,6 +842,8 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
           current_slot_start, tsch_timing[tsch_ts_rx_offset] + tsch_timing[tsch_ts_rx_wait] + tsch_timing[tsch_ts_max_tx]);
       TSCH_DEBUG_RX_EVENT();
       tsch_radio_off(TSCH_RADIO_CMD_OFF_WITHIN_TIMESLOT);
+      SLOT_STATS_RECORD(tsch_phase_rx, phase_start);
+      SLOT_STATS_START(phase_start);
 
       if(NETSTACK_RADIO.pending_packet()) {
         static int frame_valid;
@@ -834,9 +875,13 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
 #if LLSEC802154_ENABLED
         /* Decrypt and verify incoming frame */
         if(frame_valid) {
-          if(tsch_security_parse_frame(
+          int frame_secured;
+          SLOT_STATS_START(security_start);
+          frame_secured = tsch_security_parse_frame(
                current_input->payload, header_len, current_input->len - header_len - tsch_security_mic_len(),
-               &source_address, &tsch_current_asn)) {
+               &source_address, &tsch_current_asn);
+          SLOT_STATS_RECORD(tsch_phase_security, security_start);
+          if(frame_secured) {
             current_input->len -= tsch_security_mic_len();
           } else {
             TSCH_LOG_ADD(tsch_log_message,
@@ -887,12 +932,15 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
 #if LLSEC802154_ENABLED
                 if(tsch_is_pan_secured) {
                   /* Secure ACK frame. There is only header and header IEs, therefore data len == 0. */
+                  SLOT_STATS_START(security_start);
                   ack_len += tsch_security_secure_frame(ack_buf, ack_buf, ack_len, 0, &tsch_current_asn);
+                  SLOT_STATS_RECORD(tsch_phase_security, security_start);
                 }
 #endif /* LLSEC802154_ENABLED */
 
                 /* Copy to radio buffer */
                 NETSTACK_RADIO.prepare((const void *)ack_buf, ack_len);
+                SLOT_STATS_RECORD(tsch_phase_rx_process, phase_start);
 
                 /* Wait for time to ACK and transmit ACK */
                 TSCH_SCHEDULE_AND_YIELD(pt, t, rx_start_time,
@@ -1002,6 +1050,7 @@ PT_THREAD(tsch_slot_operation(struct rtimer *t, void *ptr))
           static struct pt slot_rx_pt;
           PT_SPAWN(&slot_operation_pt, &slot_rx_pt, tsch_rx_slot(&slot_rx_pt, t));
         }
+        SLOT_STATS_RECORD(tsch_phase_slot, current_slot_start);
       }
       TSCH_DEBUG_SLOT_END();
     }
@@ -82,6 +82,13 @@
 int TSCH_CALLBACK_DO_NACK(struct tsch_link *link, linkaddr_t *src, linkaddr_t *dst);
 #endif
 
+/* Called by TSCH from interrupt after each unicast or broadcast transmission
+ * attempt, with its MAC_TX_ status. Lets upper layers, e.g. a scheduling
+ * function, keep track of cell usage */
+#ifdef TSCH_CALLBACK_TX_DONE
+void TSCH_CALLBACK_TX_DONE(const struct tsch_link *link, int mac_tx_status);
+#endif
+
 /************ Types ***********/
 
 /* Stores data about an incoming packet */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Slot timing statistics
+ *
+ */
+
+#include "contiki.h"
+#include "net/mac/tsch/tsch-slot-stats.h"
+#include <string.h>
+
+/* Bucket width in rtimer ticks, at least one */
+#define BUCKET_TICKS MAX(US_TO_RTIMERTICKS(TSCH_SLOT_STATS_BUCKET_US), 1)
+
+static struct tsch_slot_stats stats[tsch_phase_count];
+
+static const char *const phase_names[tsch_phase_count] = {
+  "tx-prepare", "cca", "tx", "ack-wait", "rx", "rx-process",
+  "security", "slot", "dl-miss"
+};
+
+/*---------------------------------------------------------------------------*/
+void
+tsch_slot_stats_record(enum tsch_slot_phase phase, rtimer_clock_t duration)
+{
+  struct tsch_slot_stats *s = &stats[phase];
+  uint32_t bucket;
+
+  bucket = duration / BUCKET_TICKS;
+  if(bucket >= TSCH_SLOT_STATS_NUM_BUCKETS) {
+    bucket = TSCH_SLOT_STATS_NUM_BUCKETS - 1;
+  }
+  if(s->hist[bucket] != 0xffff) {
+    s->hist[bucket]++;
+  }
+  if(s->count == 0 || duration < s->min) {
+    s->min = duration;
+  }
+  if(duration > s->max) {
+    s->max = duration;
+  }
+  s->count++;
+  s->sum += duration;
+}
+/*---------------------------------------------------------------------------*/
+const struct tsch_slot_stats *
+tsch_slot_stats_get(enum tsch_slot_phase phase)
+{
+  return phase < tsch_phase_count ? &stats[phase] : NULL;
+}
+/*---------------------------------------------------------------------------*/
+const char *
+tsch_slot_stats_phase_name(enum tsch_slot_phase phase)
+{
+  return phase < tsch_phase_count ? phase_names[phase] : NULL;
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_slot_stats_reset(void)
+{
+  memset(stats, 0, sizeof(stats));
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Slot timing statistics: how long each phase of the TSCH slot
+ *         operation takes, in fixed-width histograms. Used to tune the
+ *         timeslot template and check the headroom left under load.
+ *
+ */
+
+#ifndef __TSCH_SLOT_STATS_H__
+#define __TSCH_SLOT_STATS_H__
+
+/********** Includes **********/
+
+#include "contiki.h"
+
+/******** Configuration *******/
+
+/* Width of a histogram bucket, in usec. Rounded to rtimer ticks. */
+#ifdef TSCH_SLOT_STATS_CONF_BUCKET_US
+#define TSCH_SLOT_STATS_BUCKET_US TSCH_SLOT_STATS_CONF_BUCKET_US
+#else
+#define TSCH_SLOT_STATS_BUCKET_US 500
+#endif
+
+/* Number of buckets per histogram. The last one counts all durations
+ * beyond the others. */
+#ifdef TSCH_SLOT_STATS_CONF_NUM_BUCKETS
+#define TSCH_SLOT_STATS_NUM_BUCKETS TSCH_SLOT_STATS_CONF_NUM_BUCKETS
+#else
+#define TSCH_SLOT_STATS_NUM_BUCKETS 24
+#endif
+
+/************ Types ***********/
+
+/* The measured phases of a slot */
+enum tsch_slot_phase {
+  /* Slot start to the packet in the radio buffer, security included */
+  tsch_phase_tx_prepare,
+  /* Clear channel assessment */
+  tsch_phase_cca,
+  /* Radio transmit call */
+  tsch_phase_tx,
+  /* Radio on for the ACK, until it is received or timed out */
+  tsch_phase_ack_wait,
+  /* Radio on for listening, until the frame is received or timed out */
+  tsch_phase_rx,
+  /* End of a reception to the ACK ready in the radio buffer */
+  tsch_phase_rx_process,
+  /* Securing or unsecuring a frame or an ACK */
+  tsch_phase_security,
+  /* Slot start to the end of the Tx or Rx slot processing */
+  tsch_phase_slot,
+  /* How late a missed deadline was, past the last time an rtimer could
+   * still have been set */
+  tsch_phase_deadline_miss,
+  tsch_phase_count
+};
+
+/* Statistics of one phase. Durations are in rtimer ticks. */
+struct tsch_slot_stats {
+  uint32_t count;
+  uint32_t sum;
+  rtimer_clock_t min;
+  rtimer_clock_t max;
+  /* Bucket i counts durations in [i, i + 1) * TSCH_SLOT_STATS_BUCKET_US,
+   * saturated at 0xffff */
+  uint16_t hist[TSCH_SLOT_STATS_NUM_BUCKETS];
+};
+
+/********** Functions *********/
+
+/* Record a duration, from the slot operation */
+void tsch_slot_stats_record(enum tsch_slot_phase phase, rtimer_clock_t duration);
+/* Get the statistics of a phase. They are updated from interrupt
+ * context: a copy taken while a slot runs may mix old and new values. */
+const struct tsch_slot_stats *tsch_slot_stats_get(enum tsch_slot_phase phase);
+/* Get a short name of a phase, for printing */
+const char *tsch_slot_stats_phase_name(enum tsch_slot_phase phase);
+/* Clear all statistics */
+void tsch_slot_stats_reset(void);
+
+#endif /* __TSCH_SLOT_STATS_H__ */
@@ -55,6 +55,9 @@
 #include "net/mac/tsch/tsch-packet.h"
 #include "net/mac/tsch/tsch-security.h"
 #include "net/mac/mac-sequence.h"
+#if TSCH_WITH_SIXTOP
+#include "net/mac/tsch/sixtop/sixtop.h"
+#endif
 #include "lib/random.h"
 
 #if FRAME802154_VERSION < FRAME802154_IEEE802154E_2012
@@ -840,6 +843,9 @@ tsch_init(void)
   tsch_queue_init();
   tsch_schedule_init();
   tsch_log_init();
+#if TSCH_WITH_SIXTOP
+  sixtop_init();
+#endif
   ringbufindex_init(&input_ringbuf, TSCH_MAX_INCOMING_PACKETS);
   ringbufindex_init(&dequeued_ringbuf, TSCH_DEQUEUED_ARRAY_SIZE);
 
@@ -958,6 +964,12 @@ packet_input(void)
     PRINTF("TSCH: received from %u with seqno %u\n",
            TSCH_LOG_ID_FROM_LINKADDR(packetbuf_addr(PACKETBUF_ADDR_SENDER)),
            packetbuf_attr(PACKETBUF_ATTR_MAC_SEQNO));
+#if TSCH_WITH_SIXTOP
+    if(sixtop_input()) {
+      /* 6P messages stop here */
+      return;
+    }
+#endif
     NETSTACK_LLSEC.input();
   }
 }
@@ -86,6 +86,15 @@ static unsigned num_tables;
 MEMB(neighbor_addr_mem, nbr_table_key_t, NBR_TABLE_MAX_NEIGHBORS);
 LIST(nbr_table_keys);
 
+#if NBR_TABLE_WITH_HASH
+#if NBR_TABLE_HASH_SIZE <= NBR_TABLE_MAX_NEIGHBORS
+#error "NBR_TABLE_HASH_SIZE must be larger than NBR_TABLE_MAX_NEIGHBORS"
+#endif
+/* Hash index over the keys, using linear probing. Each slot holds the
+ * neighbor index plus one, so that zero marks an empty slot. */
+static uint16_t hash_slots[NBR_TABLE_HASH_SIZE];
+#endif /* NBR_TABLE_WITH_HASH */
+
 /*---------------------------------------------------------------------------*/
 /* Get a key from a neighbor index */
 static nbr_table_key_t *
@@ -129,16 +138,96 @@ key_from_item(nbr_table_t *table, const nbr_table_item_t *item)
   return key_from_index(index_from_item(table, item));
 }
 /*---------------------------------------------------------------------------*/
+#if NBR_TABLE_WITH_HASH
+static unsigned
+hash_from_lladdr(const linkaddr_t *lladdr)
+{
+  uint32_t h;
+  int i;
+
+  /* FNV-1a */
+  h = 2166136261UL;
+  for(i = 0; i < LINKADDR_SIZE; i++) {
+    h = (h ^ lladdr->u8[i]) * 16777619UL;
+  }
+  return h % NBR_TABLE_HASH_SIZE;
+}
+/*---------------------------------------------------------------------------*/
+/* Insert the key with the given index into the hash index */
+static void
+hash_insert(int index)
+{
+  unsigned slot;
+
+  slot = hash_from_lladdr(&key_from_index(index)->lladdr);
+  while(hash_slots[slot] != 0) {
+    slot = (slot + 1) % NBR_TABLE_HASH_SIZE;
+  }
+  hash_slots[slot] = index + 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Remove the key with the given index from the hash index. Must be
+ * called before the link-layer address of the key changes. */
+static void
+hash_remove(int index)
+{
+  unsigned slot;
+  unsigned next;
+  unsigned home;
+
+  slot = hash_from_lladdr(&key_from_index(index)->lladdr);
+  while(hash_slots[slot] != index + 1) {
+    if(hash_slots[slot] == 0) {
+      return;
+    }
+    slot = (slot + 1) % NBR_TABLE_HASH_SIZE;
+  }
+
+  /* Shift later entries of the same probe sequence back, so that
+   * lookups never stop early at the freed slot */
+  next = slot;
+  while(1) {
+    hash_slots[slot] = 0;
+    do {
+      next = (next + 1) % NBR_TABLE_HASH_SIZE;
+      if(hash_slots[next] == 0) {
+        return;
+      }
+      home = hash_from_lladdr(&key_from_index(hash_slots[next] - 1)->lladdr);
+      /* Keep the entry if its home slot lies cyclically in (slot, next] */
+    } while(slot <= next
+            ? (slot < home && home <= next)
+            : (slot < home || home <= next));
+    hash_slots[slot] = hash_slots[next];
+    slot = next;
+  }
+}
+#endif /* NBR_TABLE_WITH_HASH */
+/*---------------------------------------------------------------------------*/
 /* Get the index of a neighbor from its link-layer address */
 static int
 index_from_lladdr(const linkaddr_t *lladdr)
 {
+#if NBR_TABLE_WITH_HASH
+  unsigned slot;
+#endif /* NBR_TABLE_WITH_HASH */
   nbr_table_key_t *key;
   /* Allow lladdr-free insertion, useful e.g. for IPv6 ND.
    * Only one such entry is possible at a time, indexed by linkaddr_null. */
   if(lladdr == NULL) {
     lladdr = &linkaddr_null;
   }
+#if NBR_TABLE_WITH_HASH
+  slot = hash_from_lladdr(lladdr);
+  while(hash_slots[slot] != 0) {
+    key = key_from_index(hash_slots[slot] - 1);
+    if(linkaddr_cmp(lladdr, &key->lladdr)) {
+      return hash_slots[slot] - 1;
+    }
+    slot = (slot + 1) % NBR_TABLE_HASH_SIZE;
+  }
+  return -1;
+#else /* NBR_TABLE_WITH_HASH */
   key = list_head(nbr_table_keys);
   while(key != NULL) {
     if(lladdr && linkaddr_cmp(lladdr, &key->lladdr)) {
@@ -147,6 +236,7 @@ index_from_lladdr(const linkaddr_t *lladdr)
     key = list_item_next(key);
   }
   return -1;
+#endif /* NBR_TABLE_WITH_HASH */
 }
 /*---------------------------------------------------------------------------*/
 /* Get bit from "used" or "locked" bitmap */
@@ -196,6 +286,9 @@ remove_key(nbr_table_key_t *least_used_key)
   }
   /* Empty used map */
   used_map[index_from_key(least_used_key)] = 0;
+#if NBR_TABLE_WITH_HASH
+  hash_remove(index_from_key(least_used_key));
+#endif /* NBR_TABLE_WITH_HASH */
   /* Remove neighbor from list */
   list_remove(nbr_table_keys, least_used_key);
 }
@@ -369,6 +462,9 @@ nbr_table_add_lladdr(nbr_table_t *table, const linkaddr_t *lladdr, nbr_table_rea
 
     /* Set link-layer address */
     linkaddr_copy(&key->lladdr, lladdr);
+#if NBR_TABLE_WITH_HASH
+    hash_insert(index);
+#endif /* NBR_TABLE_WITH_HASH */
   }
 
   /* Get item in the current table */
@@ -466,11 +562,17 @@ nbr_table_update_lladdr(const linkaddr_t *old_addr, const linkaddr_t *new_addr,
     return 0;
   }
   key = key_from_index(index);
+#if NBR_TABLE_WITH_HASH
+  hash_remove(index);
+#endif /* NBR_TABLE_WITH_HASH */
   /**
    * Copy the new lladdr into the key - since we know that there is no
    * conflicting entry.
    */
   memcpy(&key->lladdr, new_addr, sizeof(linkaddr_t));
+#if NBR_TABLE_WITH_HASH
+  hash_insert(index);
+#endif /* NBR_TABLE_WITH_HASH */
   NBR_TABLE_RELEASE_LOCK();
   return 1;
 }
@@ -46,6 +46,23 @@
 #define NBR_TABLE_MAX_NEIGHBORS 8
 #endif /* NBR_TABLE_CONF_MAX_NEIGHBORS */
 
+/* Index the neighbors by link-layer address with an open-addressing
+ * hash table, making lookups O(1) on average instead of a walk of all
+ * neighbors. Worth enabling when NBR_TABLE_MAX_NEIGHBORS is large. */
+#ifdef NBR_TABLE_CONF_WITH_HASH
+#define NBR_TABLE_WITH_HASH NBR_TABLE_CONF_WITH_HASH
+#else /* NBR_TABLE_CONF_WITH_HASH */
+#define NBR_TABLE_WITH_HASH 0
+#endif /* NBR_TABLE_CONF_WITH_HASH */
+
+/* Number of slots of the hash index. Must be larger than
+ * NBR_TABLE_MAX_NEIGHBORS. A power of two avoids a division. */
+#ifdef NBR_TABLE_CONF_HASH_SIZE
+#define NBR_TABLE_HASH_SIZE NBR_TABLE_CONF_HASH_SIZE
+#else /* NBR_TABLE_CONF_HASH_SIZE */
+#define NBR_TABLE_HASH_SIZE (2 * NBR_TABLE_MAX_NEIGHBORS)
+#endif /* NBR_TABLE_CONF_HASH_SIZE */
+
 #ifndef NBR_TABLE_CONF_WITH_LOCKING
 #define NBR_TABLE_CONF_WITH_LOCKING 0
 #endif /* NBR_TABLE_CONF_WITH_LOCKING */
@@ -97,6 +114,7 @@ typedef enum {
 	NBR_TABLE_REASON_MAC,
 	NBR_TABLE_REASON_LLSEC,
 	NBR_TABLE_REASON_LINK_STATS,
+	NBR_TABLE_REASON_SIXTOP,
 } nbr_table_reason_t;
 
 /** \name Neighbor tables: register and loop through table elements */
@@ -55,6 +55,9 @@
 struct queuebuf {
 #if QUEUEBUF_DEBUG
   struct queuebuf *next;
+#if QUEUEBUF_WITH_DLIST
+  struct queuebuf *prev;
+#endif /* QUEUEBUF_WITH_DLIST */
   const char *file;
   int line;
   clock_time_t time;
@@ -113,7 +116,12 @@ static struct ctimer renew_timer;
 
 #if QUEUEBUF_DEBUG
 #include "lib/list.h"
+#if QUEUEBUF_WITH_DLIST
+#include "lib/dlist.h"
+DLIST(queuebuf_list);
+#else /* QUEUEBUF_WITH_DLIST */
 LIST(queuebuf_list);
+#endif /* QUEUEBUF_WITH_DLIST */
 #endif /* QUEUEBUF_DEBUG */
 
 #define DEBUG 0
@@ -313,7 +321,11 @@ queuebuf_new_from_packetbuf(void)
   buf = memb_alloc(&bufmem);
   if(buf != NULL) {
 #if QUEUEBUF_DEBUG
+#if QUEUEBUF_WITH_DLIST
+    dlist_add(queuebuf_list, buf);
+#else /* QUEUEBUF_WITH_DLIST */
     list_add(queuebuf_list, buf);
+#endif /* QUEUEBUF_WITH_DLIST */
     buf->file = file;
     buf->line = line;
     buf->time = clock_time();
@@ -410,7 +422,11 @@ queuebuf_free(struct queuebuf *buf)
     PRINTF("#A q=%d\n", queuebuf_len);
 #endif /* QUEUEBUF_STATS */
 #if QUEUEBUF_DEBUG
+#if QUEUEBUF_WITH_DLIST
+    dlist_remove(queuebuf_list, buf);
+#else /* QUEUEBUF_WITH_DLIST */
     list_remove(queuebuf_list, buf);
+#endif /* QUEUEBUF_WITH_DLIST */
 #endif /* QUEUEBUF_DEBUG */
   }
 }
@@ -462,7 +478,11 @@ queuebuf_debug_print(void)
 #if QUEUEBUF_DEBUG
   struct queuebuf *q;
   printf("queuebuf_list: ");
+#if QUEUEBUF_WITH_DLIST
+  for(q = dlist_head(queuebuf_list); q != NULL;
+#else /* QUEUEBUF_WITH_DLIST */
   for(q = list_head(queuebuf_list); q != NULL;
+#endif /* QUEUEBUF_WITH_DLIST */
       q = list_item_next(q)) {
     printf("%s,%d,%lu ", q->file, q->line, q->time);
   }
@@ -85,6 +85,14 @@
 #define QUEUEBUF_DEBUG 0
 #endif /* QUEUEBUF_CONF_DEBUG */
 
+/* Keep the debug list of allocated queuebufs doubly linked, so that
+   freeing a queuebuf does not traverse the list */
+#ifdef QUEUEBUF_CONF_WITH_DLIST
+#define QUEUEBUF_WITH_DLIST QUEUEBUF_CONF_WITH_DLIST
+#else /* QUEUEBUF_CONF_WITH_DLIST */
+#define QUEUEBUF_WITH_DLIST 0
+#endif /* QUEUEBUF_CONF_WITH_DLIST */
+
 struct queuebuf;
 
 void queuebuf_init(void);
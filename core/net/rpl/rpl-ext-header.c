@@ -322,11 +322,54 @@ count_matching_bytes(const void *p1, const void *p2, size_t n)
   return n;
 }
 /*---------------------------------------------------------------------------*/
+#if RPL_NS_SRH_CACHE_SIZE > 0
+#if RPL_NS_SRH_CACHE_LEN > 255
+#error "RPL_NS_SRH_CACHE_LEN must fit a single extension header"
+#endif
+/* A complete source routing header, as last built for a destination */
+struct srh_cache_entry {
+  uip_ipaddr_t dest;
+  uip_ipaddr_t first_hop;
+  const rpl_dag_t *dag;
+  uint32_t version;
+  uint8_t ext_len; /* 0 for an unused entry */
+  uint8_t hdr[RPL_NS_SRH_CACHE_LEN];
+};
+static struct srh_cache_entry srh_cache[RPL_NS_SRH_CACHE_SIZE];
+/*---------------------------------------------------------------------------*/
+static struct srh_cache_entry *
+srh_cache_entry_for(const uip_ipaddr_t *dest)
+{
+  uint32_t h;
+
+  /* Multiplicative hash of the last four bytes of the address */
+  h = ((uint32_t)dest->u8[12] << 24) | ((uint32_t)dest->u8[13] << 16)
+    | ((uint32_t)dest->u8[14] << 8) | dest->u8[15];
+  h *= 2654435761UL;
+  return &srh_cache[(h >> 16) % RPL_NS_SRH_CACHE_SIZE];
+}
+#endif /* RPL_NS_SRH_CACHE_SIZE > 0 */
+/*---------------------------------------------------------------------------*/
+static void
+account_for_srh(uint8_t ext_len)
+{
+  uint8_t temp_len;
+
+  /* In-place update of IPv6 length field */
+  temp_len = UIP_IP_BUF->len[1];
+  UIP_IP_BUF->len[1] += ext_len;
+  if(UIP_IP_BUF->len[1] < temp_len) {
+    UIP_IP_BUF->len[0]++;
+  }
+
+  uip_ext_len += ext_len;
+  uip_len += ext_len;
+}
+/*---------------------------------------------------------------------------*/
 static int
 insert_srh_header(void)
 {
   /* Implementation of RFC6554 */
-  uint8_t temp_len;
   uint8_t path_len;
   uint8_t ext_len;
   uint8_t cmpri, cmpre; /* ComprI and ComprE fields of the RPL Source Routing Header */
@@ -337,6 +380,9 @@ insert_srh_header(void)
   rpl_ns_node_t *node;
   rpl_dag_t *dag;
   uip_ipaddr_t node_addr;
+#if RPL_NS_SRH_CACHE_SIZE > 0
+  struct srh_cache_entry *entry;
+#endif /* RPL_NS_SRH_CACHE_SIZE > 0 */
 
   PRINTF("RPL: SRH creating source routing header with destination ");
   PRINT6ADDR(&UIP_IP_BUF->destipaddr);
@@ -352,6 +398,30 @@ insert_srh_header(void)
     return 0;
   }
 
+#if RPL_NS_SRH_CACHE_SIZE > 0
+  /* Reuse the header built for the previous packet to this destination,
+   * unless the topology changed since */
+  entry = srh_cache_entry_for(&UIP_IP_BUF->destipaddr);
+  if(entry->ext_len != 0
+      && entry->dag == dag
+      && entry->version == rpl_ns_topology_version()
+      && uip_ipaddr_cmp(&entry->dest, &UIP_IP_BUF->destipaddr)
+      && !memcmp(&entry->dest, &dag->dag_id, 8)) {
+    if(uip_len + entry->ext_len > UIP_BUFSIZE) {
+      PRINTF("RPL: Packet too long: impossible to add source routing header (%u bytes)\n", entry->ext_len);
+      return 1;
+    }
+    memmove(uip_buf + uip_l2_l3_hdr_len + entry->ext_len,
+        uip_buf + uip_l2_l3_hdr_len, uip_len - UIP_IPH_LEN);
+    memcpy(UIP_RH_BUF, entry->hdr, entry->ext_len);
+    UIP_RH_BUF->next = UIP_IP_BUF->proto;
+    UIP_IP_BUF->proto = UIP_PROTO_ROUTING;
+    uip_ipaddr_copy(&UIP_IP_BUF->destipaddr, &entry->first_hop);
+    account_for_srh(entry->ext_len);
+    return 1;
+  }
+#endif /* RPL_NS_SRH_CACHE_SIZE > 0 */
+
   dest_node = rpl_ns_get_node(dag, &UIP_IP_BUF->destipaddr);
   if(dest_node == NULL) {
     /* The destination is not found, skip SRH insertion */
@@ -413,6 +483,10 @@ insert_srh_header(void)
     return 1;
   }
 
+#if RPL_NS_SRH_CACHE_SIZE > 0
+  uip_ipaddr_copy(&entry->dest, &UIP_IP_BUF->destipaddr);
+#endif /* RPL_NS_SRH_CACHE_SIZE > 0 */
+
   /* Move existing ext headers and payload uip_ext_len further */
   memmove(uip_buf + uip_l2_l3_hdr_len + ext_len,
       uip_buf + uip_l2_l3_hdr_len, uip_len - UIP_IPH_LEN);
@@ -449,15 +523,19 @@ insert_srh_header(void)
   rpl_ns_get_node_global_addr(&node_addr, node);
   uip_ipaddr_copy(&UIP_IP_BUF->destipaddr, &node_addr);
 
-  /* In-place update of IPv6 length field */
-  temp_len = UIP_IP_BUF->len[1];
-  UIP_IP_BUF->len[1] += ext_len;
-  if(UIP_IP_BUF->len[1] < temp_len) {
-    UIP_IP_BUF->len[0]++;
+#if RPL_NS_SRH_CACHE_SIZE > 0
+  if(ext_len <= RPL_NS_SRH_CACHE_LEN) {
+    uip_ipaddr_copy(&entry->first_hop, &node_addr);
+    entry->dag = dag;
+    entry->version = rpl_ns_topology_version();
+    entry->ext_len = ext_len;
+    memcpy(entry->hdr, UIP_RH_BUF, ext_len);
+  } else {
+    entry->ext_len = 0;
   }
+#endif /* RPL_NS_SRH_CACHE_SIZE > 0 */
 
-  uip_ext_len += ext_len;
-  uip_len += ext_len;
+  account_for_srh(ext_len);
 
   return 1;
 }
@@ -90,6 +90,17 @@ void RPL_DEBUG_DIO_INPUT(uip_ipaddr_t *, rpl_dio_t *);
 void RPL_DEBUG_DAO_OUTPUT(rpl_parent_t *);
 #endif
 
+/* Hooks for DIO options RPL does not handle itself (e.g. an option
+ * used by a TSCH scheduler). The output callback writes its options
+ * at buffer and returns the number of bytes written. */
+#ifdef RPL_CALLBACK_DIO_OPTION_INPUT
+void RPL_CALLBACK_DIO_OPTION_INPUT(const uip_ipaddr_t *from, const uint8_t *option, uint8_t len);
+#endif /* RPL_CALLBACK_DIO_OPTION_INPUT */
+
+#ifdef RPL_CALLBACK_DIO_OPTIONS_OUTPUT
+int RPL_CALLBACK_DIO_OPTIONS_OUTPUT(rpl_instance_t *instance, uint8_t *buffer);
+#endif /* RPL_CALLBACK_DIO_OPTIONS_OUTPUT */
+
 static uint8_t dao_sequence = RPL_LOLLIPOP_INIT;
 
 #if RPL_WITH_MULTICAST
@@ -450,8 +461,12 @@ dio_input(void)
         memcpy(&dio.prefix_info.prefix, &buffer[i + 16], 16);
         break;
       default:
+#ifdef RPL_CALLBACK_DIO_OPTION_INPUT
+        RPL_CALLBACK_DIO_OPTION_INPUT(&from, &buffer[i], len);
+#else /* RPL_CALLBACK_DIO_OPTION_INPUT */
         PRINTF("RPL: Unsupported suboption type in DIO: %u\n",
                (unsigned)subopt_type);
+#endif /* RPL_CALLBACK_DIO_OPTION_INPUT */
     }
   }
 
@@ -593,6 +608,10 @@ dio_output(rpl_instance_t *instance, uip_ipaddr_t *uc_addr)
            dag->prefix_info.length);
   }
 
+#ifdef RPL_CALLBACK_DIO_OPTIONS_OUTPUT
+  pos += RPL_CALLBACK_DIO_OPTIONS_OUTPUT(instance, &buffer[pos]);
+#endif /* RPL_CALLBACK_DIO_OPTIONS_OUTPUT */
+
 #if RPL_LEAF_ONLY
 #if (DEBUG) & DEBUG_PRINT
   if(uc_addr == NULL) {
@@ -63,6 +63,21 @@ static int num_nodes;
 LIST(nodelist);
 MEMB(nodememb, rpl_ns_node_t, RPL_NS_LINK_NUM);
 
+/* Incremented whenever a parent changes or a node goes away. 32 bits,
+   so that it does not wrap around to the version of a stale entry in
+   the SRH cache. */
+static uint32_t topology_version;
+
+#if RPL_NS_WITH_HASH
+#if RPL_NS_HASH_SIZE <= RPL_NS_LINK_NUM
+#error "RPL_NS_HASH_SIZE must be larger than RPL_NS_LINK_NUM"
+#endif
+/* Hash index over the nodes, using linear probing. Each slot holds the
+ * index of the node in nodememb plus one, so that zero marks an empty
+ * slot. */
+static uint16_t hash_slots[RPL_NS_HASH_SIZE];
+#endif /* RPL_NS_WITH_HASH */
+
 /*---------------------------------------------------------------------------*/
 int
 rpl_ns_num_nodes(void)
@@ -81,16 +96,103 @@ node_matches_address(const rpl_dag_t *dag, const rpl_ns_node_t *node, const uip_
       && !memcmp(((const unsigned char *)addr) + 8, node->link_identifier, 8);
 }
 /*---------------------------------------------------------------------------*/
+#if RPL_NS_WITH_HASH
+static rpl_ns_node_t *
+node_from_slot(unsigned slot)
+{
+  return &((rpl_ns_node_t *)nodememb.mem)[hash_slots[slot] - 1];
+}
+/*---------------------------------------------------------------------------*/
+static unsigned
+hash_from_identifier(const unsigned char *link_identifier)
+{
+  uint32_t h;
+  int i;
+
+  /* FNV-1a */
+  h = 2166136261UL;
+  for(i = 0; i < 8; i++) {
+    h = (h ^ link_identifier[i]) * 16777619UL;
+  }
+  return h % RPL_NS_HASH_SIZE;
+}
+/*---------------------------------------------------------------------------*/
+static void
+hash_insert(rpl_ns_node_t *node)
+{
+  unsigned slot;
+
+  slot = hash_from_identifier(node->link_identifier);
+  while(hash_slots[slot] != 0) {
+    slot = (slot + 1) % RPL_NS_HASH_SIZE;
+  }
+  hash_slots[slot] = node - (rpl_ns_node_t *)nodememb.mem + 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+hash_remove(rpl_ns_node_t *node)
+{
+  unsigned slot;
+  unsigned next;
+  unsigned home;
+  uint16_t index;
+
+  index = node - (rpl_ns_node_t *)nodememb.mem + 1;
+  slot = hash_from_identifier(node->link_identifier);
+  while(hash_slots[slot] != index) {
+    if(hash_slots[slot] == 0) {
+      return;
+    }
+    slot = (slot + 1) % RPL_NS_HASH_SIZE;
+  }
+
+  /* Shift later entries of the same probe sequence back, so that
+   * lookups never stop early at the freed slot */
+  next = slot;
+  while(1) {
+    hash_slots[slot] = 0;
+    do {
+      next = (next + 1) % RPL_NS_HASH_SIZE;
+      if(hash_slots[next] == 0) {
+        return;
+      }
+      home = hash_from_identifier(node_from_slot(next)->link_identifier);
+      /* Keep the entry if its home slot lies cyclically in (slot, next] */
+    } while(slot <= next
+            ? (slot < home && home <= next)
+            : (slot < home || home <= next));
+    hash_slots[slot] = hash_slots[next];
+    slot = next;
+  }
+}
+#endif /* RPL_NS_WITH_HASH */
+/*---------------------------------------------------------------------------*/
 rpl_ns_node_t *
 rpl_ns_get_node(const rpl_dag_t *dag, const uip_ipaddr_t *addr)
 {
   rpl_ns_node_t *l;
+#if RPL_NS_WITH_HASH
+  unsigned slot;
+
+  if(addr == NULL) {
+    return NULL;
+  }
+  slot = hash_from_identifier(((const unsigned char *)addr) + 8);
+  while(hash_slots[slot] != 0) {
+    l = node_from_slot(slot);
+    if(node_matches_address(dag, l, addr)) {
+      return l;
+    }
+    slot = (slot + 1) % RPL_NS_HASH_SIZE;
+  }
+#else /* RPL_NS_WITH_HASH */
   for(l = list_head(nodelist); l != NULL; l = list_item_next(l)) {
     /* Compare prefix and node identifier */
     if(node_matches_address(dag, l, addr)) {
       return l;
     }
   }
+#endif /* RPL_NS_WITH_HASH */
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
@@ -142,18 +244,24 @@ rpl_ns_update_node(rpl_dag_t *dag, const uip_ipaddr_t *child, const uip_ipaddr_t
       return NULL;
     }
     child_node->parent = NULL;
+    memcpy(child_node->link_identifier, ((const unsigned char *)child) + 8, 8);
     list_add(nodelist, child_node);
+#if RPL_NS_WITH_HASH
+    hash_insert(child_node);
+#endif /* RPL_NS_WITH_HASH */
     num_nodes++;
   }
 
   /* Initialize node */
+  if(child_node->dag != dag) {
+    topology_version++;
+  }
   child_node->dag = dag;
   child_node->lifetime = lifetime;
-  memcpy(child_node->link_identifier, ((const unsigned char *)child) + 8, 8);
+  old_parent_node = child_node->parent;
 
   /* Is the node reachable before the update? */
   if(rpl_ns_is_node_reachable(dag, child)) {
-    old_parent_node = child_node->parent;
     /* Update node */
     child_node->parent = parent_node;
     /* Has the node become unreachable? May happen if we create a loop. */
@@ -167,6 +275,10 @@ rpl_ns_update_node(rpl_dag_t *dag, const uip_ipaddr_t *child, const uip_ipaddr_t
     child_node->parent = parent_node;
   }
 
+  if(child_node->parent != old_parent_node) {
+    topology_version++;
+  }
+
   return child_node;
 }
 /*---------------------------------------------------------------------------*/
@@ -176,6 +288,10 @@ rpl_ns_init(void)
   num_nodes = 0;
   memb_init(&nodememb);
   list_init(nodelist);
+#if RPL_NS_WITH_HASH
+  memset(hash_slots, 0, sizeof(hash_slots));
+#endif /* RPL_NS_WITH_HASH */
+  topology_version++;
 }
 /*---------------------------------------------------------------------------*/
 rpl_ns_node_t *
@@ -220,11 +336,23 @@ rpl_ns_periodic(void)
         }
       }
       /* No child found, deallocate node */
-      list_remove(nodelist, l);
-      memb_free(&nodememb, l);
-      num_nodes--;
+      if(l2 == NULL) {
+#if RPL_NS_WITH_HASH
+        hash_remove(l);
+#endif /* RPL_NS_WITH_HASH */
+        list_remove(nodelist, l);
+        memb_free(&nodememb, l);
+        num_nodes--;
+        topology_version++;
+      }
     }
   }
 }
+/*---------------------------------------------------------------------------*/
+uint32_t
+rpl_ns_topology_version(void)
+{
+  return topology_version;
+}
 
 #endif /* RPL_WITH_NON_STORING */
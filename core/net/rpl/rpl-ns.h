@@ -49,6 +49,39 @@
 #define RPL_NS_LINK_NUM 32
 #endif /* RPL_NS_CONF_LINK_NUM */
 
+/* Index the nodes by link identifier in a hash table, making
+ * rpl_ns_get_node() O(1) on average instead of a walk of all nodes.
+ * Worth enabling at roots with many nodes. */
+#ifdef RPL_NS_CONF_WITH_HASH
+#define RPL_NS_WITH_HASH RPL_NS_CONF_WITH_HASH
+#else /* RPL_NS_CONF_WITH_HASH */
+#define RPL_NS_WITH_HASH 0
+#endif /* RPL_NS_CONF_WITH_HASH */
+
+/* Number of slots of the hash index. Must be larger than
+ * RPL_NS_LINK_NUM. */
+#ifdef RPL_NS_CONF_HASH_SIZE
+#define RPL_NS_HASH_SIZE RPL_NS_CONF_HASH_SIZE
+#else /* RPL_NS_CONF_HASH_SIZE */
+#define RPL_NS_HASH_SIZE (2 * RPL_NS_LINK_NUM)
+#endif /* RPL_NS_CONF_HASH_SIZE */
+
+/* Number of source routing headers the root keeps ready for reuse,
+ * one per destination. A cached header is dropped as soon as any path
+ * in the node table changes. 0 disables the cache. */
+#ifdef RPL_NS_CONF_SRH_CACHE_SIZE
+#define RPL_NS_SRH_CACHE_SIZE RPL_NS_CONF_SRH_CACHE_SIZE
+#else /* RPL_NS_CONF_SRH_CACHE_SIZE */
+#define RPL_NS_SRH_CACHE_SIZE 0
+#endif /* RPL_NS_CONF_SRH_CACHE_SIZE */
+
+/* The longest source routing header the cache holds, in bytes */
+#ifdef RPL_NS_CONF_SRH_CACHE_LEN
+#define RPL_NS_SRH_CACHE_LEN RPL_NS_CONF_SRH_CACHE_LEN
+#else /* RPL_NS_CONF_SRH_CACHE_LEN */
+#define RPL_NS_SRH_CACHE_LEN 64
+#endif /* RPL_NS_CONF_SRH_CACHE_LEN */
+
 typedef struct rpl_ns_node {
   struct rpl_ns_node *next;
   uint32_t lifetime;
@@ -68,5 +101,7 @@ rpl_ns_node_t *rpl_ns_get_node(const rpl_dag_t *dag, const uip_ipaddr_t *addr);
 int rpl_ns_is_node_reachable(const rpl_dag_t *dag, const uip_ipaddr_t *addr);
 void rpl_ns_get_node_global_addr(uip_ipaddr_t *addr, rpl_ns_node_t *node);
 void rpl_ns_periodic(void);
+/* Changes whenever the path to any node may have changed */
+uint32_t rpl_ns_topology_version(void);
 
 #endif /* RPL_NS_H */
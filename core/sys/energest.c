@@ -49,6 +49,7 @@ rtimer_clock_t energest_current_time[ENERGEST_TYPE_MAX];
 energest_t energest_leveldevice_current_leveltime[ENERGEST_CONF_LEVELDEVICE_LEVELS];
 #endif
 unsigned char energest_current_mode[ENERGEST_TYPE_MAX];
+unsigned long energest_total_avoided_wakeups;
 
 /*---------------------------------------------------------------------------*/
 void
@@ -59,6 +60,7 @@ energest_init(void)
     energest_total_time[i].current = energest_current_time[i] = 0;
     energest_current_mode[i] = 0;
   }
+  energest_total_avoided_wakeups = 0;
 #ifdef ENERGEST_CONF_LEVELDEVICE_LEVELS
   for(i = 0; i < ENERGEST_CONF_LEVELDEVICE_LEVELS; ++i) {
     energest_leveldevice_current_leveltime[i].current = 0;
@@ -113,9 +115,16 @@ energest_flush(void)
   }
 }
 /*---------------------------------------------------------------------------*/
+unsigned long
+energest_avoided_wakeups(void)
+{
+  return energest_total_avoided_wakeups;
+}
+/*---------------------------------------------------------------------------*/
 #else /* ENERGEST_CONF_ON */
 void energest_type_set(int type, unsigned long val) {}
 void energest_init(void) {}
 unsigned long energest_type_time(int type) { return 0; }
 void energest_flush(void) {}
+unsigned long energest_avoided_wakeups(void) { return 0; }
 #endif /* ENERGEST_CONF_ON */
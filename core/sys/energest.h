@@ -74,12 +74,15 @@ unsigned long energest_leveldevice_leveltime(int powerlevel);
 #endif
 void energest_type_set(int type, unsigned long value);
 void energest_flush(void);
+unsigned long energest_avoided_wakeups(void);
 
 #if ENERGEST_CONF_ON
 /*extern int energest_total_count;*/
 extern energest_t energest_total_time[ENERGEST_TYPE_MAX];
 extern rtimer_clock_t energest_current_time[ENERGEST_TYPE_MAX];
 extern unsigned char energest_current_mode[ENERGEST_TYPE_MAX];
+/* Timer ticks that the idle loop slept through, see sys/tickless.h */
+extern unsigned long energest_total_avoided_wakeups;
 
 #ifdef ENERGEST_CONF_LEVELDEVICE_LEVELS
 extern energest_t energest_leveldevice_current_leveltime[ENERGEST_CONF_LEVELDEVICE_LEVELS];
@@ -145,11 +148,16 @@ extern energest_t energest_leveldevice_current_leveltime[ENERGEST_CONF_LEVELDEVI
                                            } while(0)
 #endif
 
+#define ENERGEST_AVOIDED_WAKEUPS(n) do { \
+                                      energest_total_avoided_wakeups += (n); \
+                                    } while(0)
+
 #else /* ENERGEST_CONF_ON */
 #define ENERGEST_ON(type) do { } while(0)
 #define ENERGEST_OFF(type) do { } while(0)
 #define ENERGEST_OFF_LEVEL(type,level) do { } while(0)
 #define ENERGEST_SWITCH(type_off, type_on) do { } while(0)
+#define ENERGEST_AVOIDED_WAKEUPS(n) do { } while(0)
 #endif /* ENERGEST_CONF_ON */
 
 #endif /* ENERGEST_H_ */
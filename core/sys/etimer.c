@@ -52,8 +52,94 @@
 static struct etimer *timerlist;
 static clock_time_t next_expiration;
 
+#if ETIMER_HEAP
+/* Pending timers ordered by expiration time. heap_pos in each timer
+   is its position in the heap plus one. */
+static struct etimer *heap[ETIMER_HEAP_SIZE];
+static unsigned heap_len;
+
+#define CLOCK_HALF ((clock_time_t)~(clock_time_t)0 >> 1)
+#endif /* ETIMER_HEAP */
+
 PROCESS(etimer_process, "Event timer");
 /*---------------------------------------------------------------------------*/
+#if ETIMER_HEAP
+static int
+expires_before(struct etimer *a, struct etimer *b)
+{
+  return (clock_time_t)((a->timer.start + a->timer.interval) -
+                        (b->timer.start + b->timer.interval)) > CLOCK_HALF;
+}
+/*---------------------------------------------------------------------------*/
+static void
+heap_place(unsigned pos, struct etimer *t)
+{
+  heap[pos] = t;
+  t->heap_pos = pos + 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+heap_sift_down(unsigned pos)
+{
+  struct etimer *t;
+  unsigned child;
+
+  t = heap[pos];
+  while((child = 2 * pos + 1) < heap_len) {
+    if(child + 1 < heap_len && expires_before(heap[child + 1], heap[child])) {
+      child++;
+    }
+    if(!expires_before(heap[child], t)) {
+      break;
+    }
+    heap_place(pos, heap[child]);
+    pos = child;
+  }
+  heap_place(pos, t);
+}
+/*---------------------------------------------------------------------------*/
+/* Restore the heap order after the expiration time of the timer at
+   pos has changed */
+static void
+heap_sift(unsigned pos)
+{
+  struct etimer *t;
+  unsigned parent;
+
+  t = heap[pos];
+  if(pos > 0 && expires_before(t, heap[(pos - 1) / 2])) {
+    do {
+      parent = (pos - 1) / 2;
+      heap_place(pos, heap[parent]);
+      pos = parent;
+    } while(pos > 0 && expires_before(t, heap[(pos - 1) / 2]));
+    heap_place(pos, t);
+  } else {
+    heap_sift_down(pos);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+heap_contains(struct etimer *t)
+{
+  return t->heap_pos != 0 && t->heap_pos <= heap_len &&
+    heap[t->heap_pos - 1] == t;
+}
+/*---------------------------------------------------------------------------*/
+static void
+heap_remove(struct etimer *t)
+{
+  unsigned pos;
+
+  pos = t->heap_pos - 1;
+  t->heap_pos = 0;
+  if(pos != --heap_len) {
+    heap_place(pos, heap[heap_len]);
+    heap_sift(pos);
+  }
+}
+#endif /* ETIMER_HEAP */
+/*---------------------------------------------------------------------------*/
 static void
 update_time(void)
 {
@@ -61,6 +147,28 @@ update_time(void)
   clock_time_t now;
   struct etimer *t;
 
+#if ETIMER_HEAP
+  if(heap_len == 0 && timerlist == NULL) {
+    next_expiration = 0;
+  } else {
+    now = clock_time();
+    /* The heap top is the earliest timer in the heap, but timers that
+       did not fit into the heap still have to be searched */
+    if(heap_len > 0) {
+      tdist = heap[0]->timer.start + heap[0]->timer.interval - now;
+      t = timerlist;
+    } else {
+      tdist = timerlist->timer.start + timerlist->timer.interval - now;
+      t = timerlist->next;
+    }
+    for(; t != NULL; t = t->next) {
+      if(t->timer.start + t->timer.interval - now < tdist) {
+	tdist = t->timer.start + t->timer.interval - now;
+      }
+    }
+    next_expiration = now + tdist;
+  }
+#else /* ETIMER_HEAP */
   if (timerlist == NULL) {
     next_expiration = 0;
   } else {
@@ -75,11 +183,15 @@ update_time(void)
     }
     next_expiration = now + tdist;
   }
+#endif /* ETIMER_HEAP */
 }
 /*---------------------------------------------------------------------------*/
 PROCESS_THREAD(etimer_process, ev, data)
 {
   struct etimer *t, *u;
+#if ETIMER_HEAP
+  unsigned i, n;
+#endif /* ETIMER_HEAP */
 	
   PROCESS_BEGIN();
 
@@ -91,6 +203,21 @@ PROCESS_THREAD(etimer_process, ev, data)
     if(ev == PROCESS_EVENT_EXITED) {
       struct process *p = data;
 
+#if ETIMER_HEAP
+      /* Drop the timers of the process and rebuild the heap */
+      for(i = 0, n = 0; i < heap_len; i++) {
+	if(heap[i]->p == p) {
+	  heap[i]->heap_pos = 0;
+	} else {
+	  heap_place(n++, heap[i]);
+	}
+      }
+      heap_len = n;
+      for(i = heap_len / 2; i > 0; i--) {
+	heap_sift_down(i - 1);
+      }
+#endif /* ETIMER_HEAP */
+
       while(timerlist != NULL && timerlist->p == p) {
 	timerlist = timerlist->next;
       }
@@ -104,11 +231,30 @@ PROCESS_THREAD(etimer_process, ev, data)
 	    t = t->next;
 	}
       }
+#if ETIMER_HEAP
+      update_time();
+#endif /* ETIMER_HEAP */
       continue;
     } else if(ev != PROCESS_EVENT_POLL) {
       continue;
     }
 
+#if ETIMER_HEAP
+    /* Only the top of the heap needs to be checked: all other timers
+       in the heap expire later */
+    while(heap_len > 0 && timer_expired(&heap[0]->timer)) {
+      t = heap[0];
+      if(process_post(t->p, PROCESS_EVENT_TIMER, t) == PROCESS_ERR_OK) {
+	t->p = PROCESS_NONE;
+	heap_remove(t);
+	update_time();
+      } else {
+	etimer_request_poll();
+	break;
+      }
+    }
+#endif /* ETIMER_HEAP */
+
   again:
     
     u = NULL;
@@ -155,6 +301,15 @@ add_timer(struct etimer *timer)
   etimer_request_poll();
 
   if(timer->p != PROCESS_NONE) {
+#if ETIMER_HEAP
+    if(heap_contains(timer)) {
+      /* The expiration time may have changed */
+      timer->p = PROCESS_CURRENT();
+      heap_sift(timer->heap_pos - 1);
+      update_time();
+      return;
+    }
+#endif /* ETIMER_HEAP */
     for(t = timerlist; t != NULL; t = t->next) {
       if(t == timer) {
 	/* Timer already on list, bail out. */
@@ -167,6 +322,14 @@ add_timer(struct etimer *timer)
 
   /* Timer not on list. */
   timer->p = PROCESS_CURRENT();
+#if ETIMER_HEAP
+  if(heap_len < ETIMER_HEAP_SIZE) {
+    heap_place(heap_len++, timer);
+    heap_sift(timer->heap_pos - 1);
+    update_time();
+    return;
+  }
+#endif /* ETIMER_HEAP */
   timer->next = timerlist;
   timerlist = timer;
 
@@ -206,6 +369,11 @@ void
 etimer_adjust(struct etimer *et, int timediff)
 {
   et->timer.start += timediff;
+#if ETIMER_HEAP
+  if(heap_contains(et)) {
+    heap_sift(et->heap_pos - 1);
+  }
+#endif /* ETIMER_HEAP */
   update_time();
 }
 /*---------------------------------------------------------------------------*/
@@ -230,6 +398,11 @@ etimer_start_time(struct etimer *et)
 int
 etimer_pending(void)
 {
+#if ETIMER_HEAP
+  if(heap_len > 0) {
+    return 1;
+  }
+#endif /* ETIMER_HEAP */
   return timerlist != NULL;
 }
 /*---------------------------------------------------------------------------*/
@@ -244,6 +417,16 @@ etimer_stop(struct etimer *et)
 {
   struct etimer *t;
 
+#if ETIMER_HEAP
+  if(heap_contains(et)) {
+    heap_remove(et);
+    update_time();
+    et->next = NULL;
+    et->p = PROCESS_NONE;
+    return;
+  }
+#endif /* ETIMER_HEAP */
+
   /* First check if et is the first event timer on the list. */
   if(et == timerlist) {
     timerlist = timerlist->next;
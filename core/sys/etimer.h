@@ -65,6 +65,32 @@
 #include "sys/timer.h"
 #include "sys/process.h"
 
+/**
+ * \brief Keep pending event timers in a binary min-heap
+ *
+ * By default, pending event timers are kept in an unsorted list, which
+ * is walked whenever a timer is set or stopped and whenever the clock
+ * has advanced. When ETIMER_CONF_HEAP is set to 1, up to
+ * ETIMER_CONF_HEAP_SIZE pending timers are instead kept in a binary
+ * min-heap ordered by expiration time, so that setting and stopping a
+ * timer takes O(log n) time and checking for expired timers takes
+ * O(1). Timers beyond the capacity of the heap fall back to the list.
+ *
+ * The heap orders timers by their expiration times, so the interval of
+ * a timer must be less than half the range of clock_time_t.
+ */
+#ifdef ETIMER_CONF_HEAP
+#define ETIMER_HEAP ETIMER_CONF_HEAP
+#else /* ETIMER_CONF_HEAP */
+#define ETIMER_HEAP 0
+#endif /* ETIMER_CONF_HEAP */
+
+#ifdef ETIMER_CONF_HEAP_SIZE
+#define ETIMER_HEAP_SIZE ETIMER_CONF_HEAP_SIZE
+#else /* ETIMER_CONF_HEAP_SIZE */
+#define ETIMER_HEAP_SIZE 64
+#endif /* ETIMER_CONF_HEAP_SIZE */
+
 /**
  * A timer.
  *
@@ -77,6 +103,9 @@ struct etimer {
   struct timer timer;
   struct etimer *next;
   struct process *p;
+#if ETIMER_HEAP
+  unsigned short heap_pos;
+#endif /* ETIMER_HEAP */
 };
 
 /**
@@ -44,9 +44,16 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "sys/process.h"
 #include "sys/arg.h"
+#if PROCESS_CONF_NUMEVENTS_OVERFLOW > 0
+#include "lib/memb.h"
+#endif /* PROCESS_CONF_NUMEVENTS_OVERFLOW > 0 */
+#if PROCESS_ACCOUNTING
+#include "sys/clock.h"
+#endif /* PROCESS_ACCOUNTING */
 
 /*
  * Pointer to the currently running process structure.
@@ -63,17 +70,56 @@ struct event_data {
   process_event_t ev;
   process_data_t data;
   struct process *p;
+#if PROCESS_ACCOUNTING
+  rtimer_clock_t time;
+#endif /* PROCESS_ACCOUNTING */
+};
+
+#if PROCESS_CONF_NUMEVENTS_OVERFLOW > 0
+/*
+ * An event that did not fit into its queue.
+ */
+struct overflow_event {
+  struct overflow_event *next;
+  struct event_data e;
+};
+MEMB(overflow_events, struct overflow_event, PROCESS_CONF_NUMEVENTS_OVERFLOW);
+static unsigned short noverflow;
+#endif /* PROCESS_CONF_NUMEVENTS_OVERFLOW > 0 */
+
+/*
+ * A ring of events, followed by the events that overflowed it.
+ */
+struct event_queue {
+  struct event_data *events;
+  process_num_events_t size, nevents, fevent;
+#if PROCESS_CONF_NUMEVENTS_OVERFLOW > 0
+  struct overflow_event *overflow_head, *overflow_tail;
+#endif /* PROCESS_CONF_NUMEVENTS_OVERFLOW > 0 */
 };
 
-static process_num_events_t nevents, fevent;
 static struct event_data events[PROCESS_CONF_NUMEVENTS];
+static struct event_queue queue = { events, PROCESS_CONF_NUMEVENTS };
+#if PROCESS_CONF_NUMEVENTS_HIGH > 0
+static struct event_data events_high[PROCESS_CONF_NUMEVENTS_HIGH];
+static struct event_queue queue_high = { events_high,
+                                         PROCESS_CONF_NUMEVENTS_HIGH };
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
 
 #if PROCESS_CONF_STATS
 process_num_events_t process_maxevents;
+process_num_events_t process_maxevents_high;
+unsigned short process_maxoverflow;
+unsigned short process_droppedevents;
 #endif
 
 static volatile unsigned char poll_requested;
 
+#if PROCESS_ACCOUNTING
+/* Time spent in processes called from within the running process */
+static rtimer_clock_t nested_runtime;
+#endif /* PROCESS_ACCOUNTING */
+
 #define PROCESS_STATE_NONE        0
 #define PROCESS_STATE_RUNNING     1
 #define PROCESS_STATE_CALLED      2
@@ -113,6 +159,9 @@ process_start(struct process *p, process_data_t data)
   process_list = p;
   p->state = PROCESS_STATE_RUNNING;
   PT_INIT(&p->pt);
+#if PROCESS_ACCOUNTING
+  memset(&p->accounting, 0, sizeof(p->accounting));
+#endif /* PROCESS_ACCOUNTING */
 
   PRINTF("process: starting '%s'\n", PROCESS_NAME_STRING(p));
 
@@ -175,6 +224,11 @@ static void
 call_process(struct process *p, process_event_t ev, process_data_t data)
 {
   int ret;
+#if PROCESS_ACCOUNTING
+  rtimer_clock_t start;
+  rtimer_clock_t elapsed;
+  rtimer_clock_t outer_nested;
+#endif /* PROCESS_ACCOUNTING */
 
 #if DEBUG
   if(p->state == PROCESS_STATE_CALLED) {
@@ -187,7 +241,22 @@ call_process(struct process *p, process_event_t ev, process_data_t data)
     PRINTF("process: calling process '%s' with event %d\n", PROCESS_NAME_STRING(p), ev);
     process_current = p;
     p->state = PROCESS_STATE_CALLED;
+#if PROCESS_ACCOUNTING
+    outer_nested = nested_runtime;
+    nested_runtime = 0;
+    start = RTIMER_NOW();
+#endif /* PROCESS_ACCOUNTING */
     ret = p->thread(&p->pt, ev, data);
+#if PROCESS_ACCOUNTING
+    elapsed = RTIMER_NOW() - start;
+    /* Do not charge the process for processes that it called */
+    p->accounting.runtime += (rtimer_clock_t)(elapsed - nested_runtime);
+    if((rtimer_clock_t)(elapsed - nested_runtime) > p->accounting.max_runtime) {
+      p->accounting.max_runtime = elapsed - nested_runtime;
+    }
+    p->accounting.invocations++;
+    nested_runtime = outer_nested + elapsed;
+#endif /* PROCESS_ACCOUNTING */
     if(ret == PT_EXITED ||
        ret == PT_ENDED ||
        ev == PROCESS_EVENT_EXIT) {
@@ -209,9 +278,23 @@ process_init(void)
 {
   lastevent = PROCESS_EVENT_MAX;
 
-  nevents = fevent = 0;
+  queue.nevents = queue.fevent = 0;
+#if PROCESS_CONF_NUMEVENTS_HIGH > 0
+  queue_high.nevents = queue_high.fevent = 0;
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
+#if PROCESS_CONF_NUMEVENTS_OVERFLOW > 0
+  memb_init(&overflow_events);
+  noverflow = 0;
+  queue.overflow_head = queue.overflow_tail = NULL;
+#if PROCESS_CONF_NUMEVENTS_HIGH > 0
+  queue_high.overflow_head = queue_high.overflow_tail = NULL;
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
+#endif /* PROCESS_CONF_NUMEVENTS_OVERFLOW > 0 */
 #if PROCESS_CONF_STATS
   process_maxevents = 0;
+  process_maxevents_high = 0;
+  process_maxoverflow = 0;
+  process_droppedevents = 0;
 #endif /* PROCESS_CONF_STATS */
 
   process_current = process_list = NULL;
@@ -237,6 +320,124 @@ do_poll(void)
   }
 }
 /*---------------------------------------------------------------------------*/
+static int
+queue_put(struct event_queue *q, struct process *p, process_event_t ev,
+          process_data_t data)
+{
+  process_num_events_t snum;
+#if PROCESS_CONF_NUMEVENTS_OVERFLOW > 0
+  struct overflow_event *o;
+#endif /* PROCESS_CONF_NUMEVENTS_OVERFLOW > 0 */
+
+  if(q->nevents == q->size) {
+#if PROCESS_CONF_NUMEVENTS_OVERFLOW > 0
+    /* Since the ring is refilled from the overflow events as soon as
+       there is space, appending here keeps the events in order. */
+    o = memb_alloc(&overflow_events);
+    if(o != NULL) {
+      o->e.ev = ev;
+      o->e.data = data;
+      o->e.p = p;
+#if PROCESS_ACCOUNTING
+      o->e.time = RTIMER_NOW();
+#endif /* PROCESS_ACCOUNTING */
+      o->next = NULL;
+      if(q->overflow_tail != NULL) {
+        q->overflow_tail->next = o;
+      } else {
+        q->overflow_head = o;
+      }
+      q->overflow_tail = o;
+      ++noverflow;
+#if PROCESS_CONF_STATS
+      if(noverflow > process_maxoverflow) {
+        process_maxoverflow = noverflow;
+      }
+#endif /* PROCESS_CONF_STATS */
+      return PROCESS_ERR_OK;
+    }
+#endif /* PROCESS_CONF_NUMEVENTS_OVERFLOW > 0 */
+#if PROCESS_CONF_STATS
+    process_droppedevents++;
+#endif /* PROCESS_CONF_STATS */
+    return PROCESS_ERR_FULL;
+  }
+
+  snum = (process_num_events_t)(q->fevent + q->nevents) % q->size;
+  q->events[snum].ev = ev;
+  q->events[snum].data = data;
+  q->events[snum].p = p;
+#if PROCESS_ACCOUNTING
+  q->events[snum].time = RTIMER_NOW();
+#endif /* PROCESS_ACCOUNTING */
+  ++q->nevents;
+
+  return PROCESS_ERR_OK;
+}
+/*---------------------------------------------------------------------------*/
+static int
+queue_get(struct event_queue *q, struct event_data *e)
+{
+#if PROCESS_CONF_NUMEVENTS_OVERFLOW > 0
+  struct overflow_event *o;
+#endif /* PROCESS_CONF_NUMEVENTS_OVERFLOW > 0 */
+
+  if(q->nevents == 0) {
+    return 0;
+  }
+
+  *e = q->events[q->fevent];
+
+  /* Since we have seen the new event, we move pointer upwards
+     and decrease the number of events. */
+  q->fevent = (q->fevent + 1) % q->size;
+  --q->nevents;
+
+#if PROCESS_CONF_NUMEVENTS_OVERFLOW > 0
+  /* Move the oldest overflowed event into the freed slot */
+  o = q->overflow_head;
+  if(o != NULL) {
+    q->overflow_head = o->next;
+    if(q->overflow_head == NULL) {
+      q->overflow_tail = NULL;
+    }
+    q->events[(process_num_events_t)(q->fevent + q->nevents) % q->size] = o->e;
+    ++q->nevents;
+    memb_free(&overflow_events, o);
+    --noverflow;
+  }
+#endif /* PROCESS_CONF_NUMEVENTS_OVERFLOW > 0 */
+
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+queued_events(void)
+{
+  int n;
+
+  n = queue.nevents;
+#if PROCESS_CONF_NUMEVENTS_HIGH > 0
+  n += queue_high.nevents;
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
+#if PROCESS_CONF_NUMEVENTS_OVERFLOW > 0
+  n += noverflow;
+#endif /* PROCESS_CONF_NUMEVENTS_OVERFLOW > 0 */
+  return n;
+}
+/*---------------------------------------------------------------------------*/
+#if PROCESS_ACCOUNTING
+static void
+account_queue_delay(struct process *p, rtimer_clock_t delay)
+{
+  p->accounting.queue_delay += delay;
+  p->accounting.events++;
+  if(delay > p->accounting.max_queue_delay) {
+    p->accounting.max_queue_delay = delay;
+  }
+}
+#endif /* PROCESS_ACCOUNTING */
+/*---------------------------------------------------------------------------*/
 /*
  * Process the next event in the event queue and deliver it to
  * listening processes.
@@ -245,6 +446,7 @@ do_poll(void)
 static void
 do_event(void)
 {
+  struct event_data e;
   process_event_t ev;
   process_data_t data;
   struct process *receiver;
@@ -255,21 +457,23 @@ do_event(void)
    * through the list of processes to see if the event should be
    * delivered to any of them. If so, we call the event handler
    * function for the process. We only process one event at a time and
-   * call the poll handlers inbetween.
+   * call the poll handlers inbetween. Events of high priority
+   * processes are taken before all others.
    */
 
-  if(nevents > 0) {
+  if(
+#if PROCESS_CONF_NUMEVENTS_HIGH > 0
+     queue_get(&queue_high, &e) ||
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
+     queue_get(&queue, &e)) {
     
     /* There are events that we should deliver. */
-    ev = events[fevent].ev;
-    
-    data = events[fevent].data;
-    receiver = events[fevent].p;
-
-    /* Since we have seen the new event, we move pointer upwards
-       and decrease the number of events. */
-    fevent = (fevent + 1) % PROCESS_CONF_NUMEVENTS;
-    --nevents;
+    ev = e.ev;
+    data = e.data;
+    receiver = e.p;
+#if PROCESS_ACCOUNTING
+    e.time = RTIMER_NOW() - e.time;
+#endif /* PROCESS_ACCOUNTING */
 
     /* If this is a broadcast event, we deliver it to all events, in
        order of their priority. */
@@ -281,6 +485,9 @@ do_event(void)
 	if(poll_requested) {
 	  do_poll();
 	}
+#if PROCESS_ACCOUNTING
+	account_queue_delay(p, e.time);
+#endif /* PROCESS_ACCOUNTING */
 	call_process(p, ev, data);
       }
     } else {
@@ -292,6 +499,10 @@ do_event(void)
 	receiver->state = PROCESS_STATE_RUNNING;
       }
 
+#if PROCESS_ACCOUNTING
+      account_queue_delay(receiver, e.time);
+#endif /* PROCESS_ACCOUNTING */
+
       /* Make sure that the process actually is running. */
       call_process(receiver, ev, data);
     }
@@ -309,30 +520,39 @@ process_run(void)
   /* Process one event from the queue */
   do_event();
 
-  return nevents + poll_requested;
+  return queued_events() + poll_requested;
 }
 /*---------------------------------------------------------------------------*/
 int
 process_nevents(void)
 {
-  return nevents + poll_requested;
+  return queued_events() + poll_requested;
 }
 /*---------------------------------------------------------------------------*/
 int
 process_post(struct process *p, process_event_t ev, process_data_t data)
 {
-  process_num_events_t snum;
+  struct event_queue *q;
+  int ret;
 
   if(PROCESS_CURRENT() == NULL) {
     PRINTF("process_post: NULL process posts event %d to process '%s', nevents %d\n",
-	   ev,PROCESS_NAME_STRING(p), nevents);
+	   ev,PROCESS_NAME_STRING(p), queued_events());
   } else {
     PRINTF("process_post: Process '%s' posts event %d to process '%s', nevents %d\n",
 	   PROCESS_NAME_STRING(PROCESS_CURRENT()), ev,
-	   p == PROCESS_BROADCAST? "<broadcast>": PROCESS_NAME_STRING(p), nevents);
+	   p == PROCESS_BROADCAST? "<broadcast>": PROCESS_NAME_STRING(p), queued_events());
   }
-  
-  if(nevents == PROCESS_CONF_NUMEVENTS) {
+
+  q = &queue;
+#if PROCESS_CONF_NUMEVENTS_HIGH > 0
+  if(p != PROCESS_BROADCAST && p->priority == PROCESS_PRIORITY_HIGH) {
+    q = &queue_high;
+  }
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
+
+  ret = queue_put(q, p, ev, data);
+  if(ret != PROCESS_ERR_OK) {
 #if DEBUG
     if(p == PROCESS_BROADCAST) {
       printf("soft panic: event queue is full when broadcast event %d was posted from %s\n", ev, PROCESS_NAME_STRING(process_current));
@@ -340,19 +560,18 @@ process_post(struct process *p, process_event_t ev, process_data_t data)
       printf("soft panic: event queue is full when event %d was posted to %s from %s\n", ev, PROCESS_NAME_STRING(p), PROCESS_NAME_STRING(process_current));
     }
 #endif /* DEBUG */
-    return PROCESS_ERR_FULL;
+    return ret;
   }
-  
-  snum = (process_num_events_t)(fevent + nevents) % PROCESS_CONF_NUMEVENTS;
-  events[snum].ev = ev;
-  events[snum].data = data;
-  events[snum].p = p;
-  ++nevents;
 
 #if PROCESS_CONF_STATS
-  if(nevents > process_maxevents) {
-    process_maxevents = nevents;
+  if(queue.nevents > process_maxevents) {
+    process_maxevents = queue.nevents;
   }
+#if PROCESS_CONF_NUMEVENTS_HIGH > 0
+  if(queue_high.nevents > process_maxevents_high) {
+    process_maxevents_high = queue_high.nevents;
+  }
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
 #endif /* PROCESS_CONF_STATS */
   
   return PROCESS_ERR_OK;
@@ -385,4 +604,22 @@ process_is_running(struct process *p)
   return p->state != PROCESS_STATE_NONE;
 }
 /*---------------------------------------------------------------------------*/
+#if PROCESS_ACCOUNTING
+const struct process_accounting *
+process_accounting_get(struct process *p)
+{
+  return &p->accounting;
+}
+/*---------------------------------------------------------------------------*/
+void
+process_accounting_reset(void)
+{
+  struct process *p;
+
+  for(p = process_list; p != NULL; p = p->next) {
+    memset(&p->accounting, 0, sizeof(p->accounting));
+  }
+}
+#endif /* PROCESS_ACCOUNTING */
+/*---------------------------------------------------------------------------*/
 /** @} */
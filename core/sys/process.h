@@ -56,6 +56,20 @@
 #include "sys/pt.h"
 #include "sys/cc.h"
 
+/*
+ * Record for each process how much time it spends running and how
+ * long its events wait in the event queue. See process_accounting.
+ */
+#ifdef PROCESS_CONF_ACCOUNTING
+#define PROCESS_ACCOUNTING PROCESS_CONF_ACCOUNTING
+#else /* PROCESS_CONF_ACCOUNTING */
+#define PROCESS_ACCOUNTING 0
+#endif /* PROCESS_CONF_ACCOUNTING */
+
+#if PROCESS_ACCOUNTING
+#include "sys/rtimer.h"
+#endif /* PROCESS_ACCOUNTING */
+
 typedef unsigned char process_event_t;
 typedef void *        process_data_t;
 typedef unsigned char process_num_events_t;
@@ -88,6 +102,25 @@ typedef unsigned char process_num_events_t;
 #define PROCESS_CONF_NUMEVENTS 32
 #endif /* PROCESS_CONF_NUMEVENTS */
 
+/*
+ * Size of a separate event queue for processes with
+ * PROCESS_PRIORITY_HIGH. Events in this queue are delivered before
+ * any event in the normal queue, so that e.g. network input is not
+ * delayed by application events. Zero disables priorities.
+ */
+#ifndef PROCESS_CONF_NUMEVENTS_HIGH
+#define PROCESS_CONF_NUMEVENTS_HIGH 0
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH */
+
+/*
+ * Number of events in a pool that is shared by the event queues and
+ * used when a queue is full, instead of failing with
+ * PROCESS_ERR_FULL. Zero disables the overflow pool.
+ */
+#ifndef PROCESS_CONF_NUMEVENTS_OVERFLOW
+#define PROCESS_CONF_NUMEVENTS_OVERFLOW 0
+#endif /* PROCESS_CONF_NUMEVENTS_OVERFLOW */
+
 #define PROCESS_EVENT_NONE            0x80
 #define PROCESS_EVENT_INIT            0x81
 #define PROCESS_EVENT_POLL            0x82
@@ -312,6 +345,28 @@ static PT_THREAD(process_thread_##name(struct pt *process_pt,	\
 
 /** @} */
 
+#if PROCESS_ACCOUNTING
+/**
+ * Run time statistics of a process. All times are in rtimer ticks.
+ * The run time of a process does not include the time spent in other
+ * processes that it calls synchronously.
+ */
+struct process_accounting {
+  /** Total time spent running the process */
+  unsigned long runtime;
+  /** Number of times the process was called */
+  unsigned long invocations;
+  /** Longest single call of the process */
+  rtimer_clock_t max_runtime;
+  /** Total time that events for the process waited in the event queue */
+  unsigned long queue_delay;
+  /** Number of queued events delivered to the process */
+  unsigned long events;
+  /** Longest time an event for the process waited in the event queue */
+  rtimer_clock_t max_queue_delay;
+};
+#endif /* PROCESS_ACCOUNTING */
+
 struct process {
   struct process *next;
 #if PROCESS_CONF_NO_PROCESS_NAMES
@@ -323,6 +378,12 @@ struct process {
   PT_THREAD((* thread)(struct pt *, process_event_t, process_data_t));
   struct pt pt;
   unsigned char state, needspoll;
+#if PROCESS_CONF_NUMEVENTS_HIGH > 0
+  unsigned char priority;
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
+#if PROCESS_ACCOUNTING
+  struct process_accounting accounting;
+#endif /* PROCESS_ACCOUNTING */
 };
 
 /**
@@ -439,6 +500,31 @@ process_current = p
  */
 #define PROCESS_CONTEXT_END(p) process_current = tmp_current; }
 
+/**
+ * \name Process priorities
+ * @{
+ */
+#define PROCESS_PRIORITY_NORMAL 0
+#define PROCESS_PRIORITY_HIGH   1
+/** @} */
+
+/**
+ * \brief      Set the priority of a process
+ * \param p    The process
+ * \param priority PROCESS_PRIORITY_NORMAL or PROCESS_PRIORITY_HIGH
+ *
+ *             Events posted to a process with PROCESS_PRIORITY_HIGH
+ *             are put into a separate queue, which is emptied before
+ *             any event of the normal queue is delivered. Broadcast
+ *             events always use the normal queue. Without
+ *             PROCESS_CONF_NUMEVENTS_HIGH, this does nothing.
+ */
+#if PROCESS_CONF_NUMEVENTS_HIGH > 0
+#define process_set_priority(p, prio) ((p)->priority = (prio))
+#else /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
+#define process_set_priority(p, prio)
+#endif /* PROCESS_CONF_NUMEVENTS_HIGH > 0 */
+
 /**
  * \brief      Allocate a global event number.
  * \return     The allocated event number
@@ -521,6 +607,53 @@ int process_nevents(void);
 
 /** @} */
 
+#if PROCESS_ACCOUNTING
+/**
+ * \name Process accounting
+ *
+ * The statistics of all running processes can be read by iterating
+ * over the process list:
+ \code
+ struct process *p;
+ for(p = PROCESS_LIST(); p != NULL; p = p->next) {
+   const struct process_accounting *a = process_accounting_get(p);
+   printf("%s %lu\n", PROCESS_NAME_STRING(p), a->runtime);
+ }
+ \endcode
+ * @{
+ */
+
+/**
+ * \brief      Get the run time statistics of a process
+ * \param p    The process
+ * \return     The statistics, which are updated as the process runs
+ */
+const struct process_accounting *process_accounting_get(struct process *p);
+
+/**
+ * \brief      Clear the run time statistics of all running processes
+ */
+void process_accounting_reset(void);
+
+/** @} */
+#endif /* PROCESS_ACCOUNTING */
+
+#if PROCESS_CONF_STATS
+/**
+ * \name Event queue statistics
+ * @{
+ */
+/** Maximum number of events in the normal event queue */
+extern process_num_events_t process_maxevents;
+/** Maximum number of events in the high priority event queue */
+extern process_num_events_t process_maxevents_high;
+/** Maximum number of events held in the overflow pool at once */
+extern unsigned short process_maxoverflow;
+/** Number of events that could not be posted */
+extern unsigned short process_droppedevents;
+/** @} */
+#endif /* PROCESS_CONF_STATS */
+
 CCIF extern struct process *process_list;
 
 #define PROCESS_LIST() process_list
@@ -96,6 +96,16 @@ rtimer_run_next(void)
   t->func(t, t->ptr);
 }
 /*---------------------------------------------------------------------------*/
+int
+rtimer_next_expiration(rtimer_clock_t *time)
+{
+  if(next_rtimer == NULL) {
+    return 0;
+  }
+  *time = next_rtimer->time;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
 static void
 subtract_and_compare(rtimer_clock_t a, rtimer_clock_t b,
     rtimer_clock_t *delta, int *smaller_or_equal)
@@ -122,6 +122,13 @@ int rtimer_set(struct rtimer *task, rtimer_clock_t time,
  */
 void rtimer_run_next(void);
 
+/**
+ * \brief      Get the time of the next real-time task
+ * \param time Where the time of the task is stored
+ * \return     Non-zero if a task is scheduled, zero otherwise
+ */
+int rtimer_next_expiration(rtimer_clock_t *time);
+
 /**
  * \return     Time between a and b
  */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Implementation of the tickless idle module
+ */
+
+/**
+ * \addtogroup tickless
+ * @{
+ */
+
+#include "contiki.h"
+#include "sys/tickless.h"
+#include "sys/rtimer.h"
+#include "sys/energest.h"
+
+/* A difference in the upper half of the clock range means that the
+   deadline already has passed */
+#define CLOCK_HALF ((clock_time_t)~(clock_time_t)0 >> 1)
+
+/*---------------------------------------------------------------------------*/
+clock_time_t
+tickless_next_wakeup(void)
+{
+  clock_time_t left;
+#if TICKLESS_WITH_RTIMER
+  rtimer_clock_t time;
+  rtimer_clock_t now;
+  rtimer_clock_t delta;
+  clock_time_t ticks;
+#endif /* TICKLESS_WITH_RTIMER */
+
+  if(process_nevents() > 0) {
+    return 0;
+  }
+
+  left = TICKLESS_NO_WAKEUP;
+  if(etimer_pending()) {
+    left = etimer_next_expiration_time() - clock_time();
+    if(left > CLOCK_HALF) {
+      return 0;
+    }
+  }
+
+#if TICKLESS_WITH_RTIMER
+  if(rtimer_next_expiration(&time)) {
+    now = RTIMER_NOW();
+    if(RTIMER_CLOCK_LT(time, now)) {
+      return 0;
+    }
+    /* Round down, waking up early is harmless. Less than a tick still
+       gives one: a sleep of 0 would make the idle loop spin until the
+       rtimer, whose interrupt wakes us up anyway. */
+    delta = time - now;
+    ticks = (clock_time_t)(delta / RTIMER_SECOND) * CLOCK_SECOND +
+      (clock_time_t)((unsigned long)(delta % RTIMER_SECOND) * CLOCK_SECOND /
+                     RTIMER_SECOND);
+    if(ticks == 0 && delta > 0) {
+      ticks = 1;
+    }
+    if(ticks < left) {
+      left = ticks;
+    }
+  }
+#endif /* TICKLESS_WITH_RTIMER */
+
+  return left;
+}
+/*---------------------------------------------------------------------------*/
+clock_time_t
+tickless_suppress(clock_time_t max)
+{
+  clock_time_t ticks;
+
+  ticks = tickless_next_wakeup();
+  return ticks < max ? ticks : max;
+}
+/*---------------------------------------------------------------------------*/
+void
+tickless_resume(clock_time_t slept)
+{
+  if(slept > 1) {
+    ENERGEST_AVOIDED_WAKEUPS(slept - 1);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Header file for the tickless idle module
+ */
+
+/**
+ * \addtogroup sys
+ * @{
+ */
+
+/**
+ * \defgroup tickless Tickless idle
+ * @{
+ *
+ * The tickless idle module tells the idle loop of a platform how long
+ * the system can sleep: until the next etimer expires, which includes
+ * the etimers of the ctimers, until the next rtimer task is due, or
+ * not at all if processes have events or polls pending.
+ *
+ * A platform calls tickless_suppress() from its idle loop to learn
+ * how many clock ticks it may skip, programs its timer accordingly,
+ * sleeps, and calls tickless_resume() with the number of ticks that
+ * actually passed. The ticks the system slept through without waking
+ * up are counted by energest.
+ *
+ */
+
+#ifndef TICKLESS_H_
+#define TICKLESS_H_
+
+#include "contiki-conf.h"
+#include "sys/clock.h"
+
+/* Include the next rtimer task in the wakeup time. Platforms whose
+   rtimer interrupt wakes the MCU on its own can turn this off. */
+#ifdef TICKLESS_CONF_WITH_RTIMER
+#define TICKLESS_WITH_RTIMER TICKLESS_CONF_WITH_RTIMER
+#else
+#define TICKLESS_WITH_RTIMER 1
+#endif /* TICKLESS_CONF_WITH_RTIMER */
+
+/** The wakeup time when nothing is scheduled */
+#define TICKLESS_NO_WAKEUP ((clock_time_t)~(clock_time_t)0)
+
+/**
+ * \brief      Get the time until the system has work to do
+ * \return     The number of clock ticks from now, 0 if processes
+ *             have events pending or a timer already has expired,
+ *             or TICKLESS_NO_WAKEUP if nothing is scheduled
+ */
+clock_time_t tickless_next_wakeup(void);
+
+/**
+ * \brief      Get the number of clock ticks the idle loop may sleep
+ * \param max  The longest sleep the platform supports, in clock ticks
+ * \return     The number of clock ticks to sleep, 0 if the system
+ *             must not sleep
+ */
+clock_time_t tickless_suppress(clock_time_t max);
+
+/**
+ * \brief      Account for a sleep of the idle loop
+ * \param slept The number of clock ticks that passed during the sleep
+ *
+ *             Every tick but the one that ended the sleep is counted
+ *             as an avoided wakeup.
+ */
+void tickless_resume(clock_time_t slept);
+
+#endif /* TICKLESS_H_ */
+
+/** @} */
+/** @} */
@@ -54,6 +54,9 @@
 #define PRINTF(...)
 #endif
 
+/* There are no signals in native-multi nodes, the node main loop runs
+   the rtimer when it is due */
+#if !NATIVE_MULTI
 /*---------------------------------------------------------------------------*/
 static void
 interrupt(int sig)
@@ -61,19 +64,20 @@ interrupt(int sig)
   signal(sig, interrupt);
   rtimer_run_next();
 }
+#endif /* !NATIVE_MULTI */
 /*---------------------------------------------------------------------------*/
 void
 rtimer_arch_init(void)
 {
-#ifndef _WIN32
+#if !NATIVE_MULTI && !defined(_WIN32)
   signal(SIGALRM, interrupt);
-#endif /* !_WIN32 */
+#endif /* !NATIVE_MULTI && !_WIN32 */
 }
 /*---------------------------------------------------------------------------*/
 void
 rtimer_arch_schedule(rtimer_clock_t t)
 {
-#ifndef _WIN32
+#if !NATIVE_MULTI && !defined(_WIN32)
   struct itimerval val;
   rtimer_clock_t c;
 
@@ -87,6 +91,6 @@ rtimer_arch_schedule(rtimer_clock_t t)
 
   val.it_interval.tv_sec = val.it_interval.tv_usec = 0;
   setitimer(ITIMER_REAL, &val, NULL);
-#endif /* !_WIN32 */
+#endif /* !NATIVE_MULTI && !_WIN32 */
 }
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the Internet checksum: uip_chksum() against the
+ *         16-bit reference loop it replaces, and a full recomputation
+ *         of a UDP checksum against uip_chksum_adjust() after an
+ *         address rewrite. Build with CHKSUM_WIDE=0 to measure the
+ *         16-bit loop through uip_chksum() as well.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "lib/random.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+#define ROUNDS 1000000UL
+#define MAX_LEN 1280
+
+static const uint16_t sizes[] = { 40, 127, 1280 };
+
+static uint8_t buf[MAX_LEN + 4];
+/*---------------------------------------------------------------------------*/
+PROCESS(chksum_bench_process, "checksum benchmark");
+AUTOSTART_PROCESSES(&chksum_bench_process);
+/*---------------------------------------------------------------------------*/
+/* The checksum loop of uip6.c, two bytes at a time */
+static uint16_t
+reference_chksum(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+  uint16_t t;
+  const uint8_t *dataptr;
+  const uint8_t *last_byte;
+
+  dataptr = data;
+  last_byte = data + len - 1;
+
+  while(dataptr < last_byte) {
+    t = (dataptr[0] << 8) + dataptr[1];
+    sum += t;
+    if(sum < t) {
+      sum++;
+    }
+    dataptr += 2;
+  }
+
+  if(dataptr == last_byte) {
+    t = (dataptr[0] << 8) + 0;
+    sum += t;
+    if(sum < t) {
+      sum++;
+    }
+  }
+  return sum;
+}
+/*---------------------------------------------------------------------------*/
+static void
+fill_random(uint8_t *p, uint16_t len)
+{
+  while(len-- > 0) {
+    *p++ = random_rand();
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *what, uint16_t len, clock_time_t duration)
+{
+  printf("chksum-bench: %4u bytes: %-10s %lu ns/op\n",
+         len, what,
+         (unsigned long)((unsigned long long)duration * 1000000000ULL
+                         / CLOCK_SECOND / ROUNDS));
+}
+/*---------------------------------------------------------------------------*/
+static unsigned long
+run_full(uint16_t len)
+{
+  unsigned long i;
+  unsigned long wrong;
+  volatile uint16_t sink;
+  clock_time_t start;
+  uint16_t offset;
+
+  /* Check against the reference at every alignment and for every
+     length up to len */
+  wrong = 0;
+  fill_random(buf, sizeof(buf));
+  for(offset = 0; offset < 4; offset++) {
+    for(i = 0; i <= len; i++) {
+      if(uip_chksum((uint16_t *)&buf[offset], i)
+         != uip_htons(reference_chksum(0, &buf[offset], i))) {
+        wrong++;
+      }
+    }
+  }
+
+  start = clock_time();
+  for(i = 0; i < ROUNDS; i++) {
+    sink = reference_chksum(0, &buf[i & 3], len);
+  }
+  report("reference", len, clock_time() - start);
+
+  start = clock_time();
+  for(i = 0; i < ROUNDS; i++) {
+    sink = uip_chksum((uint16_t *)&buf[i & 3], len);
+  }
+  report("uip_chksum", len, clock_time() - start);
+  (void)sink;
+
+  return wrong;
+}
+/*---------------------------------------------------------------------------*/
+/* A UDP packet as covered by its checksum: the pseudo-header, followed
+   by the UDP header and the payload */
+struct pseudo_packet {
+  uip_ipaddr_t src;
+  uip_ipaddr_t dst;
+  uint8_t len[4];
+  uint8_t proto[4];
+  uint8_t udp[8];
+  uint8_t payload[MAX_LEN];
+};
+static struct pseudo_packet packet;
+/*---------------------------------------------------------------------------*/
+static uint16_t
+packet_sum(uint16_t payload_len)
+{
+  return uip_chksum((uint16_t *)&packet,
+                    offsetof(struct pseudo_packet, payload) + payload_len);
+}
+/*---------------------------------------------------------------------------*/
+static uint16_t
+get_chksum(void)
+{
+  uint16_t c;
+
+  memcpy(&c, &packet.udp[6], sizeof(c));
+  return c;
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_chksum(uint16_t c)
+{
+  /* Checksums in network byte order, as returned by uip_chksum() */
+  memcpy(&packet.udp[6], &c, sizeof(c));
+}
+/*---------------------------------------------------------------------------*/
+static unsigned long
+run_adjust(uint16_t len)
+{
+  unsigned long i;
+  unsigned long wrong;
+  uip_ipaddr_t old;
+  clock_time_t start;
+  uint16_t udp_len;
+
+  udp_len = sizeof(packet.udp) + len;
+  memset(&packet, 0, sizeof(packet));
+  fill_random((uint8_t *)&packet.src, 2 * sizeof(uip_ipaddr_t));
+  packet.len[2] = udp_len >> 8;
+  packet.len[3] = udp_len & 0xff;
+  packet.proto[3] = UIP_PROTO_UDP;
+  fill_random(packet.udp, 6);
+  fill_random(packet.payload, len);
+  set_chksum(~packet_sum(len));
+
+  /* Rewrite the destination address, as a translator or a router
+     that changes the final destination would, and check that the
+     adjusted checksum is valid */
+  wrong = 0;
+  start = clock_time();
+  for(i = 0; i < ROUNDS; i++) {
+    uip_ipaddr_copy(&old, &packet.dst);
+    packet.dst.u16[7] = i;
+    packet.dst.u16[3] = i >> 3;
+    set_chksum(uip_chksum_adjust(get_chksum(), &old, sizeof(old),
+                                 &packet.dst, sizeof(packet.dst)));
+  }
+  report("adjust", len, clock_time() - start);
+  if(packet_sum(len) != 0xffff) {
+    wrong++;
+  }
+
+  start = clock_time();
+  for(i = 0; i < ROUNDS; i++) {
+    packet.dst.u16[7] = i;
+    packet.dst.u16[3] = i >> 3;
+    set_chksum(0);
+    set_chksum(~packet_sum(len));
+  }
+  report("recompute", len, clock_time() - start);
+  if(packet_sum(len) != 0xffff) {
+    wrong++;
+  }
+
+  return wrong;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(chksum_bench_process, ev, data)
+{
+  static uint8_t s;
+  static unsigned long wrong;
+
+  PROCESS_BEGIN();
+
+  random_init(0);
+  wrong = 0;
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    wrong += run_full(sizes[s]);
+  }
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    wrong += run_adjust(sizes[s]);
+  }
+  if(wrong > 0) {
+    printf("chksum-bench: %lu wrong checksums\n", wrong);
+  }
+  printf("chksum-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Stress benchmark for event timers: keeps 10000 etimers pending
+ *         and re-arms each one with a random interval when it fires.
+ *         Build with ETIMER_HEAP=1 to measure the heap backend instead
+ *         of the timer list.
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+#define NUM_TIMERS 10000
+#define MIN_INTERVAL (CLOCK_SECOND / 2)
+#define MAX_INTERVAL (10 * CLOCK_SECOND)
+#define DURATION (20 * CLOCK_SECOND)
+
+static struct etimer timers[NUM_TIMERS];
+static struct etimer done_timer;
+static unsigned long fired;
+static unsigned long early;
+static unsigned long total_lateness;
+static clock_time_t max_lateness;
+/*---------------------------------------------------------------------------*/
+PROCESS(etimer_bench_process, "etimer benchmark");
+AUTOSTART_PROCESSES(&etimer_bench_process);
+/*---------------------------------------------------------------------------*/
+static clock_time_t
+random_interval(void)
+{
+  return MIN_INTERVAL + random_rand() % (MAX_INTERVAL - MIN_INTERVAL);
+}
+/*---------------------------------------------------------------------------*/
+static unsigned long
+cpu_ms(clock_t c)
+{
+  return (unsigned long)((unsigned long long)c * 1000 / CLOCKS_PER_SEC);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(etimer_bench_process, ev, data)
+{
+  static clock_t cpu_start;
+  struct etimer *t;
+  clock_time_t now;
+  clock_time_t start;
+  unsigned i;
+
+  PROCESS_BEGIN();
+
+  printf("etimer-bench: ETIMER_HEAP=%u, %u timers\n", ETIMER_HEAP, NUM_TIMERS);
+  random_init(0);
+
+  start = clock_time();
+  for(i = 0; i < NUM_TIMERS; i++) {
+    etimer_set(&timers[i], random_interval());
+  }
+  printf("etimer-bench: set %u timers in %lu ms\n", NUM_TIMERS,
+         (unsigned long)((clock_time() - start) * 1000 / CLOCK_SECOND));
+
+  etimer_set(&done_timer, DURATION);
+  cpu_start = clock();
+
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER);
+    if(data == &done_timer) {
+      break;
+    }
+
+    t = data;
+    now = clock_time();
+    if(!etimer_expired(t) || !timer_expired(&t->timer)) {
+      early++;
+    } else {
+      now -= etimer_expiration_time(t);
+      total_lateness += now;
+      if(now > max_lateness) {
+        max_lateness = now;
+      }
+    }
+    fired++;
+    etimer_set(t, random_interval());
+  }
+
+  printf("etimer-bench: %lu expirations in %lu s using %lu ms CPU time\n",
+         fired, (unsigned long)(DURATION / CLOCK_SECOND),
+         cpu_ms(clock() - cpu_start));
+  printf("etimer-bench: lateness avg %lu ms max %lu ms, %lu fired early\n",
+         fired > 0 ? (unsigned long)(total_lateness * 1000 / CLOCK_SECOND / fired) : 0,
+         (unsigned long)(max_lateness * 1000 / CLOCK_SECOND), early);
+
+  start = clock_time();
+  for(i = 0; i < NUM_TIMERS; i++) {
+    etimer_stop(&timers[i]);
+  }
+  printf("etimer-bench: stopped %u timers in %lu ms\n", NUM_TIMERS,
+         (unsigned long)((clock_time() - start) * 1000 / CLOCK_SECOND));
+  printf("etimer-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
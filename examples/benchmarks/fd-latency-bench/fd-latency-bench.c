@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Latency from file descriptor readiness to process delivery
+ *         in the native main loop.
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+/*---------------------------------------------------------------------------*/
+#define SAMPLES 2000
+#define QUEUE_SIZE 16
+
+static int pipefd[2];
+static pid_t writer;
+
+/* Send times read from the pipe but not yet seen by the process */
+static struct timeval queue[QUEUE_SIZE];
+static unsigned queue_head;
+static unsigned queue_tail;
+
+static unsigned long samples;
+static unsigned long long total_us;
+static unsigned long max_us;
+/*---------------------------------------------------------------------------*/
+PROCESS(fd_latency_bench_process, "fd latency benchmark");
+PROCESS(background_process, "background timer");
+AUTOSTART_PROCESSES(&fd_latency_bench_process, &background_process);
+/*---------------------------------------------------------------------------*/
+static int
+set_fd(fd_set *rset, fd_set *wset)
+{
+  FD_SET(pipefd[0], rset);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+handle_fd(fd_set *rset, fd_set *wset)
+{
+  struct timeval tv;
+
+  if(FD_ISSET(pipefd[0], rset)) {
+    if(read(pipefd[0], &tv, sizeof(tv)) == sizeof(tv) &&
+       queue_head - queue_tail < QUEUE_SIZE) {
+      queue[queue_head++ % QUEUE_SIZE] = tv;
+      process_poll(&fd_latency_bench_process);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static const struct select_callback pipe_callback = { set_fd, handle_fd };
+/*---------------------------------------------------------------------------*/
+static void
+write_samples(void)
+{
+  struct timeval tv;
+  int i;
+
+  srand(getpid());
+  for(i = 0; i < SAMPLES; i++) {
+    usleep(1000 + rand() % 4000);
+    gettimeofday(&tv, NULL);
+    if(write(pipefd[1], &tv, sizeof(tv)) != sizeof(tv)) {
+      break;
+    }
+  }
+  exit(0);
+}
+/*---------------------------------------------------------------------------*/
+static void
+account(void)
+{
+  struct timeval now;
+  unsigned long us;
+
+  gettimeofday(&now, NULL);
+  while(queue_tail != queue_head) {
+    struct timeval *sent = &queue[queue_tail++ % QUEUE_SIZE];
+    us = (now.tv_sec - sent->tv_sec) * 1000000UL + now.tv_usec - sent->tv_usec;
+    total_us += us;
+    if(us > max_us) {
+      max_us = us;
+    }
+    samples++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(fd_latency_bench_process, ev, data)
+{
+  static clock_t cpu_start;
+
+  PROCESS_POLLHANDLER(account());
+
+  PROCESS_BEGIN();
+
+  if(pipe(pipefd) < 0) {
+    perror("fd-latency-bench: pipe");
+    PROCESS_EXIT();
+  }
+  writer = fork();
+  if(writer == 0) {
+    write_samples();
+  }
+  close(pipefd[1]);
+
+  cpu_start = clock();
+  select_set_callback(pipefd[0], &pipe_callback);
+
+  PROCESS_WAIT_UNTIL(samples >= SAMPLES);
+
+  select_set_callback(pipefd[0], NULL);
+  waitpid(writer, NULL, 0);
+  printf("fd-latency-bench: %lu samples, average %lu us, max %lu us, cpu %lu ms\n",
+         samples, (unsigned long)(total_us / samples), max_us,
+         (unsigned long)((clock() - cpu_start) * 1000 / CLOCKS_PER_SEC));
+  printf("fd-latency-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(background_process, ev, data)
+{
+  static struct etimer et;
+
+  PROCESS_BEGIN();
+
+  etimer_set(&et, CLOCK_SECOND / 10);
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    etimer_reset(&et);
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of next-hop determination: the time
+ *         tcpip_ipv6_output() takes to find the neighbor for packets
+ *         to nodes behind 8 neighbors, for a few flows and for many.
+ *         Build with FLOW_CACHE=n to look the next hops up in a flow
+ *         cache of n entries first.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ip/tcpip.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/packetbuf.h"
+#include "net/mac/mac.h"
+
+#include <stdio.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+#define ROUNDS 1000000UL
+#define NEIGHBORS 8
+#define NODES 64
+#define PAYLOAD_LEN 16
+
+#define UIP_IP_BUF   ((struct uip_ip_hdr *)&uip_buf[UIP_LLH_LEN])
+#define UIP_UDP_BUF  ((struct uip_udp_hdr *)&uip_buf[UIP_LLIPH_LEN])
+
+static const uint16_t flow_counts[] = { 4, 16, 64 };
+
+static uip_ipaddr_t nodes[NODES];
+
+/* Hash of the frames, which must not depend on the cache */
+static uint32_t frame_hash;
+static uint32_t frames;
+static int hash_frames;
+/*---------------------------------------------------------------------------*/
+PROCESS(forward_bench_process, "Forwarding benchmark");
+AUTOSTART_PROCESSES(&forward_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+rdc_send(mac_callback_t sent, void *ptr)
+{
+  const linkaddr_t *receiver;
+  uint8_t *p;
+  uint16_t i;
+
+  frames++;
+  if(hash_frames) {
+    receiver = packetbuf_addr(PACKETBUF_ADDR_RECEIVER);
+    frame_hash = (frame_hash ^ receiver->u8[LINKADDR_SIZE - 1]) * 16777619UL;
+    p = packetbuf_dataptr();
+    for(i = 0; i < packetbuf_datalen(); i++) {
+      frame_hash = (frame_hash ^ p[i]) * 16777619UL;
+    }
+  }
+  mac_call_sent_callback(sent, ptr, MAC_TX_OK, 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+rdc_init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static void
+rdc_input(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static int
+rdc_on(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+rdc_off(int keep_radio_on)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static unsigned short
+rdc_channel_check_interval(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+const struct rdc_driver forward_bench_rdc_driver = {
+  "forward-bench",
+  rdc_init,
+  rdc_send,
+  NULL,
+  rdc_input,
+  rdc_on,
+  rdc_off,
+  rdc_channel_check_interval,
+};
+/*---------------------------------------------------------------------------*/
+/* Neighbor i has link-layer address 02:00:..:00:10+i. Node j has the
+   global address derived from 02:00:..:01:00+j and is reached through
+   neighbor j % 8. */
+static void
+setup(void)
+{
+  uip_lladdr_t lladdr;
+  uip_ipaddr_t nexthop;
+  uint16_t i;
+
+  memset(&lladdr, 0, sizeof(lladdr));
+  lladdr.addr[0] = 0x02;
+  for(i = 0; i < NEIGHBORS; i++) {
+    lladdr.addr[sizeof(lladdr) - 1] = 0x10 + i;
+    uip_ip6addr(&nexthop, 0xfe80, 0, 0, 0, 0, 0, 0, 0);
+    uip_ds6_set_addr_iid(&nexthop, &lladdr);
+    uip_ds6_nbr_add(&nexthop, &lladdr, 0, NBR_REACHABLE,
+                    NBR_TABLE_REASON_UNDEFINED, NULL);
+  }
+  for(i = 0; i < NODES; i++) {
+    lladdr.addr[sizeof(lladdr) - 2] = (0x100 + i) >> 8;
+    lladdr.addr[sizeof(lladdr) - 1] = 0x100 + i;
+    uip_ip6addr(&nodes[i], UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+    uip_ds6_set_addr_iid(&nodes[i], &lladdr);
+
+    lladdr.addr[sizeof(lladdr) - 2] = 0;
+    lladdr.addr[sizeof(lladdr) - 1] = 0x10 + i % NEIGHBORS;
+    uip_ip6addr(&nexthop, 0xfe80, 0, 0, 0, 0, 0, 0, 0);
+    uip_ds6_set_addr_iid(&nexthop, &lladdr);
+    uip_ds6_route_add(&nodes[i], 128, &nexthop);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+make_packet(uint16_t node, uint16_t seqno)
+{
+  memset(UIP_IP_BUF, 0, UIP_IPUDPH_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->len[1] = UIP_UDPH_LEN + PAYLOAD_LEN;
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = 63;
+  uip_ip6addr(&UIP_IP_BUF->srcipaddr, UIP_DS6_DEFAULT_PREFIX,
+              0, 0, 0, 0, 0, 0, 0xff);
+  uip_ipaddr_copy(&UIP_IP_BUF->destipaddr, &nodes[node]);
+  UIP_UDP_BUF->srcport = UIP_HTONS(5683);
+  UIP_UDP_BUF->destport = UIP_HTONS(5683);
+  UIP_UDP_BUF->udplen = UIP_HTONS(UIP_UDPH_LEN + PAYLOAD_LEN);
+  /* Any value does, the benchmark only checks the frames */
+  UIP_UDP_BUF->udpchksum = seqno;
+  memset(&uip_buf[UIP_LLIPH_LEN + UIP_UDPH_LEN], seqno, PAYLOAD_LEN);
+  uip_len = UIP_IPUDPH_LEN + PAYLOAD_LEN;
+}
+/*---------------------------------------------------------------------------*/
+static void
+run(uint16_t flows)
+{
+  unsigned long i;
+  clock_time_t start;
+  clock_time_t duration;
+#if UIP_FLOW_CACHE_SIZE
+  uint32_t hits;
+  uint32_t misses;
+#endif /* UIP_FLOW_CACHE_SIZE */
+
+  /* Hash the frames of a short run */
+  frame_hash = 2166136261UL;
+  hash_frames = 1;
+  for(i = 0; i < 4 * flows; i++) {
+    make_packet(i % flows, i);
+    tcpip_ipv6_output();
+  }
+  hash_frames = 0;
+
+#if UIP_FLOW_CACHE_SIZE
+  hits = uip_stat.ip.flowcache_hit;
+  misses = uip_stat.ip.flowcache_miss;
+#endif /* UIP_FLOW_CACHE_SIZE */
+  /* Time the packets with and without sending them */
+  frames = 0;
+  start = clock_time();
+  for(i = 0; i < ROUNDS; i++) {
+    make_packet(i % flows, i);
+    tcpip_ipv6_output();
+  }
+  duration = clock_time() - start;
+  start = clock_time();
+  for(i = 0; i < ROUNDS; i++) {
+    make_packet(i % flows, i);
+  }
+  duration -= clock_time() - start;
+  printf("forward-bench: %2u flows: %lu ns/packet, %lu of %lu sent, "
+         "frames %08lx\n", flows,
+         (unsigned long)((unsigned long long)duration * 1000000000ULL
+                         / CLOCK_SECOND / ROUNDS),
+         (unsigned long)frames, ROUNDS, (unsigned long)frame_hash);
+#if UIP_FLOW_CACHE_SIZE
+  hits = uip_stat.ip.flowcache_hit - hits;
+  misses = uip_stat.ip.flowcache_miss - misses;
+  printf("forward-bench: %2u flows: %lu%% hits\n", flows,
+         (unsigned long)(100ULL * hits / (hits + misses)));
+#endif /* UIP_FLOW_CACHE_SIZE */
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(forward_bench_process, ev, data)
+{
+  static uint8_t f;
+
+  PROCESS_BEGIN();
+
+  setup();
+  printf("forward-bench: %u routes\n", uip_ds6_route_num_routes());
+  for(f = 0; f < sizeof(flow_counts) / sizeof(flow_counts[0]); f++) {
+    run(flow_counts[f]);
+  }
+  printf("forward-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Throughput of fragmented datagrams over several hops, on
+ *         the native-multi host. Node 1 is the RPL root and
+ *         acknowledges every datagram it receives. The last SOURCES
+ *         nodes each send one large datagram at a time to the root,
+ *         the next one when the previous one is acknowledged, like a
+ *         block-wise transfer.
+ */
+
+#include "contiki.h"
+#include "sys/node-id.h"
+#include "net/ip/uip.h"
+#include "net/ip/uip-udp-packet.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/sicslowpan.h"
+#include "net/rpl/rpl.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define UDP_CLIENT_PORT 8765
+#define UDP_SERVER_PORT 5678
+
+/* The number of nodes that send, counted from the last one */
+#ifndef SOURCES
+#define SOURCES 1
+#endif
+
+/* The number of nodes, which the sources need to find themselves */
+#ifndef NODES
+#define NODES 16
+#endif
+
+/* The UDP payload of a datagram, which takes five fragments */
+#define DATAGRAM_SIZE 320
+
+/* Let RPL build the DODAG before sending */
+#define START_DELAY (60 * CLOCK_SECOND)
+#define RETRANSMIT_INTERVAL (2 * CLOCK_SECOND)
+#define REPORT_INTERVAL (60 * CLOCK_SECOND)
+
+#define UIP_IP_BUF   ((struct uip_ip_hdr *)&uip_buf[UIP_LLH_LEN])
+#define UIP_UDP_BUF  ((struct uip_udp_hdr *)&uip_buf[UIP_LLIPH_LEN])
+
+static struct uip_udp_conn *conn;
+static uip_ipaddr_t root_ipaddr;
+static uint8_t datagram[DATAGRAM_SIZE];
+static uint32_t seqno;
+static unsigned long datagrams;
+static unsigned long timeouts;
+static clock_time_t sent_at;
+static clock_time_t rtt_sum;
+
+PROCESS(frag_bench_process, "Fragment forwarding benchmark");
+AUTOSTART_PROCESSES(&frag_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+set_addresses(void)
+{
+  uip_ipaddr_t ipaddr;
+  rpl_dag_t *dag;
+
+  uip_ip6addr(&root_ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0x00ff, 0xfe00, 1);
+
+  if(node_id == 1) {
+    uip_ds6_addr_add(&root_ipaddr, 0, ADDR_MANUAL);
+    dag = rpl_set_root(RPL_DEFAULT_INSTANCE, &root_ipaddr);
+    uip_ip6addr(&ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+    rpl_set_prefix(dag, &ipaddr, 64);
+  } else {
+    uip_ip6addr(&ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+    uip_ds6_set_addr_iid(&ipaddr, &uip_lladdr);
+    uip_ds6_addr_add(&ipaddr, 0, ADDR_AUTOCONF);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+send_datagram(void)
+{
+  seqno++;
+  memcpy(datagram, &seqno, sizeof(seqno));
+  sent_at = clock_time();
+  uip_udp_packet_sendto(conn, datagram, sizeof(datagram),
+                        &root_ipaddr, UIP_HTONS(UDP_SERVER_PORT));
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(clock_time_t interval)
+{
+  if(node_id == 1) {
+    printf("received %lu datagrams, %lu bytes/s\n", datagrams,
+           (unsigned long)(datagrams * DATAGRAM_SIZE * CLOCK_SECOND / interval));
+  } else if(node_id > NODES - SOURCES) {
+    printf("acknowledged %lu datagrams, %lu timeouts, mean rtt %lu ms\n",
+           datagrams, timeouts, datagrams > 0 ?
+           (unsigned long)(rtt_sum * 1000 / CLOCK_SECOND / datagrams) : 0);
+  }
+#if SICSLOWPAN_FRAG_FORWARDING
+  if(sicslowpan_frag_fwd_stats.fragments > 0 ||
+     sicslowpan_frag_fwd_stats.no_entry > 0 ||
+     sicslowpan_frag_fwd_stats.no_route > 0) {
+    printf("relayed %lu datagrams in %lu fragments, no entry %lu, "
+           "reassembled %lu, no route %lu, dropped %lu, expired %lu\n",
+           (unsigned long)sicslowpan_frag_fwd_stats.datagrams,
+           (unsigned long)sicslowpan_frag_fwd_stats.fragments,
+           (unsigned long)sicslowpan_frag_fwd_stats.no_entry,
+           (unsigned long)sicslowpan_frag_fwd_stats.reassembled,
+           (unsigned long)sicslowpan_frag_fwd_stats.no_route,
+           (unsigned long)sicslowpan_frag_fwd_stats.dropped,
+           (unsigned long)sicslowpan_frag_fwd_stats.expired);
+  }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+  datagrams = 0;
+  timeouts = 0;
+  rtt_sum = 0;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(frag_bench_process, ev, data)
+{
+  static struct etimer periodic;
+  static struct etimer retransmit;
+  uint32_t acked;
+
+  PROCESS_BEGIN();
+
+  PROCESS_PAUSE();
+
+  set_addresses();
+
+  if(node_id == 1) {
+    conn = udp_new(NULL, UIP_HTONS(UDP_CLIENT_PORT), NULL);
+    udp_bind(conn, UIP_HTONS(UDP_SERVER_PORT));
+  } else {
+    conn = udp_new(NULL, UIP_HTONS(UDP_SERVER_PORT), NULL);
+    udp_bind(conn, UIP_HTONS(UDP_CLIENT_PORT));
+  }
+  if(conn == NULL) {
+    printf("No UDP connection available\n");
+    PROCESS_EXIT();
+  }
+
+  etimer_set(&periodic, START_DELAY + REPORT_INTERVAL);
+  if(node_id > NODES - SOURCES) {
+    etimer_set(&retransmit, START_DELAY);
+  }
+
+  while(1) {
+    PROCESS_YIELD();
+    if(ev == tcpip_event && uip_newdata()) {
+      if(node_id == 1) {
+        /* Acknowledge with the sequence number */
+        datagrams++;
+        uip_udp_packet_sendto(conn, uip_appdata, sizeof(uint32_t),
+                              &UIP_IP_BUF->srcipaddr, UIP_UDP_BUF->srcport);
+      } else if(uip_datalen() == sizeof(acked)) {
+        memcpy(&acked, uip_appdata, sizeof(acked));
+        if(acked == seqno) {
+          datagrams++;
+          rtt_sum += clock_time() - sent_at;
+          send_datagram();
+          etimer_restart(&retransmit);
+        }
+      }
+    } else if(ev == PROCESS_EVENT_TIMER && data == &retransmit) {
+      if(seqno > 0) {
+        timeouts++;
+      }
+      send_datagram();
+      etimer_set(&retransmit, RETRANSMIT_INTERVAL);
+    } else if(ev == PROCESS_EVENT_TIMER && data == &periodic) {
+      report(REPORT_INTERVAL);
+      etimer_set(&periodic, REPORT_INTERVAL);
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of IPHC header compression: the time sicslowpan
+ *         takes to turn a UDP packet in uip_buf into a frame, for a
+ *         few flows and for many. Build with IPHC_CACHE=n to compress
+ *         through a cache of n header templates.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ip/tcpip.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/sicslowpan.h"
+#include "net/packetbuf.h"
+#include "net/mac/mac.h"
+
+#include <stdio.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+#define ROUNDS 1000000UL
+#define PAYLOAD_LEN 32
+
+#define UIP_IP_BUF   ((struct uip_ip_hdr *)&uip_buf[UIP_LLH_LEN])
+#define UIP_UDP_BUF  ((struct uip_udp_hdr *)&uip_buf[UIP_LLIPH_LEN])
+
+static const uint16_t flow_counts[] = { 4, 64 };
+
+/* Hash of the frames, which must not depend on the cache */
+static uint32_t frame_hash;
+static int hash_frames;
+/*---------------------------------------------------------------------------*/
+PROCESS(iphc_bench_process, "IPHC benchmark");
+AUTOSTART_PROCESSES(&iphc_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+rdc_send(mac_callback_t sent, void *ptr)
+{
+  uint8_t *p;
+  uint16_t i;
+
+  if(hash_frames) {
+    p = packetbuf_dataptr();
+    for(i = 0; i < packetbuf_datalen(); i++) {
+      frame_hash = (frame_hash ^ p[i]) * 16777619UL;
+    }
+  }
+  mac_call_sent_callback(sent, ptr, MAC_TX_OK, 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+rdc_init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static void
+rdc_input(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static int
+rdc_on(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+rdc_off(int keep_radio_on)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static unsigned short
+rdc_channel_check_interval(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+const struct rdc_driver iphc_bench_rdc_driver = {
+  "iphc-bench",
+  rdc_init,
+  rdc_send,
+  NULL,
+  rdc_input,
+  rdc_on,
+  rdc_off,
+  rdc_channel_check_interval,
+};
+/*---------------------------------------------------------------------------*/
+/* Flow i goes to node i + 2. The first four nodes are neighbours, so
+   the destination IID is elided; the others are reached through them.
+   Every other flow uses ports that compress to four bits. */
+static void
+make_packet(uint16_t flow, uint16_t seqno, uip_lladdr_t *next_hop)
+{
+  uip_lladdr_t dest;
+
+  memset(&dest, 0, sizeof(dest));
+  dest.addr[0] = 0x02;
+  dest.addr[sizeof(dest) - 2] = (flow + 2) >> 8;
+  dest.addr[sizeof(dest) - 1] = flow + 2;
+  *next_hop = dest;
+  next_hop->addr[sizeof(dest) - 2] = 0;
+  next_hop->addr[sizeof(dest) - 1] = flow % 4 + 2;
+
+  memset(UIP_IP_BUF, 0, UIP_IPUDPH_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->len[1] = UIP_UDPH_LEN + PAYLOAD_LEN;
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = 64;
+  uip_ip6addr(&UIP_IP_BUF->srcipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&UIP_IP_BUF->srcipaddr, &uip_lladdr);
+  uip_ip6addr(&UIP_IP_BUF->destipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&UIP_IP_BUF->destipaddr, &dest);
+  if(flow & 1) {
+    UIP_UDP_BUF->srcport = UIP_HTONS(SICSLOWPAN_UDP_4_BIT_PORT_MIN + 1);
+    UIP_UDP_BUF->destport = UIP_HTONS(SICSLOWPAN_UDP_4_BIT_PORT_MIN + 2);
+  } else {
+    UIP_UDP_BUF->srcport = UIP_HTONS(5683);
+    UIP_UDP_BUF->destport = UIP_HTONS(5683 + flow);
+  }
+  UIP_UDP_BUF->udplen = UIP_HTONS(UIP_UDPH_LEN + PAYLOAD_LEN);
+  /* Any value does, the benchmark only checks the frames */
+  UIP_UDP_BUF->udpchksum = seqno;
+  memset(&uip_buf[UIP_LLIPH_LEN + UIP_UDPH_LEN], seqno, PAYLOAD_LEN);
+  uip_len = UIP_IPUDPH_LEN + PAYLOAD_LEN;
+}
+/*---------------------------------------------------------------------------*/
+static void
+run(uint16_t flows)
+{
+  unsigned long i;
+  clock_time_t start;
+  clock_time_t duration;
+  uip_lladdr_t next_hop;
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  uint32_t hits;
+  uint32_t misses;
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+
+  /* Hash the frames of a short run */
+  frame_hash = 2166136261UL;
+  hash_frames = 1;
+  for(i = 0; i < 4 * flows; i++) {
+    make_packet(i % flows, i, &next_hop);
+    tcpip_output(&next_hop);
+  }
+  hash_frames = 0;
+
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  hits = sicslowpan_iphc_cache_stats.hits;
+  misses = sicslowpan_iphc_cache_stats.misses;
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+  /* Time the packets with and without sending them */
+  start = clock_time();
+  for(i = 0; i < ROUNDS; i++) {
+    make_packet(i % flows, i, &next_hop);
+    tcpip_output(&next_hop);
+  }
+  duration = clock_time() - start;
+  start = clock_time();
+  for(i = 0; i < ROUNDS; i++) {
+    make_packet(i % flows, i, &next_hop);
+  }
+  duration -= clock_time() - start;
+  printf("iphc-bench: %2u flows: %lu ns/packet, frames %08lx\n", flows,
+         (unsigned long)((unsigned long long)duration * 1000000000ULL
+                         / CLOCK_SECOND / ROUNDS),
+         (unsigned long)frame_hash);
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  hits = sicslowpan_iphc_cache_stats.hits - hits;
+  misses = sicslowpan_iphc_cache_stats.misses - misses;
+  printf("iphc-bench: %2u flows: %lu%% hits\n", flows,
+         (unsigned long)(100ULL * hits / (hits + misses)));
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(iphc_bench_process, ev, data)
+{
+  static uint8_t f;
+
+  PROCESS_BEGIN();
+
+  for(f = 0; f < sizeof(flow_counts) / sizeof(flow_counts[0]); f++) {
+    run(flow_counts[f]);
+  }
+  printf("iphc-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
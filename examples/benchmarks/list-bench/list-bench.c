@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Microbenchmark comparing list_remove()/list_add() with
+ *         dlist_remove()/dlist_add() at different list lengths.
+ */
+
+#include "contiki.h"
+#include "lib/list.h"
+#include "lib/dlist.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+/*---------------------------------------------------------------------------*/
+#define OPERATIONS 50000UL
+#define MAX_ELEMENTS 4096
+
+struct element {
+  struct element *next;
+  struct element *prev;
+  uint32_t data[4];
+};
+
+static struct element elements[MAX_ELEMENTS];
+
+LIST(slist);
+DLIST(dlist);
+/*---------------------------------------------------------------------------*/
+PROCESS(list_bench_process, "list benchmark");
+AUTOSTART_PROCESSES(&list_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *name, unsigned n, clock_time_t duration)
+{
+  printf("list-bench: %-5s %4u elements: %lu remove/add pairs in %lu ms (%lu ns/pair)\n",
+         name, n, OPERATIONS,
+         (unsigned long)(duration * 1000 / CLOCK_SECOND),
+         (unsigned long)((unsigned long long)duration * 1000000000ULL
+                         / CLOCK_SECOND / OPERATIONS));
+}
+/*---------------------------------------------------------------------------*/
+static void
+run(unsigned n)
+{
+  unsigned long op;
+  unsigned i;
+  clock_time_t start;
+
+  list_init(slist);
+  for(i = 0; i < n; i++) {
+    list_add(slist, &elements[i]);
+  }
+  random_init(0);
+  start = clock_time();
+  for(op = 0; op < OPERATIONS; op++) {
+    i = random_rand() % n;
+    list_remove(slist, &elements[i]);
+    list_add(slist, &elements[i]);
+  }
+  report("list", n, clock_time() - start);
+
+  dlist_init(dlist);
+  for(i = 0; i < n; i++) {
+    dlist_add(dlist, &elements[i]);
+  }
+  random_init(0);
+  start = clock_time();
+  for(op = 0; op < OPERATIONS; op++) {
+    i = random_rand() % n;
+    dlist_remove(dlist, &elements[i]);
+    dlist_add(dlist, &elements[i]);
+  }
+  report("dlist", n, clock_time() - start);
+
+  if(dlist_length(dlist) != n) {
+    printf("list-bench: dlist has %d elements, expected %u\n",
+           dlist_length(dlist), n);
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(list_bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  run(16);
+  run(256);
+  run(4096);
+  printf("list-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Transmissions per delivered multicast datagram, on the
+ *         native-multi host. Node 1 is the RPL root and the seed. It
+ *         sends a series of datagrams to a group that all other nodes
+ *         have joined. At the end, every node prints what it received
+ *         and how many frames its multicast engine sent.
+ */
+
+#include "contiki.h"
+#include "sys/node-id.h"
+#include "net/ip/uip.h"
+#include "net/ip/uip-udp-packet.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/multicast/uip-mcast6.h"
+#include "net/rpl/rpl.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define MCAST_PORT 3001
+
+#define MESSAGES 100
+#define MESSAGE_LEN 32
+
+/* Let RPL build the DODAG, and SMRF learn the group, before sending */
+#define START_DELAY (60 * CLOCK_SECOND)
+#define SEND_INTERVAL (2 * CLOCK_SECOND)
+/* Time for retransmissions after the last message */
+#define DRAIN_TIME (60 * CLOCK_SECOND)
+
+static struct uip_udp_conn *conn;
+static uint8_t seen[(MESSAGES + 7) / 8];
+static unsigned received;
+static unsigned duplicates;
+static unsigned sent;
+
+PROCESS(mcast_bench_process, "Multicast benchmark");
+AUTOSTART_PROCESSES(&mcast_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+set_addresses(void)
+{
+  uip_ipaddr_t ipaddr;
+  rpl_dag_t *dag;
+
+  uip_ip6addr(&ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&ipaddr, &uip_lladdr);
+  uip_ds6_addr_add(&ipaddr, 0, ADDR_AUTOCONF);
+  if(node_id == 1) {
+    dag = rpl_set_root(RPL_DEFAULT_INSTANCE, &ipaddr);
+    uip_ip6addr(&ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+    rpl_set_prefix(dag, &ipaddr, 64);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+input(void)
+{
+  uint16_t seq;
+
+  if(!uip_newdata() || uip_datalen() != MESSAGE_LEN) {
+    return;
+  }
+  memcpy(&seq, uip_appdata, sizeof(seq));
+  seq = uip_ntohs(seq);
+  if(seq >= MESSAGES) {
+    return;
+  }
+  if(seen[seq / 8] & (1 << (seq % 8))) {
+    duplicates++;
+  } else {
+    seen[seq / 8] |= 1 << (seq % 8);
+    received++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+send(void)
+{
+  static uint8_t buf[MESSAGE_LEN];
+  uint16_t seq;
+
+  seq = uip_htons(sent);
+  memcpy(buf, &seq, sizeof(seq));
+  uip_udp_packet_send(conn, buf, sizeof(buf));
+  sent++;
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(void)
+{
+  unsigned control;
+
+  /* Control messages: MPL and ROLL TM count them, SMRF has none */
+#if UIP_MCAST6_ENGINE == UIP_MCAST6_ENGINE_MPL
+  control = ((struct mpl_stats *)uip_mcast6_stats.engine_stats)->icmp_out;
+#elif UIP_MCAST6_ENGINE == UIP_MCAST6_ENGINE_ROLL_TM
+  control = ((struct roll_tm_stats *)uip_mcast6_stats.engine_stats)->icmp_out;
+#else
+  control = 0;
+#endif
+
+  printf("mcast-bench: %s sent %u received %u duplicates %u "
+         "data %u control %u\n", UIP_MCAST6.name, sent, received,
+         duplicates, sent + UIP_MCAST6_STATS_GET(mcast_fwd), control);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(mcast_bench_process, ev, data)
+{
+  static struct etimer periodic;
+  static struct etimer done;
+  uip_ipaddr_t group;
+
+  PROCESS_BEGIN();
+
+  PROCESS_PAUSE();
+
+  set_addresses();
+
+  uip_ip6addr(&group, 0xff1e, 0, 0, 0, 0, 0, 0x89, 0xabcd);
+  if(node_id == 1) {
+    conn = udp_new(&group, UIP_HTONS(MCAST_PORT), NULL);
+    etimer_set(&periodic, START_DELAY);
+  } else {
+    uip_ds6_maddr_add(&group);
+    conn = udp_new(NULL, UIP_HTONS(0), NULL);
+    udp_bind(conn, UIP_HTONS(MCAST_PORT));
+  }
+  etimer_set(&done, START_DELAY + MESSAGES * SEND_INTERVAL + DRAIN_TIME);
+
+  while(1) {
+    PROCESS_YIELD();
+    if(ev == tcpip_event) {
+      input();
+    } else if(ev == PROCESS_EVENT_TIMER && data == &periodic) {
+      send();
+      if(sent < MESSAGES) {
+        etimer_set(&periodic, SEND_INTERVAL);
+      }
+    } else if(ev == PROCESS_EVENT_TIMER && data == &done) {
+      report();
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Microbenchmark for memb_alloc() and memb_free() at different
+ *         pool sizes. Build with MEMB_FREELIST=1 to measure the free
+ *         list mode instead of the default linear search.
+ */
+
+#include "contiki.h"
+#include "lib/memb.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+/*---------------------------------------------------------------------------*/
+#define OPERATIONS 1000000UL
+
+struct block {
+  uint32_t data[4];
+};
+
+MEMB(pool16, struct block, 16);
+MEMB(pool256, struct block, 256);
+MEMB(pool4096, struct block, 4096);
+
+static struct block *allocated[4096];
+/*---------------------------------------------------------------------------*/
+PROCESS(memb_bench_process, "memb benchmark");
+AUTOSTART_PROCESSES(&memb_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+run(struct memb *m)
+{
+  unsigned long op;
+  unsigned short i;
+  clock_time_t start;
+  clock_time_t duration;
+
+  memb_init(m);
+  random_init(0);
+
+  /* Fill the pool so that the linear search has to work hardest */
+  for(i = 0; i < m->num; i++) {
+    allocated[i] = memb_alloc(m);
+  }
+
+  /* Churn: free a random block and immediately allocate a new one */
+  start = clock_time();
+  for(op = 0; op < OPERATIONS; op++) {
+    i = random_rand() % m->num;
+    memb_free(m, allocated[i]);
+    allocated[i] = memb_alloc(m);
+    if(allocated[i] == NULL) {
+      printf("memb-bench: allocation failed\n");
+      return;
+    }
+  }
+  duration = clock_time() - start;
+
+  printf("memb-bench: %5u blocks: %lu free/alloc pairs in %lu ms (%lu ns/pair)\n",
+         m->num, OPERATIONS,
+         (unsigned long)(duration * 1000 / CLOCK_SECOND),
+         (unsigned long)((unsigned long long)duration * 1000000000ULL
+                         / CLOCK_SECOND / OPERATIONS));
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(memb_bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("memb-bench: MEMB_FREELIST=%u\n", MEMB_FREELIST);
+  run(&pool16);
+  run(&pool256);
+  run(&pool4096);
+  printf("memb-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
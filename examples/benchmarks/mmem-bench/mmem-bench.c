@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark for the managed memory allocator. Build with
+ *         MMEM_INCREMENTAL=1 to measure incremental compaction instead
+ *         of compaction on every mmem_free().
+ */
+
+#include "contiki.h"
+#include "lib/mmem.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+#define OPERATIONS 200000UL
+#define BLOCKS 256
+#define MIN_SIZE 16
+#define MAX_SIZE 128
+#define YIELD_INTERVAL 16
+
+static struct mmem blocks[BLOCKS];
+static struct mmem_stats stats;
+static unsigned long op;
+static unsigned long failed;
+static unsigned long corrupted;
+static unsigned long moved_start;
+static unsigned long max_stall;
+static clock_time_t start;
+/*---------------------------------------------------------------------------*/
+PROCESS(mmem_bench_process, "mmem benchmark");
+AUTOSTART_PROCESSES(&mmem_bench_process);
+/*---------------------------------------------------------------------------*/
+static unsigned int
+random_size(void)
+{
+  return MIN_SIZE + random_rand() % (MAX_SIZE - MIN_SIZE + 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+alloc(int i)
+{
+  if(!mmem_alloc(&blocks[i], random_size())) {
+    failed++;
+    mmem_alloc(&blocks[i], MIN_SIZE);
+  }
+  /* Tag the block so that moves can be verified on free */
+  memset(MMEM_PTR(&blocks[i]), i, blocks[i].size);
+}
+/*---------------------------------------------------------------------------*/
+static void
+release(int i)
+{
+  unsigned char *p = (unsigned char *)MMEM_PTR(&blocks[i]);
+
+  if(p[0] != (unsigned char)i || p[blocks[i].size - 1] != (unsigned char)i) {
+    corrupted++;
+  }
+  mmem_free(&blocks[i]);
+}
+/*---------------------------------------------------------------------------*/
+static unsigned long
+moved(void)
+{
+  mmem_stats(&stats);
+  return stats.bytes_moved;
+}
+/*---------------------------------------------------------------------------*/
+static void
+churn(int measure_stall)
+{
+  unsigned long before;
+  int i;
+
+  i = random_rand() % BLOCKS;
+  before = measure_stall ? moved() : 0;
+  release(i);
+  alloc(i);
+  if(measure_stall && moved() - before > max_stall) {
+    max_stall = moved() - before;
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(mmem_bench_process, ev, data)
+{
+  static int i;
+
+  PROCESS_BEGIN();
+
+  printf("mmem-bench: MMEM_INCREMENTAL=%u\n", MMEM_INCREMENTAL);
+  mmem_init();
+  random_init(0);
+  for(i = 0; i < BLOCKS; i++) {
+    alloc(i);
+  }
+
+  /* Timing run */
+  moved_start = moved();
+  start = clock_time();
+  for(op = 0; op < OPERATIONS; op++) {
+    churn(0);
+    if(op % YIELD_INTERVAL == 0) {
+      PROCESS_PAUSE();
+    }
+  }
+  printf("mmem-bench: %lu operations in %lu ms (%lu ns/op), %lu bytes moved/op\n",
+         OPERATIONS,
+         (unsigned long)((clock_time() - start) * 1000 / CLOCK_SECOND),
+         (unsigned long)((unsigned long long)(clock_time() - start)
+                         * 1000000000ULL / CLOCK_SECOND / OPERATIONS),
+         (moved() - moved_start) / OPERATIONS);
+
+  /* Stall run: the most bytes moved within a single free/alloc pair */
+  for(op = 0; op < OPERATIONS / 10; op++) {
+    churn(1);
+    if(op % YIELD_INTERVAL == 0) {
+      PROCESS_PAUSE();
+    }
+  }
+
+  mmem_stats(&stats);
+  printf("mmem-bench: max %lu bytes moved in one free/alloc pair, %lu failed allocations, %lu corrupted blocks\n",
+         max_stall, failed, corrupted);
+  printf("mmem-bench: free %u largest free %u holes %u fragmentation %u%%\n",
+         stats.free, stats.largest_free, stats.holes, stats.fragmentation);
+  printf("mmem-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
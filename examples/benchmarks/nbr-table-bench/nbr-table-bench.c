@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of nbr_table_get_from_lladdr() as the neighbor table
+ *         fills up. Build with NBR_TABLE_HASH=1 to measure the hashed
+ *         link-layer address index instead of the list walk.
+ */
+
+#include "contiki.h"
+#include "net/nbr-table.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+#define LOOKUPS 200000UL
+
+struct bench_nbr {
+  uint8_t value;
+};
+
+NBR_TABLE(struct bench_nbr, bench_nbrs);
+
+static const uint16_t sizes[] = { 16, 64, 256, 1024 };
+/*---------------------------------------------------------------------------*/
+PROCESS(nbr_table_bench_process, "nbr-table benchmark");
+AUTOSTART_PROCESSES(&nbr_table_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+make_lladdr(linkaddr_t *lladdr, uint16_t id)
+{
+  memset(lladdr, 0, sizeof(linkaddr_t));
+  lladdr->u8[0] = 0x02;
+  lladdr->u8[LINKADDR_SIZE - 2] = id >> 8;
+  lladdr->u8[LINKADDR_SIZE - 1] = id & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(nbr_table_bench_process, ev, data)
+{
+  static uint16_t added;
+  static uint8_t s;
+  unsigned long i;
+  unsigned long found;
+  linkaddr_t lladdr;
+  clock_time_t start;
+  clock_time_t duration;
+
+  PROCESS_BEGIN();
+
+  printf("nbr-table-bench: NBR_TABLE_WITH_HASH=%u\n", NBR_TABLE_WITH_HASH);
+  nbr_table_register(bench_nbrs, NULL);
+  random_init(0);
+
+  added = 0;
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    /* Grow the table to the next size. The stack registers its own
+       tables too, so keep clear of the ids they might have used. */
+    for(; added < sizes[s]; added++) {
+      make_lladdr(&lladdr, 0x8000 + added);
+      if(nbr_table_add_lladdr(bench_nbrs, &lladdr,
+                              NBR_TABLE_REASON_UNDEFINED, NULL) == NULL) {
+        printf("nbr-table-bench: table full at %u\n", added);
+        PROCESS_EXIT();
+      }
+    }
+
+    found = 0;
+    start = clock_time();
+    for(i = 0; i < LOOKUPS; i++) {
+      make_lladdr(&lladdr, 0x8000 + random_rand() % added);
+      if(nbr_table_get_from_lladdr(bench_nbrs, &lladdr) != NULL) {
+        found++;
+      }
+    }
+    duration = clock_time() - start;
+
+    printf("nbr-table-bench: %4u neighbors: %lu/%lu lookups hit in %lu ms (%lu ns/lookup)\n",
+           added, found, LOOKUPS,
+           (unsigned long)(duration * 1000 / CLOCK_SECOND),
+           (unsigned long)((unsigned long long)duration * 1000000000ULL
+                           / CLOCK_SECOND / LOOKUPS));
+  }
+  printf("nbr-table-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the packet queue of neighbors in address
+ *         resolution: a burst of packets goes to each of a few
+ *         neighbors, one after the other, before their NA arrives, and the benchmark counts
+ *         the packets that reach them and their order. Build with
+ *         QUEUE=n to queue n packets per neighbor and POOL=n to share
+ *         n buffers between all neighbors.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ip/tcpip.h"
+#include "net/ip/uip-packetqueue.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-nd6.h"
+#include "net/ipv6/uip-icmp6.h"
+#include "net/packetbuf.h"
+#include "net/mac/mac.h"
+
+#include <stdio.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+#define NEIGHBORS 2
+#define BURST 8
+#define PAYLOAD_LEN 16
+
+#define UIP_IP_BUF     ((struct uip_ip_hdr *)&uip_buf[UIP_LLH_LEN])
+#define UIP_UDP_BUF    ((struct uip_udp_hdr *)&uip_buf[UIP_LLIPH_LEN])
+#define UIP_ICMP_BUF   ((struct uip_icmp_hdr *)&uip_buf[UIP_LLIPH_LEN])
+#define UIP_ND6_NA_BUF ((uip_nd6_na *)&uip_buf[UIP_LLIPH_LEN + UIP_ICMPH_LEN])
+#define UIP_ND6_OPT_BUF (&uip_buf[UIP_LLIPH_LEN + UIP_ICMPH_LEN + UIP_ND6_NA_LEN])
+
+struct neighbor {
+  uip_lladdr_t lladdr;
+  uip_ipaddr_t ipaddr;
+  uint8_t received;
+  uint8_t last_seqno;
+  uint8_t reordered;
+};
+
+static struct neighbor neighbors[NEIGHBORS];
+/*---------------------------------------------------------------------------*/
+PROCESS(nd_queue_bench_process, "ND queue benchmark");
+AUTOSTART_PROCESSES(&nd_queue_bench_process);
+/*---------------------------------------------------------------------------*/
+/* Frames to a neighbor end in a UDP payload filled with the seqno */
+static void
+rdc_send(mac_callback_t sent, void *ptr)
+{
+  const linkaddr_t *receiver;
+  uint8_t seqno;
+  int i;
+
+  receiver = packetbuf_addr(PACKETBUF_ADDR_RECEIVER);
+  for(i = 0; i < NEIGHBORS; i++) {
+    if(linkaddr_cmp(receiver, (linkaddr_t *)&neighbors[i].lladdr)) {
+      seqno = ((uint8_t *)packetbuf_dataptr())[packetbuf_datalen() - 1];
+      if(neighbors[i].received > 0 && seqno <= neighbors[i].last_seqno) {
+        neighbors[i].reordered++;
+      }
+      neighbors[i].last_seqno = seqno;
+      neighbors[i].received++;
+    }
+  }
+  mac_call_sent_callback(sent, ptr, MAC_TX_OK, 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+rdc_init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static void
+rdc_input(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static int
+rdc_on(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+rdc_off(int keep_radio_on)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static unsigned short
+rdc_channel_check_interval(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+const struct rdc_driver nd_queue_bench_rdc_driver = {
+  "nd-queue-bench",
+  rdc_init,
+  rdc_send,
+  NULL,
+  rdc_input,
+  rdc_on,
+  rdc_off,
+  rdc_channel_check_interval,
+};
+/*---------------------------------------------------------------------------*/
+static void
+make_packet(struct neighbor *n, uint8_t seqno)
+{
+  memset(UIP_IP_BUF, 0, UIP_IPUDPH_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->len[1] = UIP_UDPH_LEN + PAYLOAD_LEN;
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = 64;
+  uip_ds6_select_src(&UIP_IP_BUF->srcipaddr, &n->ipaddr);
+  uip_ipaddr_copy(&UIP_IP_BUF->destipaddr, &n->ipaddr);
+  UIP_UDP_BUF->srcport = UIP_HTONS(5683);
+  UIP_UDP_BUF->destport = UIP_HTONS(5683);
+  UIP_UDP_BUF->udplen = UIP_HTONS(UIP_UDPH_LEN + PAYLOAD_LEN);
+  memset(&uip_buf[UIP_LLIPH_LEN + UIP_UDPH_LEN], seqno, PAYLOAD_LEN);
+  uip_len = UIP_IPUDPH_LEN + PAYLOAD_LEN;
+}
+/*---------------------------------------------------------------------------*/
+/* The solicited NA with which n answers our NS */
+static void
+make_na(struct neighbor *n)
+{
+  uint16_t len;
+
+  len = UIP_ICMPH_LEN + UIP_ND6_NA_LEN + UIP_ND6_OPT_LLAO_LEN;
+  memset(UIP_IP_BUF, 0, UIP_IPH_LEN + len);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->len[1] = len;
+  UIP_IP_BUF->proto = UIP_PROTO_ICMP6;
+  UIP_IP_BUF->ttl = UIP_ND6_HOP_LIMIT;
+  uip_ipaddr_copy(&UIP_IP_BUF->srcipaddr, &n->ipaddr);
+  uip_ds6_select_src(&UIP_IP_BUF->destipaddr, &n->ipaddr);
+  UIP_ICMP_BUF->type = ICMP6_NA;
+  UIP_ND6_NA_BUF->flagsreserved =
+    UIP_ND6_NA_FLAG_SOLICITED | UIP_ND6_NA_FLAG_OVERRIDE;
+  uip_ipaddr_copy(&UIP_ND6_NA_BUF->tgtipaddr, &n->ipaddr);
+  UIP_ND6_OPT_BUF[UIP_ND6_OPT_TYPE_OFFSET] = UIP_ND6_OPT_TLLAO;
+  UIP_ND6_OPT_BUF[UIP_ND6_OPT_LEN_OFFSET] = UIP_ND6_OPT_LLAO_LEN >> 3;
+  memcpy(&UIP_ND6_OPT_BUF[UIP_ND6_OPT_DATA_OFFSET], &n->lladdr, UIP_LLADDR_LEN);
+  uip_len = UIP_IPH_LEN + len;
+  UIP_ICMP_BUF->icmpchksum = ~uip_icmp6chksum();
+}
+/*---------------------------------------------------------------------------*/
+/* A burst to n while it is unknown, then its NA */
+static void
+run(struct neighbor *n)
+{
+  struct uip_packetqueue_stats before;
+  uint8_t seqno;
+
+  before = uip_packetqueue_stats;
+  for(seqno = 0; seqno < BURST; seqno++) {
+    make_packet(n, seqno);
+    tcpip_ipv6_output();
+  }
+  make_na(n);
+  tcpip_input();
+
+  printf("nd-queue-bench: %u of %u packets sent, %u reordered, "
+         "dropped %lu queue full, %lu no buffer\n",
+         n->received, BURST, n->reordered,
+         (unsigned long)(uip_packetqueue_stats.full - before.full),
+         (unsigned long)(uip_packetqueue_stats.no_buffer - before.no_buffer));
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(nd_queue_bench_process, ev, data)
+{
+  static int i;
+
+  PROCESS_BEGIN();
+
+  for(i = 0; i < NEIGHBORS; i++) {
+    memset(&neighbors[i].lladdr, 0, sizeof(uip_lladdr_t));
+    neighbors[i].lladdr.addr[0] = 0x02;
+    neighbors[i].lladdr.addr[sizeof(uip_lladdr_t) - 1] = i + 0x10;
+    uip_ip6addr(&neighbors[i].ipaddr, 0xfe80, 0, 0, 0, 0, 0, 0, 0);
+    uip_ds6_set_addr_iid(&neighbors[i].ipaddr, &neighbors[i].lladdr);
+  }
+
+  printf("nd-queue-bench: %u packets per neighbor, %u buffers\n",
+         UIP_PACKETQUEUE_PER_HANDLE, UIP_PACKETQUEUE_NUM);
+  for(i = 0; i < NEIGHBORS; i++) {
+    run(&neighbors[i]);
+  }
+  printf("nd-queue-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Slot-level simulation of the receiver-based Orchestra unicast
+ *         slotframe, comparing unicast_per_neighbor_rpl_storing (one cell
+ *         per receiver) with unicast_adaptive_rpl_storing (cells scaled
+ *         with the sub-DODAG size). 28 nodes send to the root of a
+ *         three-hop tree; reports throughput and latency at the root.
+ */
+
+#include "contiki.h"
+#include "net/linkaddr.h"
+#include "net/mac/tsch/tsch-queue.h"
+#include "orchestra-conf.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+/* Root, 4 nodes at depth 1 with 3 children each, each of which has one child */
+#define NUM_NODES 29
+#define ROOT 0
+/* Timeslots of 10 ms, the TSCH default. One hour per run. */
+#define SLOT_MS 10
+#define SLOTS (60UL * 60 * 1000 / SLOT_MS)
+/* One in this many frames is lost */
+#define LOSS 10
+
+#define QUEUE_LEN TSCH_QUEUE_NUM_PER_NEIGHBOR
+#define CELL_STRIDE (ORCHESTRA_UNICAST_PERIOD / ORCHESTRA_ADAPTIVE_MAX_CELLS)
+
+/* Per-node packet generation intervals, in slots */
+static const uint16_t intervals[] = { 3200, 1600, 800, 400 };
+
+struct packet {
+  uint32_t created;
+  uint32_t enqueued;
+  uint16_t timeslot;
+  uint8_t transmissions;
+};
+
+struct node {
+  uint8_t parent;
+  uint8_t depth;
+  uint8_t descendants;
+  uint8_t cells;
+  uint8_t next_cell;
+  uint8_t backoff_exponent;
+  uint8_t backoff_window;
+  uint8_t transmitting;
+  uint8_t receivers;
+  uint8_t head;
+  uint8_t len;
+  struct packet queue[QUEUE_LEN];
+};
+
+struct results {
+  unsigned long generated;
+  unsigned long delivered;
+  unsigned long queue_drops;
+  unsigned long retry_drops;
+  unsigned long latency_sum;
+  unsigned long latency_max;
+  unsigned long last_hop_sum;
+  unsigned long last_hop_count;
+};
+
+static struct node nodes[NUM_NODES];
+static struct results res;
+/*---------------------------------------------------------------------------*/
+static uint16_t
+get_node_timeslot(uint8_t id, uint8_t cell)
+{
+  /* The same hash as the rules, over a MAC address ending with the node id */
+  linkaddr_t addr;
+  linkaddr_copy(&addr, &linkaddr_null);
+  addr.u8[LINKADDR_SIZE - 1] = id + 1;
+  return (ORCHESTRA_LINKADDR_HASH(&addr) + cell * CELL_STRIDE) % ORCHESTRA_UNICAST_PERIOD;
+}
+/*---------------------------------------------------------------------------*/
+static int
+is_rx_cell(uint8_t id, uint16_t timeslot)
+{
+  uint8_t i;
+  for(i = 0; i < nodes[id].cells; i++) {
+    if(get_node_timeslot(id, i) == timeslot) {
+      return 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+init_nodes(int adaptive)
+{
+  uint8_t i;
+  uint8_t p;
+
+  memset(nodes, 0, sizeof(nodes));
+  for(i = 1; i < NUM_NODES; i++) {
+    if(i <= 4) {
+      nodes[i].parent = ROOT;
+    } else if(i <= 16) {
+      nodes[i].parent = 1 + (i - 5) / 3;
+    } else {
+      nodes[i].parent = i - 12;
+    }
+    nodes[i].depth = nodes[nodes[i].parent].depth + 1;
+    /* In storing mode, every ancestor has a route to the node */
+    for(p = nodes[i].parent; ; p = nodes[p].parent) {
+      nodes[p].descendants++;
+      if(p == ROOT) {
+        break;
+      }
+    }
+  }
+  for(i = 0; i < NUM_NODES; i++) {
+    /* As in update_cells() of unicast_adaptive_rpl_storing */
+    nodes[i].cells = adaptive ? MIN(1 + nodes[i].descendants / ORCHESTRA_ADAPTIVE_NODES_PER_CELL,
+                                    ORCHESTRA_ADAPTIVE_MAX_CELLS) : 1;
+    nodes[i].backoff_exponent = TSCH_MAC_MIN_BE;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+enqueue(uint8_t id, uint32_t created, uint32_t asn)
+{
+  struct node *n = &nodes[id];
+  struct node *parent = &nodes[n->parent];
+  struct packet *p;
+
+  if(n->len == QUEUE_LEN) {
+    res.queue_drops++;
+    return 0;
+  }
+  p = &n->queue[(n->head + n->len) % QUEUE_LEN];
+  p->created = created;
+  p->enqueued = asn;
+  p->transmissions = 0;
+  /* Round-robin over the cells of the parent, as select_packet() does */
+  p->timeslot = get_node_timeslot(n->parent, n->next_cell++ % parent->cells);
+  n->len++;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+dequeue(uint8_t id)
+{
+  nodes[id].head = (nodes[id].head + 1) % QUEUE_LEN;
+  nodes[id].len--;
+}
+/*---------------------------------------------------------------------------*/
+static void
+run(int adaptive, uint16_t interval)
+{
+  uint32_t asn;
+  uint16_t timeslot;
+  uint8_t i;
+  struct node *n;
+  struct packet *p;
+
+  init_nodes(adaptive);
+  memset(&res, 0, sizeof(res));
+  random_init(1);
+
+  for(asn = 0; asn < SLOTS; asn++) {
+    timeslot = asn % ORCHESTRA_UNICAST_PERIOD;
+
+    /* Every node but the root generates traffic to the root */
+    for(i = 1; i < NUM_NODES; i++) {
+      if(random_rand() % interval == 0) {
+        res.generated++;
+        enqueue(i, asn, asn);
+      }
+    }
+
+    /* Nodes whose head packet is for this timeslot transmit, unless in backoff
+     * (all links are shared). TSCH only considers the head of the queue. */
+    for(i = 0; i < NUM_NODES; i++) {
+      nodes[i].transmitting = 0;
+      nodes[i].receivers = 0;
+    }
+    for(i = 1; i < NUM_NODES; i++) {
+      n = &nodes[i];
+      if(n->len > 0 && n->queue[n->head].timeslot == timeslot
+         && n->backoff_window == 0) {
+        n->transmitting = 1;
+        nodes[n->parent].receivers++;
+      }
+    }
+
+    /* A transmission succeeds if it is the only one to a listening parent,
+     * and the frame or its ACK is not lost */
+    for(i = 1; i < NUM_NODES; i++) {
+      n = &nodes[i];
+      if(!n->transmitting) {
+        continue;
+      }
+      p = &n->queue[n->head];
+      p->transmissions++;
+      if(nodes[n->parent].receivers == 1 && !nodes[n->parent].transmitting
+         && is_rx_cell(n->parent, timeslot) && random_rand() % LOSS != 0) {
+        n->backoff_exponent = TSCH_MAC_MIN_BE;
+        n->backoff_window = 0;
+        if(n->parent == ROOT) {
+          res.delivered++;
+          res.latency_sum += asn - p->created;
+          res.latency_max = MAX(res.latency_max, asn - p->created);
+          res.last_hop_sum += asn - p->enqueued;
+          res.last_hop_count++;
+        } else {
+          enqueue(n->parent, p->created, asn);
+        }
+        dequeue(i);
+      } else {
+        /* Shared link: increment the backoff exponent, pick a new window */
+        n->backoff_exponent = MIN(n->backoff_exponent + 1, TSCH_MAC_MAX_BE);
+        n->backoff_window = 1 + random_rand() % (1 << n->backoff_exponent);
+        if(p->transmissions >= TSCH_MAC_MAX_FRAME_RETRIES + 1) {
+          res.retry_drops++;
+          dequeue(i);
+        }
+      }
+    }
+
+    /* Backoff windows count the shared slots to the parent */
+    for(i = 1; i < NUM_NODES; i++) {
+      n = &nodes[i];
+      if(n->backoff_window > 0 && is_rx_cell(n->parent, timeslot)) {
+        n->backoff_window--;
+      }
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+print_results(const char *rule, uint16_t interval)
+{
+  /* In tenths of packets per second */
+  unsigned long offered = (NUM_NODES - 1) * 10000UL / ((unsigned long)interval * SLOT_MS);
+  unsigned long throughput = res.delivered * 10000UL / (SLOTS * SLOT_MS);
+
+  printf("orchestra-bench: %-8s offered %lu.%lu pkt/s: delivered %3lu%%, root %lu.%lu pkt/s, "
+         "latency avg %5lu ms max %5lu ms, last hop avg %4lu ms (drops: %lu queue, %lu retries)\n",
+         rule, offered / 10, offered % 10,
+         res.generated ? res.delivered * 100 / res.generated : 0,
+         throughput / 10, throughput % 10,
+         res.delivered ? res.latency_sum / res.delivered * SLOT_MS : 0,
+         res.latency_max * SLOT_MS,
+         res.last_hop_count ? res.last_hop_sum / res.last_hop_count * SLOT_MS : 0,
+         res.queue_drops, res.retry_drops);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS(orchestra_bench_process, "Orchestra benchmark");
+AUTOSTART_PROCESSES(&orchestra_bench_process);
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(orchestra_bench_process, ev, data)
+{
+  static uint8_t s;
+
+  PROCESS_BEGIN();
+
+  init_nodes(1);
+  printf("orchestra-bench: period %u, root cells %u, depth-1 cells %u (adaptive)\n",
+         ORCHESTRA_UNICAST_PERIOD, nodes[ROOT].cells, nodes[1].cells);
+  for(s = 0; s < sizeof(intervals) / sizeof(intervals[0]); s++) {
+    run(0, intervals[s]);
+    print_results("storing", intervals[s]);
+    run(1, intervals[s]);
+    print_results("adaptive", intervals[s]);
+  }
+  printf("orchestra-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
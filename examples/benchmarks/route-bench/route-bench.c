@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of uip_ds6_route_lookup(), the routing table
+ *         lookup done for every forwarded packet, with 16, 256 and
+ *         2048 routes. Build with ROUTE_LPM=1 to measure the prefix
+ *         index instead of the walk of the route list.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-route.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+#define LOOKUPS 200000UL
+#define NEXTHOPS 4
+
+static const uint16_t sizes[] = { 16, 256, 2048 };
+
+static uip_ipaddr_t nexthops[NEXTHOPS];
+/*---------------------------------------------------------------------------*/
+PROCESS(route_bench_process, "route benchmark");
+AUTOSTART_PROCESSES(&route_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+make_destination(uip_ipaddr_t *ipaddr, uint16_t id)
+{
+  uip_ip6addr(ipaddr, 0xfd00, 0, 0, 0, 0x0212, 0x7400, id >> 8, id & 0xff);
+}
+/*---------------------------------------------------------------------------*/
+static void
+add_nexthops(void)
+{
+  uip_lladdr_t lladdr;
+  int i;
+
+  for(i = 0; i < NEXTHOPS; i++) {
+    memset(&lladdr, 0, sizeof(lladdr));
+    lladdr.addr[0] = 0x02;
+    lladdr.addr[sizeof(lladdr.addr) - 1] = i + 1;
+    uip_ip6addr(&nexthops[i], 0xfe80, 0, 0, 0, 0, 0, 0, i + 1);
+    uip_ds6_nbr_add(&nexthops[i], &lladdr, 1, NBR_REACHABLE,
+                    NBR_TABLE_REASON_UNDEFINED, NULL);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+run(uint16_t n)
+{
+  uip_ipaddr_t ipaddr;
+  uip_ds6_route_t *r;
+  unsigned long i;
+  unsigned long wrong;
+  clock_time_t start;
+  clock_time_t duration;
+
+  while((r = uip_ds6_route_head()) != NULL) {
+    uip_ds6_route_rm(r);
+  }
+  for(i = 0; i < n; i++) {
+    make_destination(&ipaddr, i);
+    if(uip_ds6_route_add(&ipaddr, 128, &nexthops[i % NEXTHOPS]) == NULL) {
+      printf("route-bench: could not add route %lu\n", i);
+      return;
+    }
+  }
+
+  random_init(0);
+  wrong = 0;
+  start = clock_time();
+  for(i = 0; i < LOOKUPS; i++) {
+    make_destination(&ipaddr, random_rand() % n);
+    r = uip_ds6_route_lookup(&ipaddr);
+    if(r == NULL || !uip_ipaddr_cmp(&r->ipaddr, &ipaddr)) {
+      wrong++;
+    }
+  }
+  duration = clock_time() - start;
+
+  printf("route-bench: %4u routes: %lu lookups in %lu ms (%lu ns/lookup)\n",
+         n, LOOKUPS, (unsigned long)(duration * 1000 / CLOCK_SECOND),
+         (unsigned long)((unsigned long long)duration * 1000000000ULL
+                         / CLOCK_SECOND / LOOKUPS));
+
+  /* Destinations without a route */
+  start = clock_time();
+  for(i = 0; i < LOOKUPS; i++) {
+    make_destination(&ipaddr, n + random_rand() % n);
+    if(uip_ds6_route_lookup(&ipaddr) != NULL) {
+      wrong++;
+    }
+  }
+  duration = clock_time() - start;
+
+  printf("route-bench: %4u routes: %lu misses in %lu ms (%lu ns/lookup)\n",
+         n, LOOKUPS, (unsigned long)(duration * 1000 / CLOCK_SECOND),
+         (unsigned long)((unsigned long long)duration * 1000000000ULL
+                         / CLOCK_SECOND / LOOKUPS));
+  if(wrong > 0) {
+    printf("route-bench: %lu wrong lookups\n", wrong);
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(route_bench_process, ev, data)
+{
+  static uint8_t s;
+
+  PROCESS_BEGIN();
+
+  add_nexthops();
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    run(sizes[s]);
+  }
+  printf("route-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
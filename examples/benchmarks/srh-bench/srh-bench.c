@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the source routing header insertion done by a
+ *         RPL non-storing root for every packet it sends down the
+ *         DODAG, with 16, 128 and 1000 nodes. Build with RPL_NS_HASH=1
+ *         to look nodes up through the hash index, and with
+ *         SRH_CACHE=<entries> to reuse the headers built before.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/rpl/rpl.h"
+#include "net/rpl/rpl-private.h"
+#include "net/rpl/rpl-ns.h"
+#include "net/rpl/rpl-dag-root.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+#define PACKETS 100000UL
+#define PAYLOAD_LEN 32
+/* Each node has up to this many children */
+#define FANOUT 4
+/* Move a node to another parent every this many packets */
+#define CHURN_INTERVAL 100
+
+#define UIP_IP_BUF ((struct uip_ip_hdr *)&uip_buf[UIP_LLH_LEN])
+
+static const uint16_t sizes[] = { 16, 128, 1000 };
+
+/* Parent of every node, 0 being the root */
+static uint16_t parents[1001];
+static rpl_dag_t *dag;
+/*---------------------------------------------------------------------------*/
+PROCESS(srh_bench_process, "SRH benchmark");
+AUTOSTART_PROCESSES(&srh_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+make_address(uip_ipaddr_t *ipaddr, uint16_t id)
+{
+  if(id == 0) {
+    uip_ipaddr_copy(ipaddr, &dag->dag_id);
+  } else {
+    uip_ip6addr(ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0,
+                0x0212, 0x7400, id >> 8, id & 0xff);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_parent(uint16_t id, uint16_t parent)
+{
+  uip_ipaddr_t child_addr;
+  uip_ipaddr_t parent_addr;
+
+  make_address(&child_addr, id);
+  make_address(&parent_addr, parent);
+  parents[id] = parent;
+  rpl_ns_update_node(dag, &child_addr, &parent_addr, RPL_LIFETIME(dag->instance, dag->instance->default_lifetime));
+}
+/*---------------------------------------------------------------------------*/
+static uint16_t
+first_hop(uint16_t id)
+{
+  while(parents[id] != 0) {
+    id = parents[id];
+  }
+  return id;
+}
+/*---------------------------------------------------------------------------*/
+static int
+send_down(uint16_t id, uint32_t *sum)
+{
+  uip_ipaddr_t expected;
+  int i;
+
+  memset(UIP_IP_BUF, 0, UIP_IPH_LEN + PAYLOAD_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->len[1] = PAYLOAD_LEN;
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = 64;
+  uip_ipaddr_copy(&UIP_IP_BUF->srcipaddr, &dag->dag_id);
+  make_address(&UIP_IP_BUF->destipaddr, id);
+  uip_len = UIP_IPH_LEN + PAYLOAD_LEN;
+  uip_ext_len = 0;
+
+  if(!rpl_update_header()) {
+    return 0;
+  }
+
+  for(i = 0; i < uip_ext_len; i++) {
+    *sum = *sum * 31 + uip_buf[UIP_LLH_LEN + UIP_IPH_LEN + i];
+  }
+  make_address(&expected, first_hop(id));
+  return uip_ipaddr_cmp(&UIP_IP_BUF->destipaddr, &expected)
+    && uip_len == UIP_IPH_LEN + PAYLOAD_LEN + uip_ext_len
+    && (UIP_IP_BUF->len[0] << 8) + UIP_IP_BUF->len[1] == PAYLOAD_LEN + uip_ext_len
+    && (parents[id] == 0 || UIP_IP_BUF->proto == UIP_PROTO_ROUTING);
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *what, uint16_t n, clock_time_t duration)
+{
+  printf("srh-bench: %4u nodes: %lu packets%s in %lu ms (%lu ns/packet)\n",
+         n, PACKETS, what, (unsigned long)(duration * 1000 / CLOCK_SECOND),
+         (unsigned long)((unsigned long long)duration * 1000000000ULL
+                         / CLOCK_SECOND / PACKETS));
+}
+/*---------------------------------------------------------------------------*/
+static void
+run(uint16_t n)
+{
+  unsigned long i;
+  unsigned long wrong;
+  uint32_t sum;
+  uint16_t id;
+  clock_time_t start;
+  clock_time_t duration;
+
+  rpl_ns_init();
+  for(id = 1; id <= n; id++) {
+    set_parent(id, (id - 1) / FANOUT);
+  }
+  if(rpl_ns_num_nodes() != n + 1) {
+    printf("srh-bench: could only add %u nodes\n", rpl_ns_num_nodes());
+    return;
+  }
+
+  random_init(0);
+  wrong = 0;
+  sum = 0;
+  start = clock_time();
+  for(i = 0; i < PACKETS; i++) {
+    if(!send_down(1 + random_rand() % n, &sum)) {
+      wrong++;
+    }
+  }
+  duration = clock_time() - start;
+  report("", n, duration);
+
+  /* Keep moving nodes between the parents of the upper levels, so that
+   * cached headers go stale */
+  start = clock_time();
+  for(i = 0; i < PACKETS; i++) {
+    if(i % CHURN_INTERVAL == 0) {
+      id = FANOUT + 1 + random_rand() % (n - FANOUT);
+      set_parent(id, random_rand() % MIN(id, FANOUT + 1));
+    }
+    if(!send_down(1 + random_rand() % n, &sum)) {
+      wrong++;
+    }
+  }
+  duration = clock_time() - start;
+  report(" with churn", n, duration);
+
+  printf("srh-bench: %4u nodes: header checksum %08lx\n", n, (unsigned long)sum);
+  if(wrong > 0) {
+    printf("srh-bench: %lu wrong headers\n", wrong);
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(srh_bench_process, ev, data)
+{
+  static uint8_t s;
+
+  PROCESS_BEGIN();
+
+  rpl_dag_root_init_dag_immediately();
+  dag = rpl_get_any_dag();
+  if(dag == NULL || !RPL_IS_NON_STORING(dag->instance)) {
+    printf("srh-bench: could not create a non-storing DAG\n");
+    PROCESS_EXIT();
+  }
+
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    run(sizes[s]);
+  }
+  printf("srh-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
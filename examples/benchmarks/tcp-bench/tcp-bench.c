@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         TCP throughput over several hops, on the native-multi host,
+ *         in the manner of netperf's TCP_STREAM test. Node 1 is the
+ *         RPL root and sinks a TCP connection from the last node,
+ *         which keeps its tcp-socket send buffer full.
+ */
+
+#include "contiki.h"
+#include "sys/node-id.h"
+#include "net/ip/uip.h"
+#include "net/ip/tcp-socket.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/rpl/rpl.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define SERVER_PORT 12865
+
+/* The number of nodes; the last one sends */
+#ifndef NODES
+#define NODES 9
+#endif
+
+#define SEND_BUFFER_SIZE 256
+
+/* Let RPL build the DODAG before connecting */
+#define START_DELAY (60 * CLOCK_SECOND)
+#define RECONNECT_INTERVAL (5 * CLOCK_SECOND)
+#define REPORT_INTERVAL (60 * CLOCK_SECOND)
+
+static struct tcp_socket socket;
+static uint8_t inputbuf[UIP_TCP_MSS];
+static uint8_t outputbuf[SEND_BUFFER_SIZE];
+static uint8_t pattern[SEND_BUFFER_SIZE];
+static uip_ipaddr_t root_ipaddr;
+static unsigned long received;
+static unsigned long connections;
+static struct etimer reconnect;
+
+PROCESS(tcp_bench_process, "TCP throughput benchmark");
+AUTOSTART_PROCESSES(&tcp_bench_process);
+/*---------------------------------------------------------------------------*/
+/* uIP answers a SYN from the source address it selects, so the root
+   has a single global address, made like those of the other nodes
+   from a link-layer address that ends in the node ID */
+static void
+set_addresses(void)
+{
+  uip_ipaddr_t ipaddr;
+  uip_lladdr_t root_lladdr;
+  rpl_dag_t *dag;
+
+  root_lladdr = uip_lladdr;
+  root_lladdr.addr[sizeof(root_lladdr) - 2] = 0;
+  root_lladdr.addr[sizeof(root_lladdr) - 1] = 1;
+  uip_ip6addr(&root_ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&root_ipaddr, &root_lladdr);
+
+  uip_ip6addr(&ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&ipaddr, &uip_lladdr);
+  uip_ds6_addr_add(&ipaddr, 0, ADDR_AUTOCONF);
+  if(node_id == 1) {
+    dag = rpl_set_root(RPL_DEFAULT_INSTANCE, &ipaddr);
+    uip_ip6addr(&ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+    rpl_set_prefix(dag, &ipaddr, 64);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+input(struct tcp_socket *s, void *ptr, const uint8_t *inputptr, int inputdatalen)
+{
+  received += inputdatalen;
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+event(struct tcp_socket *s, void *ptr, tcp_socket_event_t ev)
+{
+  if(ev == TCP_SOCKET_CONNECTED) {
+    connections++;
+  }
+  if(node_id == 1) {
+    return;
+  }
+  if(ev == TCP_SOCKET_CONNECTED || ev == TCP_SOCKET_DATA_SENT) {
+    /* Top up the send buffer */
+    tcp_socket_send(s, pattern, tcp_socket_max_sendlen(s));
+  } else {
+    /* Closed, timed out or aborted */
+    process_post(&tcp_bench_process, PROCESS_EVENT_CONTINUE, NULL);
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(tcp_bench_process, ev, data)
+{
+  static struct etimer periodic;
+
+  PROCESS_BEGIN();
+
+  PROCESS_PAUSE();
+
+  set_addresses();
+  memset(pattern, 'x', sizeof(pattern));
+
+  tcp_socket_register(&socket, NULL, inputbuf, sizeof(inputbuf),
+                      outputbuf, sizeof(outputbuf), input, event);
+  if(node_id == 1) {
+    tcp_socket_listen(&socket, SERVER_PORT);
+  } else if(node_id == NODES) {
+    etimer_set(&reconnect, START_DELAY);
+  }
+  etimer_set(&periodic, START_DELAY + REPORT_INTERVAL);
+
+  while(1) {
+    PROCESS_YIELD();
+    if(ev == PROCESS_EVENT_TIMER && data == &reconnect) {
+      tcp_socket_connect(&socket, &root_ipaddr, SERVER_PORT);
+    } else if(ev == PROCESS_EVENT_CONTINUE) {
+      etimer_set(&reconnect, RECONNECT_INTERVAL);
+    } else if(ev == PROCESS_EVENT_TIMER && data == &periodic) {
+      if(node_id == 1) {
+        printf("received %lu bytes/s, %lu connections\n",
+               (unsigned long)(received * CLOCK_SECOND / REPORT_INTERVAL),
+               connections);
+        received = 0;
+      }
+      etimer_set(&periodic, REPORT_INTERVAL);
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the TSCH neighbor queues. Measures
+ *         tsch_queue_get_nbr() with 8, 32 and 128 neighbors, and the
+ *         queueing delay of each neighbor when all of them share a
+ *         shared link that is close to saturation, as served by
+ *         tsch_queue_get_unicast_packet_for_any().
+ */
+
+#include "contiki.h"
+#include "net/packetbuf.h"
+#include "net/mac/tsch/tsch.h"
+#include "net/mac/tsch/tsch-private.h"
+#include "net/mac/tsch/tsch-queue.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+/*---------------------------------------------------------------------------*/
+#define LOOKUPS 1000000UL
+#define SLOTS 100000UL
+#define SHARED_NEIGHBORS 16
+/* One slot out of SHARED_PERIOD is shared */
+#define SHARED_PERIOD 4
+/* Packets queued per slot, out of 256: 90% of the shared link */
+#define LOAD 58
+
+static const uint16_t sizes[] = { 8, 32, 128 };
+/*---------------------------------------------------------------------------*/
+/* The parts of TSCH that the queues use. No slot operation runs here,
+ * so the queues are never locked. */
+const linkaddr_t tsch_broadcast_address = { { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } };
+const linkaddr_t tsch_eb_address = { { 0, 0, 0, 0, 0, 0, 0, 0 } };
+struct tsch_asn_t tsch_current_asn;
+int tsch_is_coordinator = 1;
+
+int
+tsch_is_locked(void)
+{
+  return 0;
+}
+
+int
+tsch_get_lock(void)
+{
+  return 1;
+}
+
+void
+tsch_release_lock(void)
+{
+}
+
+void
+tsch_set_ka_timeout(uint32_t timeout)
+{
+}
+
+void
+tsch_schedule_keepalive(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+PROCESS(tsch_queue_bench_process, "TSCH queue benchmark");
+AUTOSTART_PROCESSES(&tsch_queue_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+set_addr(linkaddr_t *addr, uint16_t i)
+{
+  linkaddr_copy(addr, &linkaddr_null);
+  addr->u8[LINKADDR_SIZE - 2] = (i + 1) >> 8;
+  addr->u8[LINKADDR_SIZE - 1] = (i + 1) & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+static void
+run_lookup(uint16_t n)
+{
+  linkaddr_t addr;
+  unsigned long i;
+  unsigned long missing;
+  clock_time_t start;
+  clock_time_t duration;
+
+  for(i = 0; i < n; i++) {
+    set_addr(&addr, i);
+    if(tsch_queue_add_nbr(&addr) == NULL) {
+      printf("tsch-queue-bench: could not add %u neighbors\n", n);
+      return;
+    }
+  }
+
+  random_init(0);
+  missing = 0;
+  start = clock_time();
+  for(i = 0; i < LOOKUPS; i++) {
+    set_addr(&addr, random_rand() % n);
+    if(tsch_queue_get_nbr(&addr) == NULL) {
+      missing++;
+    }
+  }
+  duration = clock_time() - start;
+
+  printf("tsch-queue-bench: %3u neighbors: get_nbr %lu ns/call\n",
+         n, (unsigned long)((unsigned long long)duration * 1000000000ULL
+                            / CLOCK_SECOND / LOOKUPS));
+  if(missing > 0) {
+    printf("tsch-queue-bench: %lu neighbors not found\n", missing);
+  }
+
+  tsch_queue_free_unused_neighbors();
+}
+/*---------------------------------------------------------------------------*/
+static void
+run_shared(void)
+{
+  static struct tsch_neighbor *nbrs[SHARED_NEIGHBORS];
+  struct tsch_link link;
+  struct tsch_neighbor *n;
+  struct tsch_packet *p;
+  linkaddr_t addr;
+  unsigned long i;
+  unsigned long dropped;
+  unsigned long sent;
+  int32_t avg;
+  int32_t worst_avg;
+  uint16_t worst_max;
+
+  for(i = 0; i < SHARED_NEIGHBORS; i++) {
+    set_addr(&addr, i);
+    nbrs[i] = tsch_queue_add_nbr(&addr);
+    if(nbrs[i] == NULL) {
+      printf("tsch-queue-bench: could not add %u neighbors\n", SHARED_NEIGHBORS);
+      return;
+    }
+    tsch_queue_reset_stats(nbrs[i]);
+  }
+
+  memset(&link, 0, sizeof(link));
+  link.link_options = LINK_OPTION_TX | LINK_OPTION_RX | LINK_OPTION_SHARED;
+  linkaddr_copy(&link.addr, &tsch_broadcast_address);
+
+  random_init(0);
+  dropped = 0;
+  sent = 0;
+  TSCH_ASN_INIT(tsch_current_asn, 0, 0);
+  for(i = 0; i < SLOTS; i++) {
+    /* Traffic arrives for random neighbors... */
+    if((random_rand() & 0xff) < LOAD) {
+      packetbuf_clear();
+      packetbuf_set_datalen(32);
+      if(tsch_queue_add_packet(&nbrs[random_rand() % SHARED_NEIGHBORS]->addr,
+                               NULL, NULL) == NULL) {
+        dropped++;
+      }
+    }
+    /* ...and one packet leaves in each shared slot */
+    if(i % SHARED_PERIOD == 0) {
+      n = NULL;
+      p = tsch_queue_get_unicast_packet_for_any(&n, &link);
+      if(p != NULL) {
+        tsch_queue_remove_packet_from_queue(n);
+        tsch_queue_free_packet(p);
+        sent++;
+      }
+    }
+    TSCH_ASN_INC(tsch_current_asn, 1);
+  }
+
+  worst_avg = 0;
+  worst_max = 0;
+  for(i = 0; i < SHARED_NEIGHBORS; i++) {
+    avg = tsch_queue_get_avg_delay(nbrs[i]);
+    worst_avg = MAX(worst_avg, avg);
+    worst_max = MAX(worst_max, nbrs[i]->stats.delay_max);
+  }
+  avg = tsch_queue_get_avg_delay(nbrs[0]);
+  printf("tsch-queue-bench: %u neighbors, shared link: %lu sent, %lu dropped\n",
+         SHARED_NEIGHBORS, sent, dropped);
+  printf("tsch-queue-bench: delay (slots): first neighbor avg %ld, worst neighbor avg %ld, max %u\n",
+         (long)avg, (long)worst_avg, worst_max);
+
+  tsch_queue_reset();
+  tsch_queue_free_unused_neighbors();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(tsch_queue_bench_process, ev, data)
+{
+  static uint8_t s;
+
+  PROCESS_BEGIN();
+
+  tsch_queue_init();
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    run_lookup(sizes[s]);
+  }
+  run_shared();
+  printf("tsch-queue-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
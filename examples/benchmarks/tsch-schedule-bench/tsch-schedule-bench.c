@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of tsch_schedule_get_next_active_link(), which TSCH
+ *         calls between two slots to find the next link to run, with
+ *         10, 100 and 1000 links. The walk of every link of every
+ *         slotframe, as done before the schedule index, is measured
+ *         alongside and must give the same links.
+ */
+
+#include "contiki.h"
+#include "net/mac/tsch/tsch.h"
+#include "net/mac/tsch/tsch-schedule.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+/*---------------------------------------------------------------------------*/
+#define CALLS 100000UL
+
+/* Slotframe of the EBs, shared slotframe and slotframe of the dedicated
+ * links, as set up by Orchestra */
+#define EB_LENGTH 397
+#define COMMON_LENGTH 31
+#define UNICAST_LENGTH 1031
+
+static const uint16_t sizes[] = { 10, 100, 1000 };
+/*---------------------------------------------------------------------------*/
+/* The parts of TSCH that the schedule uses. No slot operation runs
+ * here, so the schedule is never locked. */
+const linkaddr_t tsch_broadcast_address = { { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } };
+struct tsch_link *current_link = NULL;
+
+int
+tsch_is_locked(void)
+{
+  return 0;
+}
+
+int
+tsch_get_lock(void)
+{
+  return 1;
+}
+
+void
+tsch_release_lock(void)
+{
+}
+
+struct tsch_neighbor *
+tsch_queue_add_nbr(const linkaddr_t *addr)
+{
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS(tsch_schedule_bench_process, "TSCH schedule benchmark");
+AUTOSTART_PROCESSES(&tsch_schedule_bench_process);
+/*---------------------------------------------------------------------------*/
+/* The walk of all links, as tsch_schedule_get_next_active_link() did it
+ * before the schedule index */
+static struct tsch_link *
+walk_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset,
+                      struct tsch_link **backup_link)
+{
+  uint16_t time_to_curr_best = 0;
+  struct tsch_link *curr_best = NULL;
+  struct tsch_link *curr_backup = NULL;
+  struct tsch_slotframe *sf = tsch_schedule_slotframes_next(NULL);
+
+  while(sf != NULL) {
+    uint16_t timeslot = TSCH_ASN_MOD(*asn, sf->size);
+    struct tsch_link *l = list_head(sf->links_list);
+    while(l != NULL) {
+      uint16_t time_to_timeslot =
+        l->timeslot > timeslot ?
+        l->timeslot - timeslot :
+        sf->size.val + l->timeslot - timeslot;
+      if(curr_best == NULL || time_to_timeslot < time_to_curr_best) {
+        time_to_curr_best = time_to_timeslot;
+        curr_best = l;
+        curr_backup = NULL;
+      } else if(time_to_timeslot == time_to_curr_best) {
+        struct tsch_link *new_best = NULL;
+        if((curr_best->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
+          if(l->slotframe_handle < curr_best->slotframe_handle) {
+            new_best = l;
+          }
+        } else {
+          if(l->link_options & LINK_OPTION_TX) {
+            new_best = l;
+          }
+        }
+        if(curr_backup == NULL) {
+          if(new_best != l && (l->link_options & LINK_OPTION_RX)) {
+            curr_backup = l;
+          }
+          if(new_best != curr_best && (curr_best->link_options & LINK_OPTION_RX)) {
+            curr_backup = curr_best;
+          }
+        }
+        if(new_best != NULL) {
+          curr_best = new_best;
+        }
+      }
+      l = list_item_next(l);
+    }
+    sf = tsch_schedule_slotframes_next(sf);
+  }
+  *time_offset = time_to_curr_best;
+  *backup_link = curr_backup;
+  return curr_best;
+}
+/*---------------------------------------------------------------------------*/
+static int
+build_schedule(uint16_t n)
+{
+  struct tsch_slotframe *sf_eb;
+  struct tsch_slotframe *sf_common;
+  struct tsch_slotframe *sf_unicast;
+  linkaddr_t addr;
+  uint16_t i;
+
+  tsch_schedule_remove_all_slotframes();
+  sf_eb = tsch_schedule_add_slotframe(0, EB_LENGTH);
+  sf_common = tsch_schedule_add_slotframe(1, COMMON_LENGTH);
+  sf_unicast = tsch_schedule_add_slotframe(2, UNICAST_LENGTH);
+
+  if(tsch_schedule_add_link(sf_eb, LINK_OPTION_TX, LINK_TYPE_ADVERTISING_ONLY,
+                            &tsch_broadcast_address, 0, 0) == NULL
+     || tsch_schedule_add_link(sf_common, LINK_OPTION_RX | LINK_OPTION_TX | LINK_OPTION_SHARED,
+                               LINK_TYPE_ADVERTISING, &tsch_broadcast_address, 0, 1) == NULL) {
+    return 0;
+  }
+
+  /* Dedicated links, Tx to even and Rx from odd neighbors, spread over
+   * the slotframe */
+  for(i = 2; i < n; i++) {
+    linkaddr_copy(&addr, &linkaddr_null);
+    addr.u8[LINKADDR_SIZE - 2] = i >> 8;
+    addr.u8[LINKADDR_SIZE - 1] = i & 0xff;
+    if(tsch_schedule_add_link(sf_unicast,
+                              (i & 1) ? LINK_OPTION_RX : LINK_OPTION_TX,
+                              LINK_TYPE_NORMAL, &addr,
+                              (uint32_t)i * 7 % UNICAST_LENGTH, 2) == NULL) {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+run(uint16_t n)
+{
+  struct tsch_asn_t asn;
+  struct tsch_link *l;
+  struct tsch_link *backup;
+  struct tsch_link *ref;
+  struct tsch_link *ref_backup;
+  uint16_t offset;
+  uint16_t ref_offset;
+  unsigned long i;
+  unsigned long wrong;
+  clock_time_t start;
+  clock_time_t duration;
+
+  if(!build_schedule(n)) {
+    printf("tsch-schedule-bench: could not add %u links\n", n);
+    return;
+  }
+
+  /* Compare with the walk, from random ASNs */
+  random_init(0);
+  wrong = 0;
+  for(i = 0; i < CALLS / 10; i++) {
+    TSCH_ASN_INIT(asn, 0, ((uint32_t)random_rand() << 16) | random_rand());
+    l = tsch_schedule_get_next_active_link(&asn, &offset, &backup);
+    ref = walk_next_active_link(&asn, &ref_offset, &ref_backup);
+    if(l != ref || offset != ref_offset || backup != ref_backup) {
+      wrong++;
+    }
+  }
+
+  /* Follow the schedule, as the slot operation does */
+  TSCH_ASN_INIT(asn, 0, 0);
+  start = clock_time();
+  for(i = 0; i < CALLS; i++) {
+    tsch_schedule_get_next_active_link(&asn, &offset, &backup);
+    TSCH_ASN_INC(asn, offset);
+  }
+  duration = clock_time() - start;
+
+  printf("tsch-schedule-bench: %4u links: index %lu ns/call\n",
+         n, (unsigned long)((unsigned long long)duration * 1000000000ULL
+                            / CLOCK_SECOND / CALLS));
+
+  TSCH_ASN_INIT(asn, 0, 0);
+  start = clock_time();
+  for(i = 0; i < CALLS; i++) {
+    walk_next_active_link(&asn, &offset, &backup);
+    TSCH_ASN_INC(asn, offset);
+  }
+  duration = clock_time() - start;
+
+  printf("tsch-schedule-bench: %4u links: walk  %lu ns/call\n",
+         n, (unsigned long)((unsigned long long)duration * 1000000000ULL
+                            / CLOCK_SECOND / CALLS));
+  if(wrong > 0) {
+    printf("tsch-schedule-bench: %lu wrong links\n", wrong);
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(tsch_schedule_bench_process, ev, data)
+{
+  static uint8_t s;
+
+  PROCESS_BEGIN();
+
+  tsch_schedule_init();
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    run(sizes[s]);
+  }
+  printf("tsch-schedule-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
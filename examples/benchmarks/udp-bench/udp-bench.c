@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the UDP send path: the time per datagram for a
+ *         sender that builds several small datagrams per event, with
+ *         simple_udp_sendto(), with simple_udp_reserve() and
+ *         simple_udp_commit_to(), and, when built with BATCH=n, with
+ *         simple_udp_batch_reserve().
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ip/simple-udp.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/packetbuf.h"
+#include "net/mac/mac.h"
+
+#include <stdio.h>
+#include <string.h>
+/*---------------------------------------------------------------------------*/
+#define DATAGRAMS 400000UL
+#define BURST 8
+#define PORT 5683
+
+static const uint16_t payload_lens[] = { 16, 64 };
+
+enum mode {
+  MODE_COPY,
+  MODE_RESERVE,
+#if UIP_UDP_PACKET_BATCH_NUM
+  MODE_BATCH,
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
+  MODE_COUNT
+};
+
+static const char *const mode_names[] = {
+  "sendto ",
+  "reserve",
+#if UIP_UDP_PACKET_BATCH_NUM
+  "batch  ",
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
+};
+
+/* Payload bytes copied by the UDP send API itself, before sicslowpan
+   copies the payload into the frame */
+static const uint8_t mode_copies[] = {
+  1,
+  0,
+#if UIP_UDP_PACKET_BATCH_NUM
+  1,
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
+};
+
+static struct simple_udp_connection conn;
+static uip_ipaddr_t dest;
+static uint8_t appbuf[UIP_BUFSIZE];
+
+/* Hash of the frames, which must not depend on the mode */
+static uint32_t frame_hash;
+static uint32_t frames;
+static int hash_frames;
+/*---------------------------------------------------------------------------*/
+PROCESS(udp_bench_process, "UDP benchmark");
+AUTOSTART_PROCESSES(&udp_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+rdc_send(mac_callback_t sent, void *ptr)
+{
+  uint8_t *p;
+  uint16_t i;
+
+  frames++;
+  if(hash_frames) {
+    p = packetbuf_dataptr();
+    for(i = 0; i < packetbuf_datalen(); i++) {
+      frame_hash = (frame_hash ^ p[i]) * 16777619UL;
+    }
+  }
+  mac_call_sent_callback(sent, ptr, MAC_TX_OK, 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+rdc_init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static void
+rdc_input(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static int
+rdc_on(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+rdc_off(int keep_radio_on)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static unsigned short
+rdc_channel_check_interval(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+const struct rdc_driver udp_bench_rdc_driver = {
+  "udp-bench",
+  rdc_init,
+  rdc_send,
+  NULL,
+  rdc_input,
+  rdc_on,
+  rdc_off,
+  rdc_channel_check_interval,
+};
+/*---------------------------------------------------------------------------*/
+static void
+fill(uint8_t *p, uint16_t len, unsigned long seqno)
+{
+  memset(p, seqno, len);
+  p[0] = seqno >> 8;
+}
+/*---------------------------------------------------------------------------*/
+/* Builds and sends one burst of datagrams. Batched datagrams leave
+   when the caller yields. */
+static void
+send_burst(enum mode mode, uint16_t len, unsigned long seqno)
+{
+  uint8_t i;
+  uint8_t *p;
+
+  for(i = 0; i < BURST; i++, seqno++) {
+    switch(mode) {
+    case MODE_COPY:
+      fill(appbuf, len, seqno);
+      simple_udp_sendto(&conn, appbuf, len, &dest);
+      break;
+    case MODE_RESERVE:
+      p = simple_udp_reserve(&conn, len);
+      if(p != NULL) {
+        fill(p, len, seqno);
+        simple_udp_commit_to(&conn, len, &dest);
+      }
+      break;
+#if UIP_UDP_PACKET_BATCH_NUM
+    case MODE_BATCH:
+      p = simple_udp_batch_reserve(&conn, len, &dest);
+      if(p != NULL) {
+        fill(p, len, seqno);
+      }
+      break;
+#endif /* UIP_UDP_PACKET_BATCH_NUM */
+    default:
+      break;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(udp_bench_process, ev, data)
+{
+  static uint8_t l;
+  static uint8_t mode;
+  static unsigned long i;
+  static clock_time_t start;
+  static clock_time_t duration;
+  uip_lladdr_t lladdr;
+
+  PROCESS_BEGIN();
+
+  memset(&lladdr, 0, sizeof(lladdr));
+  lladdr.addr[0] = 0x02;
+  lladdr.addr[sizeof(lladdr) - 1] = 0x10;
+  uip_ip6addr(&dest, 0xfe80, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&dest, &lladdr);
+  uip_ds6_nbr_add(&dest, &lladdr, 0, NBR_REACHABLE,
+                  NBR_TABLE_REASON_UNDEFINED, NULL);
+  simple_udp_register(&conn, PORT, NULL, PORT, NULL);
+
+  for(l = 0; l < sizeof(payload_lens) / sizeof(payload_lens[0]); l++) {
+    for(mode = 0; mode < MODE_COUNT; mode++) {
+      /* Hash the frames of a short run */
+      frame_hash = 2166136261UL;
+      hash_frames = 1;
+      for(i = 0; i < 4 * BURST; i += BURST) {
+        send_burst(mode, payload_lens[l], i);
+        PROCESS_PAUSE();
+      }
+      hash_frames = 0;
+
+      frames = 0;
+      start = clock_time();
+      for(i = 0; i < DATAGRAMS; i += BURST) {
+        send_burst(mode, payload_lens[l], i);
+        PROCESS_PAUSE();
+      }
+      duration = clock_time() - start;
+      printf("udp-bench: %2u bytes: %s %lu ns/datagram, %u copies, "
+             "%lu of %lu sent, frames %08lx\n",
+             payload_lens[l], mode_names[mode],
+             (unsigned long)((unsigned long long)duration * 1000000000ULL
+                             / CLOCK_SECOND / DATAGRAMS),
+             mode_copies[mode],
+             (unsigned long)frames, DATAGRAMS, (unsigned long)frame_hash);
+    }
+  }
+  printf("udp-bench: done\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
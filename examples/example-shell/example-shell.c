@@ -84,6 +84,7 @@ PROCESS_THREAD(example_shell_process, ev, data)
   shell_tcpsend_init();
   shell_text_init();
   shell_time_init();
+  shell_tsch_init();
   shell_udpsend_init();
   shell_vars_init();
   shell_wget_init();
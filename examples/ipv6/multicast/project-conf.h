@@ -49,6 +49,12 @@
 /* For Imin: Use 16 over NullRDC, 64 over Contiki MAC */
 #define ROLL_TM_CONF_IMIN_1         64
 
+/* MPL joins ff02::fc, in addition to the group of the sinks */
+#if UIP_MCAST6_CONF_ENGINE == UIP_MCAST6_ENGINE_MPL
+#undef UIP_CONF_DS6_MADDR_NBU
+#define UIP_CONF_DS6_MADDR_NBU       1
+#endif
+
 #undef UIP_CONF_IPV6_RPL
 #undef UIP_CONF_ND6_SEND_RA
 #undef UIP_CONF_ROUTER
@@ -45,6 +45,9 @@
 #if WITH_ORCHESTRA
 #include "orchestra.h"
 #endif /* WITH_ORCHESTRA */
+#if WITH_MSF
+#include "msf.h"
+#endif /* WITH_MSF */
 
 #define DEBUG DEBUG_PRINT
 #include "net/ip/uip-debug.h"
@@ -240,6 +243,9 @@ PROCESS_THREAD(node_process, ev, data)
 #if WITH_ORCHESTRA
   orchestra_init();
 #endif /* WITH_ORCHESTRA */
+#if WITH_MSF
+  msf_init();
+#endif /* WITH_MSF */
 
   /* Print out routing tables every minute */
   etimer_set(&et, CLOCK_SECOND * 60);
@@ -40,6 +40,11 @@
 #define WITH_ORCHESTRA 0
 #endif /* WITH_ORCHESTRA */
 
+/* Set to run 6P with the MSF scheduling function */
+#ifndef WITH_MSF
+#define WITH_MSF 0
+#endif /* WITH_MSF */
+
 /* Set to enable TSCH security */
 #ifndef WITH_SECURITY
 #define WITH_SECURITY 0
@@ -141,6 +146,22 @@
 
 #endif /* WITH_ORCHESTRA */
 
+#if WITH_MSF
+
+#if WITH_ORCHESTRA
+/* Both need TSCH_CALLBACK_NEW_TIME_SOURCE, and MSF relies on the
+ * 6TiSCH minimal schedule that Orchestra disables */
+#error "WITH_MSF and WITH_ORCHESTRA cannot be used together"
+#endif /* WITH_ORCHESTRA */
+
+/* See apps/msf/README.md for more MSF configuration options */
+#define TSCH_CONF_WITH_SIXTOP 1 /* MSF negotiates cells with 6P */
+/* MSF callbacks */
+#define TSCH_CALLBACK_NEW_TIME_SOURCE msf_callback_new_time_source
+#define TSCH_CALLBACK_TX_DONE msf_callback_tx_done
+
+#endif /* WITH_MSF */
+
 /*******************************************************/
 /************* Other system configuration **************/
 /*******************************************************/
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         A data collection network for the native-multi host. Node 1
+ *         is the RPL root and counts the datagrams that the other
+ *         nodes send to it periodically.
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+#include "sys/node-id.h"
+#include "net/ip/uip.h"
+#include "net/ip/uip-udp-packet.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/rpl/rpl.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define UDP_CLIENT_PORT 8765
+#define UDP_SERVER_PORT 5678
+
+#ifndef PERIOD
+#define PERIOD 30
+#endif
+
+#define SEND_INTERVAL (PERIOD * CLOCK_SECOND)
+#define REPORT_INTERVAL (60 * CLOCK_SECOND)
+
+static struct uip_udp_conn *conn;
+static uip_ipaddr_t root_ipaddr;
+static unsigned long received;
+static unsigned long sent;
+
+PROCESS(rpl_collect_process, "RPL collect process");
+AUTOSTART_PROCESSES(&rpl_collect_process);
+/*---------------------------------------------------------------------------*/
+static void
+set_addresses(void)
+{
+  uip_ipaddr_t ipaddr;
+  rpl_dag_t *dag;
+
+  /* The root has the address fd00::ff:fe00:1, the others one derived
+     from their link-layer address */
+  uip_ip6addr(&root_ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0x00ff, 0xfe00, 1);
+
+  if(node_id == 1) {
+    uip_ds6_addr_add(&root_ipaddr, 0, ADDR_MANUAL);
+    dag = rpl_set_root(RPL_DEFAULT_INSTANCE, &root_ipaddr);
+    uip_ip6addr(&ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+    rpl_set_prefix(dag, &ipaddr, 64);
+  } else {
+    uip_ip6addr(&ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+    uip_ds6_set_addr_iid(&ipaddr, &uip_lladdr);
+    uip_ds6_addr_add(&ipaddr, 0, ADDR_AUTOCONF);
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(rpl_collect_process, ev, data)
+{
+  static struct etimer periodic;
+
+  PROCESS_BEGIN();
+
+  PROCESS_PAUSE();
+
+  set_addresses();
+
+  if(node_id == 1) {
+    conn = udp_new(NULL, UIP_HTONS(UDP_CLIENT_PORT), NULL);
+    udp_bind(conn, UIP_HTONS(UDP_SERVER_PORT));
+    etimer_set(&periodic, REPORT_INTERVAL);
+  } else {
+    conn = udp_new(NULL, UIP_HTONS(UDP_SERVER_PORT), NULL);
+    udp_bind(conn, UIP_HTONS(UDP_CLIENT_PORT));
+    etimer_set(&periodic, SEND_INTERVAL + random_rand() % SEND_INTERVAL);
+  }
+  if(conn == NULL) {
+    printf("No UDP connection available\n");
+    PROCESS_EXIT();
+  }
+
+  while(1) {
+    PROCESS_YIELD();
+    if(ev == tcpip_event && uip_newdata()) {
+      received++;
+    } else if(ev == PROCESS_EVENT_TIMER && data == &periodic) {
+      if(node_id == 1) {
+        printf("received %lu datagrams\n", received);
+        etimer_reset(&periodic);
+      } else {
+        sent++;
+        uip_udp_packet_sendto(conn, &sent, sizeof(sent),
+                              &root_ipaddr, UIP_HTONS(UDP_SERVER_PORT));
+        etimer_set(&periodic, SEND_INTERVAL - CLOCK_SECOND / 2 +
+                   random_rand() % CLOCK_SECOND);
+      }
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
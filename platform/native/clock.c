@@ -41,25 +41,37 @@
 #include <time.h>
 #include <sys/time.h>
 
+#if NATIVE_MULTI
+/* The simulated time, set by the native-multi node main loop */
+clock_time_t native_multi_clock;
+#endif /* NATIVE_MULTI */
 /*---------------------------------------------------------------------------*/
 clock_time_t
 clock_time(void)
 {
+#if NATIVE_MULTI
+  return native_multi_clock;
+#else /* NATIVE_MULTI */
   struct timeval tv;
 
   gettimeofday(&tv, NULL);
 
   return tv.tv_sec * 1000 + tv.tv_usec / 1000;
+#endif /* NATIVE_MULTI */
 }
 /*---------------------------------------------------------------------------*/
 unsigned long
 clock_seconds(void)
 {
+#if NATIVE_MULTI
+  return native_multi_clock / CLOCK_SECOND;
+#else /* NATIVE_MULTI */
   struct timeval tv;
 
   gettimeofday(&tv, NULL);
 
   return tv.tv_sec;
+#endif /* NATIVE_MULTI */
 }
 /*---------------------------------------------------------------------------*/
 void
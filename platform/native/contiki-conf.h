@@ -78,6 +78,20 @@ typedef unsigned short uip_stats_t;
 #define NETSTACK_CONF_RDC_CHANNEL_CHECK_RATE 8
 #endif /* NETSTACK_CONF_RDC_CHANNEL_CHECK_RATE */
 
+/* Build the node library for the native-multi host, which runs many
+   nodes in one process (make NATIVE_MULTI=1) */
+#ifdef NATIVE_CONF_MULTI
+#define NATIVE_MULTI NATIVE_CONF_MULTI
+#else
+#define NATIVE_MULTI 0
+#endif /* NATIVE_CONF_MULTI */
+
+#if NATIVE_MULTI
+#ifndef NETSTACK_CONF_RADIO
+#define NETSTACK_CONF_RADIO   sim_radio_driver
+#endif /* NETSTACK_CONF_RADIO */
+#endif /* NATIVE_MULTI */
+
 #if NETSTACK_CONF_WITH_IPV6
 
 #define LINKADDR_CONF_SIZE              8
@@ -138,6 +152,10 @@ typedef unsigned short uip_stats_t;
 #define UIP_CONF_LLH_LEN                0
 #define UIP_CONF_LL_802154              1
 
+#ifndef UIP_CONF_CHKSUM_WIDE
+#define UIP_CONF_CHKSUM_WIDE            1
+#endif /* UIP_CONF_CHKSUM_WIDE */
+
 #define UIP_CONF_ICMP_DEST_UNREACH 1
 
 #define UIP_CONF_DHCP_LIGHT
@@ -47,12 +47,17 @@
 #include <unistd.h>
 #include <sys/select.h>
 #include <errno.h>
+#include <signal.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif /* __linux__ */
 
 #ifdef __CYGWIN__
 #include "net/wpcap-drv.h"
 #endif /* __CYGWIN__ */
 
 #include "contiki.h"
+#include "sys/tickless.h"
 #include "net/netstack.h"
 
 #include "ctk/ctk.h"
@@ -78,9 +83,34 @@
 #define SELECT_MAX 8
 #endif
 
+/* Wait for the file descriptors with epoll instead of select. If
+   epoll cannot be used at run time, e.g. because a callback watches a
+   regular file, the main loop falls back to select. */
+#ifdef SELECT_CONF_EPOLL
+#define SELECT_EPOLL SELECT_CONF_EPOLL
+#elif defined(__linux__)
+#define SELECT_EPOLL 1
+#else
+#define SELECT_EPOLL 0
+#endif
+
+/* The longest time in milliseconds that the main loop sleeps when no
+   etimer is pending */
+#ifdef SELECT_CONF_MAX_SLEEP
+#define SELECT_MAX_SLEEP SELECT_CONF_MAX_SLEEP
+#else
+#define SELECT_MAX_SLEEP 1000
+#endif
+
 static const struct select_callback *select_callback[SELECT_MAX];
 static int select_max = 0;
 
+#if SELECT_EPOLL
+static int epoll_fd = -1;
+/* The epoll events each file descriptor is registered for */
+static uint32_t epoll_registered[SELECT_MAX];
+#endif /* SELECT_EPOLL */
+
 SENSORS(&pir_sensor, &vib_sensor, &button_sensor);
 
 static uint8_t serial_id[] = {0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08};
@@ -101,6 +131,14 @@ select_set_callback(int fd, const struct select_callback *callback)
 
     select_callback[fd] = callback;
 
+#if SELECT_EPOLL
+    if(callback == NULL && epoll_fd >= 0 && epoll_registered[fd] != 0) {
+      /* The fd may already be closed, which removes it from epoll */
+      epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+      epoll_registered[fd] = 0;
+    }
+#endif /* SELECT_EPOLL */
+
     /* Update fd max */
     if(callback != NULL) {
       if(fd > select_max) {
@@ -130,9 +168,15 @@ static void
 stdin_handle_fd(fd_set *rset, fd_set *wset)
 {
   char c;
+  ssize_t n;
+
   if(FD_ISSET(STDIN_FILENO, rset)) {
-    if(read(STDIN_FILENO, &c, 1) > 0) {
+    n = read(STDIN_FILENO, &c, 1);
+    if(n > 0) {
       serial_line_input_byte(c);
+    } else if(n == 0) {
+      /* End of input: stop watching stdin, it would stay readable */
+      select_set_callback(STDIN_FILENO, NULL);
     }
   }
 }
@@ -140,6 +184,146 @@ const static struct select_callback stdin_fd = {
   stdin_set_fd, stdin_handle_fd
 };
 /*---------------------------------------------------------------------------*/
+/* The time in milliseconds until the main loop has work to do, as far
+   as Contiki knows */
+static int
+sleep_time(void)
+{
+  clock_time_t ticks;
+
+  ticks = tickless_suppress((clock_time_t)SELECT_MAX_SLEEP * CLOCK_SECOND / 1000);
+  return (int)(ticks * 1000 / CLOCK_SECOND);
+}
+/*---------------------------------------------------------------------------*/
+static void
+select_wait(int timeout, const sigset_t *sigmask)
+{
+  fd_set fdr;
+  fd_set fdw;
+  int maxfd;
+  int i;
+  int retval;
+  struct timespec ts;
+
+  ts.tv_sec = timeout / 1000;
+  ts.tv_nsec = (timeout % 1000) * 1000000L;
+
+  FD_ZERO(&fdr);
+  FD_ZERO(&fdw);
+  maxfd = 0;
+  for(i = 0; i <= select_max; i++) {
+    if(select_callback[i] != NULL && select_callback[i]->set_fd(&fdr, &fdw)) {
+      maxfd = i;
+    }
+  }
+
+  retval = pselect(maxfd + 1, &fdr, &fdw, NULL, &ts, sigmask);
+  if(retval < 0) {
+    if(errno != EINTR) {
+      perror("pselect");
+    }
+  } else if(retval > 0) {
+    /* timeout => retval == 0 */
+    for(i = 0; i <= maxfd; i++) {
+      if(select_callback[i] != NULL) {
+        select_callback[i]->handle_fd(&fdr, &fdw);
+      }
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+#if SELECT_EPOLL
+static int
+epoll_register(int fd, uint32_t events)
+{
+  struct epoll_event ev;
+  int op;
+
+  memset(&ev, 0, sizeof(ev));
+  ev.events = events;
+  ev.data.fd = fd;
+
+  if(events == 0) {
+    op = EPOLL_CTL_DEL;
+  } else if(epoll_registered[fd] == 0) {
+    op = EPOLL_CTL_ADD;
+  } else {
+    op = EPOLL_CTL_MOD;
+  }
+
+  if(epoll_ctl(epoll_fd, op, fd, &ev) < 0) {
+    if(op == EPOLL_CTL_MOD && errno == ENOENT) {
+      /* The fd was closed and reopened since it was registered */
+      op = EPOLL_CTL_ADD;
+    } else if(op == EPOLL_CTL_ADD && errno == EEXIST) {
+      op = EPOLL_CTL_MOD;
+    } else if(op != EPOLL_CTL_DEL) {
+      return 0;
+    }
+    if(op != EPOLL_CTL_DEL && epoll_ctl(epoll_fd, op, fd, &ev) < 0) {
+      return 0;
+    }
+  }
+
+  epoll_registered[fd] = events;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+epoll_wait_fds(int timeout, const sigset_t *sigmask)
+{
+  fd_set fdr;
+  fd_set fdw;
+  struct epoll_event events[SELECT_MAX];
+  uint32_t wanted;
+  int i;
+  int n;
+
+  /* The callbacks still report what they wait for through fd_sets.
+     Only the changes are passed on to epoll. */
+  FD_ZERO(&fdr);
+  FD_ZERO(&fdw);
+  for(i = 0; i <= select_max; i++) {
+    wanted = 0;
+    if(select_callback[i] != NULL && select_callback[i]->set_fd(&fdr, &fdw)) {
+      wanted = (FD_ISSET(i, &fdr) ? EPOLLIN : 0) |
+        (FD_ISSET(i, &fdw) ? EPOLLOUT : 0);
+    }
+    if(wanted != epoll_registered[i] && !epoll_register(i, wanted)) {
+      /* E.g. a regular file, which epoll does not support */
+      close(epoll_fd);
+      epoll_fd = -1;
+      select_wait(0, sigmask);
+      return;
+    }
+  }
+
+  n = epoll_pwait(epoll_fd, events, SELECT_MAX, timeout, sigmask);
+  if(n < 0) {
+    if(errno != EINTR) {
+      perror("epoll_pwait");
+    }
+    return;
+  }
+
+  FD_ZERO(&fdr);
+  FD_ZERO(&fdw);
+  for(i = 0; i < n; i++) {
+    if(events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+      FD_SET(events[i].data.fd, &fdr);
+    }
+    if(events[i].events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) {
+      FD_SET(events[i].data.fd, &fdw);
+    }
+  }
+  for(i = 0; i < n; i++) {
+    if(select_callback[events[i].data.fd] != NULL) {
+      select_callback[events[i].data.fd]->handle_fd(&fdr, &fdw);
+    }
+  }
+}
+#endif /* SELECT_EPOLL */
+/*---------------------------------------------------------------------------*/
 static void
 set_rime_addr(void)
 {
@@ -175,6 +359,9 @@ char **contiki_argv;
 int
 main(int argc, char **argv)
 {
+  sigset_t alarm_mask;
+  sigset_t wait_mask;
+
 #if NETSTACK_CONF_WITH_IPV6
 #if UIP_CONF_IPV6_RPL
   printf(CONTIKI_VERSION_STRING " started with IPV6, RPL\n");
@@ -250,41 +437,35 @@ main(int argc, char **argv)
   setvbuf(stdout, (char *)NULL, _IONBF, 0);
 
   select_set_callback(STDIN_FILENO, &stdin_fd);
+#if SELECT_EPOLL
+  epoll_fd = epoll_create(SELECT_MAX);
+#endif /* SELECT_EPOLL */
+  sigemptyset(&alarm_mask);
+  sigaddset(&alarm_mask, SIGALRM);
   while(1) {
-    fd_set fdr;
-    fd_set fdw;
-    int maxfd;
-    int i;
-    int retval;
-    struct timeval tv;
-
-    retval = process_run();
-
-    tv.tv_sec = 0;
-    tv.tv_usec = retval ? 1 : 1000;
-
-    FD_ZERO(&fdr);
-    FD_ZERO(&fdw);
-    maxfd = 0;
-    for(i = 0; i <= select_max; i++) {
-      if(select_callback[i] != NULL && select_callback[i]->set_fd(&fdr, &fdw)) {
-        maxfd = i;
-      }
-    }
-
-    retval = select(maxfd + 1, &fdr, &fdw, NULL, &tv);
-    if(retval < 0) {
-      if(errno != EINTR) {
-        perror("select");
-      }
-    } else if(retval > 0) {
-      /* timeout => retval == 0 */
-      for(i = 0; i <= maxfd; i++) {
-        if(select_callback[i] != NULL) {
-          select_callback[i]->handle_fd(&fdr, &fdw);
-        }
-      }
+    clock_time_t start;
+    int timeout;
+
+    process_run();
+
+    /* Sleep until an fd is ready or the next timer expires. SIGALRM
+       (the rtimer) is blocked from the time we look at the pending work
+       until the wait, which unblocks it atomically: an rtimer that polls
+       a process in between interrupts the wait instead of being missed. */
+    sigprocmask(SIG_BLOCK, &alarm_mask, &wait_mask);
+    timeout = sleep_time();
+    start = clock_time();
+
+#if SELECT_EPOLL
+    if(epoll_fd >= 0) {
+      epoll_wait_fds(timeout, &wait_mask);
+    } else
+#endif /* SELECT_EPOLL */
+    {
+      select_wait(timeout, &wait_mask);
     }
+    sigprocmask(SIG_SETMASK, &wait_mask, NULL);
+    tickless_resume(clock_time() - start);
 
     etimer_request_poll();
 
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Main loop of a Contiki node run by the native-multi host.
+ *         It replaces contiki-main.c when the application is built
+ *         with NATIVE_MULTI=1: instead of sleeping in select(), the
+ *         node runs for one instant of simulated time each time the
+ *         host calls native_multi_node_run(), and tells the host when
+ *         it wants to run next.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "contiki.h"
+#include "net/netstack.h"
+#include "net/queuebuf.h"
+#include "dev/serial-line.h"
+#include "dev/button-sensor.h"
+#include "dev/pir-sensor.h"
+#include "dev/vib-sensor.h"
+#include "sys/node-id.h"
+#include "sys/tickless.h"
+#include "lib/random.h"
+
+#if NETSTACK_CONF_WITH_IPV6
+#include "net/ipv6/uip-ds6.h"
+#endif /* NETSTACK_CONF_WITH_IPV6 */
+
+#include "native-multi.h"
+#include "sim-radio.h"
+
+/* The longest run of process_run() calls in one activation. Processes
+   that keep polling themselves continue in the next millisecond. */
+#define MAX_EVENTS_PER_RUN 1000
+
+/* The wakeup time reported when the node waits for nothing but
+   radio frames */
+#define IDLE_TIME (60 * CLOCK_SECOND)
+
+/* The simulated time in clock.c */
+extern clock_time_t native_multi_clock;
+
+static const struct native_multi_host *host;
+static int node_index;
+
+/* The output of the node, collected until the end of the line */
+static char log_line[256];
+static int log_len;
+
+static unsigned int rand_state;
+
+unsigned short node_id;
+
+int contiki_argc = 0;
+char **contiki_argv;
+
+SENSORS(&pir_sensor, &vib_sensor, &button_sensor);
+/*---------------------------------------------------------------------------*/
+int
+select_set_callback(int fd, const struct select_callback *callback)
+{
+  /* The nodes share the file descriptors of the host */
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* The node library is linked with -Bsymbolic, so the functions below
+   replace those of the C library for the code of the node. */
+static void
+log_char(char c)
+{
+  if(c == '\n' || log_len == sizeof(log_line) - 1) {
+    log_line[log_len] = '\0';
+    host->log(node_index, log_line);
+    log_len = 0;
+    if(c == '\n') {
+      return;
+    }
+  }
+  log_line[log_len++] = c;
+}
+/*---------------------------------------------------------------------------*/
+int
+putchar(int c)
+{
+  log_char(c);
+  return (unsigned char)c;
+}
+/*---------------------------------------------------------------------------*/
+int
+puts(const char *s)
+{
+  const char *p;
+
+  for(p = s; *p != '\0'; p++) {
+    log_char(*p);
+  }
+  log_char('\n');
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+int
+printf(const char *fmt, ...)
+{
+  char buf[256];
+  va_list ap;
+  int len;
+  int i;
+
+  va_start(ap, fmt);
+  len = vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+
+  for(i = 0; i < len && i < sizeof(buf) - 1; i++) {
+    log_char(buf[i]);
+  }
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+/* Each node has its own random sequence, independent of the others */
+void
+srand(unsigned int seed)
+{
+  rand_state = seed;
+}
+/*---------------------------------------------------------------------------*/
+int
+rand(void)
+{
+  return rand_r(&rand_state);
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_addresses(void)
+{
+  linkaddr_t addr;
+
+  memset(&addr, 0, sizeof(linkaddr_t));
+#if NETSTACK_CONF_WITH_IPV6
+  addr.u8[0] = 0x02;
+  addr.u8[sizeof(addr.u8) - 2] = node_id >> 8;
+  addr.u8[sizeof(addr.u8) - 1] = node_id & 0xff;
+  memcpy(&uip_lladdr.addr, addr.u8, sizeof(uip_lladdr.addr));
+#else
+  addr.u8[0] = node_id & 0xff;
+  addr.u8[1] = node_id >> 8;
+#endif
+  linkaddr_set_node_addr(&addr);
+}
+/*---------------------------------------------------------------------------*/
+void
+native_multi_node_init(int node, const struct native_multi_host *h,
+                       unsigned long now)
+{
+  host = h;
+  node_index = node;
+  node_id = node + 1;
+  native_multi_clock = now;
+
+  random_init(node_id);
+
+  process_init();
+  process_start(&etimer_process, NULL);
+  ctimer_init();
+  rtimer_init();
+
+  set_addresses();
+
+  sim_radio_attach(node_index, host);
+  netstack_init();
+
+#if NETSTACK_CONF_WITH_IPV6
+  queuebuf_init();
+  process_start(&tcpip_process, NULL);
+  uip_ds6_get_link_local(-1)->state = ADDR_AUTOCONF;
+#elif NETSTACK_CONF_WITH_IPV4
+  process_start(&tcpip_process, NULL);
+#endif
+
+  serial_line_init();
+
+  autostart_start(autostart_processes);
+}
+/*---------------------------------------------------------------------------*/
+unsigned long
+native_multi_node_run(unsigned long now)
+{
+  clock_time_t left;
+  rtimer_clock_t time;
+  int i;
+
+  native_multi_clock = now;
+
+  /* The rtimer has no signal here; run it once it is due */
+  if(rtimer_next_expiration(&time) && !RTIMER_CLOCK_LT(RTIMER_NOW(), time)) {
+    rtimer_run_next();
+  }
+
+  sim_radio_check();
+  if(etimer_pending() &&
+     (long)(etimer_next_expiration_time() - now) <= 0) {
+    etimer_request_poll();
+  }
+
+  for(i = 0; i < MAX_EVENTS_PER_RUN && process_run() > 0; i++);
+
+  left = tickless_suppress(IDLE_TIME);
+  return now + (left > 0 ? left : 1);
+}
+/*---------------------------------------------------------------------------*/
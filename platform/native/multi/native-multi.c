@@ -0,0 +1,599 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         The native-multi host: runs many Contiki nodes of one
+ *         application in a single process, on simulated time, and
+ *         connects their radios through an in-memory medium.
+ *
+ *         The node library is loaded once per worker copy. A copy
+ *         holds the state of one node at a time in its data segment;
+ *         the host swaps the data segment when the copy runs another
+ *         node. The copies are spread over worker threads, which run
+ *         the nodes that are due in lockstep, one millisecond of
+ *         simulated time after the other. Frames sent in one
+ *         millisecond reach the neighbours in range in the next.
+ *         With an air time, a node sends one frame per air time and
+ *         the others wait in its outbox.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <dlfcn.h>
+#include <link.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "native-multi.h"
+
+/* The number of frames a node can hold in each direction */
+#define INBOX_SIZE  16
+#define OUTBOX_SIZE 16
+
+struct frame {
+  unsigned short len;
+  unsigned char data[NATIVE_MULTI_FRAME_SIZE];
+};
+
+struct node {
+  int copy;
+  unsigned long next;
+  int radio_on;
+  int channel;
+  struct frame inbox[INBOX_SIZE];
+  int in_first;
+  int in_count;
+  struct frame outbox[OUTBOX_SIZE];
+  int out_count;
+  /* The time at which the radio can send the next frame */
+  unsigned long tx_free;
+  int *neighbors;
+  int neighbor_count;
+  /* The data segment of the node while another node is loaded */
+  char *image;
+  unsigned long activations;
+  unsigned long sent;
+  unsigned long tx_dropped;
+};
+
+struct copy {
+  void *handle;
+  uintptr_t base;
+  native_multi_node_init_t init;
+  native_multi_node_run_t run;
+  char *segment;
+  size_t segment_size;
+  int segments;
+  char *pristine;
+  int current;
+};
+
+static struct node *nodes;
+static int node_count = 16;
+static struct copy *copies;
+static int copy_count;
+static int worker_count = 1;
+
+static unsigned long now;
+static unsigned long end_time = 60 * 1000UL;
+static volatile int done;
+static pthread_barrier_t round_start;
+static pthread_barrier_t round_end;
+
+static double range = 1.5;
+static unsigned long airtime;
+static int loss;
+static double speed;
+static int quiet;
+static int log_filter;
+static unsigned int loss_seed = 1;
+static pthread_mutex_t log_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static unsigned long rounds;
+static unsigned long delivered;
+static unsigned long rx_dropped;
+/*---------------------------------------------------------------------------*/
+static void
+host_send(int node, const void *frame, unsigned short len)
+{
+  struct node *n = &nodes[node];
+
+  n->sent++;
+  if(n->out_count == OUTBOX_SIZE || len > NATIVE_MULTI_FRAME_SIZE) {
+    n->tx_dropped++;
+    return;
+  }
+  n->outbox[n->out_count].len = len;
+  memcpy(n->outbox[n->out_count].data, frame, len);
+  n->out_count++;
+}
+/*---------------------------------------------------------------------------*/
+static int
+host_receive(int node, void *buf, unsigned short bufsize)
+{
+  struct node *n = &nodes[node];
+  struct frame *f;
+  int len;
+
+  if(n->in_count == 0) {
+    return 0;
+  }
+  f = &n->inbox[n->in_first];
+  len = f->len < bufsize ? f->len : bufsize;
+  memcpy(buf, f->data, len);
+  n->in_first = (n->in_first + 1) % INBOX_SIZE;
+  n->in_count--;
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+static int
+host_pending(int node)
+{
+  return nodes[node].in_count;
+}
+/*---------------------------------------------------------------------------*/
+static void
+host_radio_state(int node, int on, int channel)
+{
+  nodes[node].radio_on = on;
+  nodes[node].channel = channel;
+}
+/*---------------------------------------------------------------------------*/
+static void
+host_log(int node, const char *line)
+{
+  if(quiet || (log_filter != 0 && node + 1 != log_filter)) {
+    return;
+  }
+  pthread_mutex_lock(&log_mutex);
+  printf("%lu.%03lu ID:%d %s\n", now / 1000, now % 1000, node + 1, line);
+  pthread_mutex_unlock(&log_mutex);
+}
+/*---------------------------------------------------------------------------*/
+static const struct native_multi_host host = {
+  host_send, host_receive, host_pending, host_radio_state, host_log
+};
+/*---------------------------------------------------------------------------*/
+static int
+find_segment(struct dl_phdr_info *info, size_t size, void *data)
+{
+  struct copy *c = data;
+  int i;
+
+  if(info->dlpi_addr != c->base) {
+    return 0;
+  }
+  for(i = 0; i < info->dlpi_phnum; i++) {
+    if(info->dlpi_phdr[i].p_type == PT_LOAD &&
+       (info->dlpi_phdr[i].p_flags & PF_W)) {
+      c->segment = (char *)(info->dlpi_addr + info->dlpi_phdr[i].p_vaddr);
+      c->segment_size = info->dlpi_phdr[i].p_memsz;
+      c->segments++;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+copy_file(const char *from, const char *to)
+{
+  char buf[65536];
+  ssize_t len;
+  int in;
+  int out;
+
+  in = open(from, O_RDONLY);
+  if(in < 0) {
+    return 0;
+  }
+  out = open(to, O_WRONLY | O_CREAT | O_TRUNC, 0700);
+  if(out < 0) {
+    close(in);
+    return 0;
+  }
+  while((len = read(in, buf, sizeof(buf))) > 0) {
+    if(write(out, buf, len) != len) {
+      len = -1;
+      break;
+    }
+  }
+  close(in);
+  close(out);
+  return len == 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Load one more copy of the node library. dlopen() returns the same
+   instance for the same file, so each copy is loaded from its own
+   temporary file. */
+static int
+load_copy(struct copy *c, const char *library, const char *dir, int index)
+{
+  char path[4096];
+  struct link_map *map;
+
+  snprintf(path, sizeof(path), "%s/node-%d.so", dir, index);
+  if(!copy_file(library, path)) {
+    fprintf(stderr, "cannot copy %s to %s: %s\n", library, path,
+            strerror(errno));
+    return 0;
+  }
+  c->handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  unlink(path);
+  if(c->handle == NULL) {
+    fprintf(stderr, "cannot load %s: %s\n", library, dlerror());
+    return 0;
+  }
+
+  c->init = (native_multi_node_init_t)dlsym(c->handle, NATIVE_MULTI_NODE_INIT);
+  c->run = (native_multi_node_run_t)dlsym(c->handle, NATIVE_MULTI_NODE_RUN);
+  if(c->init == NULL || c->run == NULL) {
+    fprintf(stderr, "%s is not a native-multi node library\n", library);
+    return 0;
+  }
+
+  if(dlinfo(c->handle, RTLD_DI_LINKMAP, &map) != 0) {
+    fprintf(stderr, "cannot inspect %s: %s\n", library, dlerror());
+    return 0;
+  }
+  c->base = map->l_addr;
+  dl_iterate_phdr(find_segment, c);
+  if(c->segments != 1) {
+    fprintf(stderr, "%s has %d writable segments, expected one\n",
+            library, c->segments);
+    return 0;
+  }
+
+  c->pristine = malloc(c->segment_size);
+  if(c->pristine == NULL) {
+    return 0;
+  }
+  memcpy(c->pristine, c->segment, c->segment_size);
+  c->current = -1;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Bring the state of a node into the data segment of its copy */
+static void
+load_node(int node)
+{
+  struct copy *c = &copies[nodes[node].copy];
+
+  if(c->current == node) {
+    return;
+  }
+  if(c->current >= 0) {
+    memcpy(nodes[c->current].image, c->segment, c->segment_size);
+  }
+  if(nodes[node].image != NULL) {
+    memcpy(c->segment, nodes[node].image, c->segment_size);
+  }
+  c->current = node;
+}
+/*---------------------------------------------------------------------------*/
+static void
+run_worker(int worker)
+{
+  struct node *n;
+  int c;
+  int i;
+
+  for(c = worker; c < copy_count; c += worker_count) {
+    for(i = c; i < node_count; i += copy_count) {
+      n = &nodes[i];
+      if(n->next <= now || n->in_count > 0) {
+        load_node(i);
+        n->next = copies[c].run(now);
+        n->activations++;
+      }
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void *
+worker_thread(void *arg)
+{
+  int worker = (int)(intptr_t)arg;
+
+  while(1) {
+    pthread_barrier_wait(&round_start);
+    if(done) {
+      break;
+    }
+    run_worker(worker);
+    pthread_barrier_wait(&round_end);
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/* Hand the frames sent in this round to the neighbours in range */
+static void
+deliver(void)
+{
+  struct node *n;
+  struct node *r;
+  struct frame *f;
+  int i;
+  int j;
+  int k;
+  int count;
+
+  for(i = 0; i < node_count; i++) {
+    n = &nodes[i];
+    count = n->out_count;
+    if(airtime > 0) {
+      if(count == 0 || n->tx_free > now) {
+        continue;
+      }
+      count = 1;
+      n->tx_free = now + airtime;
+    }
+    for(j = 0; j < count; j++) {
+      f = &n->outbox[j];
+      for(k = 0; k < n->neighbor_count; k++) {
+        r = &nodes[n->neighbors[k]];
+        if(!r->radio_on || r->channel != n->channel) {
+          continue;
+        }
+        if(loss > 0 && rand_r(&loss_seed) % 100 < loss) {
+          rx_dropped++;
+          continue;
+        }
+        if(r->in_count == INBOX_SIZE) {
+          rx_dropped++;
+          continue;
+        }
+        r->inbox[(r->in_first + r->in_count) % INBOX_SIZE] = *f;
+        r->in_count++;
+        if(r->next > now + 1) {
+          r->next = now + 1;
+        }
+        delivered++;
+      }
+    }
+    n->out_count -= count;
+    memmove(n->outbox, &n->outbox[count], n->out_count * sizeof(struct frame));
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Place the nodes on a square grid with unit spacing and connect
+   those within range */
+static int
+build_topology(void)
+{
+  int side;
+  int i;
+  int j;
+  double dx;
+  double dy;
+
+  for(side = 1; side * side < node_count; side++);
+
+  for(i = 0; i < node_count; i++) {
+    nodes[i].neighbors = malloc(node_count * sizeof(int));
+    if(nodes[i].neighbors == NULL) {
+      return 0;
+    }
+    for(j = 0; j < node_count; j++) {
+      dx = i % side - j % side;
+      dy = i / side - j / side;
+      if(i != j && dx * dx + dy * dy <= range * range) {
+        nodes[i].neighbors[nodes[i].neighbor_count++] = j;
+      }
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static double
+wall_time(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+/*---------------------------------------------------------------------------*/
+static void
+usage(const char *name)
+{
+  fprintf(stderr, "usage: %s [options]\n"
+          "  -n nodes    number of nodes (16)\n"
+          "  -t seconds  simulated time (60)\n"
+          "  -w workers  worker threads (1)\n"
+          "  -c copies   copies of the node library (one per worker)\n"
+          "  -r range    radio range, in grid spacings (1.5)\n"
+          "  -a ms       air time of a frame (0)\n"
+          "  -L percent  frame loss (0)\n"
+          "  -s factor   run at most factor times faster than real time\n"
+          "  -f node     only print the output of one node\n"
+          "  -q          do not print the output of the nodes\n"
+          "  -l library  node library (the program name + .so)\n",
+          name);
+  exit(1);
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  char library[4096];
+  char dir[] = "/tmp/native-multi-XXXXXX";
+  pthread_t *threads;
+  unsigned long activations;
+  unsigned long sent;
+  unsigned long tx_dropped;
+  double start;
+  double elapsed;
+  int opt;
+  int i;
+
+  snprintf(library, sizeof(library), "%s.so", argv[0]);
+  while((opt = getopt(argc, argv, "n:t:w:c:r:a:L:s:f:ql:")) != -1) {
+    switch(opt) {
+    case 'n': node_count = atoi(optarg); break;
+    case 't': end_time = strtoul(optarg, NULL, 10) * 1000; break;
+    case 'w': worker_count = atoi(optarg); break;
+    case 'c': copy_count = atoi(optarg); break;
+    case 'r': range = atof(optarg); break;
+    case 'a': airtime = strtoul(optarg, NULL, 10); break;
+    case 'L': loss = atoi(optarg); break;
+    case 's': speed = atof(optarg); break;
+    case 'f': log_filter = atoi(optarg); break;
+    case 'q': quiet = 1; break;
+    case 'l': snprintf(library, sizeof(library), "%s", optarg); break;
+    default: usage(argv[0]);
+    }
+  }
+  if(node_count < 1 || worker_count < 1 || copy_count < 0) {
+    usage(argv[0]);
+  }
+  if(copy_count < worker_count) {
+    copy_count = worker_count;
+  }
+  if(copy_count > node_count) {
+    copy_count = node_count;
+  }
+  if(worker_count > copy_count) {
+    worker_count = copy_count;
+  }
+
+  nodes = calloc(node_count, sizeof(struct node));
+  copies = calloc(copy_count, sizeof(struct copy));
+  if(nodes == NULL || copies == NULL || !build_topology()) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+
+  if(mkdtemp(dir) == NULL) {
+    perror("mkdtemp");
+    return 1;
+  }
+  for(i = 0; i < copy_count; i++) {
+    if(!load_copy(&copies[i], library, dir, i)) {
+      rmdir(dir);
+      return 1;
+    }
+  }
+  rmdir(dir);
+
+  /* Start each node from the pristine data segment of its copy. The
+     state only needs to be saved when the copy runs several nodes. */
+  for(i = 0; i < node_count; i++) {
+    struct copy *c = &copies[i % copy_count];
+
+    nodes[i].copy = i % copy_count;
+    if(node_count > copy_count) {
+      nodes[i].image = malloc(c->segment_size);
+      if(nodes[i].image == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+      }
+    }
+    if(c->current >= 0) {
+      memcpy(nodes[c->current].image, c->segment, c->segment_size);
+    }
+    memcpy(c->segment, c->pristine, c->segment_size);
+    c->current = i;
+    c->init(i, &host, 0);
+  }
+
+  pthread_barrier_init(&round_start, NULL, worker_count);
+  pthread_barrier_init(&round_end, NULL, worker_count);
+  threads = calloc(worker_count, sizeof(pthread_t));
+  for(i = 1; i < worker_count; i++) {
+    pthread_create(&threads[i], NULL, worker_thread, (void *)(intptr_t)i);
+  }
+
+  start = wall_time();
+  now = 0;
+  while(now <= end_time) {
+    unsigned long next;
+
+    pthread_barrier_wait(&round_start);
+    run_worker(0);
+    pthread_barrier_wait(&round_end);
+    rounds++;
+
+    deliver();
+
+    /* Skip the time in which no node has anything to do */
+    next = end_time + 1;
+    for(i = 0; i < node_count; i++) {
+      if(nodes[i].next < next) {
+        next = nodes[i].next;
+      }
+      if(nodes[i].out_count > 0 && nodes[i].tx_free < next) {
+        next = nodes[i].tx_free;
+      }
+    }
+    now = next > now ? next : now + 1;
+
+    if(speed > 0) {
+      elapsed = wall_time() - start;
+      if(now / 1000.0 / speed > elapsed) {
+        usleep((now / 1000.0 / speed - elapsed) * 1e6);
+      }
+    }
+  }
+  elapsed = wall_time() - start;
+
+  done = 1;
+  pthread_barrier_wait(&round_start);
+  for(i = 1; i < worker_count; i++) {
+    pthread_join(threads[i], NULL);
+  }
+
+  activations = sent = tx_dropped = 0;
+  for(i = 0; i < node_count; i++) {
+    activations += nodes[i].activations;
+    sent += nodes[i].sent;
+    tx_dropped += nodes[i].tx_dropped;
+  }
+  fprintf(stderr, "%d nodes, %d workers, %d copies, data segment %lu bytes\n",
+          node_count, worker_count, copy_count,
+          (unsigned long)copies[0].segment_size);
+  fprintf(stderr, "simulated %.3f s in %.3f s wall time, %.1fx real time\n",
+          end_time / 1000.0, elapsed,
+          elapsed > 0 ? end_time / 1000.0 / elapsed : 0);
+  fprintf(stderr, "rounds %lu, activations %lu, frames sent %lu, "
+          "delivered %lu, dropped %lu\n", rounds, activations, sent,
+          delivered, tx_dropped + rx_dropped);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Interface between the native-multi host and the Contiki
+ *         node library it runs. The host loads one copy of the node
+ *         library per worker and calls the node entry points; the
+ *         nodes reach the simulated radio medium and the log through
+ *         the callbacks in struct native_multi_host.
+ *
+ *         This header is shared by the host and the node library, so
+ *         it must not depend on any Contiki header.
+ */
+
+#ifndef NATIVE_MULTI_H_
+#define NATIVE_MULTI_H_
+
+/* The largest radio frame carried by the simulated medium */
+#define NATIVE_MULTI_FRAME_SIZE 127
+
+struct native_multi_host {
+  /* Put a frame on the medium */
+  void (* send)(int node, const void *frame, unsigned short len);
+  /* Take the next received frame; returns its length, 0 if none */
+  int (* receive)(int node, void *buf, unsigned short bufsize);
+  /* Non-zero if received frames are waiting */
+  int (* pending)(int node);
+  /* Report whether the radio listens, and on which channel */
+  void (* radio_state)(int node, int on, int channel);
+  /* Output one line of log from the node */
+  void (* log)(int node, const char *line);
+};
+
+/* Entry points of the node library. Time is in clock ticks of the
+   native platform (milliseconds). */
+#define NATIVE_MULTI_NODE_INIT "native_multi_node_init"
+#define NATIVE_MULTI_NODE_RUN  "native_multi_node_run"
+
+typedef void (* native_multi_node_init_t)(int node,
+                                          const struct native_multi_host *host,
+                                          unsigned long now);
+typedef unsigned long (* native_multi_node_run_t)(unsigned long now);
+
+#endif /* NATIVE_MULTI_H_ */
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Radio driver for the in-memory radio medium of the
+ *         native-multi host. Frames are handed to the host on
+ *         transmission and delivered by the host to the nodes in
+ *         range. The medium has no collisions, so the channel is
+ *         always clear.
+ */
+
+#include "contiki.h"
+#include "net/packetbuf.h"
+#include "net/netstack.h"
+#include "sim-radio.h"
+
+#include <string.h>
+
+#define CHANNEL_MIN 11
+#define CHANNEL_MAX 26
+
+static int node_index;
+static const struct native_multi_host *medium;
+
+static uint8_t tx_buf[NATIVE_MULTI_FRAME_SIZE];
+static unsigned short tx_len;
+static int radio_on;
+static int channel = CHANNEL_MIN;
+
+PROCESS(sim_radio_process, "sim radio process");
+/*---------------------------------------------------------------------------*/
+static void
+update_state(void)
+{
+  medium->radio_state(node_index, radio_on, channel);
+}
+/*---------------------------------------------------------------------------*/
+void
+sim_radio_attach(int node, const struct native_multi_host *host)
+{
+  node_index = node;
+  medium = host;
+}
+/*---------------------------------------------------------------------------*/
+void
+sim_radio_check(void)
+{
+  if(radio_on && medium->pending(node_index)) {
+    process_poll(&sim_radio_process);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+init(void)
+{
+  radio_on = 1;
+  update_state();
+  process_start(&sim_radio_process, NULL);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+prepare(const void *payload, unsigned short payload_len)
+{
+  if(payload_len > sizeof(tx_buf)) {
+    return RADIO_TX_ERR;
+  }
+  memcpy(tx_buf, payload, payload_len);
+  tx_len = payload_len;
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+transmit(unsigned short transmit_len)
+{
+  if(transmit_len > tx_len) {
+    return RADIO_TX_ERR;
+  }
+  medium->send(node_index, tx_buf, transmit_len);
+  return RADIO_TX_OK;
+}
+/*---------------------------------------------------------------------------*/
+static int
+send(const void *payload, unsigned short payload_len)
+{
+  if(prepare(payload, payload_len) != 0) {
+    return RADIO_TX_ERR;
+  }
+  return transmit(payload_len);
+}
+/*---------------------------------------------------------------------------*/
+static int
+radio_read(void *buf, unsigned short buf_len)
+{
+  return medium->receive(node_index, buf, buf_len);
+}
+/*---------------------------------------------------------------------------*/
+static int
+channel_clear(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+receiving_packet(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+pending_packet(void)
+{
+  return medium->pending(node_index);
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  radio_on = 1;
+  update_state();
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(void)
+{
+  radio_on = 0;
+  update_state();
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+get_value(radio_param_t param, radio_value_t *value)
+{
+  switch(param) {
+  case RADIO_PARAM_POWER_MODE:
+    *value = radio_on ? RADIO_POWER_MODE_ON : RADIO_POWER_MODE_OFF;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_CHANNEL:
+    *value = channel;
+    return RADIO_RESULT_OK;
+  case RADIO_CONST_CHANNEL_MIN:
+    *value = CHANNEL_MIN;
+    return RADIO_RESULT_OK;
+  case RADIO_CONST_CHANNEL_MAX:
+    *value = CHANNEL_MAX;
+    return RADIO_RESULT_OK;
+  default:
+    return RADIO_RESULT_NOT_SUPPORTED;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+set_value(radio_param_t param, radio_value_t value)
+{
+  switch(param) {
+  case RADIO_PARAM_POWER_MODE:
+    if(value == RADIO_POWER_MODE_ON) {
+      on();
+    } else if(value == RADIO_POWER_MODE_OFF) {
+      off();
+    } else {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_CHANNEL:
+    if(value < CHANNEL_MIN || value > CHANNEL_MAX) {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    channel = value;
+    update_state();
+    return RADIO_RESULT_OK;
+  default:
+    return RADIO_RESULT_NOT_SUPPORTED;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+get_object(radio_param_t param, void *dest, size_t size)
+{
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+set_object(radio_param_t param, const void *src, size_t size)
+{
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(sim_radio_process, ev, data)
+{
+  int len;
+
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
+
+    while(radio_on && medium->pending(node_index)) {
+      packetbuf_clear();
+      len = radio_read(packetbuf_dataptr(), PACKETBUF_SIZE);
+      if(len > 0) {
+        packetbuf_set_datalen(len);
+        NETSTACK_RDC.input();
+      }
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+const struct radio_driver sim_radio_driver =
+  {
+    init,
+    prepare,
+    transmit,
+    send,
+    radio_read,
+    channel_clear,
+    receiving_packet,
+    pending_packet,
+    on,
+    off,
+    get_value,
+    set_value,
+    get_object,
+    set_object
+  };
+/*---------------------------------------------------------------------------*/
@@ -56,6 +56,14 @@
 #undef FRAME802154_CONF_VERSION
 #define FRAME802154_CONF_VERSION FRAME802154_IEEE802154E_2012
 
+/* 6P and MSF, for the MSF test. A short slotframe keeps the
+ * evaluation window of MSF short */
+#undef TSCH_CONF_WITH_SIXTOP
+#define TSCH_CONF_WITH_SIXTOP 1
+#define TSCH_CALLBACK_NEW_TIME_SOURCE msf_callback_new_time_source
+#define TSCH_CALLBACK_TX_DONE msf_callback_tx_done
+#define MSF_CONF_SLOTFRAME_LENGTH 11
+
 #if CONTIKI_TARGET_COOJA
 #define COOJA_CONF_SIMULATE_TURNAROUND 0
 #endif /* CONTIKI_TARGET_COOJA */
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "contiki.h"
+#include "lib/assert.h"
+#include "sys/node-id.h"
+
+#include "net/linkaddr.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "net/mac/tsch/tsch.h"
+#include "net/mac/tsch/tsch-queue.h"
+#include "net/mac/tsch/tsch-schedule.h"
+#include "msf.h"
+
+#include "unit-test.h"
+#include "common.h"
+
+PROCESS(test_process, "MSF cell negotiation test");
+AUTOSTART_PROCESSES(&test_process);
+
+/* Node 1 is the coordinator, node 2 its child */
+#define COORDINATOR_ID 1
+#define WAIT_MAX       (60 * CLOCK_SECOND)
+/* About one packet per slotframe of MSF_CONF_SLOTFRAME_LENGTH 10 ms timeslots */
+#define SEND_INTERVAL  (CLOCK_SECOND / 10)
+
+static struct etimer et;
+static clock_time_t start;
+
+static int
+count_cells(uint8_t link_options)
+{
+  struct tsch_slotframe *sf = tsch_schedule_get_slotframe_by_handle(MSF_SLOTFRAME_HANDLE);
+  struct tsch_link *l;
+  int count = 0;
+  if(sf != NULL) {
+    for(l = list_head(sf->links_list); l != NULL; l = list_item_next(l)) {
+      if(l->link_options == link_options) {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+static void
+send_to_parent(void)
+{
+  struct tsch_neighbor *n = tsch_queue_get_time_source();
+  if(n != NULL && tsch_queue_packet_count(&n->addr) == 0) {
+    packetbuf_clear();
+    memset(packetbuf_dataptr(), 0, 32);
+    packetbuf_set_datalen(32);
+    packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &n->addr);
+    NETSTACK_MAC.send(NULL, NULL);
+  }
+}
+
+UNIT_TEST_REGISTER(test_rx_cell,
+                   "coordinator should install an RX cell for its child");
+UNIT_TEST(test_rx_cell)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(count_cells(LINK_OPTION_RX) >= 1);
+
+  UNIT_TEST_END();
+}
+
+UNIT_TEST_REGISTER(test_first_cell,
+                   "child should negotiate a TX cell to its parent");
+UNIT_TEST(test_first_cell)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(msf_num_tx_cells() == 1);
+  UNIT_TEST_ASSERT(count_cells(LINK_OPTION_TX) == 1);
+
+  UNIT_TEST_END();
+}
+
+UNIT_TEST_REGISTER(test_add_cell,
+                   "child should add a TX cell under load");
+UNIT_TEST(test_add_cell)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(msf_num_tx_cells() >= 2);
+
+  UNIT_TEST_END();
+}
+
+UNIT_TEST_REGISTER(test_delete_cell,
+                   "child should delete TX cells once idle");
+UNIT_TEST(test_delete_cell)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(msf_num_tx_cells() == 1);
+
+  UNIT_TEST_END();
+}
+
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  tsch_set_coordinator(node_id == COORDINATOR_ID);
+  msf_init();
+
+  etimer_set(&et, CLOCK_SECOND);
+  while(tsch_is_associated == 0) {
+    PROCESS_YIELD_UNTIL(etimer_expired(&et));
+    etimer_reset(&et);
+  }
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  if(node_id == COORDINATOR_ID) {
+    start = clock_time();
+    while(count_cells(LINK_OPTION_RX) == 0 && clock_time() - start < 2 * WAIT_MAX) {
+      PROCESS_YIELD_UNTIL(etimer_expired(&et));
+      etimer_reset(&et);
+    }
+    UNIT_TEST_RUN(test_rx_cell);
+  } else {
+    /* One cell right after joining */
+    start = clock_time();
+    while(msf_num_tx_cells() == 0 && clock_time() - start < WAIT_MAX) {
+      PROCESS_YIELD_UNTIL(etimer_expired(&et));
+      etimer_reset(&et);
+    }
+    UNIT_TEST_RUN(test_first_cell);
+
+    /* A packet per slotframe keeps the cell busy */
+    etimer_set(&et, SEND_INTERVAL);
+    start = clock_time();
+    while(msf_num_tx_cells() < 2 && clock_time() - start < WAIT_MAX) {
+      PROCESS_YIELD_UNTIL(etimer_expired(&et));
+      etimer_reset(&et);
+      send_to_parent();
+    }
+    UNIT_TEST_RUN(test_add_cell);
+
+    /* No traffic */
+    etimer_set(&et, CLOCK_SECOND);
+    start = clock_time();
+    while(msf_num_tx_cells() > 1 && clock_time() - start < WAIT_MAX) {
+      PROCESS_YIELD_UNTIL(etimer_expired(&et));
+      etimer_reset(&et);
+    }
+    UNIT_TEST_RUN(test_delete_cell);
+  }
+
+  printf("=check-me= DONE\n");
+  PROCESS_END();
+}
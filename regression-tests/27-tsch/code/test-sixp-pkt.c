@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2026, Hasso-Plattner-Institut.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "contiki.h"
+#include "lib/assert.h"
+
+#include "net/mac/frame802154e-ie.h"
+#include "net/mac/tsch/sixtop/sixp-pkt.h"
+#include "net/mac/tsch/sixtop/sixp.h"
+#include "net/mac/tsch/sixtop/sixtop.h"
+
+#include "unit-test.h"
+#include "common.h"
+
+PROCESS(test_process, "6P message creation and parsing test");
+AUTOSTART_PROCESSES(&test_process);
+
+static uint8_t buf[SIXP_PKT_MAX_LEN];
+static uint8_t cells[SIXP_PKT_MAX_CELLS * SIXP_PKT_CELL_LEN];
+
+static void
+fill_cells(uint8_t *cell_list, uint8_t count, uint16_t first_timeslot)
+{
+  struct sixp_pkt_cell cell;
+  uint8_t i;
+  for(i = 0; i < count; i++) {
+    cell.timeslot = first_timeslot + i;
+    cell.channel_offset = 0x100 + i;
+    sixp_pkt_set_cell(cell_list, i, &cell);
+  }
+}
+
+UNIT_TEST_REGISTER(test_add,
+                   "ADD request should be parsed as created");
+UNIT_TEST(test_add)
+{
+  struct sixp_pkt pkt;
+  struct sixp_pkt parsed;
+  struct sixp_pkt_cell cell;
+  int len;
+
+  UNIT_TEST_BEGIN();
+
+  fill_cells(cells, 3, 10);
+  memset(&pkt, 0, sizeof(pkt));
+  pkt.type = SIXP_PKT_TYPE_REQUEST;
+  pkt.code = SIXP_PKT_CMD_ADD;
+  pkt.sfid = 0;
+  pkt.seqnum = 42;
+  pkt.metadata = 0x1234;
+  pkt.cell_options = SIXP_PKT_CELL_OPTION_TX;
+  pkt.num_cells = 1;
+  pkt.cell_list = cells;
+  pkt.cell_list_len = 3;
+
+  len = sixp_pkt_create(&pkt, buf, sizeof(buf));
+  UNIT_TEST_ASSERT(len == SIXP_PKT_HDR_LEN + 4 + 3 * SIXP_PKT_CELL_LEN);
+  /* Version 0, type request */
+  UNIT_TEST_ASSERT(buf[0] == 0x00);
+  /* Little-endian metadata */
+  UNIT_TEST_ASSERT(buf[4] == 0x34 && buf[5] == 0x12);
+
+  UNIT_TEST_ASSERT(sixp_pkt_parse(buf, len, &parsed) == 0);
+  UNIT_TEST_ASSERT(parsed.type == SIXP_PKT_TYPE_REQUEST);
+  UNIT_TEST_ASSERT(parsed.code == SIXP_PKT_CMD_ADD);
+  UNIT_TEST_ASSERT(parsed.seqnum == 42);
+  UNIT_TEST_ASSERT(parsed.metadata == 0x1234);
+  UNIT_TEST_ASSERT(parsed.cell_options == SIXP_PKT_CELL_OPTION_TX);
+  UNIT_TEST_ASSERT(parsed.num_cells == 1);
+  UNIT_TEST_ASSERT(parsed.cell_list_len == 3);
+  UNIT_TEST_ASSERT(parsed.candidate_list == NULL);
+  sixp_pkt_get_cell(parsed.cell_list, 2, &cell);
+  UNIT_TEST_ASSERT(cell.timeslot == 12 && cell.channel_offset == 0x102);
+  UNIT_TEST_ASSERT(sixp_pkt_find_cell(parsed.cell_list, parsed.cell_list_len, &cell) == 2);
+  cell.timeslot = 13;
+  UNIT_TEST_ASSERT(sixp_pkt_find_cell(parsed.cell_list, parsed.cell_list_len, &cell) == -1);
+
+  UNIT_TEST_END();
+}
+
+UNIT_TEST_REGISTER(test_relocate,
+                   "RELOCATE request should split relocation and candidate cells");
+UNIT_TEST(test_relocate)
+{
+  struct sixp_pkt pkt;
+  struct sixp_pkt parsed;
+  struct sixp_pkt_cell cell;
+  int len;
+
+  UNIT_TEST_BEGIN();
+
+  fill_cells(cells, 2, 20);
+  fill_cells(cells + 2 * SIXP_PKT_CELL_LEN, 4, 30);
+  memset(&pkt, 0, sizeof(pkt));
+  pkt.type = SIXP_PKT_TYPE_REQUEST;
+  pkt.code = SIXP_PKT_CMD_RELOCATE;
+  pkt.seqnum = 7;
+  pkt.cell_options = SIXP_PKT_CELL_OPTION_TX;
+  pkt.num_cells = 2;
+  pkt.cell_list = cells;
+  pkt.cell_list_len = 2;
+  pkt.candidate_list = cells + 2 * SIXP_PKT_CELL_LEN;
+  pkt.candidate_list_len = 4;
+
+  len = sixp_pkt_create(&pkt, buf, sizeof(buf));
+  UNIT_TEST_ASSERT(len == SIXP_PKT_HDR_LEN + 4 + 6 * SIXP_PKT_CELL_LEN);
+  UNIT_TEST_ASSERT(sixp_pkt_parse(buf, len, &parsed) == 0);
+  UNIT_TEST_ASSERT(parsed.num_cells == 2);
+  UNIT_TEST_ASSERT(parsed.cell_list_len == 2);
+  UNIT_TEST_ASSERT(parsed.candidate_list_len == 4);
+  sixp_pkt_get_cell(parsed.cell_list, 1, &cell);
+  UNIT_TEST_ASSERT(cell.timeslot == 21);
+  sixp_pkt_get_cell(parsed.candidate_list, 0, &cell);
+  UNIT_TEST_ASSERT(cell.timeslot == 30);
+
+  /* The relocation list must hold num_cells cells */
+  pkt.cell_list_len = 1;
+  UNIT_TEST_ASSERT(sixp_pkt_create(&pkt, buf, sizeof(buf)) == -1);
+
+  UNIT_TEST_END();
+}
+
+UNIT_TEST_REGISTER(test_response,
+                   "responses and CLEAR should be parsed as created");
+UNIT_TEST(test_response)
+{
+  struct sixp_pkt pkt;
+  struct sixp_pkt parsed;
+  int len;
+
+  UNIT_TEST_BEGIN();
+
+  fill_cells(cells, 1, 5);
+  memset(&pkt, 0, sizeof(pkt));
+  pkt.type = SIXP_PKT_TYPE_RESPONSE;
+  pkt.code = SIXP_PKT_RC_SUCCESS;
+  pkt.seqnum = 3;
+  pkt.cell_list = cells;
+  pkt.cell_list_len = 1;
+  len = sixp_pkt_create(&pkt, buf, sizeof(buf));
+  UNIT_TEST_ASSERT(len == SIXP_PKT_HDR_LEN + SIXP_PKT_CELL_LEN);
+  UNIT_TEST_ASSERT(buf[0] == 0x10);
+  UNIT_TEST_ASSERT(sixp_pkt_parse(buf, len, &parsed) == 0);
+  UNIT_TEST_ASSERT(parsed.type == SIXP_PKT_TYPE_RESPONSE);
+  UNIT_TEST_ASSERT(parsed.cell_list_len == 1);
+
+  /* An error response has no body */
+  pkt.code = SIXP_PKT_RC_ERR_SEQNUM;
+  pkt.cell_list_len = 0;
+  len = sixp_pkt_create(&pkt, buf, sizeof(buf));
+  UNIT_TEST_ASSERT(len == SIXP_PKT_HDR_LEN);
+  UNIT_TEST_ASSERT(sixp_pkt_parse(buf, len, &parsed) == 0);
+  UNIT_TEST_ASSERT(parsed.code == SIXP_PKT_RC_ERR_SEQNUM);
+  UNIT_TEST_ASSERT(parsed.cell_list_len == 0);
+
+  memset(&pkt, 0, sizeof(pkt));
+  pkt.type = SIXP_PKT_TYPE_REQUEST;
+  pkt.code = SIXP_PKT_CMD_CLEAR;
+  len = sixp_pkt_create(&pkt, buf, sizeof(buf));
+  UNIT_TEST_ASSERT(len == SIXP_PKT_HDR_LEN + 2);
+  UNIT_TEST_ASSERT(sixp_pkt_parse(buf, len, &parsed) == 0);
+  UNIT_TEST_ASSERT(parsed.code == SIXP_PKT_CMD_CLEAR);
+
+  UNIT_TEST_END();
+}
+
+UNIT_TEST_REGISTER(test_malformed,
+                   "malformed messages and unknown versions should be rejected");
+UNIT_TEST(test_malformed)
+{
+  struct sixp_pkt pkt;
+  struct sixp_pkt parsed;
+  int len;
+
+  UNIT_TEST_BEGIN();
+
+  fill_cells(cells, 1, 5);
+  memset(&pkt, 0, sizeof(pkt));
+  pkt.type = SIXP_PKT_TYPE_REQUEST;
+  pkt.code = SIXP_PKT_CMD_ADD;
+  pkt.num_cells = 1;
+  pkt.cell_list = cells;
+  pkt.cell_list_len = 1;
+  len = sixp_pkt_create(&pkt, buf, sizeof(buf));
+
+  /* Truncated header, truncated cell */
+  UNIT_TEST_ASSERT(sixp_pkt_parse(buf, SIXP_PKT_HDR_LEN - 1, &parsed) == -1);
+  UNIT_TEST_ASSERT(sixp_pkt_parse(buf, len - 1, &parsed) == -1);
+  /* Reserved type */
+  buf[0] = 0x30;
+  UNIT_TEST_ASSERT(sixp_pkt_parse(buf, len, &parsed) == -1);
+  /* Unknown version, reported apart so that it gets answered */
+  buf[0] = 0x01;
+  UNIT_TEST_ASSERT(sixp_pkt_parse(buf, len, &parsed) == -2);
+  UNIT_TEST_ASSERT(parsed.type == SIXP_PKT_TYPE_REQUEST);
+  /* Does not fit */
+  UNIT_TEST_ASSERT(sixp_pkt_create(&pkt, buf, len - 1) == -1);
+
+  UNIT_TEST_END();
+}
+
+UNIT_TEST_REGISTER(test_ie,
+                   "6top IE should be parsed as created");
+UNIT_TEST(test_ie)
+{
+  static uint8_t frame[64];
+  struct ieee802154_ies ies;
+  uint8_t msg[] = { 0x00, SIXP_PKT_CMD_CLEAR, 0x00, 0x05, 0x00, 0x00 };
+  int hdr_len;
+  int ie_len;
+
+  UNIT_TEST_BEGIN();
+
+  /* An empty header IE list, then the 6top IE */
+  memset(&ies, 0, sizeof(ies));
+  hdr_len = frame80215e_create_ie_header_list_termination_1(frame, sizeof(frame), &ies);
+  UNIT_TEST_ASSERT(hdr_len == 2);
+  ies.ie_sixtop_content = msg;
+  ies.ie_sixtop_content_len = sizeof(msg);
+  ie_len = frame80215e_create_ie_sixtop(frame + hdr_len, sizeof(frame) - hdr_len, &ies);
+  UNIT_TEST_ASSERT(ie_len == 2 + 1 + sizeof(msg));
+
+  memset(&ies, 0, sizeof(ies));
+  UNIT_TEST_ASSERT(frame802154e_parse_information_elements(frame, hdr_len + ie_len, &ies) != -1);
+  UNIT_TEST_ASSERT(ies.ie_sixtop_content == frame + hdr_len + 3);
+  UNIT_TEST_ASSERT(ies.ie_sixtop_content_len == sizeof(msg));
+  UNIT_TEST_ASSERT(memcmp(ies.ie_sixtop_content, msg, sizeof(msg)) == 0);
+
+  /* Too short a buffer */
+  UNIT_TEST_ASSERT(frame80215e_create_ie_sixtop(frame, 2 + sizeof(msg), &ies) == -1);
+
+  UNIT_TEST_END();
+}
+
+/* A scheduling function that records the requests it is given */
+#define TEST_SFID 0xf0
+static int requests_received;
+
+static void
+test_request_input(const linkaddr_t *peer, const struct sixp_pkt *request,
+                   struct sixp_pkt *response)
+{
+  requests_received++;
+}
+
+static const struct sixtop_sf test_sf = {
+  TEST_SFID, CLOCK_SECOND, NULL, test_request_input, NULL, NULL, NULL
+};
+
+UNIT_TEST_REGISTER(test_oversized,
+                   "requests larger than a transaction should be rejected");
+UNIT_TEST(test_oversized)
+{
+  static uint8_t big[2 * SIXP_PKT_MAX_LEN];
+  static uint8_t big_cells[2 * SIXP_PKT_MAX_CELLS * SIXP_PKT_CELL_LEN];
+  const linkaddr_t peer = { { 0x02 } };
+  struct sixp_pkt pkt;
+  int len;
+
+  UNIT_TEST_BEGIN();
+
+  sixtop_add_sf(&test_sf);
+
+  /* Twice as many cells as a 6P message may carry */
+  fill_cells(big_cells, 2 * SIXP_PKT_MAX_CELLS, 1);
+  memset(&pkt, 0, sizeof(pkt));
+  pkt.type = SIXP_PKT_TYPE_REQUEST;
+  pkt.code = SIXP_PKT_CMD_ADD;
+  pkt.sfid = TEST_SFID;
+  pkt.num_cells = 1;
+  pkt.cell_list = big_cells;
+  pkt.cell_list_len = 2 * SIXP_PKT_MAX_CELLS;
+  len = sixp_pkt_create(&pkt, big, sizeof(big));
+  UNIT_TEST_ASSERT(len > SIXP_PKT_MAX_LEN);
+
+  requests_received = 0;
+  sixp_input(big, len, &peer);
+  UNIT_TEST_ASSERT(requests_received == 0);
+  UNIT_TEST_ASSERT(!sixp_is_busy(&peer));
+
+  /* The same request with a single cell is handed to the SF */
+  pkt.cell_list_len = 1;
+  len = sixp_pkt_create(&pkt, big, sizeof(big));
+  sixp_input(big, len, &peer);
+  UNIT_TEST_ASSERT(requests_received == 1);
+
+  UNIT_TEST_END();
+}
+
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(test_add);
+  UNIT_TEST_RUN(test_relocate);
+  UNIT_TEST_RUN(test_response);
+  UNIT_TEST_RUN(test_malformed);
+  UNIT_TEST_RUN(test_ie);
+  UNIT_TEST_RUN(test_oversized);
+
+  printf("=check-me= DONE\n");
+  PROCESS_END();
+}